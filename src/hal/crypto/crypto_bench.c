@@ -0,0 +1,239 @@
+/**
+ * @file crypto_bench.c
+ * @brief Crypto HAL Budget Benchmark
+ * @author USB Key Authentication Team
+ * @date 2025-09-09
+ * @version 1.0
+ *
+ * On MCXA156 call crypto_bench_run() from a debug command or at startup;
+ * cycles are core clock cycles read from the DWT counter. On Linux the file
+ * builds as a program, where "cycles" are nanoseconds. From the repository
+ * root:
+ * @code
+ * EXT=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/mcuboot_opensource/ext
+ * gcc -std=c11 -O2 -I src -I src/hal/crypto/port -I $EXT/tinycrypt/lib/include \
+ *     -I $EXT/tinycrypt-sha512/lib/include -I $EXT/fiat/src \
+ *     src/hal/crypto/crypto_bench.c src/hal/crypto/tinycrypt_crypto_hal.c \
+ *     src/hal/crypto/p256_comb.c src/hal/crypto/p256_field.c src/hal/crypto/p256_pool.c \
+ *     src/hal/crypto/key_slot.c src/hal/crypto/lpadc_entropy.c src/hal/crypto/ed25519.c \
+ *     src/hal/crypto/sha2.c src/hal/crypto/crypto_util.c \
+ *     src/platform/time/cycle_counter.c \
+ *     $EXT/tinycrypt/lib/source/[a-z]*.c $EXT/tinycrypt-sha512/lib/source/sha512.c \
+ *     $EXT/fiat/src/curve25519.c -o crypto_bench
+ * ./crypto_bench [-a p256|ed25519] [-i iterations] [-p]
+ * @endcode
+ *
+ * Add -DTINYCRYPT_P256_COMB=0 to time tinycrypt's ladder instead of the comb.
+ * -p fills the precompute pool between commands, so P-256 signatures time
+ * the request-path part only.
+ *
+ * The host program exits non-zero when an operation fails or either
+ * command exceeds CRYPTO_BENCH_BUDGET_MS.
+ */
+
+#include "crypto_bench.h"
+#include "tinycrypt_crypto_hal.h"
+#include "p256_pool.h"
+#include "platform/time/cycle_counter.h"
+#include <stdio.h>
+#include <string.h>
+
+/** @brief authData (37) + attested credential data for a P-256 key (~164) */
+#define BENCH_MAKE_CREDENTIAL_TBS   201U
+
+/** @brief authData (37) + clientDataHash (32) */
+#define BENCH_GET_ASSERTION_TBS     69U
+
+/** @brief Typical rpId */
+static const char k_bench_rp_id[] = "login.example.com";
+
+/**
+ * @brief Average cost of an operation in microseconds
+ */
+static uint32_t op_average_us(crypto_op_t op) {
+    crypto_op_stats_t stats;
+
+    if (tinycrypt_crypto_get_op_stats(op, &stats) != HAL_SUCCESS || stats.count == 0) {
+        return 0;
+    }
+
+    uint64_t average = stats.total_cycles / stats.count;
+    return (uint32_t)(average * 1000000u / cycle_counter_get_hz());
+}
+
+/**
+ * @brief Print the statistics table
+ */
+static void print_stats(void) {
+    printf("%-18s %8s %12s %12s %12s %10s\n",
+           "operation", "count", "avg", "min", "max", "avg_us");
+
+    for (crypto_op_t op = CRYPTO_OP_GENERATE_KEY_PAIR; op < CRYPTO_OP_COUNT; op++) {
+        crypto_op_stats_t stats;
+
+        (void)tinycrypt_crypto_get_op_stats(op, &stats);
+        printf("%-18s %8lu %12lu %12lu %12lu %10lu\n",
+               tinycrypt_crypto_op_name(op), (unsigned long)stats.count,
+               (unsigned long)(stats.count ? stats.total_cycles / stats.count : 0),
+               (unsigned long)stats.min_cycles, (unsigned long)stats.max_cycles,
+               (unsigned long)op_average_us(op));
+    }
+}
+
+/**
+ * @brief Stand-in for idle time before a command: fill the pool
+ */
+static void idle(bool idle_precompute) {
+    if (idle_precompute) {
+        while (tinycrypt_crypto_precompute()) {
+        }
+    }
+}
+
+/**
+ * @brief Sign a payload and check the signature round-trips
+ */
+static hal_result_t sign_and_verify(const crypto_hal_t* crypto,
+                                    const crypto_key_t* public_key,
+                                    const crypto_key_t* private_key,
+                                    const uint8_t* payload, size_t length) {
+    uint8_t signature[TINYCRYPT_P256_MAX_DER_SIGNATURE];
+    size_t signature_length = sizeof(signature);
+
+    hal_result_t result = crypto->sign(private_key, payload, length,
+                                       signature, &signature_length);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    return crypto->verify(public_key, payload, length, signature, signature_length);
+}
+
+hal_result_t crypto_bench_run(crypto_algorithm_t algorithm, uint32_t iterations,
+                              bool idle_precompute, crypto_bench_result_t* result) {
+    if (iterations == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    const crypto_hal_t* crypto = &tinycrypt_crypto_hal;
+    hal_result_t status = crypto->base.init();
+    if (status != HAL_SUCCESS) {
+        printf("[CRYPTO_BENCH] Backend init failed: %d\n", status);
+        return status;
+    }
+
+    uint8_t make_credential_tbs[BENCH_MAKE_CREDENTIAL_TBS];
+    uint8_t get_assertion_tbs[BENCH_GET_ASSERTION_TBS];
+    status = crypto->rng.generate_random(make_credential_tbs, sizeof(make_credential_tbs));
+    if (status == HAL_SUCCESS) {
+        status = crypto->rng.generate_random(get_assertion_tbs, sizeof(get_assertion_tbs));
+    }
+    if (status != HAL_SUCCESS) {
+        printf("[CRYPTO_BENCH] RNG failed: %d\n", status);
+        return status;
+    }
+
+    tinycrypt_crypto_reset_op_stats();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        crypto_key_t public_key;
+        crypto_key_t private_key;
+        uint8_t rp_id_hash[CRYPTO_MAX_HASH_SIZE];
+        size_t hash_length = sizeof(rp_id_hash);
+
+        idle(idle_precompute);
+        status = crypto->generate_key_pair(algorithm, &public_key, &private_key);
+        if (status != HAL_SUCCESS) {
+            printf("[CRYPTO_BENCH] generate_key_pair failed: %d\n", status);
+            return status;
+        }
+
+        status = crypto->hash(CRYPTO_HASH_SHA256, (const uint8_t*)k_bench_rp_id,
+                              sizeof(k_bench_rp_id) - 1U, rp_id_hash, &hash_length);
+        if (status == HAL_SUCCESS) {
+            memcpy(make_credential_tbs, rp_id_hash, hash_length);
+            memcpy(get_assertion_tbs, rp_id_hash, hash_length);
+            status = sign_and_verify(crypto, &public_key, &private_key,
+                                     make_credential_tbs, sizeof(make_credential_tbs));
+        }
+        if (status == HAL_SUCCESS) {
+            idle(idle_precompute);
+            status = sign_and_verify(crypto, &public_key, &private_key,
+                                     get_assertion_tbs, sizeof(get_assertion_tbs));
+        }
+
+        (void)crypto->delete_key(&public_key);
+        (void)crypto->delete_key(&private_key);
+
+        if (status != HAL_SUCCESS) {
+            printf("[CRYPTO_BENCH] Round %lu failed: %d\n", (unsigned long)i, status);
+            return status;
+        }
+    }
+
+    uint32_t hash_us = op_average_us(CRYPTO_OP_HASH);
+    uint32_t sign_us = op_average_us(CRYPTO_OP_SIGN);
+    crypto_bench_result_t summary = {
+        .make_credential_us = op_average_us(CRYPTO_OP_GENERATE_KEY_PAIR) + hash_us + sign_us,
+        .get_assertion_us = hash_us + sign_us,
+    };
+    summary.within_budget = summary.make_credential_us <= CRYPTO_BENCH_BUDGET_MS * 1000u &&
+                            summary.get_assertion_us <= CRYPTO_BENCH_BUDGET_MS * 1000u;
+
+    printf("[CRYPTO_BENCH] %s, %lu rounds, %lu cycles/s%s\n",
+           algorithm == CRYPTO_ALG_ED25519 ? "Ed25519" : "P-256",
+           (unsigned long)iterations, (unsigned long)cycle_counter_get_hz(),
+           idle_precompute ? ", pool filled between commands" : "");
+    print_stats();
+    if (idle_precompute) {
+        p256_pool_stats_t pool;
+        p256_pool_get_stats(&pool);
+        printf("pool: %lu/%lu nonces taken/missed\n",
+               (unsigned long)pool.signature_hits, (unsigned long)pool.signature_misses);
+
+        tinycrypt_rng_stats_t rng;
+        if (tinycrypt_crypto_get_rng_stats(&rng) == HAL_SUCCESS) {
+            printf("rng: %lu/%lu bytes from reservoir/DRBG, %lu reseeds, %lu bits\n",
+                   (unsigned long)rng.reservoir_bytes, (unsigned long)rng.direct_bytes,
+                   (unsigned long)rng.reseeds, (unsigned long)rng.entropy_bits);
+        }
+    }
+    printf("MakeCredential crypto: %lu us, GetAssertion crypto: %lu us, budget %lu ms: %s\n",
+           (unsigned long)summary.make_credential_us, (unsigned long)summary.get_assertion_us,
+           (unsigned long)CRYPTO_BENCH_BUDGET_MS, summary.within_budget ? "OK" : "EXCEEDED");
+
+    if (result) {
+        *result = summary;
+    }
+    return HAL_SUCCESS;
+}
+
+#if !defined(MCXA156_SERIES)
+#include <stdlib.h>
+
+int main(int argc, char** argv) {
+    crypto_algorithm_t algorithm = CRYPTO_ALG_ECC_P256;
+    uint32_t iterations = 50;
+    bool idle_precompute = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            iterations = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-p") == 0) {
+            idle_precompute = true;
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc &&
+                   (strcmp(argv[i + 1], "p256") == 0 || strcmp(argv[i + 1], "ed25519") == 0)) {
+            algorithm = strcmp(argv[++i], "ed25519") == 0 ? CRYPTO_ALG_ED25519 : CRYPTO_ALG_ECC_P256;
+        } else {
+            fprintf(stderr, "usage: %s [-a p256|ed25519] [-i iterations] [-p]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    crypto_bench_result_t result;
+    if (crypto_bench_run(algorithm, iterations, idle_precompute, &result) != HAL_SUCCESS) {
+        return 1;
+    }
+    return result.within_budget ? 0 : 1;
+}
+#endif
@@ -0,0 +1,59 @@
+#ifndef CRYPTO_BENCH_H
+#define CRYPTO_BENCH_H
+
+/**
+ * @file crypto_bench.h
+ * @brief Crypto HAL Budget Benchmark
+ * @author USB Key Authentication Team
+ * @date 2025-09-09
+ * @version 1.0
+ *
+ * Runs the crypto work of CTAP2 MakeCredential and GetAssertion through the
+ * tinycrypt backend and reports the per-operation cycle statistics. Prints
+ * with printf, so on MCXA156 the output goes to the debug console. The
+ * same file builds as a host program (see crypto_bench.c).
+ */
+
+#include "hal/interface/crypto_hal.h"
+
+/** @brief Crypto time allowed per CTAP2 command */
+#ifndef CRYPTO_BENCH_BUDGET_MS
+#define CRYPTO_BENCH_BUDGET_MS      200U
+#endif
+
+/**
+ * @brief Benchmark summary
+ */
+typedef struct {
+    uint32_t make_credential_us;    /**< keygen + rpId hash + attestation sign */
+    uint32_t get_assertion_us;      /**< rpId hash + assertion sign */
+    bool within_budget;             /**< Both fit in CRYPTO_BENCH_BUDGET_MS */
+} crypto_bench_result_t;
+
+/**
+ * @brief Run the benchmark
+ *
+ * Initializes tinycrypt_crypto_hal if needed and clears its statistics.
+ * Every iteration generates a key pair, hashes an rpId, signs a
+ * MakeCredential and a GetAssertion payload, verifies both signatures and
+ * deletes the keys.
+ *
+ * @param algorithm Credential algorithm (CRYPTO_ALG_ECC_P256 or
+ *                  CRYPTO_ALG_ED25519)
+ * @param iterations Rounds to run (at least 1)
+ * @param idle_precompute Fill the precompute pool before every command, as
+ *                        idle time between requests would; the fill is not
+ *                        counted
+ * @param result Output summary, may be NULL
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM iterations is 0
+ * @retval HAL_ERROR_NOT_SUPPORTED The backend does not sign with algorithm
+ * @retval HAL_ERROR_HARDWARE_FAILURE A signature failed to verify
+ *
+ * @note Blocks for iterations * (keygen + 2 signs + 2 verifies); run it
+ *       from a task that may starve the ones below it
+ */
+hal_result_t crypto_bench_run(crypto_algorithm_t algorithm, uint32_t iterations,
+                              bool idle_precompute, crypto_bench_result_t* result);
+
+#endif // CRYPTO_BENCH_H
@@ -0,0 +1,18 @@
+/**
+ * @file crypto_util.c
+ * @brief Helpers Shared by the Software Crypto Modules
+ * @author USB Key Authentication Team
+ * @date 2025-09-14
+ * @version 1.0
+ */
+
+#include "crypto_util.h"
+#include <stdint.h>
+
+void crypto_secure_zero(void* data, size_t length) {
+    volatile uint8_t* p = (volatile uint8_t*)data;
+
+    while (length-- > 0) {
+        *p++ = 0;
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef CRYPTO_UTIL_H
+#define CRYPTO_UTIL_H
+
+/**
+ * @file crypto_util.h
+ * @brief Helpers Shared by the Software Crypto Modules
+ * @author USB Key Authentication Team
+ * @date 2025-09-14
+ * @version 1.0
+ */
+
+#include <stddef.h>
+
+/**
+ * @brief Zero memory the compiler may not optimize away
+ *
+ * For keys, seeds and intermediate secrets about to go out of scope.
+ *
+ * @param data Memory to clear
+ * @param length Bytes to clear
+ */
+void crypto_secure_zero(void* data, size_t length);
+
+#endif // CRYPTO_UTIL_H
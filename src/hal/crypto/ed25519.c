@@ -0,0 +1,317 @@
+/**
+ * @file ed25519.c
+ * @brief Ed25519 Signatures on the Vendored fiat Curve25519
+ * @author USB Key Authentication Team
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ * Base-point multiplication uses the signed all-bits comb of p256_comb.c
+ * with T teeth and spacing D over the group order L: the scalar k is mapped
+ * to b = (k + 2^(T*D) - 1) / 2 mod L and every bit of b is read as a sign,
+ * so each of the D columns adds one of the 2^(T-1) table points or its
+ * negation. The vendored addition formulas are complete on the twisted
+ * Edwards curve, so doublings are additions of a point to itself and no
+ * input needs special handling.
+ *
+ * Table entries are stored as cached points with Z = 1 plus the negated
+ * T*2d, so negating an entry is a masked swap of Y+X and Y-X and a masked
+ * choice of T*2d.
+ */
+
+#include "ed25519.h"
+#include "ed25519_fiat.h"
+#include "ed25519_comb_table.h"
+#include "sha2.h"
+#include "crypto_util.h"
+#include <string.h>
+
+#if ED25519_COMB_TABLE_TEETH != ED25519_COMB_TEETH
+#error "ed25519_comb_table.h does not match ED25519_COMB_TEETH, regenerate it with ed25519_comb_gen"
+#endif
+
+/** @brief 32-bit words in a scalar */
+#define SCALAR_WORDS    8
+
+/** @brief Bits needed to index every tooth of every column */
+#define RECODED_WORDS   ((ED25519_COMB_TEETH * ED25519_COMB_SPACING + 31) / 32)
+
+/** @brief Fields of a table entry */
+enum {
+    ENTRY_Y_PLUS_X = 0,
+    ENTRY_Y_MINUS_X,
+    ENTRY_T2D,
+    ENTRY_NEG_T2D,
+    ENTRY_FIELDS
+};
+
+/** @brief Group order L = 2^252 + 27742317777372353535851937790883648493 */
+static const uint32_t k_group_order[SCALAR_WORDS] = {
+    0x5CF5D3EDU, 0x5812631AU, 0xA2F79CD6U, 0x14DEF9DEU,
+    0x00000000U, 0x00000000U, 0x00000000U, 0x10000000U
+};
+
+// =============================================================================
+// Scalar arithmetic mod L
+// =============================================================================
+
+static void load_words(uint32_t* words, const uint8_t* bytes) {
+    for (unsigned i = 0; i < SCALAR_WORDS; i++) {
+        words[i] = (uint32_t)bytes[4 * i] | ((uint32_t)bytes[4 * i + 1] << 8) |
+                   ((uint32_t)bytes[4 * i + 2] << 16) | ((uint32_t)bytes[4 * i + 3] << 24);
+    }
+}
+
+/**
+ * @brief r = a + b, returns the carry
+ */
+static uint32_t words_add(uint32_t* r, const uint32_t* a, const uint32_t* b) {
+    uint64_t acc = 0;
+
+    for (unsigned i = 0; i < SCALAR_WORDS; i++) {
+        acc += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)acc;
+        acc >>= 32;
+    }
+    return (uint32_t)acc;
+}
+
+/**
+ * @brief r = mask ? a : b
+ */
+static void words_select(uint32_t* r, const uint32_t* a, const uint32_t* b, uint32_t mask) {
+    for (unsigned i = 0; i < SCALAR_WORDS; i++) {
+        r[i] = (a[i] & mask) | (b[i] & ~mask);
+    }
+}
+
+/**
+ * @brief s = a * b + c mod L, all little-endian 32-byte values
+ */
+static void sc_muladd(uint8_t* s, const uint8_t* a, const uint8_t* b, const uint8_t* c) {
+    uint32_t x[SCALAR_WORDS], y[SCALAR_WORDS], z[SCALAR_WORDS];
+    uint32_t product[2 * SCALAR_WORDS] = {0};
+    uint8_t wide[64];
+
+    load_words(x, a);
+    load_words(y, b);
+    load_words(z, c);
+
+    for (unsigned i = 0; i < SCALAR_WORDS; i++) {
+        uint64_t carry = 0;
+        for (unsigned j = 0; j < SCALAR_WORDS; j++) {
+            carry += (uint64_t)x[i] * y[j] + product[i + j];
+            product[i + j] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        product[i + SCALAR_WORDS] = (uint32_t)carry;
+    }
+
+    // a, b < 2^256 and c < 2^253 keep the sum below 2^512
+    uint64_t carry = 0;
+    for (unsigned i = 0; i < 2 * SCALAR_WORDS; i++) {
+        carry += (uint64_t)product[i] + (i < SCALAR_WORDS ? z[i] : 0U);
+        wide[4 * i] = (uint8_t)carry;
+        wide[4 * i + 1] = (uint8_t)(carry >> 8);
+        wide[4 * i + 2] = (uint8_t)(carry >> 16);
+        wide[4 * i + 3] = (uint8_t)(carry >> 24);
+        carry >>= 32;
+    }
+
+    x25519_sc_reduce(wide);
+    memcpy(s, wide, 32);
+
+    crypto_secure_zero(x, sizeof(x));
+    crypto_secure_zero(y, sizeof(y));
+    crypto_secure_zero(product, sizeof(product));
+    crypto_secure_zero(wide, sizeof(wide));
+}
+
+// =============================================================================
+// Comb
+// =============================================================================
+
+/**
+ * @brief b = (k + 2^(T*D) - 1) / 2 mod L
+ */
+static void comb_recode(uint32_t* recoded, const uint8_t* scalar) {
+    uint8_t wide[64] = {0};
+    uint32_t t[SCALAR_WORDS], reduced[SCALAR_WORDS];
+
+    memcpy(wide, scalar, 32);
+    x25519_sc_reduce(wide);
+    load_words(t, wide);
+
+    // t + offset < 2L < 2^254, subtract L once if needed
+    (void)words_add(t, t, k_ed25519_comb_offset);
+    uint64_t borrow = 0;
+    for (unsigned i = 0; i < SCALAR_WORDS; i++) {
+        uint64_t diff = (uint64_t)t[i] - k_group_order[i] - borrow;
+        reduced[i] = (uint32_t)diff;
+        borrow = (diff >> 32) & 1U;
+    }
+    words_select(t, t, reduced, 0U - (uint32_t)borrow);
+
+    // Halve mod L: (t + L) / 2 when t is odd, t + L < 2^254 has no carry
+    (void)words_add(reduced, t, k_group_order);
+    words_select(t, reduced, t, 0U - (t[0] & 1U));
+
+    memset(recoded, 0, RECODED_WORDS * sizeof(uint32_t));
+    for (unsigned i = 0; i < SCALAR_WORDS; i++) {
+        uint32_t high = (i + 1 < SCALAR_WORDS) ? t[i + 1] : 0U;
+        recoded[i] = (t[i] >> 1) | (high << 31);
+    }
+
+    crypto_secure_zero(wide, sizeof(wide));
+    crypto_secure_zero(t, sizeof(t));
+    crypto_secure_zero(reduced, sizeof(reduced));
+}
+
+/**
+ * @brief Read bit position of the recoded scalar
+ */
+static uint32_t comb_bit(const uint32_t* recoded, unsigned position) {
+    return (recoded[position / 32] >> (position % 32)) & 1U;
+}
+
+/**
+ * @brief Load column i as a cached +-table[index] without secret-dependent access
+ */
+static void comb_load_column(ge_cached* point, const uint32_t* recoded, unsigned column) {
+    uint32_t top = comb_bit(recoded, column + (ED25519_COMB_TEETH - 1) * ED25519_COMB_SPACING);
+    uint32_t index = 0;
+    uint32_t entry_words[ENTRY_FIELDS][ED25519_FE_LIMBS] = {{0}};
+
+    // Table entries assume a + top tooth; flip every sign when it is -
+    for (unsigned j = 0; j < ED25519_COMB_TEETH - 1; j++) {
+        index |= (comb_bit(recoded, column + j * ED25519_COMB_SPACING) ^ top ^ 1U) << j;
+    }
+
+    for (uint32_t entry = 0; entry < ED25519_COMB_POINTS; entry++) {
+        uint32_t diff = entry ^ index;
+        uint32_t mask = ((diff | (0U - diff)) >> 31) - 1U;
+        for (unsigned f = 0; f < ENTRY_FIELDS; f++) {
+            for (unsigned i = 0; i < ED25519_FE_LIMBS; i++) {
+                entry_words[f][i] |= k_ed25519_comb_table[entry][f][i] & mask;
+            }
+        }
+    }
+
+    // -P swaps Y+X with Y-X and negates T*2d
+    uint32_t positive = 0U - top;
+    for (unsigned i = 0; i < ED25519_FE_LIMBS; i++) {
+        uint32_t plus = entry_words[ENTRY_Y_PLUS_X][i];
+        uint32_t minus = entry_words[ENTRY_Y_MINUS_X][i];
+        point->YplusX.v[i] = (plus & positive) | (minus & ~positive);
+        point->YminusX.v[i] = (minus & positive) | (plus & ~positive);
+        point->T2d.v[i] = (entry_words[ENTRY_T2D][i] & positive) |
+                          (entry_words[ENTRY_NEG_T2D][i] & ~positive);
+        point->Z.v[i] = (i == 0) ? 1U : 0U;
+    }
+
+    crypto_secure_zero(entry_words, sizeof(entry_words));
+}
+
+void ed25519_mul_base(uint8_t* point, const uint8_t* scalar) {
+    uint32_t recoded[RECODED_WORDS];
+    ge_p3 r = { .Y.v = {1}, .Z.v = {1} };     // Neutral element (0, 1)
+    ge_cached addend;
+    ge_p1p1 sum;
+    ge_p2 result;
+
+    comb_recode(recoded, scalar);
+
+    for (unsigned column = ED25519_COMB_SPACING; column-- > 0;) {
+        if (column != ED25519_COMB_SPACING - 1) {
+            x25519_ge_p3_to_cached(&addend, &r);
+            x25519_ge_add(&sum, &r, &addend);
+            x25519_ge_p1p1_to_p3(&r, &sum);
+        }
+        comb_load_column(&addend, recoded, column);
+        x25519_ge_add(&sum, &r, &addend);
+        x25519_ge_p1p1_to_p3(&r, &sum);
+    }
+
+    result.X = r.X;
+    result.Y = r.Y;
+    result.Z = r.Z;
+    x25519_ge_tobytes(point, &result);
+
+    crypto_secure_zero(recoded, sizeof(recoded));
+    crypto_secure_zero(&r, sizeof(r));
+    crypto_secure_zero(&addend, sizeof(addend));
+    crypto_secure_zero(&sum, sizeof(sum));
+    crypto_secure_zero(&result, sizeof(result));
+}
+
+// =============================================================================
+// Signatures
+// =============================================================================
+
+/**
+ * @brief SHA-512 over up to three concatenated parts
+ */
+static void sha512_parts(uint8_t* digest, const uint8_t* a, size_t a_length,
+                         const uint8_t* b, size_t b_length,
+                         const uint8_t* c, size_t c_length) {
+    sha512_context_t sha;
+
+    sha512_init(&sha);
+    sha512_update(&sha, a, a_length);
+    sha512_update(&sha, b, b_length);
+    sha512_update(&sha, c, c_length);
+    sha512_final(&sha, digest);
+}
+
+/**
+ * @brief Expand a seed into the clamped scalar (first half) and nonce prefix
+ */
+static void expand_seed(uint8_t* expanded, const uint8_t* seed) {
+    sha512_parts(expanded, seed, ED25519_SEED_SIZE, NULL, 0, NULL, 0);
+    expanded[0] &= 248;
+    expanded[31] &= 127;
+    expanded[31] |= 64;
+}
+
+void ed25519_key_from_seed(uint8_t* private_key, const uint8_t* seed) {
+    uint8_t expanded[64];
+
+    expand_seed(expanded, seed);
+    memmove(private_key, seed, ED25519_SEED_SIZE);
+    ed25519_mul_base(private_key + ED25519_SEED_SIZE, expanded);
+    crypto_secure_zero(expanded, sizeof(expanded));
+}
+
+void ed25519_sign(uint8_t* signature, const uint8_t* message, size_t length,
+                  const uint8_t* private_key) {
+    const uint8_t* public_key = private_key + ED25519_SEED_SIZE;
+    uint8_t expanded[64];
+    uint8_t nonce[64];
+    uint8_t challenge[64];
+
+    expand_seed(expanded, private_key);
+
+    // r = H(prefix || M), R = rB
+    sha512_parts(nonce, expanded + 32, 32, message, length, NULL, 0);
+    x25519_sc_reduce(nonce);
+    ed25519_mul_base(signature, nonce);
+
+    // S = r + H(R || A || M) * a
+    sha512_parts(challenge, signature, 32, public_key, ED25519_PUBLIC_KEY_SIZE,
+                 message, length);
+    x25519_sc_reduce(challenge);
+    sc_muladd(signature + 32, challenge, expanded, nonce);
+
+    crypto_secure_zero(expanded, sizeof(expanded));
+    crypto_secure_zero(nonce, sizeof(nonce));
+}
+
+int ed25519_verify(const uint8_t* message, size_t length, const uint8_t* signature,
+                   const uint8_t* public_key) {
+    return ED25519_verify(message, length, signature, public_key);
+}
+
+int ed25519_valid_public_key(const uint8_t* public_key) {
+    ge_p3 point;
+
+    return x25519_ge_frombytes_vartime(&point, public_key);
+}
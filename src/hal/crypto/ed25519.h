@@ -0,0 +1,101 @@
+#ifndef ED25519_H
+#define ED25519_H
+
+/**
+ * @file ed25519.h
+ * @brief Ed25519 Signatures on the Vendored fiat Curve25519
+ * @author USB Key Authentication Team
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ * RFC 8032 Ed25519 (PureEdDSA) key generation, signing and verification
+ * built on the fiat-crypto curve25519.c and tinycrypt SHA-512 vendored with
+ * the SDK's mcuboot (middleware/mcuboot_opensource/ext); key generation and
+ * signing hash with sha2.h instead. mcuboot only needs
+ * verification, so its copy has no base-point multiplication: signing and
+ * key generation multiply the base point through a signed comb over a
+ * precomputed table in flash (ed25519_comb_table.h), like p256_comb.h.
+ *
+ * The comb has the same side-channel properties as the P-256 one: a fixed
+ * sequence of group operations for every scalar, table entries read by a
+ * masked scan of the whole table and negated with masks. Verification uses
+ * the vendored ED25519_verify(), which only handles public data.
+ *
+ * The vendored curve25519.c includes <mcuboot_config/mcuboot_config.h>;
+ * builds outside mcuboot put src/hal/crypto/port on the include path for
+ * it.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Private key seed size in bytes */
+#define ED25519_SEED_SIZE           32U
+
+/** @brief Encoded public key size in bytes */
+#define ED25519_PUBLIC_KEY_SIZE     32U
+
+/** @brief Private key size: seed || public key */
+#define ED25519_PRIVATE_KEY_SIZE    (ED25519_SEED_SIZE + ED25519_PUBLIC_KEY_SIZE)
+
+/** @brief Signature size in bytes (R || S) */
+#define ED25519_SIGNATURE_SIZE      64U
+
+/** @brief Comb teeth: table holds 2^(teeth-1) points */
+#define ED25519_COMB_TEETH          6
+
+/** @brief Bits between teeth, also the number of comb columns */
+#define ED25519_COMB_SPACING        ((253 + ED25519_COMB_TEETH - 1) / ED25519_COMB_TEETH)
+
+/** @brief Points in the comb table */
+#define ED25519_COMB_POINTS         (1 << (ED25519_COMB_TEETH - 1))
+
+/**
+ * @brief Multiply the base point by a scalar
+ *
+ * @param point Output encoded point (32 bytes)
+ * @param scalar Little-endian scalar (32 bytes), reduced mod the group
+ *               order internally
+ */
+void ed25519_mul_base(uint8_t* point, const uint8_t* scalar);
+
+/**
+ * @brief Derive a key pair from a seed
+ *
+ * @param private_key Output seed || public key (ED25519_PRIVATE_KEY_SIZE)
+ * @param seed Random seed (ED25519_SEED_SIZE)
+ */
+void ed25519_key_from_seed(uint8_t* private_key, const uint8_t* seed);
+
+/**
+ * @brief Sign a message
+ *
+ * @param signature Output R || S (ED25519_SIGNATURE_SIZE)
+ * @param message Message, signed as is (no prehash)
+ * @param length Message length in bytes
+ * @param private_key Seed || public key from ed25519_key_from_seed()
+ */
+void ed25519_sign(uint8_t* signature, const uint8_t* message, size_t length,
+                  const uint8_t* private_key);
+
+/**
+ * @brief Verify a signature
+ *
+ * @param message Signed message
+ * @param length Message length in bytes
+ * @param signature R || S
+ * @param public_key Encoded public key
+ * @return 1 if the signature is valid, 0 otherwise
+ */
+int ed25519_verify(const uint8_t* message, size_t length, const uint8_t* signature,
+                   const uint8_t* public_key);
+
+/**
+ * @brief Check that 32 bytes encode a curve point
+ *
+ * @param public_key Encoded public key
+ * @return 1 if it decodes, 0 otherwise
+ */
+int ed25519_valid_public_key(const uint8_t* public_key);
+
+#endif // ED25519_H
@@ -0,0 +1,161 @@
+/**
+ * @file ed25519_check.c
+ * @brief Known-Answer Check of ed25519.h
+ * @author USB Key Authentication Team
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ * On MCXA156 call ed25519_check_run() from a debug command to validate the
+ * comb and the signing path on the real core. On Linux the file builds as
+ * a program. From the repository root:
+ * @code
+ * EXT=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/mcuboot_opensource/ext
+ * gcc -std=c11 -O2 -I src -I src/hal/crypto/port -I $EXT/fiat/src \
+ *     -I $EXT/tinycrypt/lib/include -I $EXT/tinycrypt-sha512/lib/include \
+ *     src/hal/crypto/ed25519_check.c src/hal/crypto/ed25519.c src/hal/crypto/sha2.c \
+ *     src/hal/crypto/crypto_util.c $EXT/fiat/src/curve25519.c \
+ *     $EXT/tinycrypt-sha512/lib/source/sha512.c $EXT/tinycrypt/lib/source/utils.c \
+ *     -o ed25519_check
+ * ./ed25519_check
+ * @endcode
+ *
+ * The host program exits non-zero on any mismatch.
+ */
+
+#include "ed25519_check.h"
+#include "ed25519.h"
+#include "crypto_util.h"
+#include <stdio.h>
+#include <string.h>
+
+/** @brief Longest test message */
+#define CHECK_MAX_MESSAGE   2U
+
+/**
+ * @brief RFC 8032 section 7.1 test vector
+ */
+typedef struct {
+    const char* name;                               /**< RFC test name */
+    uint8_t seed[ED25519_SEED_SIZE];                /**< SECRET KEY */
+    uint8_t public_key[ED25519_PUBLIC_KEY_SIZE];    /**< PUBLIC KEY */
+    uint8_t message[CHECK_MAX_MESSAGE];             /**< MESSAGE */
+    size_t length;                                  /**< Message length */
+    uint8_t signature[ED25519_SIGNATURE_SIZE];      /**< SIGNATURE */
+} known_answer_t;
+
+static const known_answer_t k_known_answers[] = {
+    {
+        "TEST 1",
+        { 0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60, 0xba, 0x84, 0x4a, 0xf4, 0x92, 0xec, 0x2c, 0xc4,
+          0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32, 0x69, 0x19, 0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60 },
+        { 0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+          0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a },
+        { 0 },
+        0,
+        { 0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2, 0xcc, 0x80, 0x6e, 0x82, 0x8a,
+          0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5, 0xd9, 0x74, 0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55,
+          0x5f, 0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70, 0x1c, 0xf9, 0xb4, 0x6b,
+          0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe, 0x24, 0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b },
+    },
+    {
+        "TEST 2",
+        { 0x4c, 0xcd, 0x08, 0x9b, 0x28, 0xff, 0x96, 0xda, 0x9d, 0xb6, 0xc3, 0x46, 0xec, 0x11, 0x4e, 0x0f,
+          0x5b, 0x8a, 0x31, 0x9f, 0x35, 0xab, 0xa6, 0x24, 0xda, 0x8c, 0xf6, 0xed, 0x4f, 0xb8, 0xa6, 0xfb },
+        { 0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a, 0x92, 0xb7, 0x0a, 0xa7, 0x4d, 0x1b, 0x7e, 0xbc,
+          0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c, 0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c },
+        { 0x72 },
+        1,
+        { 0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8, 0x72, 0x0e, 0x82, 0x0b, 0x5f, 0x64, 0x25, 0x40,
+          0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f, 0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda,
+          0x08, 0x5a, 0xc1, 0xe4, 0x3e, 0x15, 0x99, 0x6e, 0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+          0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee, 0xb0, 0x0d, 0x29, 0x16, 0x12, 0xbb, 0x0c, 0x00 },
+    },
+    {
+        "TEST 3",
+        { 0xc5, 0xaa, 0x8d, 0xf4, 0x3f, 0x9f, 0x83, 0x7b, 0xed, 0xb7, 0x44, 0x2f, 0x31, 0xdc, 0xb7, 0xb1,
+          0x66, 0xd3, 0x85, 0x35, 0x07, 0x6f, 0x09, 0x4b, 0x85, 0xce, 0x3a, 0x2e, 0x0b, 0x44, 0x58, 0xf7 },
+        { 0xfc, 0x51, 0xcd, 0x8e, 0x62, 0x18, 0xa1, 0xa3, 0x8d, 0xa4, 0x7e, 0xd0, 0x02, 0x30, 0xf0, 0x58,
+          0x08, 0x16, 0xed, 0x13, 0xba, 0x33, 0x03, 0xac, 0x5d, 0xeb, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25 },
+        { 0xaf, 0x82 },
+        2,
+        { 0x62, 0x91, 0xd6, 0x57, 0xde, 0xec, 0x24, 0x02, 0x48, 0x27, 0xe6, 0x9c, 0x3a, 0xbe, 0x01, 0xa3,
+          0x0c, 0xe5, 0x48, 0xa2, 0x84, 0x74, 0x3a, 0x44, 0x5e, 0x36, 0x80, 0xd7, 0xdb, 0x5a, 0xc3, 0xac,
+          0x18, 0xff, 0x9b, 0x53, 0x8d, 0x16, 0xf2, 0x90, 0xae, 0x67, 0xf7, 0x60, 0x98, 0x4d, 0xc6, 0x59,
+          0x4a, 0x7c, 0x15, 0xe9, 0x71, 0x6e, 0xd2, 0x8d, 0xc0, 0x27, 0xbe, 0xce, 0xea, 0x1e, 0xc4, 0x0a },
+    },
+};
+
+#define KNOWN_ANSWER_COUNT  (sizeof(k_known_answers) / sizeof(k_known_answers[0]))
+
+static void report(const char* name, const char* what) {
+    printf("[ED25519] %s: %s mismatch\n", name, what);
+}
+
+/**
+ * @brief Check one vector, returns the number of mismatches
+ */
+static uint32_t check_vector(const known_answer_t* vector) {
+    uint8_t private_key[ED25519_PRIVATE_KEY_SIZE];
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    uint8_t altered[CHECK_MAX_MESSAGE + 1];
+    uint32_t mismatches = 0;
+
+    ed25519_key_from_seed(private_key, vector->seed);
+    if (memcmp(private_key, vector->seed, ED25519_SEED_SIZE) != 0 ||
+        memcmp(&private_key[ED25519_SEED_SIZE], vector->public_key,
+               ED25519_PUBLIC_KEY_SIZE) != 0) {
+        report(vector->name, "public key");
+        mismatches++;
+    }
+
+    ed25519_sign(signature, vector->message, vector->length, private_key);
+    if (memcmp(signature, vector->signature, ED25519_SIGNATURE_SIZE) != 0) {
+        report(vector->name, "signature");
+        mismatches++;
+    }
+
+    if (!ed25519_verify(vector->message, vector->length, vector->signature,
+                        vector->public_key)) {
+        report(vector->name, "verify");
+        mismatches++;
+    }
+
+    // One more byte: the RFC signature must no longer verify
+    memcpy(altered, vector->message, vector->length);
+    altered[vector->length] = 0x00;
+    if (ed25519_verify(altered, vector->length + 1, vector->signature, vector->public_key)) {
+        report(vector->name, "verify of an altered message");
+        mismatches++;
+    }
+
+    crypto_secure_zero(private_key, sizeof(private_key));
+    return mismatches;
+}
+
+hal_result_t ed25519_check_run(ed25519_check_result_t* result) {
+    ed25519_check_result_t summary = {0};
+
+    for (size_t i = 0; i < KNOWN_ANSWER_COUNT; i++) {
+        summary.mismatches += check_vector(&k_known_answers[i]);
+        summary.vectors++;
+    }
+
+    printf("[ED25519] %lu RFC 8032 vectors, %lu mismatches\n", (unsigned long)summary.vectors,
+           (unsigned long)summary.mismatches);
+
+    if (result) {
+        *result = summary;
+    }
+    return summary.mismatches == 0 ? HAL_SUCCESS : HAL_ERROR_HARDWARE_FAILURE;
+}
+
+#if !defined(MCXA156_SERIES)
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        fprintf(stderr, "usage: %s\n", argv[0]);
+        return 2;
+    }
+
+    return ed25519_check_run(NULL) == HAL_SUCCESS ? 0 : 1;
+}
+#endif
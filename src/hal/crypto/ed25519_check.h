@@ -0,0 +1,36 @@
+#ifndef ED25519_CHECK_H
+#define ED25519_CHECK_H
+
+/**
+ * @file ed25519_check.h
+ * @brief Known-Answer Check of ed25519.h
+ * @author USB Key Authentication Team
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ * Checks key derivation, signing and verification against the RFC 8032
+ * section 7.1 test vectors, and that a signature stops verifying once the
+ * message is altered. On Linux the same file builds as a program (see
+ * ed25519_check.c).
+ */
+
+#include "hal/interface/hal_common.h"
+
+/**
+ * @brief Check summary
+ */
+typedef struct {
+    uint32_t vectors;               /**< Test vectors checked */
+    uint32_t mismatches;            /**< Results that differ from the RFC */
+} ed25519_check_result_t;
+
+/**
+ * @brief Run the check
+ *
+ * @param result Output summary, may be NULL
+ * @return HAL_SUCCESS if every vector matched
+ * @retval HAL_ERROR_HARDWARE_FAILURE At least one mismatch (each is printed)
+ */
+hal_result_t ed25519_check_run(ed25519_check_result_t* result);
+
+#endif // ED25519_CHECK_H
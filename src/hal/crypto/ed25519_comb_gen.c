@@ -0,0 +1,143 @@
+/**
+ * @file ed25519_comb_gen.c
+ * @brief Host generator for the Ed25519 comb table
+ * @author USB Key Authentication Team
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ * Writes ed25519_comb_table.h for the ED25519_COMB_TEETH configured in
+ * ed25519.h. Rerun after changing the teeth count, from the repository
+ * root:
+ * @code
+ * EXT=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/mcuboot_opensource/ext
+ * gcc -std=c11 -O2 -I src/hal/crypto/port -I $EXT/fiat/src \
+ *     -I $EXT/tinycrypt/lib/include -I $EXT/tinycrypt-sha512/lib/include \
+ *     src/hal/crypto/ed25519_comb_gen.c $EXT/fiat/src/curve25519.c \
+ *     $EXT/tinycrypt-sha512/lib/source/sha512.c $EXT/tinycrypt/lib/source/utils.c \
+ *     -o ed25519_comb_gen
+ * ./ed25519_comb_gen > src/hal/crypto/ed25519_comb_table.h
+ * @endcode
+ *
+ * Entry i of the table is
+ *   2^((T-1)*D) B + sum over j < T-1 of (bit j of i ? +1 : -1) * 2^(j*D) B
+ * with T teeth and spacing D, as an affine cached point (Y+X, Y-X, T*2d)
+ * followed by the T*2d of its negation.
+ */
+
+#include "ed25519.h"
+#include "ed25519_fiat.h"
+#include <stdio.h>
+#include <string.h>
+
+/** @brief Encoded base point, y = 4/5 */
+static const uint8_t k_base_point[32] = {
+    0x58, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+};
+
+/**
+ * @brief Reduce a point to affine coordinates through its encoding
+ */
+static void normalize(ge_p3* point, uint8_t* encoded) {
+    ge_p2 projective = { point->X, point->Y, point->Z };
+
+    x25519_ge_tobytes(encoded, &projective);
+    (void)x25519_ge_frombytes_vartime(point, encoded);
+}
+
+static void point_double(ge_p3* point) {
+    ge_cached cached;
+    ge_p1p1 sum;
+
+    x25519_ge_p3_to_cached(&cached, point);
+    x25519_ge_add(&sum, point, &cached);
+    x25519_ge_p1p1_to_p3(point, &sum);
+}
+
+static void print_limbs(const fe_loose* f) {
+    printf("{ ");
+    for (unsigned i = 0; i < ED25519_FE_LIMBS; i++) {
+        printf(i == 0 ? "0x%08XU" : ", 0x%08XU", f->v[i]);
+    }
+    printf(" }");
+}
+
+int main(void) {
+    ge_p3 teeth[ED25519_COMB_TEETH];
+    uint8_t encoded[32];
+    uint8_t offset[64] = {0};
+
+    // 2^(T*D) - 1 mod L, the offset of the signed-digit recoding
+    for (unsigned bit = 0; bit < ED25519_COMB_TEETH * ED25519_COMB_SPACING; bit++) {
+        offset[bit / 8] |= (uint8_t)(1U << (bit % 8));
+    }
+    x25519_sc_reduce(offset);
+
+    // teeth[j] = 2^(j*D) B
+    if (!x25519_ge_frombytes_vartime(&teeth[0], k_base_point)) {
+        fprintf(stderr, "bad base point\n");
+        return 1;
+    }
+    for (unsigned j = 1; j < ED25519_COMB_TEETH; j++) {
+        teeth[j] = teeth[j - 1];
+        for (unsigned i = 0; i < ED25519_COMB_SPACING; i++) {
+            point_double(&teeth[j]);
+        }
+        normalize(&teeth[j], encoded);
+    }
+
+    printf("#ifndef ED25519_COMB_TABLE_H\n#define ED25519_COMB_TABLE_H\n\n");
+    printf("/**\n * @file ed25519_comb_table.h\n * @brief Ed25519 Base Point Comb Table\n *\n");
+    printf(" * Generated by ed25519_comb_gen.c, do not edit.\n */\n\n");
+    printf("#include <stdint.h>\n\n");
+    printf("/** @brief Teeth the table was generated for */\n");
+    printf("#define ED25519_COMB_TABLE_TEETH    %d\n\n", ED25519_COMB_TEETH);
+    printf("/** @brief 2^(teeth * spacing) - 1 mod L, little-endian words */\n");
+    printf("static const uint32_t k_ed25519_comb_offset[8] = {\n    ");
+    for (unsigned i = 0; i < 8; i++) {
+        uint32_t word = (uint32_t)offset[4 * i] | ((uint32_t)offset[4 * i + 1] << 8) |
+                        ((uint32_t)offset[4 * i + 2] << 16) | ((uint32_t)offset[4 * i + 3] << 24);
+        printf(i == 0 ? "0x%08XU" : (i % 4 == 0 ? ",\n    0x%08XU" : ", 0x%08XU"), word);
+    }
+    printf("\n};\n\n");
+    printf("/** @brief Cached points: Y+X, Y-X, T*2d, -T*2d as fiat limbs */\n");
+    printf("static const uint32_t k_ed25519_comb_table[%d][4][10] = {\n", ED25519_COMB_POINTS);
+
+    for (unsigned index = 0; index < ED25519_COMB_POINTS; index++) {
+        ge_p3 point = teeth[ED25519_COMB_TEETH - 1];
+        ge_cached cached;
+        ge_p1p1 sum;
+
+        for (unsigned j = 0; j < ED25519_COMB_TEETH - 1; j++) {
+            x25519_ge_p3_to_cached(&cached, &teeth[j]);
+            if (index & (1U << j)) {
+                x25519_ge_add(&sum, &point, &cached);
+            } else {
+                x25519_ge_sub(&sum, &point, &cached);
+            }
+            x25519_ge_p1p1_to_p3(&point, &sum);
+        }
+
+        normalize(&point, encoded);
+        x25519_ge_p3_to_cached(&cached, &point);
+
+        ge_p3 negated;
+        ge_cached negated_cached;
+        encoded[31] ^= 0x80;
+        (void)x25519_ge_frombytes_vartime(&negated, encoded);
+        x25519_ge_p3_to_cached(&negated_cached, &negated);
+
+        printf("    {\n        ");
+        print_limbs(&cached.YplusX);
+        printf(",\n        ");
+        print_limbs(&cached.YminusX);
+        printf(",\n        ");
+        print_limbs(&cached.T2d);
+        printf(",\n        ");
+        print_limbs(&negated_cached.T2d);
+        printf("\n    },\n");
+    }
+
+    printf("};\n\n#endif // ED25519_COMB_TABLE_H\n");
+    return 0;
+}
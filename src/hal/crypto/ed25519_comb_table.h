@@ -0,0 +1,218 @@
+#ifndef ED25519_COMB_TABLE_H
+#define ED25519_COMB_TABLE_H
+
+/**
+ * @file ed25519_comb_table.h
+ * @brief Ed25519 Base Point Comb Table
+ *
+ * Generated by ed25519_comb_gen.c, do not edit.
+ */
+
+#include <stdint.h>
+
+/** @brief Teeth the table was generated for */
+#define ED25519_COMB_TABLE_TEETH    6
+
+/** @brief 2^(teeth * spacing) - 1 mod L, little-endian words */
+static const uint32_t k_ed25519_comb_offset[8] = {
+    0x1F80D8ACU, 0x53799C83U, 0xE5106740U, 0xDD208235U,
+    0xFFFFFFFAU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0x0FFFFFFFU
+};
+
+/** @brief Cached points: Y+X, Y-X, T*2d, -T*2d as fiat limbs */
+static const uint32_t k_ed25519_comb_table[32][4][10] = {
+    {
+        { 0x037D7C8EU, 0x038E6098U, 0x05202E19U, 0x0274836BU, 0x05E0C8F1U, 0x0161AA5EU, 0x03F05E7FU, 0x006ABDC3U, 0x05373D11U, 0x01BF2C00U },
+        { 0x0ADA6F8CU, 0x03FCA668U, 0x0ACA5A99U, 0x030E577FU, 0x0A037057U, 0x041EFE16U, 0x057E7339U, 0x04373F83U, 0x0AAA56DDU, 0x03C3ADF4U },
+        { 0x020B5717U, 0x01134E32U, 0x026DCF1EU, 0x0175BCA4U, 0x00FDEB08U, 0x0045F3CCU, 0x011D5455U, 0x00D00D40U, 0x0303874BU, 0x014821FEU },
+        { 0x01F4A8D6U, 0x00ECB1CDU, 0x019230E1U, 0x008A435BU, 0x030214F7U, 0x01BA0C33U, 0x02E2ABAAU, 0x012FF2BFU, 0x00FC78B4U, 0x00B7DE01U }
+    },
+    {
+        { 0x05345EE1U, 0x02FBC438U, 0x04FA4E73U, 0x01D1F14AU, 0x0345D83EU, 0x01B26B18U, 0x0704A83AU, 0x024AA984U, 0x02F5D112U, 0x02C63343U },
+        { 0x09AE2C31U, 0x03E0E834U, 0x0721F067U, 0x03C38DCCU, 0x063DFA02U, 0x033BEDEAU, 0x0823141EU, 0x03FAE954U, 0x070BB852U, 0x031049CBU },
+        { 0x01DFBFD3U, 0x011838C7U, 0x012820BEU, 0x010AE5B4U, 0x00989292U, 0x01911FFCU, 0x02C7EC0BU, 0x0191A4D3U, 0x01DE3D60U, 0x01DE5A69U },
+        { 0x0220401AU, 0x00E7C738U, 0x02D7DF41U, 0x00F51A4BU, 0x03676D6DU, 0x006EE003U, 0x013813F4U, 0x006E5B2CU, 0x0221C29FU, 0x0021A596U }
+    },
+    {
+        { 0x061C069FU, 0x005E9915U, 0x016F14B7U, 0x017B86C1U, 0x04944CFCU, 0x00F57D8EU, 0x03F8AFA2U, 0x02362FC9U, 0x01C11F29U, 0x0089BF85U },
+        { 0x06FB1397U, 0x044B579FU, 0x0924CD5BU, 0x04214569U, 0x079DF64EU, 0x044832C6U, 0x070B9F4AU, 0x02EC0397U, 0x0906EF31U, 0x03EDF3A5U },
+        { 0x003BCDC7U, 0x01651F15U, 0x0102377AU, 0x004A5978U, 0x034FD622U, 0x01D61046U, 0x00318F0DU, 0x00974364U, 0x010EB965U, 0x01747CF7U },
+        { 0x03C43226U, 0x009AE0EAU, 0x02FDC885U, 0x01B5A687U, 0x00B029DDU, 0x0029EFB9U, 0x03CE70F2U, 0x0168BC9BU, 0x02F1469AU, 0x008B8308U }
+    },
+    {
+        { 0x05B23CA1U, 0x03CC0643U, 0x04E3FE2AU, 0x02437221U, 0x05E73CC3U, 0x021E1361U, 0x0187A72EU, 0x02600ABEU, 0x0266E8BCU, 0x01B259C8U },
+        { 0x06B8CB3BU, 0x03D8FEEBU, 0x05045102U, 0x0252DEDBU, 0x08941781U, 0x055DE5EBU, 0x070A8AB6U, 0x047CAEB4U, 0x090ED5CEU, 0x03D25DA2U },
+        { 0x0076E4F5U, 0x00320E8DU, 0x0256D7B1U, 0x00B9EF58U, 0x01D8A4DCU, 0x00ABED93U, 0x03F8B61BU, 0x01C9C3AAU, 0x0150D93BU, 0x000C2AE2U },
+        { 0x03891AF8U, 0x01CDF172U, 0x01A9284EU, 0x014610A7U, 0x02275B23U, 0x0154126CU, 0x000749E4U, 0x00363C55U, 0x02AF26C4U, 0x01F3D51DU }
+    },
+    {
+        { 0x025F6B37U, 0x03E0710FU, 0x02FDBBEDU, 0x02F51A53U, 0x068ABF71U, 0x03633047U, 0x05D246ADU, 0x0227B545U, 0x06C5B7AEU, 0x02A5A228U },
+        { 0x09234635U, 0x03E11177U, 0x0A584F9DU, 0x046F75A3U, 0x071AB4B3U, 0x042278E1U, 0x067F3581U, 0x02E885CDU, 0x08E37A88U, 0x052310D4U },
+        { 0x019495BAU, 0x00E93144U, 0x0198115DU, 0x0111FB4AU, 0x010ABC3FU, 0x01081A30U, 0x031EC0FCU, 0x00C43199U, 0x02BF36A8U, 0x00CD717EU },
+        { 0x026B6A33U, 0x0116CEBBU, 0x0267EEA2U, 0x00EE04B5U, 0x02F543C0U, 0x00F7E5CFU, 0x00E13F03U, 0x013BCE66U, 0x0140C957U, 0x01328E81U }
+    },
+    {
+        { 0x0449F640U, 0x01AE2C54U, 0x05ABDAD2U, 0x01FF3C46U, 0x044A5334U, 0x0340757EU, 0x026D7D70U, 0x028A8AF9U, 0x0484ED8AU, 0x01268D0DU },
+        { 0x0981B288U, 0x042A90F4U, 0x06246D32U, 0x05AA5978U, 0x05729DDEU, 0x044F7C2AU, 0x09411020U, 0x044A7C11U, 0x07B7242AU, 0x03ABCC8FU },
+        { 0x00BE48A0U, 0x01184A11U, 0x03C62C44U, 0x0150B410U, 0x03C71322U, 0x0151B4FFU, 0x014FFD24U, 0x011B4626U, 0x03A03B64U, 0x00D43FE9U },
+        { 0x0341B74DU, 0x00E7B5EEU, 0x0039D3BBU, 0x00AF4BEFU, 0x0038ECDDU, 0x00AE4B00U, 0x02B002DBU, 0x00E4B9D9U, 0x005FC49BU, 0x012BC016U }
+    },
+    {
+        { 0x01941593U, 0x028B4EE5U, 0x00C61A80U, 0x027A3FFCU, 0x01E81D60U, 0x01B808E5U, 0x02F31C31U, 0x03602D39U, 0x01F0F10FU, 0x027F80DCU },
+        { 0x08FDE05FU, 0x02C0B753U, 0x07B05804U, 0x041307DCU, 0x07BE1CD0U, 0x03B70313U, 0x0801BBD5U, 0x039F1D8FU, 0x08D7E3B1U, 0x034C8ACCU },
+        { 0x029FA6E9U, 0x0044F82AU, 0x01BBE97FU, 0x019B06F6U, 0x03C0DBDCU, 0x01BEFEEEU, 0x0249C38EU, 0x01D9E1E4U, 0x0268148FU, 0x0160618DU },
+        { 0x01605904U, 0x01BB07D5U, 0x02441680U, 0x0064F909U, 0x003F2423U, 0x00410111U, 0x01B63C71U, 0x00261E1BU, 0x0197EB70U, 0x009F9E72U }
+    },
+    {
+        { 0x024F9092U, 0x032B9D0FU, 0x02BB28E3U, 0x023F1FF9U, 0x04F2C8ADU, 0x03142A58U, 0x029A345BU, 0x02711D0CU, 0x04817298U, 0x031CCEBEU },
+        { 0x09151870U, 0x048949F7U, 0x0A651CA1U, 0x057C50A5U, 0x04F7AA35U, 0x03FB6552U, 0x08E05413U, 0x03C84086U, 0x05597216U, 0x03A74080U },
+        { 0x00463202U, 0x013A57FCU, 0x00FD06FCU, 0x0183ED86U, 0x01C69287U, 0x01C38F88U, 0x01E00E52U, 0x01A4DF87U, 0x025CF89FU, 0x019B5291U },
+        { 0x03B9CDEBU, 0x00C5A803U, 0x0302F903U, 0x007C1279U, 0x02396D78U, 0x003C7077U, 0x021FF1ADU, 0x005B2078U, 0x01A30760U, 0x0064AD6EU }
+    },
+    {
+        { 0x062C5195U, 0x018AC6C6U, 0x03C4B0B7U, 0x01829411U, 0x04C4FDD3U, 0x005E5B5AU, 0x012448D4U, 0x0250FB7CU, 0x03C83FD6U, 0x0310C14CU },
+        { 0x06626C7BU, 0x03F79060U, 0x0829940BU, 0x029778E7U, 0x09AFC4EFU, 0x0439E330U, 0x0842F89AU, 0x047FE144U, 0x090A4362U, 0x03D7A812U },
+        { 0x0108FC9DU, 0x00D4F1CAU, 0x01EC617CU, 0x013DB2B7U, 0x0241AB69U, 0x01357AE1U, 0x033AC99CU, 0x01B54A0DU, 0x0393DA93U, 0x00C1C6B0U },
+        { 0x02F70350U, 0x012B0E35U, 0x02139E83U, 0x00C24D48U, 0x01BE5496U, 0x00CA851EU, 0x00C53663U, 0x004AB5F2U, 0x006C256CU, 0x013E394FU }
+    },
+    {
+        { 0x07BA05C8U, 0x01455151U, 0x05110137U, 0x0183D7A9U, 0x03C9C1AFU, 0x03882A9DU, 0x036B24B1U, 0x03A2AC45U, 0x02E43F3BU, 0x0336B1D4U },
+        { 0x081B46F4U, 0x0362A3E3U, 0x05CE6153U, 0x04DB7799U, 0x04A19EAFU, 0x0444BC81U, 0x08380E5BU, 0x03C0E14DU, 0x0925EAA3U, 0x03B92B8EU },
+        { 0x01780714U, 0x01072838U, 0x000962AAU, 0x010FF2C3U, 0x037EDDB4U, 0x00CF2D9DU, 0x02702D58U, 0x01F64B45U, 0x00EBAEF5U, 0x001F13C6U },
+        { 0x0287F8D9U, 0x00F8D7C7U, 0x03F69D55U, 0x00F00D3CU, 0x0081224BU, 0x0130D262U, 0x018FD2A7U, 0x0009B4BAU, 0x0314510AU, 0x01E0EC39U }
+    },
+    {
+        { 0x03EF829EU, 0x03DAF172U, 0x024510BDU, 0x015460C5U, 0x03FB35E3U, 0x01AC1F84U, 0x0557052FU, 0x016104A0U, 0x0300CEC5U, 0x0117CAEAU },
+        { 0x0492BD8AU, 0x03E72B16U, 0x08EF550BU, 0x03052F19U, 0x09E3D955U, 0x055173BEU, 0x081F8685U, 0x04EE8EBAU, 0x07DF5E21U, 0x04E22BA8U },
+        { 0x02F0B510U, 0x0054FBBDU, 0x00611CB8U, 0x01F74322U, 0x007E4331U, 0x0086F122U, 0x0207E5DDU, 0x01292BCCU, 0x03312A7BU, 0x0164A37BU },
+        { 0x010F4ADDU, 0x01AB0442U, 0x039EE347U, 0x0008BCDDU, 0x0381BCCEU, 0x01790EDDU, 0x01F81A22U, 0x00D6D433U, 0x00CED584U, 0x009B5C84U }
+    },
+    {
+        { 0x065437EAU, 0x01854D16U, 0x0281FABAU, 0x01E0A315U, 0x039B835DU, 0x0080285FU, 0x033D0740U, 0x00D99AD9U, 0x066F9214U, 0x03373835U },
+        { 0x0957211CU, 0x056384A8U, 0x09288338U, 0x03254567U, 0x084D1319U, 0x04351523U, 0x06379B40U, 0x037579A1U, 0x0847971CU, 0x03E11293U },
+        { 0x038BEDECU, 0x01A62C56U, 0x01EDE388U, 0x0056B129U, 0x01FF1035U, 0x00710E29U, 0x00511410U, 0x01976EE4U, 0x03CF8E3CU, 0x013124F8U },
+        { 0x00741201U, 0x0059D3A9U, 0x02121C77U, 0x01A94ED6U, 0x0200EFCAU, 0x018EF1D6U, 0x03AEEBEFU, 0x0068911BU, 0x003071C3U, 0x00CEDB07U }
+    },
+    {
+        { 0x0421EA3DU, 0x01750166U, 0x05A3C6A5U, 0x01C25463U, 0x03C74837U, 0x02C16160U, 0x03EC8C32U, 0x018475FAU, 0x0223FFC7U, 0x00F293E5U },
+        { 0x07004159U, 0x02A072DCU, 0x0A1F47E1U, 0x0561EE3DU, 0x0AB30C27U, 0x0339955AU, 0x05EC5ACCU, 0x04468770U, 0x060E1BDBU, 0x03CCFD25U },
+        { 0x00EAFF45U, 0x00FCFA13U, 0x03E321C4U, 0x01C251A3U, 0x0343AAE7U, 0x001AA8E7U, 0x030C4193U, 0x013E694BU, 0x02DDBB8CU, 0x01B1AFF8U },
+        { 0x031500A8U, 0x010305ECU, 0x001CDE3BU, 0x003DAE5CU, 0x00BC5518U, 0x01E55718U, 0x00F3BE6CU, 0x00C196B4U, 0x01224473U, 0x004E5007U }
+    },
+    {
+        { 0x04AC1105U, 0x02831A91U, 0x0606AEC2U, 0x02F56EBDU, 0x0338F260U, 0x020D9B2DU, 0x03C8E91EU, 0x030DCE4DU, 0x0777403EU, 0x02A37E95U },
+        { 0x09295697U, 0x02E52F25U, 0x07D36986U, 0x04F21B97U, 0x09FA1A06U, 0x025EC8BFU, 0x09BE03D6U, 0x03F42793U, 0x07992724U, 0x03C0A0C7U },
+        { 0x007A8972U, 0x00BF017CU, 0x019A28CCU, 0x00CE93D2U, 0x00888AE0U, 0x0197AAF5U, 0x0392521BU, 0x017E0936U, 0x01F3551CU, 0x002F2DA1U },
+        { 0x0385767BU, 0x0140FE83U, 0x0265D733U, 0x01316C2DU, 0x0377751FU, 0x0068550AU, 0x006DADE4U, 0x0081F6C9U, 0x020CAAE3U, 0x01D0D25EU }
+    },
+    {
+        { 0x045D9EF1U, 0x02D390CDU, 0x03CF6B65U, 0x00B385DAU, 0x00C0E06BU, 0x0262F989U, 0x0167752EU, 0x00F2E8AAU, 0x0372E373U, 0x03464EFCU },
+        { 0x0A5EDAB5U, 0x03B277FBU, 0x08D640CFU, 0x0494B750U, 0x07AFD87BU, 0x02700C7DU, 0x0954E91CU, 0x03DC893CU, 0x05B0412DU, 0x03B4AB8EU },
+        { 0x016C4404U, 0x0145A1B1U, 0x0386586BU, 0x0058EDC0U, 0x03AF1FF0U, 0x000C574DU, 0x01FBEA79U, 0x01ED051FU, 0x01B86421U, 0x01BFA2D6U },
+        { 0x0293BBE9U, 0x00BA5E4EU, 0x0079A794U, 0x01A7123FU, 0x0050E00FU, 0x01F3A8B2U, 0x02041586U, 0x0012FAE0U, 0x02479BDEU, 0x00405D29U }
+    },
+    {
+        { 0x05527BEDU, 0x01281B8BU, 0x0302B888U, 0x03142950U, 0x02AF7CCBU, 0x020E3D09U, 0x03E4D370U, 0x00396E3DU, 0x01F01735U, 0x0268866EU },
+        { 0x0A0E9565U, 0x050F47BFU, 0x07C31386U, 0x03AFD1A6U, 0x059EEC31U, 0x02D60F83U, 0x068F2D88U, 0x041E098DU, 0x0678C46BU, 0x049008F8U },
+        { 0x03565D71U, 0x007475B9U, 0x03384E01U, 0x00541020U, 0x01BF06DDU, 0x012DD7AAU, 0x03F5746EU, 0x004153E4U, 0x00041CEAU, 0x01ABA4F0U },
+        { 0x00A9A27CU, 0x018B8A46U, 0x00C7B1FEU, 0x01ABEFDFU, 0x0240F922U, 0x00D22855U, 0x000A8B91U, 0x01BEAC1BU, 0x03FBE315U, 0x00545B0FU }
+    },
+    {
+        { 0x0330D0FBU, 0x0358FFD1U, 0x05057CF3U, 0x007004A1U, 0x03EAFAD0U, 0x015EE0DFU, 0x03761674U, 0x031F5AECU, 0x034432B1U, 0x01FC1A37U },
+        { 0x05415FBFU, 0x0417E013U, 0x08179C69U, 0x03FE0C09U, 0x0650ADCEU, 0x054005D3U, 0x04B1657CU, 0x04918E0AU, 0x068917DDU, 0x05986B9DU },
+        { 0x0187F748U, 0x01068148U, 0x026D92D1U, 0x001B59B6U, 0x0221EF9AU, 0x00BEB218U, 0x01EE3419U, 0x0021A6B0U, 0x01350A25U, 0x010A28E0U },
+        { 0x027808A5U, 0x00F97EB7U, 0x01926D2EU, 0x01E4A649U, 0x01DE1065U, 0x01414DE7U, 0x0211CBE6U, 0x01DE594FU, 0x02CAF5DAU, 0x00F5D71FU }
+    },
+    {
+        { 0x0164A60DU, 0x004BF1E4U, 0x056CADE2U, 0x011F76F9U, 0x0269CEA9U, 0x01928603U, 0x04731FCDU, 0x01EA0B96U, 0x03D5450EU, 0x033B926EU },
+        { 0x08DEC827U, 0x043379A2U, 0x08458E80U, 0x0379D5CBU, 0x07E61D99U, 0x038B7F23U, 0x0A1723A9U, 0x05431D4EU, 0x0B9DF172U, 0x046FE142U },
+        { 0x038605E6U, 0x01CBA8DCU, 0x0044D412U, 0x01F6A100U, 0x02380DB2U, 0x0040768AU, 0x032BD68AU, 0x000385A4U, 0x0299445CU, 0x0052942CU },
+        { 0x0079FA07U, 0x00345723U, 0x03BB2BEDU, 0x00095EFFU, 0x01C7F24DU, 0x01BF8975U, 0x00D42975U, 0x01FC7A5BU, 0x0166BBA3U, 0x01AD6BD3U }
+    },
+    {
+        { 0x041CE962U, 0x0224DABAU, 0x03579671U, 0x02C067A2U, 0x0425F27CU, 0x0364C995U, 0x0518C149U, 0x01E03425U, 0x045C4E91U, 0x01AF4B2FU },
+        { 0x06B45AF8U, 0x0349DA5AU, 0x054B4A15U, 0x035131FAU, 0x06BAA6ECU, 0x0477721DU, 0x055A99CDU, 0x0592B911U, 0x08499765U, 0x035A20BDU },
+        { 0x023B515DU, 0x00BA0069U, 0x01E7C3DDU, 0x00544265U, 0x017B46B0U, 0x01D58D0FU, 0x03070C04U, 0x006ED5D9U, 0x032BB99BU, 0x005E8A49U },
+        { 0x01C4AE90U, 0x0145FF96U, 0x02183C22U, 0x01ABBD9AU, 0x0284B94FU, 0x002A72F0U, 0x00F8F3FBU, 0x01912A26U, 0x00D44664U, 0x01A175B6U }
+    },
+    {
+        { 0x0225218EU, 0x033D62F7U, 0x0436479EU, 0x01018526U, 0x05C0AB40U, 0x02835C52U, 0x04E495A3U, 0x0234A30DU, 0x016E785CU, 0x01BEF6D3U },
+        { 0x09C4E270U, 0x0484EB63U, 0x07DAA6C8U, 0x048BCDFEU, 0x084A004AU, 0x043D6144U, 0x07042CA7U, 0x05B7B6C3U, 0x06C91E46U, 0x0342D28DU },
+        { 0x033BDEDFU, 0x01D2E50BU, 0x01B87B51U, 0x01148599U, 0x030BB896U, 0x01288D8CU, 0x0374AD0BU, 0x0098A8CDU, 0x036E12A4U, 0x00D8368BU },
+        { 0x00C4210EU, 0x002D1AF4U, 0x024784AEU, 0x00EB7A66U, 0x00F44769U, 0x00D77273U, 0x008B52F4U, 0x01675732U, 0x0091ED5BU, 0x0127C974U }
+    },
+    {
+        { 0x03EAFD2DU, 0x027CC41DU, 0x050AD3A8U, 0x00CD1393U, 0x04FC9506U, 0x02681C82U, 0x0204EA5FU, 0x0164AFBCU, 0x0592A7D8U, 0x022E323AU },
+        { 0x0BC67F65U, 0x04B3B777U, 0x07422292U, 0x0473C45BU, 0x0A8FE020U, 0x0530CCA4U, 0x06A85EDDU, 0x04D555F0U, 0x07290B02U, 0x02AD4BC0U },
+        { 0x03C49723U, 0x00C615C6U, 0x02497B73U, 0x006C3B9FU, 0x02C442FEU, 0x0181EA06U, 0x00C17D02U, 0x00F7C298U, 0x032FF6B6U, 0x0150A4AAU },
+        { 0x003B68CAU, 0x0139EA39U, 0x01B6848CU, 0x0193C460U, 0x013BBD01U, 0x007E15F9U, 0x033E82FDU, 0x01083D67U, 0x00D00949U, 0x00AF5B55U }
+    },
+    {
+        { 0x05D79A04U, 0x02FE14C6U, 0x0520870AU, 0x01354AF3U, 0x0488BD4CU, 0x02B9954FU, 0x03CD8A28U, 0x0203EC82U, 0x02F40AA6U, 0x01EDF832U },
+        { 0x094804C4U, 0x0391E510U, 0x0A62FEA4U, 0x042B3779U, 0x09E3FB1AU, 0x0368E16DU, 0x058ED562U, 0x02FC6232U, 0x05881E36U, 0x0436F852U },
+        { 0x03562245U, 0x006ED27AU, 0x00F8E2AAU, 0x01A9A20AU, 0x02DA5A8DU, 0x003BAA3BU, 0x0009670DU, 0x0036EE6AU, 0x025ECC2CU, 0x0045536BU },
+        { 0x00A9DDA8U, 0x01912D85U, 0x03071D55U, 0x00565DF5U, 0x0125A572U, 0x01C455C4U, 0x03F698F2U, 0x01C91195U, 0x01A133D3U, 0x01BAAC94U }
+    },
+    {
+        { 0x05D2F187U, 0x01D74E10U, 0x00EC7A34U, 0x017ABD54U, 0x03261070U, 0x01F39C47U, 0x059DBEF9U, 0x02C5A1F0U, 0x05453542U, 0x01936B57U },
+        { 0x0624D8E3U, 0x054851AAU, 0x089FE2AAU, 0x02D9ACE6U, 0x0A3BF2E2U, 0x053ED7D3U, 0x08EFA02BU, 0x03A9BF08U, 0x0A7CBB14U, 0x057599BBU },
+        { 0x01E24CEBU, 0x0116DE9FU, 0x02ECDA6AU, 0x0157BEF8U, 0x01C3C415U, 0x00D94E4DU, 0x02F24656U, 0x01B0D249U, 0x03673ACEU, 0x0000C9A9U },
+        { 0x021DB302U, 0x00E92160U, 0x01132595U, 0x00A84107U, 0x023C3BEAU, 0x0126B1B2U, 0x010DB9A9U, 0x004F2DB6U, 0x0098C531U, 0x01FF3656U }
+    },
+    {
+        { 0x0665FFA7U, 0x00E9F775U, 0x02B3319DU, 0x00F96E07U, 0x02913746U, 0x0250378EU, 0x038CBFD6U, 0x019E57F0U, 0x027CD7CAU, 0x02387118U },
+        { 0x09470DB1U, 0x03A78B69U, 0x05B33D29U, 0x047570B7U, 0x06A2C3EAU, 0x029DBC0CU, 0x0A6F9562U, 0x04A69F1AU, 0x06653148U, 0x0357C1DAU },
+        { 0x0343ADE0U, 0x01B848FFU, 0x025113E0U, 0x013A476BU, 0x01197A47U, 0x014CF69DU, 0x008CF9AEU, 0x00E17A03U, 0x00A9CFCCU, 0x0047F09AU },
+        { 0x00BC520DU, 0x0047B700U, 0x01AEEC1FU, 0x00C5B894U, 0x02E685B8U, 0x00B30962U, 0x03730651U, 0x011E85FCU, 0x03563033U, 0x01B80F65U }
+    },
+    {
+        { 0x0223FDF3U, 0x02D41A62U, 0x04D4047EU, 0x00F740E9U, 0x00A05CBCU, 0x01D6C7CBU, 0x02A082E1U, 0x01C26A3DU, 0x04CEC3FBU, 0x02757769U },
+        { 0x07607363U, 0x03649610U, 0x06F2BC98U, 0x045BD30DU, 0x07ECE264U, 0x039B7CE9U, 0x07092215U, 0x02CC8CAFU, 0x0860D1CDU, 0x03869705U },
+        { 0x03827371U, 0x0113BDD4U, 0x025445CFU, 0x011C7D3BU, 0x00BE446AU, 0x004B7A17U, 0x0386387BU, 0x002A05F3U, 0x01AAB7A5U, 0x00DAE03DU },
+        { 0x007D8C7CU, 0x00EC422BU, 0x01ABBA30U, 0x00E382C4U, 0x0341BB95U, 0x01B485E8U, 0x0079C784U, 0x01D5FA0CU, 0x0255485AU, 0x01251FC2U }
+    },
+    {
+        { 0x01087809U, 0x00F15E13U, 0x047C16FBU, 0x02407B51U, 0x045F5D1EU, 0x018EC730U, 0x03500FA2U, 0x00F34D68U, 0x056077C4U, 0x01F72AF1U },
+        { 0x077C9B5DU, 0x0492546DU, 0x09E379BFU, 0x03CAFFE5U, 0x05D2782EU, 0x03C069F6U, 0x097676D4U, 0x0370139EU, 0x09A1E142U, 0x04945105U },
+        { 0x008D95BBU, 0x01E78857U, 0x026BEED4U, 0x00908871U, 0x0199B0F2U, 0x00E37569U, 0x03E8161CU, 0x00C9A366U, 0x013ADE87U, 0x00B88DBEU },
+        { 0x03726A32U, 0x001877A8U, 0x0194112BU, 0x016F778EU, 0x02664F0DU, 0x011C8A96U, 0x0017E9E3U, 0x01365C99U, 0x02C52178U, 0x01477241U }
+    },
+    {
+        { 0x0035C45EU, 0x01AA030CU, 0x048A2D49U, 0x020747ECU, 0x0343B4EFU, 0x029A707EU, 0x04EDC363U, 0x02382390U, 0x03B87F42U, 0x020AD52BU },
+        { 0x0827100EU, 0x038D1BE6U, 0x09BACA23U, 0x0273AE24U, 0x0AC28587U, 0x0560A560U, 0x0825165DU, 0x05321074U, 0x07DF2952U, 0x05C06DEBU },
+        { 0x02F22535U, 0x00E778E2U, 0x02D66A58U, 0x017F5DE0U, 0x031B22D3U, 0x003158F2U, 0x021D35DDU, 0x01580751U, 0x02115129U, 0x00F5E4EDU },
+        { 0x010DDAB8U, 0x0118871DU, 0x012995A7U, 0x0080A21FU, 0x00E4DD2CU, 0x01CEA70DU, 0x01E2CA22U, 0x00A7F8AEU, 0x01EEAED6U, 0x010A1B12U }
+    },
+    {
+        { 0x0370F5B7U, 0x01C40453U, 0x04A94FEFU, 0x01BDAAB5U, 0x055A24BDU, 0x0140E0BAU, 0x051B0928U, 0x01AD177BU, 0x020F4347U, 0x00B23626U },
+        { 0x0B569E11U, 0x03B3E925U, 0x06CE1FCDU, 0x03BFB3BDU, 0x09250AD5U, 0x04EAA78AU, 0x0541B1B0U, 0x0572A44FU, 0x06D605D3U, 0x04963430U },
+        { 0x02D5E7C3U, 0x019DA793U, 0x00338C74U, 0x00F70FBFU, 0x01CC3942U, 0x016C7016U, 0x00E20AA5U, 0x00557B57U, 0x03398EF7U, 0x01BB75FEU },
+        { 0x012A182AU, 0x0062586CU, 0x03CC738BU, 0x0108F040U, 0x0233C6BDU, 0x00938FE9U, 0x031DF55AU, 0x01AA84A8U, 0x00C67108U, 0x00448A01U }
+    },
+    {
+        { 0x02B82A10U, 0x0102895CU, 0x02080E4EU, 0x0181ECE5U, 0x041CA69FU, 0x009D6556U, 0x05BD1829U, 0x01CA4796U, 0x02ACCE16U, 0x02E10C71U },
+        { 0x05B9E7AAU, 0x04A3C8D8U, 0x06A3C552U, 0x030C786DU, 0x0883B5B9U, 0x040D5C40U, 0x09C25DFFU, 0x02450E02U, 0x093CCAF0U, 0x033EEEB3U },
+        { 0x0345B8DFU, 0x0034FC49U, 0x010D0EE4U, 0x00A3055CU, 0x001F2115U, 0x0175DC91U, 0x02A11778U, 0x01767F67U, 0x0033C150U, 0x011FD740U },
+        { 0x00BA470EU, 0x01CB03B6U, 0x02F2F11BU, 0x015CFAA3U, 0x03E0DEEAU, 0x008A236EU, 0x015EE887U, 0x00898098U, 0x03CC3EAFU, 0x00E028BFU }
+    },
+    {
+        { 0x0485DE6EU, 0x01ED656BU, 0x02BBA55CU, 0x0338F448U, 0x04CA7E71U, 0x0277EDE1U, 0x02F466B5U, 0x02F805C7U, 0x04EEB472U, 0x018CCBEAU },
+        { 0x08B2FC78U, 0x038B2665U, 0x081A0BE0U, 0x03F9D708U, 0x08DA0351U, 0x041A8DFFU, 0x0747A197U, 0x04B8B1F7U, 0x06938AA2U, 0x03560262U },
+        { 0x01FD8A12U, 0x017F75EDU, 0x022A67B2U, 0x00400AC2U, 0x0114A7E4U, 0x011BE119U, 0x03F8CC49U, 0x007C0737U, 0x0150A0EDU, 0x0182C80BU },
+        { 0x020275DBU, 0x00808A12U, 0x01D5984DU, 0x01BFF53DU, 0x02EB581BU, 0x00E41EE6U, 0x000733B6U, 0x0183F8C8U, 0x02AF5F12U, 0x007D37F4U }
+    },
+    {
+        { 0x0228E783U, 0x035CC596U, 0x053690F5U, 0x0205F7E1U, 0x03FFCF44U, 0x039023A1U, 0x05D264F5U, 0x013183E9U, 0x04F5B571U, 0x035F3FF8U },
+        { 0x0625D471U, 0x03CEC4DCU, 0x095A029BU, 0x03AEC073U, 0x09E994ACU, 0x03A18DF5U, 0x0843DE1FU, 0x033782C1U, 0x0A928F07U, 0x03A91F50U },
+        { 0x007BEA9EU, 0x013FBA2CU, 0x00FF5CF4U, 0x01C801B0U, 0x00F6C021U, 0x000F7AA3U, 0x005B3E18U, 0x00A3C371U, 0x0378C1D6U, 0x007A4E6CU },
+        { 0x0384154FU, 0x00C045D3U, 0x0300A30BU, 0x0037FE4FU, 0x03093FDEU, 0x01F0855CU, 0x03A4C1E7U, 0x015C3C8EU, 0x00873E29U, 0x0185B193U }
+    },
+    {
+        { 0x040BC5BDU, 0x01F55901U, 0x07342AD0U, 0x013EDB3EU, 0x0569F477U, 0x021326B7U, 0x03628A0FU, 0x00F7C2F2U, 0x060E6CE2U, 0x01F5B855U },
+        { 0x087EE855U, 0x0320A38BU, 0x0881FA9AU, 0x0312FABEU, 0x088231BDU, 0x032783F7U, 0x05EBACB1U, 0x03D212C6U, 0x083B3AC4U, 0x0536E209U },
+        { 0x0057ACFEU, 0x01BD2BE7U, 0x029F457BU, 0x00939BBBU, 0x024976EEU, 0x0053183FU, 0x01B9D54EU, 0x0009EF25U, 0x00D8CBD5U, 0x014ED844U },
+        { 0x03A852EFU, 0x0042D418U, 0x0160BA84U, 0x016C6444U, 0x01B68911U, 0x01ACE7C0U, 0x02462AB1U, 0x01F610DAU, 0x0327342AU, 0x00B127BBU }
+    },
+};
+
+#endif // ED25519_COMB_TABLE_H
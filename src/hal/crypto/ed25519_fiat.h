@@ -0,0 +1,44 @@
+#ifndef ED25519_FIAT_H
+#define ED25519_FIAT_H
+
+/**
+ * @file ed25519_fiat.h
+ * @brief Declarations of the Vendored fiat Curve25519 Group Operations
+ * @author USB Key Authentication Team
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ * The vendored curve25519.c exports its group operations without a header
+ * (mcuboot declares ED25519_verify() where it calls it). This header pulls
+ * in the point types from curve25519.h and declares the functions
+ * ed25519.c and ed25519_comb_gen.c use.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+// curve25519.h defines the fiat field functions static; only its types are used here
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "curve25519.h"
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+/** @brief Limbs of a fiat field element */
+#define ED25519_FE_LIMBS    10
+
+void x25519_ge_tobytes(uint8_t s[32], const ge_p2* h);
+int x25519_ge_frombytes_vartime(ge_p3* h, const uint8_t s[32]);
+void x25519_ge_p3_to_cached(ge_cached* r, const ge_p3* p);
+void x25519_ge_p1p1_to_p2(ge_p2* r, const ge_p1p1* p);
+void x25519_ge_p1p1_to_p3(ge_p3* r, const ge_p1p1* p);
+void x25519_ge_add(ge_p1p1* r, const ge_p3* p, const ge_cached* q);
+void x25519_ge_sub(ge_p1p1* r, const ge_p3* p, const ge_cached* q);
+void x25519_sc_reduce(uint8_t s[64]);
+int ED25519_verify(const uint8_t* message, size_t message_len,
+                   const uint8_t signature[64], const uint8_t public_key[32]);
+
+#endif // ED25519_FIAT_H
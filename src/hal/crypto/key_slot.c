@@ -0,0 +1,121 @@
+/**
+ * @file key_slot.c
+ * @brief Static Key-Slot Table Behind crypto_key_t Handles
+ * @author USB Key Authentication Team
+ * @date 2025-09-14
+ * @version 1.0
+ *
+ * A handle is (generation << 8) | (index + 1): never 0, so
+ * CRYPTO_KEY_HANDLE_INVALID and a zeroed crypto_key_t never resolve, and
+ * the generation changes every time the slot is freed.
+ */
+
+#include "key_slot.h"
+#include "crypto_util.h"
+#include <string.h>
+
+/** @brief Handle bits holding index + 1 */
+#define HANDLE_INDEX_BITS   8U
+
+/** @brief Mask of the index bits */
+#define HANDLE_INDEX_MASK   ((1U << HANDLE_INDEX_BITS) - 1U)
+
+/**
+ * @brief One key slot
+ */
+typedef struct {
+    uint8_t data[KEY_SLOT_DATA_SIZE];   /**< Key material */
+    uint16_t generation;                /**< Bumped on every free */
+    uint8_t size;                       /**< Bytes of data in use */
+    uint8_t used;                       /**< Slot allocated */
+} key_slot_t;
+
+_Static_assert(KEY_SLOT_COUNT > 0U && KEY_SLOT_COUNT < HANDLE_INDEX_MASK,
+               "KEY_SLOT_COUNT must fit the handle index bits");
+_Static_assert(KEY_SLOT_DATA_SIZE <= 255U, "slot size is kept in a byte");
+_Static_assert(sizeof(key_slot_t) * KEY_SLOT_COUNT <= KEY_SLOT_MEMORY_LIMIT,
+               "key-slot table exceeds KEY_SLOT_MEMORY_LIMIT");
+
+/** @brief Global slot table */
+static key_slot_t g_key_slots[KEY_SLOT_COUNT] = {0};
+
+/**
+ * @brief Slot named by a handle, NULL if it is stale or invalid
+ */
+static key_slot_t* slot_from_handle(crypto_key_handle_t handle) {
+    uint32_t index = (handle & HANDLE_INDEX_MASK);
+
+    if (index == 0 || index > KEY_SLOT_COUNT) {
+        return NULL;
+    }
+
+    key_slot_t* slot = &g_key_slots[index - 1U];
+    if (!slot->used || slot->generation != (uint16_t)(handle >> HANDLE_INDEX_BITS)) {
+        return NULL;
+    }
+    return slot;
+}
+
+/**
+ * @brief Wipe a slot and retire its handle
+ */
+static void slot_release(key_slot_t* slot) {
+    uint16_t generation = slot->generation;
+
+    crypto_secure_zero(slot, sizeof(*slot));
+    slot->generation = (uint16_t)(generation + 1U);
+}
+
+hal_result_t key_slot_alloc(size_t size, crypto_key_handle_t* handle, uint8_t** data) {
+    if (size == 0 || size > KEY_SLOT_DATA_SIZE || !handle || !data) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0; i < KEY_SLOT_COUNT; i++) {
+        key_slot_t* slot = &g_key_slots[i];
+
+        if (!slot->used) {
+            slot->used = 1;
+            slot->size = (uint8_t)size;
+            *handle = ((crypto_key_handle_t)slot->generation << HANDLE_INDEX_BITS) | (i + 1U);
+            *data = slot->data;
+            return HAL_SUCCESS;
+        }
+    }
+
+    return HAL_ERROR_INSUFFICIENT_MEMORY;
+}
+
+uint8_t* key_slot_data(crypto_key_handle_t handle, size_t size) {
+    key_slot_t* slot = slot_from_handle(handle);
+
+    if (!slot || slot->size != size) {
+        return NULL;
+    }
+    return slot->data;
+}
+
+void key_slot_free(crypto_key_handle_t handle) {
+    key_slot_t* slot = slot_from_handle(handle);
+
+    if (slot) {
+        slot_release(slot);
+    }
+}
+
+void key_slot_free_all(void) {
+    for (uint32_t i = 0; i < KEY_SLOT_COUNT; i++) {
+        if (g_key_slots[i].used) {
+            slot_release(&g_key_slots[i]);
+        }
+    }
+}
+
+uint32_t key_slot_used(void) {
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < KEY_SLOT_COUNT; i++) {
+        count += g_key_slots[i].used;
+    }
+    return count;
+}
@@ -0,0 +1,88 @@
+#ifndef KEY_SLOT_H
+#define KEY_SLOT_H
+
+/**
+ * @file key_slot.h
+ * @brief Static Key-Slot Table Behind crypto_key_t Handles
+ * @author USB Key Authentication Team
+ * @date 2025-09-14
+ * @version 1.0
+ *
+ * Key material of software crypto backends lives in a fixed table of
+ * slots with inline storage instead of on the heap. A crypto_key_t carries
+ * an opaque handle that names a slot and the slot's generation, so a
+ * handle kept after delete_key() (or copied before it) no longer resolves
+ * once the slot is freed or reused.
+ *
+ * The table is KEY_SLOT_COUNT * sizeof(slot) bytes of .bss, checked
+ * against KEY_SLOT_MEMORY_LIMIT at compile time. Freeing a slot zeroes it.
+ *
+ * @warning Not thread-safe, like the backends using it.
+ */
+
+#include "hal/interface/crypto_hal.h"
+
+/** @brief Keys that can exist at once */
+#ifndef KEY_SLOT_COUNT
+#define KEY_SLOT_COUNT          8U
+#endif
+
+/**
+ * @brief Inline storage per slot
+ *
+ * The largest key of the enabled algorithms: a P-256 public key (X||Y) or
+ * an Ed25519 private key (seed || public key). Backends assert their key
+ * sizes against it.
+ */
+#ifndef KEY_SLOT_DATA_SIZE
+#define KEY_SLOT_DATA_SIZE      64U
+#endif
+
+/** @brief Upper bound on the RAM the table may take, in bytes */
+#ifndef KEY_SLOT_MEMORY_LIMIT
+#define KEY_SLOT_MEMORY_LIMIT   1024U
+#endif
+
+/**
+ * @brief Claim a free slot
+ *
+ * @param size Key size in bytes, at most KEY_SLOT_DATA_SIZE
+ * @param handle Output handle for crypto_key_t
+ * @param data Output key storage (size bytes, zeroed)
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM size is 0 or too large, NULL output
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Every slot is in use
+ */
+hal_result_t key_slot_alloc(size_t size, crypto_key_handle_t* handle, uint8_t** data);
+
+/**
+ * @brief Resolve a handle to its key material
+ *
+ * @param handle Handle from key_slot_alloc()
+ * @param size Size recorded in the key descriptor, must match the slot
+ * @return Key storage, NULL for a stale, forged or mismatched handle
+ */
+uint8_t* key_slot_data(crypto_key_handle_t handle, size_t size);
+
+/**
+ * @brief Zero and release a slot
+ *
+ * Stale and invalid handles are ignored.
+ *
+ * @param handle Handle from key_slot_alloc()
+ */
+void key_slot_free(crypto_key_handle_t handle);
+
+/**
+ * @brief Zero and release every slot, invalidating all handles
+ */
+void key_slot_free_all(void);
+
+/**
+ * @brief Number of slots in use
+ *
+ * @return Allocated slots, for leak checks
+ */
+uint32_t key_slot_used(void);
+
+#endif // KEY_SLOT_H
@@ -0,0 +1,147 @@
+/**
+ * @file lpadc_entropy.c
+ * @brief LPADC Noise Entropy Source
+ * @author USB Key Authentication Team
+ * @date 2025-09-16
+ * @version 1.0
+ */
+
+#include "lpadc_entropy.h"
+#include "crypto_util.h"
+
+#if defined(MCXA156_SERIES)
+#include <stdbool.h>
+#include "sha2.h"
+#include "fsl_lpadc.h"
+#include "fsl_clock.h"
+#include "fsl_reset.h"
+
+/** @brief Command slot used for the noise conversion */
+#define ENTROPY_COMMAND_ID      1U
+
+/** @brief Software trigger used for the noise conversion */
+#define ENTROPY_TRIGGER_ID      0U
+
+/** @brief Polls of the result FIFO before a conversion counts as lost */
+#define ENTROPY_TIMEOUT_POLLS   10000U
+
+/** @brief ADC configured */
+static bool g_lpadc_entropy_initialized = false;
+
+hal_result_t lpadc_entropy_init(void) {
+    if (g_lpadc_entropy_initialized) {
+        return HAL_SUCCESS;
+    }
+
+    lpadc_config_t config;
+    lpadc_conv_command_config_t command;
+    lpadc_conv_trigger_config_t trigger;
+
+    RESET_ReleasePeripheralReset(kADC0_RST_SHIFT_RSTn);
+    CLOCK_SetClockDiv(kCLOCK_DivADC0, 1U);
+    CLOCK_AttachClk(kFRO12M_to_ADC0);
+
+    // No calibration and no averaging: the noise is what we are after
+    LPADC_GetDefaultConfig(&config);
+    config.enableAnalogPreliminary = true;
+    LPADC_Init(ADC0, &config);
+
+    LPADC_GetDefaultConvCommandConfig(&command);
+    command.channelNumber = LPADC_ENTROPY_CHANNEL;
+    command.conversionResolutionMode = kLPADC_ConversionResolutionHigh;
+    LPADC_SetConvCommandConfig(ADC0, ENTROPY_COMMAND_ID, &command);
+
+    LPADC_GetDefaultConvTriggerConfig(&trigger);
+    trigger.targetCommandId = ENTROPY_COMMAND_ID;
+    trigger.enableHardwareTrigger = false;
+    LPADC_SetConvTriggerConfig(ADC0, ENTROPY_TRIGGER_ID, &trigger);
+
+    g_lpadc_entropy_initialized = true;
+    return HAL_SUCCESS;
+}
+
+void lpadc_entropy_deinit(void) {
+    if (g_lpadc_entropy_initialized) {
+        LPADC_Deinit(ADC0);
+        g_lpadc_entropy_initialized = false;
+    }
+}
+
+/**
+ * @brief Run one conversion and wait for its result
+ */
+static bool sample(uint16_t* value) {
+    lpadc_conv_result_t result;
+
+    LPADC_DoSoftwareTrigger(ADC0, 1UL << ENTROPY_TRIGGER_ID);
+    for (uint32_t polls = 0; !LPADC_GetConvResult(ADC0, &result); polls++) {
+        if (polls >= ENTROPY_TIMEOUT_POLLS) {
+            return false;
+        }
+    }
+
+    *value = result.convValue;
+    return true;
+}
+
+hal_result_t lpadc_entropy_read(uint8_t* seed, uint32_t* entropy_bits) {
+    if (!seed || !entropy_bits) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!g_lpadc_entropy_initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    sha256_context_t sha;
+    uint16_t value = 0;
+    uint16_t previous = 0;
+    uint32_t run = 0;
+    hal_result_t result = HAL_SUCCESS;
+
+    sha256_init(&sha);
+    for (uint32_t i = 0; i < LPADC_ENTROPY_SAMPLES; i++) {
+        if (!sample(&value)) {
+            result = HAL_ERROR_TIMEOUT;
+            goto cleanup_and_exit;
+        }
+
+        // SP 800-90B 4.4.1: a stuck input repeats the same conversion
+        run = (i > 0 && value == previous) ? run + 1U : 1U;
+        if (run >= LPADC_ENTROPY_REPETITION_CUTOFF) {
+            result = HAL_ERROR_HARDWARE_FAILURE;
+            goto cleanup_and_exit;
+        }
+        previous = value;
+
+        sha256_update(&sha, (const uint8_t*)&value, sizeof(value));
+    }
+    sha256_final(&sha, seed);
+
+    *entropy_bits = LPADC_ENTROPY_SAMPLES / LPADC_ENTROPY_SAMPLES_PER_BIT;
+    if (*entropy_bits > LPADC_ENTROPY_SEED_SIZE * 8U) {
+        *entropy_bits = LPADC_ENTROPY_SEED_SIZE * 8U;
+    }
+
+cleanup_and_exit:
+    crypto_secure_zero(&sha, sizeof(sha));
+    crypto_secure_zero(&value, sizeof(value));
+    crypto_secure_zero(&previous, sizeof(previous));
+    return result;
+}
+
+#else
+
+hal_result_t lpadc_entropy_init(void) {
+    return HAL_ERROR_NOT_SUPPORTED;
+}
+
+void lpadc_entropy_deinit(void) {
+}
+
+hal_result_t lpadc_entropy_read(uint8_t* seed, uint32_t* entropy_bits) {
+    (void)seed;
+    (void)entropy_bits;
+    return HAL_ERROR_NOT_SUPPORTED;
+}
+
+#endif
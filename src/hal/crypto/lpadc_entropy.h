@@ -0,0 +1,84 @@
+#ifndef LPADC_ENTROPY_H
+#define LPADC_ENTROPY_H
+
+/**
+ * @file lpadc_entropy.h
+ * @brief LPADC Noise Entropy Source
+ * @author USB Key Authentication Team
+ * @date 2025-09-16
+ * @version 1.0
+ *
+ * MCXA156 has no TRNG. The low bits of fast, unaveraged LPADC conversions
+ * of the internal temperature sensor carry thermal and quantization noise;
+ * this module samples it, runs the SP 800-90B repetition count test on the
+ * raw samples and condenses them with SHA-256 into a seed for the DRBG.
+ *
+ * The credit is deliberately low, 1 bit per LPADC_ENTROPY_SAMPLES_PER_BIT
+ * samples. Characterize the board before raising it.
+ *
+ * On the host every call returns HAL_ERROR_NOT_SUPPORTED.
+ */
+
+#include "hal/interface/hal_common.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Seed size produced by lpadc_entropy_read() (SHA-256) */
+#define LPADC_ENTROPY_SEED_SIZE         32U
+
+/** @brief ADC0 channel sampled, the internal temperature sensor */
+#ifndef LPADC_ENTROPY_CHANNEL
+#define LPADC_ENTROPY_CHANNEL           26U
+#endif
+
+/** @brief Conversions per seed */
+#ifndef LPADC_ENTROPY_SAMPLES
+#define LPADC_ENTROPY_SAMPLES           1024U
+#endif
+
+/** @brief Conversions credited with one bit of entropy */
+#ifndef LPADC_ENTROPY_SAMPLES_PER_BIT
+#define LPADC_ENTROPY_SAMPLES_PER_BIT   4U
+#endif
+
+/**
+ * @brief Repetition count test cutoff
+ *
+ * 1 + ceil(20 / H) for H = 1/LPADC_ENTROPY_SAMPLES_PER_BIT bits per
+ * sample: a false alarm probability of 2^-20.
+ */
+#ifndef LPADC_ENTROPY_REPETITION_CUTOFF
+#define LPADC_ENTROPY_REPETITION_CUTOFF (1U + 20U * LPADC_ENTROPY_SAMPLES_PER_BIT)
+#endif
+
+/**
+ * @brief Clock, reset and configure ADC0 for noise sampling
+ *
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_NOT_SUPPORTED Host build
+ */
+hal_result_t lpadc_entropy_init(void);
+
+/**
+ * @brief Stop ADC0
+ */
+void lpadc_entropy_deinit(void);
+
+/**
+ * @brief Sample LPADC_ENTROPY_SAMPLES conversions into a seed
+ *
+ * Takes about LPADC_ENTROPY_SAMPLES conversion times (a few ms); call it
+ * from idle time, not the request path.
+ *
+ * @param seed Output LPADC_ENTROPY_SEED_SIZE bytes
+ * @param entropy_bits Output entropy credited to the seed
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_NOT_INITIALIZED lpadc_entropy_init() not called
+ * @retval HAL_ERROR_TIMEOUT A conversion did not complete
+ * @retval HAL_ERROR_HARDWARE_FAILURE Repetition count test failed, the
+ *         input looks stuck; nothing is credited
+ * @retval HAL_ERROR_NOT_SUPPORTED Host build
+ */
+hal_result_t lpadc_entropy_read(uint8_t* seed, uint32_t* entropy_bits);
+
+#endif // LPADC_ENTROPY_H
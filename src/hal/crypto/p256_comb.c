@@ -0,0 +1,569 @@
+/**
+ * @file p256_comb.c
+ * @brief Fixed-Base Comb Multiplication for P-256
+ * @author USB Key Authentication Team
+ * @date 2025-09-10
+ * @version 1.0
+ *
+ * With T teeth and spacing D (T*D >= 256), the scalar k is mapped to
+ * b = (k + 2^(T*D) - 1) / 2 mod n. Reading every bit of b as a sign
+ * (1 -> +1, 0 -> -1) gives k = sum over columns i of 2^i * C_i where
+ *   C_i = sum over teeth j of (+-1) * 2^(j*D)
+ * Each C_i is odd in every tooth, so it is never zero and is one of the
+ * 2^(T-1) table points, negated when its top tooth is -1. k*G then takes
+ * D-1 doublings and D-1 mixed additions, with no data-dependent branch.
+ */
+
+#include "p256_comb.h"
+#include "p256_comb_table.h"
+#include "p256_field.h"
+#include "crypto_util.h"
+#include <string.h>
+
+#if P256_COMB_TABLE_TEETH != P256_COMB_TEETH
+#error "p256_comb_table.h does not match P256_COMB_TEETH, regenerate it with p256_comb_gen"
+#endif
+
+#define WORDS           NUM_ECC_WORDS
+
+/** @brief Bits needed to index every tooth of every column */
+#define RECODED_WORDS   ((P256_COMB_TEETH * P256_COMB_SPACING + 31) / 32)
+
+/**
+ * @brief Jacobian point (x = X/Z^2, y = Y/Z^3)
+ */
+typedef struct {
+    uECC_word_t x[WORDS];
+    uECC_word_t y[WORDS];
+    uECC_word_t z[WORDS];
+} jacobian_point_t;
+
+// =============================================================================
+// Constant-time integer helpers
+// =============================================================================
+
+/**
+ * @brief All-ones if a == b, zero otherwise
+ */
+static uECC_word_t ct_equal_mask(uECC_word_t a, uECC_word_t b) {
+    uECC_word_t diff = a ^ b;
+
+    return ((diff | (0U - diff)) >> 31) - 1U;
+}
+
+/**
+ * @brief r = mask ? a : b
+ */
+static void ct_select(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b,
+                      uECC_word_t mask) {
+    for (unsigned i = 0; i < WORDS; i++) {
+        r[i] = (a[i] & mask) | (b[i] & ~mask);
+    }
+}
+
+/**
+ * @brief r = a + b, returns the carry
+ */
+static uECC_word_t vli_add(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b) {
+    uECC_dword_t acc = 0;
+
+    for (unsigned i = 0; i < WORDS; i++) {
+        acc += (uECC_dword_t)a[i] + b[i];
+        r[i] = (uECC_word_t)acc;
+        acc >>= 32;
+    }
+    return (uECC_word_t)acc;
+}
+
+/**
+ * @brief r = a - b, returns the borrow
+ */
+static uECC_word_t vli_sub(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b) {
+    uECC_word_t borrow = 0;
+
+    for (unsigned i = 0; i < WORDS; i++) {
+        uECC_dword_t diff = (uECC_dword_t)a[i] - b[i] - borrow;
+        r[i] = (uECC_word_t)diff;
+        borrow = (uECC_word_t)(diff >> 32) & 1U;
+    }
+    return borrow;
+}
+
+/**
+ * @brief r = a + b mod m for a, b < m
+ */
+static void mod_add(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b,
+                    const uECC_word_t* m) {
+    uECC_word_t reduced[WORDS];
+    uECC_word_t carry = vli_add(r, a, b);
+    uECC_word_t borrow = vli_sub(reduced, r, m);
+
+    ct_select(r, reduced, r, 0U - (carry | (borrow ^ 1U)));
+}
+
+/**
+ * @brief r = a - b mod m for a, b < m
+ */
+static void mod_sub(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b,
+                    const uECC_word_t* m) {
+    uECC_word_t wrapped[WORDS];
+    uECC_word_t borrow = vli_sub(r, a, b);
+
+    (void)vli_add(wrapped, r, m);
+    ct_select(r, wrapped, r, 0U - borrow);
+}
+
+// =============================================================================
+// Field arithmetic mod p
+// =============================================================================
+
+static void fe_mul(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b) {
+    p256_field_mul(r, a, b);
+}
+
+static void fe_sqr(uECC_word_t* r, const uECC_word_t* a) {
+    p256_field_sqr(r, a);
+}
+
+static void fe_add(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b) {
+    mod_add(r, a, b, uECC_secp256r1()->p);
+}
+
+static void fe_sub(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b) {
+    mod_sub(r, a, b, uECC_secp256r1()->p);
+}
+
+/**
+ * @brief r = a^(2^count)
+ */
+static void fe_sqr_n(uECC_word_t* r, const uECC_word_t* a, unsigned count) {
+    memcpy(r, a, WORDS * sizeof(uECC_word_t));
+    while (count-- > 0) {
+        fe_sqr(r, r);
+    }
+}
+
+/**
+ * @brief r = a^(p-2) = 1/a
+ *
+ * Fixed addition chain for p - 2 = 2^256 - 2^224 + 2^192 + 2^96 - 3:
+ * 255 squarings and 12 multiplications. x_k holds a^(2^k - 1).
+ */
+static void fe_inv(uECC_word_t* r, const uECC_word_t* a) {
+    uECC_word_t x2[WORDS], x3[WORDS], x15[WORDS], x30[WORDS], x32[WORDS], t[WORDS];
+
+    fe_sqr(x2, a);
+    fe_mul(x2, x2, a);
+    fe_sqr(x3, x2);
+    fe_mul(x3, x3, a);
+    fe_sqr_n(t, x3, 3);
+    fe_mul(t, t, x3);           // x6
+    fe_sqr_n(x15, t, 6);
+    fe_mul(x15, x15, t);        // x12
+    fe_sqr_n(x15, x15, 3);
+    fe_mul(x15, x15, x3);
+    fe_sqr_n(x30, x15, 15);
+    fe_mul(x30, x30, x15);
+    fe_sqr_n(x32, x30, 2);
+    fe_mul(x32, x32, x2);
+
+    fe_sqr_n(t, x32, 32);       // ffffffff 00000001
+    fe_mul(t, t, a);
+    fe_sqr_n(t, t, 128);        // 00000000 x3, ffffffff
+    fe_mul(t, t, x32);
+    fe_sqr_n(t, t, 32);         // ffffffff
+    fe_mul(t, t, x32);
+    fe_sqr_n(t, t, 30);         // fffffffd
+    fe_mul(t, t, x30);
+    fe_sqr_n(t, t, 2);
+    fe_mul(r, t, a);
+}
+
+// =============================================================================
+// Point arithmetic
+// =============================================================================
+
+/**
+ * @brief P = 2P (dbl-2001-b, a = -3)
+ */
+static void point_double(jacobian_point_t* p) {
+    uECC_word_t delta[WORDS], gamma[WORDS], beta[WORDS], alpha[WORDS], t[WORDS];
+
+    fe_sqr(delta, p->z);
+    fe_sqr(gamma, p->y);
+    fe_mul(beta, p->x, gamma);
+
+    // alpha = 3 * (X - delta) * (X + delta)
+    fe_sub(t, p->x, delta);
+    fe_add(alpha, p->x, delta);
+    fe_mul(alpha, alpha, t);
+    fe_add(t, alpha, alpha);
+    fe_add(alpha, alpha, t);
+
+    // Z3 = (Y + Z)^2 - gamma - delta
+    fe_add(t, p->y, p->z);
+    fe_sqr(t, t);
+    fe_sub(t, t, gamma);
+    fe_sub(p->z, t, delta);
+
+    // X3 = alpha^2 - 8 * beta
+    fe_add(beta, beta, beta);
+    fe_add(beta, beta, beta);
+    fe_sqr(p->x, alpha);
+    fe_sub(p->x, p->x, beta);
+    fe_sub(p->x, p->x, beta);
+
+    // Y3 = alpha * (4 * beta - X3) - 8 * gamma^2
+    fe_sub(t, beta, p->x);
+    fe_mul(t, alpha, t);
+    fe_sqr(gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_sub(p->y, t, gamma);
+}
+
+/**
+ * @brief P = P + (x2, y2) with an affine second point (madd-2004-hmv)
+ *
+ * @return All-ones if the points share an x coordinate, where this
+ *         formula is invalid, zero otherwise
+ */
+static uECC_word_t point_add_affine(jacobian_point_t* p, const uECC_word_t* x2,
+                                    const uECC_word_t* y2) {
+    uECC_word_t t1[WORDS], t2[WORDS], t3[WORDS], t4[WORDS];
+    uECC_word_t h_bits = 0;
+
+    fe_sqr(t1, p->z);
+    fe_mul(t2, t1, p->z);
+    fe_mul(t1, t1, x2);
+    fe_mul(t2, t2, y2);
+    fe_sub(t1, t1, p->x);       // H
+    fe_sub(t2, t2, p->y);       // R
+
+    for (unsigned i = 0; i < WORDS; i++) {
+        h_bits |= t1[i];
+    }
+
+    fe_mul(p->z, p->z, t1);
+    fe_sqr(t3, t1);
+    fe_mul(t4, t3, t1);
+    fe_mul(t3, t3, p->x);
+    fe_add(t1, t3, t3);
+    fe_sqr(p->x, t2);
+    fe_sub(p->x, p->x, t1);
+    fe_sub(p->x, p->x, t4);
+    fe_sub(t3, t3, p->x);
+    fe_mul(t3, t3, t2);
+    fe_mul(t4, t4, p->y);
+    fe_sub(p->y, t3, t4);
+
+    return ct_equal_mask(h_bits, 0);
+}
+
+// =============================================================================
+// Comb
+// =============================================================================
+
+/**
+ * @brief b = (k + 2^(T*D) - 1) / 2 mod n
+ */
+static void comb_recode(uECC_word_t* recoded, const uECC_word_t* scalar) {
+    const uECC_word_t* n = uECC_secp256r1()->n;
+    uECC_word_t t[WORDS];
+    uECC_word_t odd_sum[WORDS];
+
+    mod_add(t, scalar, k_p256_comb_offset, n);
+
+    // Halve mod n: (t + n) / 2 when t is odd, keeping the carry bit
+    uECC_word_t carry = vli_add(odd_sum, t, n);
+    uECC_word_t odd = 0U - (t[0] & 1U);
+    ct_select(t, odd_sum, t, odd);
+    carry &= odd;
+
+    memset(recoded, 0, RECODED_WORDS * sizeof(uECC_word_t));
+    for (unsigned i = 0; i < WORDS; i++) {
+        uECC_word_t high = (i + 1 < WORDS) ? t[i + 1] : carry;
+        recoded[i] = (t[i] >> 1) | (high << 31);
+    }
+
+    crypto_secure_zero(t, sizeof(t));
+    crypto_secure_zero(odd_sum, sizeof(odd_sum));
+}
+
+/**
+ * @brief Read bit position of the recoded scalar
+ */
+static uint32_t comb_bit(const uECC_word_t* recoded, unsigned position) {
+    return (recoded[position / 32] >> (position % 32)) & 1U;
+}
+
+/**
+ * @brief Load column i as +-table[index] without secret-dependent access
+ */
+static void comb_load_column(uECC_word_t* x, uECC_word_t* y,
+                             const uECC_word_t* recoded, unsigned column) {
+    uint32_t top = comb_bit(recoded, column + (P256_COMB_TEETH - 1) * P256_COMB_SPACING);
+    uint32_t index = 0;
+
+    // Table entries assume a + top tooth; flip every sign when it is -
+    for (unsigned j = 0; j < P256_COMB_TEETH - 1; j++) {
+        index |= (comb_bit(recoded, column + j * P256_COMB_SPACING) ^ top ^ 1U) << j;
+    }
+
+    memset(x, 0, WORDS * sizeof(uECC_word_t));
+    memset(y, 0, WORDS * sizeof(uECC_word_t));
+    for (unsigned entry = 0; entry < P256_COMB_POINTS; entry++) {
+        uECC_word_t mask = ct_equal_mask(entry, index);
+        for (unsigned i = 0; i < WORDS; i++) {
+            x[i] |= k_p256_comb_table[entry][i] & mask;
+            y[i] |= k_p256_comb_table[entry][WORDS + i] & mask;
+        }
+    }
+
+    uECC_word_t negated[WORDS];
+    (void)vli_sub(negated, uECC_secp256r1()->p, y);
+    ct_select(y, negated, y, 0U - (top ^ 1U));
+}
+
+int p256_comb_mul_base(uECC_word_t* result, const uECC_word_t* scalar) {
+    uECC_Curve curve = uECC_secp256r1();
+
+    if (uECC_vli_isZero(scalar, WORDS) || uECC_vli_cmp(curve->n, scalar, WORDS) != 1) {
+        return 0;
+    }
+
+    uECC_word_t recoded[RECODED_WORDS];
+    uECC_word_t x[WORDS], y[WORDS], lambda[WORDS];
+    jacobian_point_t r;
+    uECC_word_t exceptional = 0;
+    int ok = 0;
+
+    comb_recode(recoded, scalar);
+    comb_load_column(r.x, r.y, recoded, P256_COMB_SPACING - 1);
+
+    // Random projective coordinates: (X * l^2, Y * l^3, l)
+    if (!uECC_generate_random_int(lambda, curve->p, WORDS)) {
+        goto cleanup_and_exit;
+    }
+    memcpy(r.z, lambda, sizeof(lambda));
+    fe_sqr(lambda, lambda);
+    fe_mul(r.x, r.x, lambda);
+    fe_mul(lambda, lambda, r.z);
+    fe_mul(r.y, r.y, lambda);
+
+    for (unsigned column = P256_COMB_SPACING - 1; column-- > 0;) {
+        point_double(&r);
+        comb_load_column(x, y, recoded, column);
+        exceptional |= point_add_affine(&r, x, y);
+    }
+
+    fe_inv(lambda, r.z);
+    fe_sqr(x, lambda);
+    fe_mul(result, r.x, x);
+    fe_mul(x, x, lambda);
+    fe_mul(result + WORDS, r.y, x);
+    ok = exceptional == 0;
+
+cleanup_and_exit:
+    crypto_secure_zero(recoded, sizeof(recoded));
+    crypto_secure_zero(&r, sizeof(r));
+    crypto_secure_zero(x, sizeof(x));
+    crypto_secure_zero(y, sizeof(y));
+    crypto_secure_zero(lambda, sizeof(lambda));
+    return ok;
+}
+
+// =============================================================================
+// Key generation and signing
+// =============================================================================
+
+/**
+ * @brief k*G through the comb, falling back to tinycrypt's ladder
+ */
+static int mul_base(uECC_word_t* result, uECC_word_t* scalar) {
+    if (p256_comb_mul_base(result, scalar)) {
+        return 1;
+    }
+    return (int)EccPoint_compute_public_key(result, scalar, p256_field_curve());
+}
+
+int p256_comb_make_key(uint8_t* public_key, uint8_t* private_key) {
+    uECC_Curve curve = uECC_secp256r1();
+    uECC_word_t random[2 * WORDS];
+    uECC_word_t scalar[WORDS];
+    uECC_word_t point[2 * WORDS];
+    int ok = 0;
+
+    for (unsigned tries = 0; tries < uECC_RNG_MAX_TRIES; tries++) {
+        uECC_RNG_Function rng = uECC_get_rng();
+        if (!rng || !rng((uint8_t*)random, sizeof(random))) {
+            break;
+        }
+
+        // Reduce 512 random bits mod n (FIPS 186-4 B.4.1)
+        uECC_vli_mmod(scalar, random, curve->n, WORDS);
+        if (uECC_vli_isZero(scalar, WORDS) || !mul_base(point, scalar)) {
+            continue;
+        }
+
+        uECC_vli_nativeToBytes(private_key, NUM_ECC_BYTES, scalar);
+        uECC_vli_nativeToBytes(public_key, NUM_ECC_BYTES, point);
+        uECC_vli_nativeToBytes(public_key + NUM_ECC_BYTES, NUM_ECC_BYTES, point + WORDS);
+        ok = 1;
+        break;
+    }
+
+    crypto_secure_zero(random, sizeof(random));
+    crypto_secure_zero(scalar, sizeof(scalar));
+    return ok;
+}
+
+/**
+ * @brief r and 1/k for a given nonce k, 0 < k < n
+ *
+ * @return 0 if r is zero or the RNG failed; the caller picks another k
+ */
+static int presign_with_k(uECC_word_t* k, p256_presign_t* presign) {
+    uECC_Curve curve = uECC_secp256r1();
+    uECC_word_t point[2 * WORDS];
+    uECC_word_t blind[WORDS], reduced[WORDS];
+    int ok = 0;
+
+    if (!mul_base(point, k)) {
+        goto cleanup_and_exit;
+    }
+
+    // r = x mod n; x < p < 2n so one conditional subtraction suffices
+    uECC_word_t borrow = vli_sub(reduced, point, curve->n);
+    ct_select(presign->r, reduced, point, borrow - 1U);
+    if (uECC_vli_isZero(presign->r, WORDS)) {
+        goto cleanup_and_exit;
+    }
+
+    // 1/k computed as 1/(k * blind) * blind to hide k from the inversion
+    if (!uECC_generate_random_int(blind, curve->n, WORDS)) {
+        goto cleanup_and_exit;
+    }
+    uECC_vli_modMult(presign->k_inverse, k, blind, curve->n, WORDS);
+    uECC_vli_modInv(presign->k_inverse, presign->k_inverse, curve->n, WORDS);
+    uECC_vli_modMult(presign->k_inverse, presign->k_inverse, blind, curve->n, WORDS);
+    ok = 1;
+
+cleanup_and_exit:
+    crypto_secure_zero(blind, sizeof(blind));
+    return ok;
+}
+
+/**
+ * @brief Private scalar and truncated hash of a signature
+ *
+ * @return 0 if the private key is out of range
+ */
+static int load_signing_inputs(uECC_word_t* d, uECC_word_t* e, const uint8_t* private_key,
+                               const uint8_t* message_hash, unsigned hash_size) {
+    uECC_Curve curve = uECC_secp256r1();
+
+    uECC_vli_bytesToNative(d, private_key, NUM_ECC_BYTES);
+    if (uECC_vli_isZero(d, WORDS) || uECC_vli_cmp(curve->n, d, WORDS) != 1) {
+        return 0;
+    }
+
+    // e = leftmost 256 bits of the hash, reduced mod n
+    uECC_vli_clear(e, WORDS);
+    uECC_vli_bytesToNative(e, message_hash,
+                           hash_size > NUM_ECC_BYTES ? NUM_ECC_BYTES : (int)hash_size);
+    if (uECC_vli_cmp_unsafe(curve->n, e, WORDS) != 1) {
+        uECC_vli_sub(e, e, curve->n, WORDS);
+    }
+    return 1;
+}
+
+/**
+ * @brief s = (e + r * d) / k, the only private-key step of a signature
+ *
+ * @return 0 if s is zero; the caller picks another k
+ */
+static int finish_signature(const uECC_word_t* d, const uECC_word_t* e,
+                            const p256_presign_t* presign, uint8_t* signature) {
+    uECC_Curve curve = uECC_secp256r1();
+    uECC_word_t s[WORDS];
+    int ok = 0;
+
+    uECC_vli_modMult(s, presign->r, d, curve->n, WORDS);
+    mod_add(s, e, s, curve->n);
+    uECC_vli_modMult(s, s, presign->k_inverse, curve->n, WORDS);
+
+    if (!uECC_vli_isZero(s, WORDS)) {
+        uECC_vli_nativeToBytes(signature, NUM_ECC_BYTES, presign->r);
+        uECC_vli_nativeToBytes(signature + NUM_ECC_BYTES, NUM_ECC_BYTES, s);
+        ok = 1;
+    }
+
+    crypto_secure_zero(s, sizeof(s));
+    return ok;
+}
+
+int p256_comb_presign(p256_presign_t* presign) {
+    uECC_Curve curve = uECC_secp256r1();
+    uECC_word_t k[WORDS];
+    uECC_word_t random[2 * WORDS];
+    int ok = 0;
+
+    for (unsigned tries = 0; tries < uECC_RNG_MAX_TRIES; tries++) {
+        uECC_RNG_Function rng = uECC_get_rng();
+        if (!rng || !rng((uint8_t*)random, sizeof(random))) {
+            break;
+        }
+
+        uECC_vli_mmod(k, random, curve->n, WORDS);
+        if (!uECC_vli_isZero(k, WORDS) && presign_with_k(k, presign)) {
+            ok = 1;
+            break;
+        }
+    }
+
+    if (!ok) {
+        crypto_secure_zero(presign, sizeof(*presign));
+    }
+    crypto_secure_zero(k, sizeof(k));
+    crypto_secure_zero(random, sizeof(random));
+    return ok;
+}
+
+int p256_comb_sign_presigned(const uint8_t* private_key, const uint8_t* message_hash,
+                             unsigned hash_size, const p256_presign_t* presign,
+                             uint8_t* signature) {
+    uECC_word_t d[WORDS], e[WORDS];
+    int ok = load_signing_inputs(d, e, private_key, message_hash, hash_size) &&
+             finish_signature(d, e, presign, signature);
+
+    crypto_secure_zero(d, sizeof(d));
+    return ok;
+}
+
+int p256_comb_sign(const uint8_t* private_key, const uint8_t* message_hash,
+                   unsigned hash_size, uint8_t* signature) {
+    uECC_word_t d[WORDS], e[WORDS];
+    p256_presign_t presign;
+    int ok = 0;
+
+    if (!load_signing_inputs(d, e, private_key, message_hash, hash_size)) {
+        goto cleanup_and_exit;
+    }
+
+    for (unsigned tries = 0; tries < uECC_RNG_MAX_TRIES; tries++) {
+        if (!p256_comb_presign(&presign)) {
+            break;
+        }
+        if (finish_signature(d, e, &presign, signature)) {
+            ok = 1;
+            break;
+        }
+    }
+
+cleanup_and_exit:
+    crypto_secure_zero(d, sizeof(d));
+    crypto_secure_zero(&presign, sizeof(presign));
+    return ok;
+}
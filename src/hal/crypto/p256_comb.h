@@ -0,0 +1,118 @@
+#ifndef P256_COMB_H
+#define P256_COMB_H
+
+/**
+ * @file p256_comb.h
+ * @brief Fixed-Base Comb Multiplication for P-256
+ * @author USB Key Authentication Team
+ * @date 2025-09-10
+ * @version 1.0
+ *
+ * Computes k*G for the P-256 generator from a precomputed comb table in
+ * flash (p256_comb_table.h) instead of tinycrypt's generic Montgomery
+ * ladder. Used by the tinycrypt backend for key generation and the k*G
+ * step of ECDSA signing.
+ *
+ * The scalar is recoded so every comb column is a nonzero signed digit
+ * (Hamburg's signed all-bits-set comb), so the sequence of doublings and
+ * additions is the same for every scalar. Table entries are read by
+ * scanning the whole table with masks and negated with a mask, the
+ * starting point gets random projective coordinates and the final
+ * inversion uses a fixed exponent. Field arithmetic is p256_field.h.
+ *
+ * Integers and points use tinycrypt's native layout (little-endian
+ * 32-bit words, points X||Y).
+ *
+ * Signing is split so the expensive part can run ahead of time:
+ * p256_comb_presign() picks k and computes r and 1/k, which depend on
+ * nothing but the RNG, and p256_comb_sign_presigned() applies the key and
+ * message hash with two modular multiplications (see p256_pool.h).
+ */
+
+#include <stdint.h>
+#include <tinycrypt/ecc.h>
+
+/** @brief Comb teeth: table holds 2^(teeth-1) points */
+#define P256_COMB_TEETH         6
+
+/** @brief Bits between teeth, also the number of comb columns */
+#define P256_COMB_SPACING       ((256 + P256_COMB_TEETH - 1) / P256_COMB_TEETH)
+
+/** @brief Points in the comb table */
+#define P256_COMB_POINTS        (1 << (P256_COMB_TEETH - 1))
+
+/**
+ * @brief Per-signature values that do not depend on the key or message
+ *
+ * k itself is not kept: a signature only needs r and 1/k. Secret, and
+ * valid for exactly one signature.
+ */
+typedef struct {
+    uECC_word_t r[NUM_ECC_WORDS];           /**< x(k*G) mod n, nonzero */
+    uECC_word_t k_inverse[NUM_ECC_WORDS];   /**< 1/k mod n */
+} p256_presign_t;
+
+/**
+ * @brief Multiply the P-256 generator by a scalar
+ *
+ * @param result Affine point k*G (2 * NUM_ECC_WORDS words)
+ * @param scalar Scalar k, 0 < k < n (NUM_ECC_WORDS words)
+ * @return 1 on success, 0 if k is out of range, the RNG failed or an
+ *         addition hit an exceptional case (probability ~2^-200 for a
+ *         random k); callers then fall back to EccPoint_mult()
+ */
+int p256_comb_mul_base(uECC_word_t* result, const uECC_word_t* scalar);
+
+/**
+ * @brief Generate a P-256 key pair
+ *
+ * Same contract as tinycrypt's uECC_make_key() for secp256r1.
+ *
+ * @param public_key Output public key, 64 bytes X||Y big-endian
+ * @param private_key Output private key, 32 bytes big-endian
+ * @return 1 on success, 0 on RNG failure
+ */
+int p256_comb_make_key(uint8_t* public_key, uint8_t* private_key);
+
+/**
+ * @brief ECDSA P-256 signature of a message hash
+ *
+ * Same contract as tinycrypt's uECC_sign() for secp256r1, with the
+ * modular inversion of k blinded by a random factor.
+ *
+ * @param private_key Private key, 32 bytes big-endian
+ * @param message_hash Hash of the message
+ * @param hash_size Hash length in bytes
+ * @param signature Output r||s, 64 bytes big-endian
+ * @return 1 on success, 0 on RNG failure or invalid key
+ */
+int p256_comb_sign(const uint8_t* private_key, const uint8_t* message_hash,
+                   unsigned hash_size, uint8_t* signature);
+
+/**
+ * @brief Draw a nonce and compute its r and 1/k
+ *
+ * @param presign Output values, wiped on failure
+ * @return 1 on success, 0 on RNG failure
+ */
+int p256_comb_presign(p256_presign_t* presign);
+
+/**
+ * @brief ECDSA P-256 signature from precomputed r and 1/k
+ *
+ * Same output as p256_comb_sign(). The caller must wipe presign
+ * afterwards and never use it again: two signatures with one k reveal the
+ * private key.
+ *
+ * @param private_key Private key, 32 bytes big-endian
+ * @param message_hash Hash of the message
+ * @param hash_size Hash length in bytes
+ * @param presign Values from p256_comb_presign()
+ * @param signature Output r||s, 64 bytes big-endian
+ * @return 1 on success, 0 for an invalid key or if s came out zero
+ */
+int p256_comb_sign_presigned(const uint8_t* private_key, const uint8_t* message_hash,
+                             unsigned hash_size, const p256_presign_t* presign,
+                             uint8_t* signature);
+
+#endif // P256_COMB_H
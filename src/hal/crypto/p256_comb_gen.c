@@ -0,0 +1,101 @@
+/**
+ * @file p256_comb_gen.c
+ * @brief Host generator for the P-256 comb table
+ * @author USB Key Authentication Team
+ * @date 2025-09-10
+ * @version 1.0
+ *
+ * Writes p256_comb_table.h for the P256_COMB_TEETH configured in
+ * p256_comb.h. Rerun after changing the teeth count, from the repository
+ * root:
+ * @code
+ * TC=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/mcuboot_opensource/ext/tinycrypt/lib
+ * gcc -std=c11 -O2 -I src -I $TC/include src/hal/crypto/p256_comb_gen.c \
+ *     $TC/source/ecc.c $TC/source/ecc_platform_specific.c -o p256_comb_gen
+ * ./p256_comb_gen > src/hal/crypto/p256_comb_table.h
+ * @endcode
+ *
+ * Entry i of the table is
+ *   2^((T-1)*D) G + sum over j < T-1 of (bit j of i ? +1 : -1) * 2^(j*D) G
+ * with T teeth and spacing D, in affine tinycrypt native words.
+ */
+
+#include "p256_comb.h"
+#include <stdio.h>
+
+#define WORDS   NUM_ECC_WORDS
+
+/**
+ * @brief Set x = 2^exponent mod n
+ */
+static void pow2_mod_n(uECC_word_t* x, unsigned exponent, uECC_Curve curve) {
+    uECC_vli_clear(x, WORDS);
+    x[0] = 1;
+    while (exponent-- > 0) {
+        uECC_vli_modAdd(x, x, x, curve->n, WORDS);
+    }
+}
+
+/**
+ * @brief Print a native integer as a C initializer
+ */
+static void print_words(const uECC_word_t* x, unsigned count, const char* indent) {
+    for (unsigned i = 0; i < count; i++) {
+        if (i > 0) {
+            printf(i % 4 == 0 ? ",\n%s" : ", ", indent);
+        }
+        printf("0x%08XU", x[i]);
+    }
+}
+
+int main(void) {
+    uECC_Curve curve = uECC_secp256r1();
+    uECC_word_t offset[WORDS];
+    uECC_word_t one[WORDS] = {1};
+
+    // 2^(T*D) - 1 mod n, the offset of the signed-digit recoding
+    pow2_mod_n(offset, P256_COMB_TEETH * P256_COMB_SPACING, curve);
+    uECC_vli_modSub(offset, offset, one, curve->n, WORDS);
+
+    printf("#ifndef P256_COMB_TABLE_H\n#define P256_COMB_TABLE_H\n\n");
+    printf("/**\n * @file p256_comb_table.h\n * @brief P-256 Generator Comb Table\n *\n");
+    printf(" * Generated by p256_comb_gen.c, do not edit.\n */\n\n");
+    printf("#include <tinycrypt/ecc.h>\n\n");
+    printf("/** @brief Teeth the table was generated for */\n");
+    printf("#define P256_COMB_TABLE_TEETH   %d\n\n", P256_COMB_TEETH);
+    printf("/** @brief 2^(teeth * spacing) - 1 mod n */\n");
+    printf("static const uECC_word_t k_p256_comb_offset[NUM_ECC_WORDS] = {\n    ");
+    print_words(offset, WORDS, "    ");
+    printf("\n};\n\n");
+    printf("/** @brief Affine comb points, X||Y */\n");
+    printf("static const uECC_word_t k_p256_comb_table[%d][2 * NUM_ECC_WORDS] = {\n",
+           P256_COMB_POINTS);
+
+    for (unsigned index = 0; index < P256_COMB_POINTS; index++) {
+        uECC_word_t scalar[WORDS];
+        uECC_word_t term[WORDS];
+        uECC_word_t point[2 * WORDS];
+
+        pow2_mod_n(scalar, (P256_COMB_TEETH - 1) * P256_COMB_SPACING, curve);
+        for (unsigned j = 0; j < P256_COMB_TEETH - 1; j++) {
+            pow2_mod_n(term, j * P256_COMB_SPACING, curve);
+            if (index & (1U << j)) {
+                uECC_vli_modAdd(scalar, scalar, term, curve->n, WORDS);
+            } else {
+                uECC_vli_modSub(scalar, scalar, term, curve->n, WORDS);
+            }
+        }
+
+        if (!EccPoint_compute_public_key(point, scalar, curve)) {
+            fprintf(stderr, "entry %u is the point at infinity\n", index);
+            return 1;
+        }
+
+        printf("    { ");
+        print_words(point, 2 * WORDS, "      ");
+        printf(" },\n");
+    }
+
+    printf("};\n\n#endif // P256_COMB_TABLE_H\n");
+    return 0;
+}
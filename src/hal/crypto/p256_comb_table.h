@@ -0,0 +1,154 @@
+#ifndef P256_COMB_TABLE_H
+#define P256_COMB_TABLE_H
+
+/**
+ * @file p256_comb_table.h
+ * @brief P-256 Generator Comb Table
+ *
+ * Generated by p256_comb_gen.c, do not edit.
+ */
+
+#include <tinycrypt/ecc.h>
+
+/** @brief Teeth the table was generated for */
+#define P256_COMB_TABLE_TEETH   6
+
+/** @brief 2^(teeth * spacing) - 1 mod n */
+static const uECC_word_t k_p256_comb_offset[NUM_ECC_WORDS] = {
+    0x0E736ABBU, 0x3118D4F4U, 0x63A185ECU, 0x0C641549U,
+    0x00000001U, 0x00000000U, 0xFFFFFFFCU, 0x00000003U
+};
+
+/** @brief Affine comb points, X||Y */
+static const uECC_word_t k_p256_comb_table[32][2 * NUM_ECC_WORDS] = {
+    { 0x79F1952DU, 0x3BD04BB6U, 0x118BE011U, 0x767855B4U,
+      0xB59C1AC3U, 0x76FDAB0DU, 0x0C4B18A4U, 0x16E4ABE6U,
+      0xD3A5AF5DU, 0xC4716379U, 0x0FB8F754U, 0xC1FB5774U,
+      0xC8C2C216U, 0xFB8DB58EU, 0x850675E8U, 0x2CB99CFCU },
+    { 0x090D092AU, 0xC803D606U, 0x1554C3D0U, 0xF25F7CBCU,
+      0xC264423CU, 0xA5D141BFU, 0x634A1D28U, 0xF00E4339U,
+      0xCC47C9BAU, 0x040F0752U, 0x14DA4163U, 0x899C7CBEU,
+      0x8A559DFBU, 0xA6E84F04U, 0x7DB3427FU, 0x5013E1E0U },
+    { 0x3E930576U, 0x6FBD84F4U, 0xB16B5A47U, 0xCC67D205U,
+      0xC651C52AU, 0x34B5642EU, 0x41712315U, 0x79E3EB10U,
+      0x09F87A59U, 0x2DA56B73U, 0x41597386U, 0x0966C53DU,
+      0x8FA9A873U, 0x1122F091U, 0x1523534AU, 0xC6F8990CU },
+    { 0x4B2C7CB5U, 0xDC52945CU, 0x0604881CU, 0xF3C4B3B0U,
+      0x9A689EF4U, 0x6F854B3DU, 0x51FE7B8EU, 0x708BB8F8U,
+      0xE87C90BCU, 0x1CF468FFU, 0xD73C1896U, 0x6B05EFD1U,
+      0x9B53386CU, 0xA7CB53B1U, 0x3BCC6C4FU, 0x06DA7AEEU },
+    { 0xCF725D71U, 0x1530C239U, 0x53A1CABCU, 0x34E6EA55U,
+      0x794B5572U, 0xE49DA18CU, 0xB29C56EFU, 0x6B9B3919U,
+      0x218E740AU, 0x9CD28B3FU, 0x5350C88DU, 0x0F878D87U,
+      0x903A14AEU, 0x6455CE06U, 0xC3E2DDFAU, 0x87E1F0EEU },
+    { 0x007264FEU, 0x747E9845U, 0x5D7AFA38U, 0x6E03D130U,
+      0xAF7BC52DU, 0x93B364AAU, 0xB459F28EU, 0xA18ADA01U,
+      0x46B59886U, 0x2465AD54U, 0x768F2811U, 0x47BE449AU,
+      0x28CE1EE1U, 0xAAA8ABB0U, 0x8D26DBECU, 0x159A4CCCU },
+    { 0x0118E54BU, 0xE3AC0EB9U, 0x3E5760DCU, 0xC84449F2U,
+      0x09E3787CU, 0xA235A261U, 0xEA79377BU, 0x4BAF4DF8U,
+      0x787BA563U, 0x8D9D8DC4U, 0x49F0E8F0U, 0x076B245DU,
+      0x44DC9AE3U, 0xACFE90ECU, 0x908C70B9U, 0x721D664AU },
+    { 0xC2E859FBU, 0x23445D3FU, 0xDAEA05ACU, 0x65E56120U,
+      0xC64D7F36U, 0xF969CE2BU, 0x1FFF9E25U, 0x6F08B186U,
+      0xAE30362FU, 0xCF51E928U, 0x833CDDB0U, 0x1D0A0D9FU,
+      0x05CFA50BU, 0xC1E31A2FU, 0x3CD3DB1AU, 0xA9401BB3U },
+    { 0x7F82440CU, 0x6D7C3FA7U, 0x124F22D5U, 0x5A9A32A5U,
+      0x5D530247U, 0x325408E0U, 0xCA18B07DU, 0xBFB342FDU,
+      0x30DC8CCCU, 0x9FC58F24U, 0x0E7B947CU, 0x0B50392DU,
+      0x5B559968U, 0xFB0C0637U, 0xFB8CA3D7U, 0x31975005U },
+    { 0x8A93CE62U, 0xAEE513E1U, 0x61DC37F2U, 0x8D2056CAU,
+      0xB030547AU, 0xD8AEF3EFU, 0xA25BD699U, 0x70B6C627U,
+      0x6C3392EEU, 0x5FEE3D43U, 0x60FFF409U, 0x2ED738C9U,
+      0x2847382DU, 0xD4F92CA4U, 0x04D1AD9DU, 0x81AF1BA4U },
+    { 0xF9F48DF1U, 0x82334B03U, 0xDD62EA40U, 0x28795FF0U,
+      0xAF2C1F88U, 0x0A385130U, 0xB099BED7U, 0x5E654FC5U,
+      0x8A1C8B72U, 0x47593AE5U, 0x09FCB1B4U, 0xF2B75B55U,
+      0x576BCB6EU, 0x376C2915U, 0xA227182AU, 0x54DBDA6EU },
+    { 0xE2A337E1U, 0x6AFCF2A7U, 0x57896E0FU, 0xF5D26DD4U,
+      0x0527B7DEU, 0x0C24F4F3U, 0x64B1F103U, 0x3B411C8BU,
+      0xC91FB8E3U, 0xC960A25DU, 0x6D98F164U, 0x92E49934U,
+      0x4C6BCD96U, 0xDFF8533CU, 0x302CABBEU, 0x3E93F88EU },
+    { 0xFAE300DAU, 0x268A5234U, 0x2757E079U, 0x1E96954EU,
+      0x8A98D39AU, 0x41D320B7U, 0x396457E8U, 0xC5F3A1C3U,
+      0x2F78A0A6U, 0x38EDA1F1U, 0x4393B5F6U, 0xD4169978U,
+      0x5C03DF0FU, 0x7EC45AB3U, 0x681A2304U, 0x69BA87B8U },
+    { 0x2C6E57CBU, 0x216B0E51U, 0xC6B4161AU, 0x8522F4C8U,
+      0x4E572CE8U, 0xEA20BBB6U, 0xD1CFCC5DU, 0x01078AC1U,
+      0xBED01D25U, 0x5022D094U, 0xD0C6FDD3U, 0xF12B2E60U,
+      0x74FA21ACU, 0x78183AECU, 0xD0FB0A10U, 0xEFF624C7U },
+    { 0x4C3B39F7U, 0xF3060FEFU, 0xD9E75B09U, 0xB4A67537U,
+      0x5C3ADECCU, 0x37F0270CU, 0x77071104U, 0x451404ECU,
+      0x46D65448U, 0x0334154AU, 0x8F4538B8U, 0xE5A19B76U,
+      0x19205542U, 0x9E6CB67DU, 0x6E2F229DU, 0xF8D4CC82U },
+    { 0x375A54B7U, 0x4093A8C3U, 0x938D674CU, 0xAC0DED40U,
+      0x2AFAB3D5U, 0x9C8B3D26U, 0xFD9E966BU, 0x6939A5E4U,
+      0x6252EBAAU, 0x8FBBB843U, 0x3E04D4A7U, 0x3B12335EU,
+      0xA1F400D9U, 0x87FDE95CU, 0x1AC3E744U, 0x0E419D29U },
+    { 0xD4469BF3U, 0xC3AF0F38U, 0xC5863618U, 0x99B64DFFU,
+      0xCF800026U, 0xEE4949FCU, 0xE622E0EDU, 0x81B0578AU,
+      0xA4D6BBACU, 0x16872A5EU, 0x0CDBE1C6U, 0x8526823CU,
+      0xCF3D90ACU, 0xA16CEED7U, 0x1DC8E6ACU, 0x2847687BU },
+    { 0xFADADA30U, 0x0828C3E6U, 0x517FA7C4U, 0xD48D9981U,
+      0x4F6A0575U, 0x63EB69ADU, 0xA11FB4C1U, 0xE000BB7FU,
+      0xD61FF297U, 0xEC53F28AU, 0x10E9EF5DU, 0x13EA9359U,
+      0x371A45C9U, 0x7612C6DCU, 0x503114F6U, 0x1E2B4202U },
+    { 0x1A7DB624U, 0xD1239E0BU, 0x6910B073U, 0x945D7C22U,
+      0x502A175DU, 0x20BF8225U, 0x593E8AD7U, 0x3E13E433U,
+      0xD780F253U, 0x686AB327U, 0xBF816623U, 0x9CDE5707U,
+      0x96329A64U, 0x503055A4U, 0x91F915A2U, 0x42D5DCB9U },
+    { 0xF1F79EF8U, 0xB90D2042U, 0x77F60379U, 0xF951C649U,
+      0x819F9606U, 0x70288953U, 0x8DE81F4AU, 0x391CFD55U,
+      0x2F8DA33EU, 0xB2FD1E0CU, 0xC18ED6B7U, 0xBF171620U,
+      0xB41CE386U, 0x33FB6E66U, 0xABD9C54DU, 0x3BB2C5BCU },
+    { 0x131FC711U, 0x16C90DC2U, 0x2E539339U, 0x6A20AD98U,
+      0x6338A496U, 0x6E689B1EU, 0x21326C8BU, 0xEFA51EBAU,
+      0x12142137U, 0x5073FE67U, 0xA27C0098U, 0xD5E03BCFU,
+      0xBC79B4ADU, 0x1054084BU, 0x181431F4U, 0xA9BB5340U },
+    { 0xA0285A0CU, 0xA7AB395DU, 0xEC00AD80U, 0x12737892U,
+      0x6A3EE90BU, 0x73CAD5B5U, 0xAC2EF483U, 0xE80CB386U,
+      0x252799F7U, 0x9571A01EU, 0x88F8E0CFU, 0x778AD7D7U,
+      0xD20D4E04U, 0xD2A0B7FDU, 0x1AF78EE9U, 0x505C3B53U },
+    { 0xAEC193D7U, 0x0E47B714U, 0x50345B7AU, 0x9724B530U,
+      0x8531F855U, 0xC0F727DFU, 0x94D17C8FU, 0x7FE2602BU,
+      0xF3A67F01U, 0xB59AECF0U, 0xD8A94FFCU, 0xF4AE3293U,
+      0xEBA6623FU, 0xA9C07D7AU, 0x8C2C753CU, 0x454091A6U },
+    { 0x37F42A75U, 0xBE32211DU, 0x4F9FA00FU, 0x1F171B12U,
+      0xA62EB032U, 0x26815A04U, 0x4B6F7157U, 0x94356E3BU,
+      0xAB655A27U, 0x02D26F97U, 0xBEFDEA00U, 0x80BF3ECBU,
+      0x9C170991U, 0x48F4ACCFU, 0x3C563375U, 0x6298E275U },
+    { 0xFCBEB801U, 0xCBFED9C9U, 0xF2544946U, 0x7AC36B60U,
+      0xA33F021AU, 0x814FCD93U, 0x53A5597FU, 0x7D02BFC9U,
+      0xC4FD70D7U, 0x26BFA782U, 0x13DA5BFDU, 0x5F60C039U,
+      0x64692FF4U, 0xDF14622DU, 0xEAC5A27AU, 0x72027379U },
+    { 0x3A77DC93U, 0x34540DB1U, 0x3F05E104U, 0x0445CFAFU,
+      0xBDE70338U, 0x7AA78326U, 0xA48206B5U, 0xD2FF073FU,
+      0x2E0F2D1DU, 0xFBC5DCDCU, 0xD2ECB9A0U, 0x08C3484AU,
+      0x581DC3C1U, 0xAD96D0DAU, 0x0F4A3C34U, 0xEA970006U },
+    { 0x06CF3753U, 0x20B42347U, 0x722487F1U, 0x7DD4F86BU,
+      0x8351F08BU, 0x639DAF5AU, 0x398B5031U, 0x9DF63780U,
+      0x9CA3C491U, 0x264CB81DU, 0x5AE027A5U, 0x81306944U,
+      0x64D0B637U, 0xBA035018U, 0xE365A953U, 0xCF43DF1AU },
+    { 0x44A01E3BU, 0x5F424707U, 0x98786F01U, 0x597CD01BU,
+      0x892C3F6CU, 0x3B8537D3U, 0x6484D513U, 0x2E754EEDU,
+      0x83D91024U, 0x4E685D49U, 0x0D366D41U, 0x21EA9E3AU,
+      0x3A29C81FU, 0xA91343BDU, 0x2C3C6704U, 0x1FF30B96U },
+    { 0xEF3D0CA4U, 0xBF5109C9U, 0xEA33D2ECU, 0xD6072C6AU,
+      0x3BFD8B59U, 0xA590A5BDU, 0x5CBF5B11U, 0x5308051BU,
+      0x32D51985U, 0x7FA490A3U, 0xA882071BU, 0x135F6B27U,
+      0x6094E9F4U, 0xA655BCB4U, 0x42723907U, 0xE4A47608U },
+    { 0x54540E99U, 0x7002DCA5U, 0xB56B868CU, 0xADD41F38U,
+      0xCDBF9C05U, 0x35D6F530U, 0x34B96EBDU, 0xFEB2ACA2U,
+      0xBC22AE1BU, 0xD2EFA742U, 0x03A4C0EEU, 0xE6D8E6D6U,
+      0xF2C6738DU, 0x0A166874U, 0x6B303E85U, 0xFB362C23U },
+    { 0x9C4025FDU, 0xD22E1B90U, 0x28BF4E8EU, 0x601BD3CCU,
+      0x90C9E34DU, 0xD64B821AU, 0x4D70BC76U, 0xACB41A54U,
+      0x92C11C81U, 0x8F7F8A86U, 0x44004CA8U, 0x4843171EU,
+      0x14B273D1U, 0x86BA70E6U, 0x7B2E62D5U, 0x57359923U },
+    { 0xAFCC2BEFU, 0xB9E437F4U, 0x3ADA2B53U, 0x4F1FB2D6U,
+      0xBB580C9AU, 0xE6C0E12DU, 0x33C7546DU, 0x25183734U,
+      0xBFD92FB9U, 0xAB12D90FU, 0xA185AE46U, 0x2CB9B9B3U,
+      0x9CE6F49FU, 0x2A0C7A7EU, 0xB48F21F2U, 0x531F307FU },
+};
+
+#endif // P256_COMB_TABLE_H
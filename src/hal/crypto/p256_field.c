@@ -0,0 +1,304 @@
+/**
+ * @file p256_field.c
+ * @brief P-256 Field Arithmetic for Cortex-M33
+ * @author USB Key Authentication Team
+ * @date 2025-09-11
+ * @version 1.0
+ *
+ * UMAAL RdLo, RdHi, Rn, Rm computes RdHi:RdLo = Rn * Rm + RdHi + RdLo,
+ * which never overflows 64 bits. Schoolbook rows therefore need no carry
+ * flags: row i runs lo = r[i + j], hi = carry through UMAAL for every j
+ * and leaves the row's carry in r[i + 8].
+ */
+
+#include "p256_field.h"
+#include <string.h>
+
+#define WORDS           P256_FIELD_WORDS
+
+#if P256_FIELD_UMAAL
+#define UMAAL(lo, hi, a, b) \
+    __asm__("umaal %0, %1, %2, %3" : "+r"(lo), "+r"(hi) : "r"(a), "r"(b))
+#else
+#define UMAAL(lo, hi, a, b)                                             \
+    do {                                                                \
+        uint64_t umaal_acc = (uint64_t)(a) * (b) + (lo) + (hi);         \
+        (lo) = (uint32_t)umaal_acc;                                     \
+        (hi) = (uint32_t)(umaal_acc >> 32);                             \
+    } while (0)
+#endif
+
+/**
+ * @brief Accumulate a[i] * b into product[i .. i + 8]
+ */
+#define MUL_ROW(i)                                                      \
+    do {                                                                \
+        uint32_t ai = a[i];                                             \
+        uint32_t carry = 0;                                             \
+        UMAAL(product[(i) + 0], carry, ai, b0);                         \
+        UMAAL(product[(i) + 1], carry, ai, b1);                         \
+        UMAAL(product[(i) + 2], carry, ai, b2);                         \
+        UMAAL(product[(i) + 3], carry, ai, b3);                         \
+        UMAAL(product[(i) + 4], carry, ai, b4);                         \
+        UMAAL(product[(i) + 5], carry, ai, b5);                         \
+        UMAAL(product[(i) + 6], carry, ai, b6);                         \
+        UMAAL(product[(i) + 7], carry, ai, b7);                         \
+        product[(i) + 8] = carry;                                       \
+    } while (0)
+
+/** @brief 2^256 - p as signed word coefficients: 2^224 - 2^192 - 2^96 + 1 */
+static const int8_t k_fold_coefficients[WORDS] = { 1, 0, 0, -1, 0, 0, -1, 1 };
+
+// =============================================================================
+// Products
+// =============================================================================
+
+void p256_field_mul_wide(uECC_word_t* product, const uECC_word_t* a, const uECC_word_t* b) {
+    const uint32_t b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+    const uint32_t b4 = b[4], b5 = b[5], b6 = b[6], b7 = b[7];
+
+    memset(product, 0, WORDS * sizeof(uECC_word_t));
+    MUL_ROW(0);
+    MUL_ROW(1);
+    MUL_ROW(2);
+    MUL_ROW(3);
+    MUL_ROW(4);
+    MUL_ROW(5);
+    MUL_ROW(6);
+    MUL_ROW(7);
+}
+
+void p256_field_sqr_wide(uECC_word_t* product, const uECC_word_t* a) {
+    const uint32_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+    const uint32_t a4 = a[4], a5 = a[5], a6 = a[6], a7 = a[7];
+    uint32_t carry;
+
+    // Off-diagonal products a[i] * a[j], i < j: 28 UMAALs
+    memset(product, 0, 2 * WORDS * sizeof(uECC_word_t));
+    carry = 0;
+    UMAAL(product[1], carry, a0, a1);
+    UMAAL(product[2], carry, a0, a2);
+    UMAAL(product[3], carry, a0, a3);
+    UMAAL(product[4], carry, a0, a4);
+    UMAAL(product[5], carry, a0, a5);
+    UMAAL(product[6], carry, a0, a6);
+    UMAAL(product[7], carry, a0, a7);
+    product[8] = carry;
+    carry = 0;
+    UMAAL(product[3], carry, a1, a2);
+    UMAAL(product[4], carry, a1, a3);
+    UMAAL(product[5], carry, a1, a4);
+    UMAAL(product[6], carry, a1, a5);
+    UMAAL(product[7], carry, a1, a6);
+    UMAAL(product[8], carry, a1, a7);
+    product[9] = carry;
+    carry = 0;
+    UMAAL(product[5], carry, a2, a3);
+    UMAAL(product[6], carry, a2, a4);
+    UMAAL(product[7], carry, a2, a5);
+    UMAAL(product[8], carry, a2, a6);
+    UMAAL(product[9], carry, a2, a7);
+    product[10] = carry;
+    carry = 0;
+    UMAAL(product[7], carry, a3, a4);
+    UMAAL(product[8], carry, a3, a5);
+    UMAAL(product[9], carry, a3, a6);
+    UMAAL(product[10], carry, a3, a7);
+    product[11] = carry;
+    carry = 0;
+    UMAAL(product[9], carry, a4, a5);
+    UMAAL(product[10], carry, a4, a6);
+    UMAAL(product[11], carry, a4, a7);
+    product[12] = carry;
+    carry = 0;
+    UMAAL(product[11], carry, a5, a6);
+    UMAAL(product[12], carry, a5, a7);
+    product[13] = carry;
+    carry = 0;
+    UMAAL(product[13], carry, a6, a7);
+    product[14] = carry;
+
+    // Double, then add the squares a[i]^2 on the diagonal
+    for (unsigned i = 2 * WORDS - 1; i > 0; i--) {
+        product[i] = (product[i] << 1) | (product[i - 1] >> 31);
+    }
+
+    carry = 0;
+#define SQR_DIAGONAL(i)                                                 \
+    do {                                                                \
+        uint64_t high;                                                  \
+        UMAAL(product[2 * (i)], carry, a##i, a##i);                     \
+        high = (uint64_t)product[2 * (i) + 1] + carry;                  \
+        product[2 * (i) + 1] = (uint32_t)high;                          \
+        carry = (uint32_t)(high >> 32);                                 \
+    } while (0)
+    SQR_DIAGONAL(0);
+    SQR_DIAGONAL(1);
+    SQR_DIAGONAL(2);
+    SQR_DIAGONAL(3);
+    SQR_DIAGONAL(4);
+    SQR_DIAGONAL(5);
+    SQR_DIAGONAL(6);
+    SQR_DIAGONAL(7);
+#undef SQR_DIAGONAL
+}
+
+void p256_field_mul_wide_ref(uECC_word_t* product, const uECC_word_t* a,
+                             const uECC_word_t* b) {
+    memset(product, 0, 2 * WORDS * sizeof(uECC_word_t));
+    for (unsigned i = 0; i < WORDS; i++) {
+        uint64_t carry = 0;
+        for (unsigned j = 0; j < WORDS; j++) {
+            carry += (uint64_t)a[i] * b[j] + product[i + j];
+            product[i + j] = (uint32_t)carry;
+            carry >>= 32;
+        }
+        product[i + WORDS] = (uint32_t)carry;
+    }
+}
+
+// =============================================================================
+// Reduction
+// =============================================================================
+
+/**
+ * @brief Fold value + carry * 2^256 back below 2^256, returns the new carry
+ *
+ * Adds carry * (2^256 - p). For the small carries left by the column sums
+ * the returned carry is -1, 0 or 1, and a second fold returns 0.
+ */
+static int64_t fold_carry(uECC_word_t* r, int64_t carry) {
+    int64_t acc = 0;
+
+    for (unsigned i = 0; i < WORDS; i++) {
+        acc += (int64_t)r[i] + k_fold_coefficients[i] * carry;
+        r[i] = (uint32_t)acc;
+        acc >>= 32;
+    }
+    return acc;
+}
+
+void p256_field_reduce(uECC_word_t* r, const uECC_word_t* product) {
+    // FIPS 186-4 D.2.3: T + 2 S1 + 2 S2 + S3 + S4 - D1 - D2 - D3 - D4,
+    // summed per column so every term enters once
+#define C(i) ((int64_t)product[i])
+    int64_t acc;
+
+    acc = C(0) + C(8) + C(9) - C(11) - C(12) - C(13) - C(14);
+    r[0] = (uint32_t)acc;
+    acc >>= 32;
+    acc += C(1) + C(9) + C(10) - C(12) - C(13) - C(14) - C(15);
+    r[1] = (uint32_t)acc;
+    acc >>= 32;
+    acc += C(2) + C(10) + C(11) - C(13) - C(14) - C(15);
+    r[2] = (uint32_t)acc;
+    acc >>= 32;
+    acc += C(3) + 2 * C(11) + 2 * C(12) + C(13) - C(15) - C(8) - C(9);
+    r[3] = (uint32_t)acc;
+    acc >>= 32;
+    acc += C(4) + 2 * C(12) + 2 * C(13) + C(14) - C(9) - C(10);
+    r[4] = (uint32_t)acc;
+    acc >>= 32;
+    acc += C(5) + 2 * C(13) + 2 * C(14) + C(15) - C(10) - C(11);
+    r[5] = (uint32_t)acc;
+    acc >>= 32;
+    acc += C(6) + 3 * C(14) + 2 * C(15) + C(13) - C(8) - C(9);
+    r[6] = (uint32_t)acc;
+    acc >>= 32;
+    acc += C(7) + 3 * C(15) + C(8) - C(10) - C(11) - C(12) - C(13);
+    r[7] = (uint32_t)acc;
+    acc >>= 32;
+#undef C
+
+    // The column sums leave a small signed carry
+    acc = fold_carry(r, acc);
+    (void)fold_carry(r, acc);
+
+    // Now r < 2^256 < 2p: subtract p once if r >= p
+    const uECC_word_t* p = uECC_secp256r1()->p;
+    uECC_word_t reduced[WORDS];
+    int64_t borrow = 0;
+
+    for (unsigned i = 0; i < WORDS; i++) {
+        borrow += (int64_t)r[i] - p[i];
+        reduced[i] = (uint32_t)borrow;
+        borrow >>= 32;
+    }
+
+    uECC_word_t keep = (uECC_word_t)borrow;     // all-ones if r < p
+    for (unsigned i = 0; i < WORDS; i++) {
+        r[i] = (r[i] & keep) | (reduced[i] & ~keep);
+    }
+}
+
+// =============================================================================
+// Field operations
+// =============================================================================
+
+void p256_field_mul(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b) {
+    uECC_word_t product[2 * WORDS];
+
+    p256_field_mul_wide(product, a, b);
+    p256_field_reduce(r, product);
+}
+
+void p256_field_sqr(uECC_word_t* r, const uECC_word_t* a) {
+    uECC_word_t product[2 * WORDS];
+
+    p256_field_sqr_wide(product, a);
+    p256_field_reduce(r, product);
+}
+
+// =============================================================================
+// tinycrypt curve
+// =============================================================================
+
+/**
+ * @brief mmod_fast hook: tinycrypt passes the product non-const
+ */
+static void curve_mmod_fast(uECC_word_t* r, uECC_word_t* product) {
+    p256_field_reduce(r, product);
+}
+
+/** @brief secp256r1 as in <tinycrypt/ecc.h>, reducing through this layer */
+static const struct uECC_Curve_t k_field_curve = {
+    .num_words = NUM_ECC_WORDS,
+    .num_bytes = NUM_ECC_BYTES,
+    .num_n_bits = 256,
+    .p = {
+        BYTES_TO_WORDS_8(FF, FF, FF, FF, FF, FF, FF, FF),
+        BYTES_TO_WORDS_8(FF, FF, FF, FF, 00, 00, 00, 00),
+        BYTES_TO_WORDS_8(00, 00, 00, 00, 00, 00, 00, 00),
+        BYTES_TO_WORDS_8(01, 00, 00, 00, FF, FF, FF, FF)
+    },
+    .n = {
+        BYTES_TO_WORDS_8(51, 25, 63, FC, C2, CA, B9, F3),
+        BYTES_TO_WORDS_8(84, 9E, 17, A7, AD, FA, E6, BC),
+        BYTES_TO_WORDS_8(FF, FF, FF, FF, FF, FF, FF, FF),
+        BYTES_TO_WORDS_8(00, 00, 00, 00, FF, FF, FF, FF)
+    },
+    .G = {
+        BYTES_TO_WORDS_8(96, C2, 98, D8, 45, 39, A1, F4),
+        BYTES_TO_WORDS_8(A0, 33, EB, 2D, 81, 7D, 03, 77),
+        BYTES_TO_WORDS_8(F2, 40, A4, 63, E5, E6, BC, F8),
+        BYTES_TO_WORDS_8(47, 42, 2C, E1, F2, D1, 17, 6B),
+
+        BYTES_TO_WORDS_8(F5, 51, BF, 37, 68, 40, B6, CB),
+        BYTES_TO_WORDS_8(CE, 5E, 31, 6B, 57, 33, CE, 2B),
+        BYTES_TO_WORDS_8(16, 9E, 0F, 7C, 4A, EB, E7, 8E),
+        BYTES_TO_WORDS_8(9B, 7F, 1A, FE, E2, 42, E3, 4F)
+    },
+    .b = {
+        BYTES_TO_WORDS_8(4B, 60, D2, 27, 3E, 3C, CE, 3B),
+        BYTES_TO_WORDS_8(F6, B0, 53, CC, B0, 06, 1D, 65),
+        BYTES_TO_WORDS_8(BC, 86, 98, 76, 55, BD, EB, B3),
+        BYTES_TO_WORDS_8(E7, 93, 3A, AA, D8, 35, C6, 5A)
+    },
+    .double_jacobian = &double_jacobian_default,
+    .x_side = &x_side_default,
+    .mmod_fast = &curve_mmod_fast,
+};
+
+uECC_Curve p256_field_curve(void) {
+    return &k_field_curve;
+}
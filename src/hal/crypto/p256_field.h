@@ -0,0 +1,118 @@
+#ifndef P256_FIELD_H
+#define P256_FIELD_H
+
+/**
+ * @file p256_field.h
+ * @brief P-256 Field Arithmetic for Cortex-M33
+ * @author USB Key Authentication Team
+ * @date 2025-09-11
+ * @version 1.0
+ *
+ * Multiplication, squaring and reduction modulo the P-256 prime on fully
+ * unrolled 8-word operands, used by the comb (p256_comb.c) for key
+ * generation and signing in place of tinycrypt's uECC_vli_* word loops.
+ * p256_field_curve() hands the reduction to tinycrypt itself, so ECDH,
+ * verification and public key checks run on it too.
+ *
+ * The 256x256-bit products are a fixed UMAAL schedule. With the DSP
+ * extension (MCXA156 builds with CONFIG_DSP) every step is one UMAAL
+ * instruction; elsewhere the same schedule runs on a C model of UMAAL, so
+ * the host executes exactly the sequence the target does.
+ * p256_field_mul_wide_ref() is an independent plain C product and
+ * p256_field_check.c compares the two, and both against tinycrypt.
+ *
+ * Reduction is the NIST fast reduction with signed column sums and a
+ * masked final subtraction. No function branches on or indexes by operand
+ * values.
+ *
+ * Integers use tinycrypt's native layout (little-endian 32-bit words).
+ */
+
+#include <tinycrypt/ecc.h>
+
+/**
+ * @brief Use the UMAAL instruction for products
+ *
+ * Defaults to 1 on cores with the DSP extension. Set to 0 to run the C
+ * model of the schedule on the target as well.
+ */
+#ifndef P256_FIELD_UMAAL
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define P256_FIELD_UMAAL        1
+#else
+#define P256_FIELD_UMAAL        0
+#endif
+#endif
+
+/** @brief Words in a field element */
+#define P256_FIELD_WORDS        NUM_ECC_WORDS
+
+/**
+ * @brief r = a * b mod p
+ *
+ * @param r Result, fully reduced (may alias a or b)
+ * @param a First factor, any 256-bit value
+ * @param b Second factor, any 256-bit value
+ */
+void p256_field_mul(uECC_word_t* r, const uECC_word_t* a, const uECC_word_t* b);
+
+/**
+ * @brief r = a^2 mod p
+ *
+ * @param r Result, fully reduced (may alias a)
+ * @param a Any 256-bit value
+ */
+void p256_field_sqr(uECC_word_t* r, const uECC_word_t* a);
+
+/**
+ * @brief r = product mod p
+ *
+ * Drop-in for tinycrypt's mmod_fast curve hook.
+ *
+ * @param r Result, fully reduced
+ * @param product Any 512-bit value (2 * P256_FIELD_WORDS words)
+ */
+void p256_field_reduce(uECC_word_t* r, const uECC_word_t* product);
+
+/**
+ * @brief 512-bit product a * b through the UMAAL schedule
+ *
+ * @param product Result (2 * P256_FIELD_WORDS words, must not alias a or b)
+ * @param a First factor
+ * @param b Second factor
+ */
+void p256_field_mul_wide(uECC_word_t* product, const uECC_word_t* a, const uECC_word_t* b);
+
+/**
+ * @brief 512-bit square a^2 through the UMAAL schedule
+ *
+ * @param product Result (2 * P256_FIELD_WORDS words, must not alias a)
+ * @param a Factor
+ */
+void p256_field_sqr_wide(uECC_word_t* product, const uECC_word_t* a);
+
+/**
+ * @brief Reference 512-bit product in portable C
+ *
+ * Plain schoolbook loops on 64-bit intermediates, kept deliberately
+ * different from the UMAAL schedule for differential checking.
+ *
+ * @param product Result (2 * P256_FIELD_WORDS words, must not alias a or b)
+ * @param a First factor
+ * @param b Second factor
+ */
+void p256_field_mul_wide_ref(uECC_word_t* product, const uECC_word_t* a,
+                             const uECC_word_t* b);
+
+/**
+ * @brief secp256r1 with p256_field_reduce() as its mmod_fast hook
+ *
+ * Same parameters as uECC_secp256r1(); pass it to tinycrypt's curve
+ * functions (uECC_shared_secret(), uECC_verify(), ...) so every modular
+ * product they compute is reduced by this layer.
+ *
+ * @return Curve in const storage
+ */
+uECC_Curve p256_field_curve(void);
+
+#endif // P256_FIELD_H
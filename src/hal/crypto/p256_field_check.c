@@ -0,0 +1,271 @@
+/**
+ * @file p256_field_check.c
+ * @brief Differential Check of the P-256 Field Layer
+ * @author USB Key Authentication Team
+ * @date 2025-09-11
+ * @version 1.0
+ *
+ * On MCXA156 call p256_field_check_run() from a debug command to validate
+ * the UMAAL build on the real core. On Linux the file builds as a program
+ * that runs the C model of the same UMAAL schedule. From the repository
+ * root:
+ * @code
+ * TC=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/mcuboot_opensource/ext/tinycrypt/lib
+ * gcc -std=c11 -O2 -I src -I $TC/include \
+ *     src/hal/crypto/p256_field_check.c src/hal/crypto/p256_field.c \
+ *     src/platform/time/cycle_counter.c $TC/source/ecc.c \
+ *     $TC/source/ecc_platform_specific.c -o p256_field_check
+ * ./p256_field_check [-i iterations]
+ * @endcode
+ *
+ * The UMAAL instructions themselves can be run on Linux under user-mode
+ * QEMU: build the same command with arm-linux-gnueabihf-gcc -static
+ * -march=armv7-a -mthumb (ARMv7-A defines __ARM_FEATURE_DSP and has
+ * UMAAL), then run the program with qemu-arm.
+ *
+ * The host program exits non-zero on any mismatch.
+ */
+
+#include "p256_field_check.h"
+#include "p256_field.h"
+#include "platform/time/cycle_counter.h"
+#include <stdio.h>
+#include <string.h>
+
+#define WORDS               P256_FIELD_WORDS
+
+/** @brief Operand pairs timed per implementation */
+#define CHECK_TIMED_MULS    1000U
+
+/** @brief Operand pairs per point multiplication checked on the curve */
+#define CHECK_POINT_RATIO   1000U
+
+/** @brief Fixed xorshift seed, so host and target check the same operands */
+#define CHECK_SEED          0x2545F491U
+
+/** @brief Edge-case operands, little-endian words */
+static const uECC_word_t k_edge_operands[][WORDS] = {
+    { 0, 0, 0, 0, 0, 0, 0, 0 },
+    { 1, 0, 0, 0, 0, 0, 0, 0 },
+    { 0xFFFFFFFEU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0, 0, 0, 1, 0xFFFFFFFFU },     // p - 1
+    { 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0, 0, 0, 1, 0xFFFFFFFFU },     // p
+    { 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU,
+      0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU },                 // 2^256 - 1
+    { 0, 0, 0, 0, 0, 0, 0, 0x80000000U },                                   // 2^255
+    { 0, 0, 0, 0, 0, 0, 0, 1 },                                             // 2^224
+    { 0xFFFFFFFFU, 0, 0xFFFFFFFFU, 0, 0xFFFFFFFFU, 0, 0xFFFFFFFFU, 0 },
+    { 0, 0xFFFFFFFFU, 0, 0xFFFFFFFFU, 0, 0xFFFFFFFFU, 0, 0xFFFFFFFFU },
+};
+
+#define EDGE_OPERAND_COUNT  (sizeof(k_edge_operands) / sizeof(k_edge_operands[0]))
+
+static uint32_t g_check_state;
+
+/**
+ * @brief xorshift32, reproducible operands (not for key material)
+ */
+static uint32_t check_random(void) {
+    g_check_state ^= g_check_state << 13;
+    g_check_state ^= g_check_state >> 17;
+    g_check_state ^= g_check_state << 5;
+    return g_check_state;
+}
+
+static void random_words(uECC_word_t* x, unsigned count) {
+    for (unsigned i = 0; i < count; i++) {
+        x[i] = check_random();
+    }
+}
+
+/**
+ * @brief Print a mismatch with its operands
+ */
+static void report(const char* what, const uECC_word_t* a, const uECC_word_t* b) {
+    printf("[P256_FIELD] %s mismatch\n  a =", what);
+    for (unsigned i = WORDS; i-- > 0;) {
+        printf(" %08lx", (unsigned long)a[i]);
+    }
+    printf("\n  b =");
+    for (unsigned i = WORDS; i-- > 0;) {
+        printf(" %08lx", (unsigned long)b[i]);
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Check one operand pair, returns the number of mismatches
+ */
+static uint32_t check_pair(const uECC_word_t* a, const uECC_word_t* b) {
+    const uECC_word_t* p = uECC_secp256r1()->p;
+    uECC_word_t product[2 * WORDS], expected_product[2 * WORDS];
+    uECC_word_t r[WORDS], expected[WORDS];
+    uint32_t mismatches = 0;
+
+    p256_field_mul_wide_ref(expected_product, a, b);
+    p256_field_mul_wide(product, a, b);
+    if (memcmp(product, expected_product, sizeof(product)) != 0) {
+        report("mul_wide", a, b);
+        mismatches++;
+    }
+
+    p256_field_reduce(r, expected_product);
+    uECC_vli_mmod(expected, expected_product, p, WORDS);
+    if (memcmp(r, expected, sizeof(r)) != 0) {
+        report("reduce", a, b);
+        mismatches++;
+    }
+
+    p256_field_mul(r, a, b);
+    if (memcmp(r, expected, sizeof(r)) != 0) {
+        report("mul", a, b);
+        mismatches++;
+    }
+
+    p256_field_mul_wide_ref(expected_product, a, a);
+    p256_field_sqr_wide(product, a);
+    if (memcmp(product, expected_product, sizeof(product)) != 0) {
+        report("sqr_wide", a, a);
+        mismatches++;
+    }
+
+    uECC_vli_modMult(expected, a, a, p, WORDS);
+    p256_field_sqr(r, a);
+    if (memcmp(r, expected, sizeof(r)) != 0) {
+        report("sqr", a, a);
+        mismatches++;
+    }
+
+    return mismatches;
+}
+
+/**
+ * @brief Public keys on p256_field_curve() against uECC_secp256r1()
+ *
+ * k*P runs the ladder that ECDH runs, so every double_jacobian and
+ * modMult_fast goes through the field layer. Returns the mismatches.
+ */
+static uint32_t check_curve(uint32_t points) {
+    uECC_Curve field = p256_field_curve();
+    uECC_Curve reference = uECC_secp256r1();
+    uint8_t scalar[NUM_ECC_BYTES];
+    uint8_t point[2 * NUM_ECC_BYTES], expected[2 * NUM_ECC_BYTES];
+    uint32_t mismatches = 0;
+
+    if (memcmp(field->p, reference->p, sizeof(field->p)) != 0 ||
+        memcmp(field->n, reference->n, sizeof(field->n)) != 0 ||
+        memcmp(field->G, reference->G, sizeof(field->G)) != 0 ||
+        memcmp(field->b, reference->b, sizeof(field->b)) != 0) {
+        printf("[P256_FIELD] curve parameters differ from uECC_secp256r1()\n");
+        mismatches++;
+    }
+
+    for (uint32_t i = 0; i < points; i++) {
+        uECC_word_t words[WORDS];
+
+        random_words(words, WORDS);
+        words[WORDS - 1] &= 0x7FFFFFFFU;
+        uECC_vli_nativeToBytes(scalar, NUM_ECC_BYTES, words);
+
+        int ok = uECC_compute_public_key(scalar, point, field);
+        int expected_ok = uECC_compute_public_key(scalar, expected, reference);
+        if (ok != expected_ok || memcmp(point, expected, sizeof(point)) != 0 ||
+            (ok && uECC_valid_public_key(point, field) != 0)) {
+            report("k*G on p256_field_curve()", words, words);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Average cycles of one field multiplication
+ */
+static uint32_t time_muls(bool tinycrypt) {
+    uECC_word_t a[WORDS], b[WORDS];
+
+    // Reduced operands: uECC_vli_modMult_fast() requires inputs below p
+    random_words(a, WORDS);
+    random_words(b, WORDS);
+    a[WORDS - 1] &= 0x7FFFFFFFU;
+    b[WORDS - 1] &= 0x7FFFFFFFU;
+
+    uint32_t start = cycle_counter_read();
+    for (uint32_t i = 0; i < CHECK_TIMED_MULS; i++) {
+        if (tinycrypt) {
+            uECC_vli_modMult_fast(a, a, b, uECC_secp256r1());
+        } else {
+            p256_field_mul(a, a, b);
+        }
+    }
+    return (cycle_counter_read() - start) / CHECK_TIMED_MULS;
+}
+
+hal_result_t p256_field_check_run(uint32_t iterations, p256_field_check_result_t* result) {
+    p256_field_check_result_t summary = {0};
+    uECC_word_t a[WORDS], b[WORDS];
+    uECC_word_t wide[2 * WORDS];
+
+    (void)cycle_counter_init();
+    g_check_state = CHECK_SEED;
+
+    for (unsigned i = 0; i < EDGE_OPERAND_COUNT; i++) {
+        for (unsigned j = 0; j < EDGE_OPERAND_COUNT; j++) {
+            summary.mismatches += check_pair(k_edge_operands[i], k_edge_operands[j]);
+            summary.vectors++;
+        }
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        random_words(a, WORDS);
+        random_words(b, WORDS);
+        summary.mismatches += check_pair(a, b);
+        summary.vectors++;
+
+        // Reduction must also handle 512-bit values that are not products
+        uECC_word_t r[WORDS], expected[WORDS];
+        random_words(wide, 2 * WORDS);
+        p256_field_reduce(r, wide);
+        uECC_vli_mmod(expected, wide, uECC_secp256r1()->p, WORDS);
+        if (memcmp(r, expected, sizeof(r)) != 0) {
+            report("reduce (512-bit)", wide, wide + WORDS);
+            summary.mismatches++;
+        }
+    }
+
+    summary.points = iterations / CHECK_POINT_RATIO + 1U;
+    summary.mismatches += check_curve(summary.points);
+
+    summary.field_mul_cycles = time_muls(false);
+    summary.tinycrypt_mul_cycles = time_muls(true);
+
+    printf("[P256_FIELD] %s products, %lu operand pairs, %lu points, %lu mismatches\n",
+           P256_FIELD_UMAAL ? "UMAAL" : "C model", (unsigned long)summary.vectors,
+           (unsigned long)summary.points, (unsigned long)summary.mismatches);
+    printf("field mul: %lu cycles, tinycrypt modMult_fast: %lu cycles (%lu cycles/s)\n",
+           (unsigned long)summary.field_mul_cycles, (unsigned long)summary.tinycrypt_mul_cycles,
+           (unsigned long)cycle_counter_get_hz());
+
+    if (result) {
+        *result = summary;
+    }
+    return summary.mismatches == 0 ? HAL_SUCCESS : HAL_ERROR_HARDWARE_FAILURE;
+}
+
+#if !defined(MCXA156_SERIES)
+#include <stdlib.h>
+
+int main(int argc, char** argv) {
+    uint32_t iterations = 100000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            iterations = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-i iterations]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    return p256_field_check_run(iterations, NULL) == HAL_SUCCESS ? 0 : 1;
+}
+#endif
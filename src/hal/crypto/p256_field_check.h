@@ -0,0 +1,46 @@
+#ifndef P256_FIELD_CHECK_H
+#define P256_FIELD_CHECK_H
+
+/**
+ * @file p256_field_check.h
+ * @brief Differential Check of the P-256 Field Layer
+ * @author USB Key Authentication Team
+ * @date 2025-09-11
+ * @version 1.0
+ *
+ * Compares p256_field.h against its plain C reference product and against
+ * tinycrypt's generic uECC_vli_mmod()/uECC_vli_modMult() on edge-case and
+ * pseudo-random operands, checks public keys computed on p256_field_curve()
+ * against uECC_secp256r1(), then times a field multiplication against
+ * tinycrypt's uECC_vli_modMult_fast(). On MCXA156 this exercises the UMAAL
+ * build; on Linux the same file builds as a program (see p256_field_check.c).
+ */
+
+#include "hal/interface/hal_common.h"
+
+/**
+ * @brief Check summary
+ */
+typedef struct {
+    uint32_t vectors;               /**< Operand pairs checked */
+    uint32_t points;                /**< Point multiplications checked */
+    uint32_t mismatches;            /**< Results that differ from a reference */
+    uint32_t field_mul_cycles;      /**< p256_field_mul() average */
+    uint32_t tinycrypt_mul_cycles;  /**< uECC_vli_modMult_fast() average */
+} p256_field_check_result_t;
+
+/**
+ * @brief Run the differential check
+ *
+ * Checks every pair of edge-case operands (0, 1, p - 1, p, 2^256 - 1, ...)
+ * followed by iterations pseudo-random pairs from a fixed seed, so runs
+ * are reproducible across host and target.
+ *
+ * @param iterations Random operand pairs to check
+ * @param result Output summary, may be NULL
+ * @return HAL_SUCCESS if every result matched
+ * @retval HAL_ERROR_HARDWARE_FAILURE At least one mismatch (each is printed)
+ */
+hal_result_t p256_field_check_run(uint32_t iterations, p256_field_check_result_t* result);
+
+#endif // P256_FIELD_CHECK_H
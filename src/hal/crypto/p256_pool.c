@@ -0,0 +1,249 @@
+/**
+ * @file p256_pool.c
+ * @brief Pool of Precomputed P-256 Signing Nonces and Ephemeral Keys
+ * @author USB Key Authentication Team
+ * @date 2025-09-13
+ * @version 1.0
+ *
+ * A slot is EMPTY, FILLING while p256_pool_fill() computes into it outside
+ * the lock, or READY. Only the filler moves a slot out of FILLING, so the
+ * computation never races a taker, and a generation counter bumped by
+ * p256_pool_clear() makes a fill that straddles a clear throw its result
+ * away.
+ */
+
+#include "p256_pool.h"
+#include "crypto_util.h"
+#include <string.h>
+
+#if defined(MCXA156_SERIES)
+#include "fsl_common.h"
+/** @brief Guard slot state shared by the filling and consuming tasks */
+#define POOL_CRITICAL_ENTER()   uint32_t pool_irq_state = DisableGlobalIRQ()
+#define POOL_CRITICAL_EXIT()    EnableGlobalIRQ(pool_irq_state)
+#else
+#define POOL_CRITICAL_ENTER()   do { } while (0)
+#define POOL_CRITICAL_EXIT()    do { } while (0)
+#endif
+
+/**
+ * @brief Slot states
+ */
+enum {
+    SLOT_EMPTY = 0,
+    SLOT_FILLING,
+    SLOT_READY,
+};
+
+/**
+ * @brief Precomputed signature nonce
+ */
+typedef struct {
+    p256_presign_t presign;                 /**< r and 1/k */
+    uint8_t state;                          /**< SLOT_* */
+} presign_slot_t;
+
+/**
+ * @brief Precomputed ephemeral key pair
+ */
+typedef struct {
+    uint8_t public_key[2 * NUM_ECC_BYTES];  /**< X||Y big-endian */
+    uint8_t private_key[NUM_ECC_BYTES];     /**< Scalar big-endian */
+    uint8_t state;                          /**< SLOT_* */
+} key_pair_slot_t;
+
+/**
+ * @brief Pool state
+ */
+typedef struct {
+    presign_slot_t signatures[P256_POOL_SIGNATURES];    /**< Nonces */
+    key_pair_slot_t key_pairs[P256_POOL_KEY_PAIRS];     /**< Key pairs */
+    uint32_t generation;                    /**< Bumped by p256_pool_clear() */
+    p256_pool_stats_t stats;                /**< Hit/miss counters */
+} pool_state_t;
+
+/** @brief Global pool */
+static pool_state_t g_pool = {0};
+
+/**
+ * @brief Count slots in a state (caller holds the lock)
+ */
+static uint32_t count_signatures(uint8_t state) {
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < P256_POOL_SIGNATURES; i++) {
+        count += (g_pool.signatures[i].state == state) ? 1U : 0U;
+    }
+    return count;
+}
+
+/**
+ * @brief Count slots in a state (caller holds the lock)
+ */
+static uint32_t count_key_pairs(uint8_t state) {
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < P256_POOL_KEY_PAIRS; i++) {
+        count += (g_pool.key_pairs[i].state == state) ? 1U : 0U;
+    }
+    return count;
+}
+
+/**
+ * @brief Index of the first empty slot, or count if there is none
+ */
+static uint32_t first_empty_signature(void) {
+    uint32_t i = 0;
+
+    while (i < P256_POOL_SIGNATURES && g_pool.signatures[i].state != SLOT_EMPTY) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Index of the first empty slot, or count if there is none
+ */
+static uint32_t first_empty_key_pair(void) {
+    uint32_t i = 0;
+
+    while (i < P256_POOL_KEY_PAIRS && g_pool.key_pairs[i].state != SLOT_EMPTY) {
+        i++;
+    }
+    return i;
+}
+
+bool p256_pool_fill(void) {
+    presign_slot_t* signature = NULL;
+    key_pair_slot_t* key_pair = NULL;
+    uint32_t generation;
+
+    POOL_CRITICAL_ENTER();
+    uint32_t free_signature = first_empty_signature();
+    uint32_t free_key_pair = first_empty_key_pair();
+
+    // One key pair first (clientPIN needs it once per session), then nonces
+    if (free_key_pair < P256_POOL_KEY_PAIRS &&
+        (count_key_pairs(SLOT_READY) == 0 || free_signature == P256_POOL_SIGNATURES)) {
+        key_pair = &g_pool.key_pairs[free_key_pair];
+        key_pair->state = SLOT_FILLING;
+    } else if (free_signature < P256_POOL_SIGNATURES) {
+        signature = &g_pool.signatures[free_signature];
+        signature->state = SLOT_FILLING;
+    }
+    generation = g_pool.generation;
+    POOL_CRITICAL_EXIT();
+
+    if (!signature && !key_pair) {
+        return false;
+    }
+
+    // Slow part, preemptible: the slot is ours while FILLING
+    bool ok = signature ? p256_comb_presign(&signature->presign) != 0
+                        : p256_comb_make_key(key_pair->public_key, key_pair->private_key) != 0;
+
+    POOL_CRITICAL_ENTER();
+    if (ok && generation == g_pool.generation) {
+        if (signature) {
+            signature->state = SLOT_READY;
+        } else {
+            key_pair->state = SLOT_READY;
+        }
+    } else {
+        ok = false;
+        if (signature) {
+            crypto_secure_zero(signature, sizeof(*signature));
+        } else {
+            crypto_secure_zero(key_pair, sizeof(*key_pair));
+        }
+    }
+    POOL_CRITICAL_EXIT();
+
+    return ok;
+}
+
+bool p256_pool_take_presign(p256_presign_t* presign) {
+    bool found = false;
+
+    if (!presign) {
+        return false;
+    }
+
+    POOL_CRITICAL_ENTER();
+    for (uint32_t i = 0; i < P256_POOL_SIGNATURES; i++) {
+        presign_slot_t* slot = &g_pool.signatures[i];
+
+        if (slot->state == SLOT_READY) {
+            *presign = slot->presign;
+            crypto_secure_zero(slot, sizeof(*slot));
+            found = true;
+            break;
+        }
+    }
+    if (found) {
+        g_pool.stats.signature_hits++;
+    } else {
+        g_pool.stats.signature_misses++;
+    }
+    POOL_CRITICAL_EXIT();
+
+    return found;
+}
+
+bool p256_pool_take_key_pair(uint8_t* public_key, uint8_t* private_key) {
+    bool found = false;
+
+    if (!public_key || !private_key) {
+        return false;
+    }
+
+    POOL_CRITICAL_ENTER();
+    for (uint32_t i = 0; i < P256_POOL_KEY_PAIRS; i++) {
+        key_pair_slot_t* slot = &g_pool.key_pairs[i];
+
+        if (slot->state == SLOT_READY) {
+            memcpy(public_key, slot->public_key, sizeof(slot->public_key));
+            memcpy(private_key, slot->private_key, sizeof(slot->private_key));
+            crypto_secure_zero(slot, sizeof(*slot));
+            found = true;
+            break;
+        }
+    }
+    if (found) {
+        g_pool.stats.key_pair_hits++;
+    } else {
+        g_pool.stats.key_pair_misses++;
+    }
+    POOL_CRITICAL_EXIT();
+
+    return found;
+}
+
+void p256_pool_clear(void) {
+    POOL_CRITICAL_ENTER();
+    for (uint32_t i = 0; i < P256_POOL_SIGNATURES; i++) {
+        if (g_pool.signatures[i].state == SLOT_READY) {
+            crypto_secure_zero(&g_pool.signatures[i], sizeof(g_pool.signatures[i]));
+        }
+    }
+    for (uint32_t i = 0; i < P256_POOL_KEY_PAIRS; i++) {
+        if (g_pool.key_pairs[i].state == SLOT_READY) {
+            crypto_secure_zero(&g_pool.key_pairs[i], sizeof(g_pool.key_pairs[i]));
+        }
+    }
+    g_pool.generation++;
+    memset(&g_pool.stats, 0, sizeof(g_pool.stats));
+    POOL_CRITICAL_EXIT();
+}
+
+void p256_pool_get_stats(p256_pool_stats_t* stats) {
+    if (!stats) {
+        return;
+    }
+
+    POOL_CRITICAL_ENTER();
+    *stats = g_pool.stats;
+    stats->signatures_ready = count_signatures(SLOT_READY);
+    stats->key_pairs_ready = count_key_pairs(SLOT_READY);
+    POOL_CRITICAL_EXIT();
+}
@@ -0,0 +1,93 @@
+#ifndef P256_POOL_H
+#define P256_POOL_H
+
+/**
+ * @file p256_pool.h
+ * @brief Pool of Precomputed P-256 Signing Nonces and Ephemeral Keys
+ * @author USB Key Authentication Team
+ * @date 2025-09-13
+ * @version 1.0
+ *
+ * The expensive half of an ECDSA signature (k*G and 1/k) and a whole
+ * ephemeral key pair for clientPIN key agreement depend on nothing but the
+ * RNG, so they can be computed while the key waits for USB traffic. This
+ * pool keeps a few of each in static RAM. p256_pool_fill() adds one entry
+ * and is called from idle time; the request path takes entries and falls
+ * back to computing them when the pool is empty.
+ *
+ * Every entry is handed out once: taking copies it to the caller and wipes
+ * the slot under the same lock. Filling and taking may run on different
+ * tasks; on MCXA156 the slot bookkeeping uses a FreeRTOS critical section
+ * and the computation itself runs outside it.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "p256_comb.h"
+
+/** @brief Precomputed signature nonces */
+#ifndef P256_POOL_SIGNATURES
+#define P256_POOL_SIGNATURES        4U
+#endif
+
+/** @brief Precomputed ephemeral key pairs */
+#ifndef P256_POOL_KEY_PAIRS
+#define P256_POOL_KEY_PAIRS         2U
+#endif
+
+/**
+ * @brief Pool counters
+ */
+typedef struct {
+    uint32_t signatures_ready;      /**< Nonces waiting to be used */
+    uint32_t key_pairs_ready;       /**< Key pairs waiting to be used */
+    uint32_t signature_hits;        /**< Nonces taken from the pool */
+    uint32_t signature_misses;      /**< Nonce requests that found it empty */
+    uint32_t key_pair_hits;         /**< Key pairs taken from the pool */
+    uint32_t key_pair_misses;       /**< Key pair requests that found it empty */
+} p256_pool_stats_t;
+
+/**
+ * @brief Compute one missing entry
+ *
+ * Refills a key pair first when none is ready, then nonces, then the
+ * remaining key pairs. Uses tinycrypt's RNG (uECC_get_rng()).
+ *
+ * @return true if an entry was added, false if the pool is full or the
+ *         computation failed
+ */
+bool p256_pool_fill(void);
+
+/**
+ * @brief Take a precomputed nonce
+ *
+ * @param presign Output r and 1/k for p256_comb_sign_presigned()
+ * @return true on success, false if none is ready
+ */
+bool p256_pool_take_presign(p256_presign_t* presign);
+
+/**
+ * @brief Take a precomputed key pair
+ *
+ * @param public_key Output public key, 64 bytes X||Y big-endian
+ * @param private_key Output private key, 32 bytes big-endian
+ * @return true on success, false if none is ready
+ */
+bool p256_pool_take_key_pair(uint8_t* public_key, uint8_t* private_key);
+
+/**
+ * @brief Wipe every entry
+ *
+ * Entries being computed when this is called are discarded when they
+ * complete.
+ */
+void p256_pool_clear(void);
+
+/**
+ * @brief Read the pool counters
+ *
+ * @param stats Output counters
+ */
+void p256_pool_get_stats(p256_pool_stats_t* stats);
+
+#endif // P256_POOL_H
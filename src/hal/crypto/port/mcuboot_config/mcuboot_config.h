@@ -0,0 +1,18 @@
+#ifndef MCUBOOT_CONFIG_PORT_H
+#define MCUBOOT_CONFIG_PORT_H
+
+/**
+ * @file mcuboot_config.h
+ * @brief mcuboot Configuration for the Vendored fiat Curve25519
+ * @author USB Key Authentication Team
+ * @date 2025-09-12
+ * @version 1.0
+ *
+ * ext/fiat/src/curve25519.c includes <mcuboot_config/mcuboot_config.h> to
+ * choose between mbed TLS and tinycrypt SHA-512. The application is not
+ * built with mcuboot, so this stand-in leaves MCUBOOT_USE_MBED_TLS
+ * undefined and the file uses tinycrypt-sha512. Only on the include path
+ * of ed25519.c's dependencies.
+ */
+
+#endif // MCUBOOT_CONFIG_PORT_H
@@ -0,0 +1,118 @@
+/**
+ * @file rng_gate_check.c
+ * @brief Host Check that an Uncredited RNG Fails Closed
+ * @author USB Key Authentication Team
+ * @date 2025-09-15
+ * @version 1.0
+ *
+ * Builds the backend with TINYCRYPT_HOST_SEED_BITS=0, so the host seed is
+ * credited like one from an ADC that failed its health test, and checks
+ * that every operation needing fresh randomness returns an error instead
+ * of drawing from that seed: P-256 sign (the non-resident GetAssertion
+ * path, with an imported key and an empty nonce pool), encrypt, key
+ * wrapping, key generation and generate_random. Then feeds add_entropy()
+ * constant bytes and checks that they are not credited.
+ *
+ * Linux only. From the repository root:
+ * @code
+ * EXT=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/mcuboot_opensource/ext
+ * gcc -std=c11 -O2 -DTINYCRYPT_HOST_SEED_BITS=0 -I src -I src/hal/crypto/port \
+ *     -I $EXT/tinycrypt/lib/include -I $EXT/tinycrypt-sha512/lib/include -I $EXT/fiat/src \
+ *     src/hal/crypto/rng_gate_check.c src/hal/crypto/tinycrypt_crypto_hal.c \
+ *     src/hal/crypto/p256_comb.c src/hal/crypto/p256_field.c src/hal/crypto/p256_pool.c \
+ *     src/hal/crypto/key_slot.c src/hal/crypto/lpadc_entropy.c src/hal/crypto/ed25519.c \
+ *     src/hal/crypto/sha2.c src/hal/crypto/crypto_util.c \
+ *     src/platform/time/cycle_counter.c \
+ *     $EXT/tinycrypt/lib/source/[a-z]*.c $EXT/tinycrypt-sha512/lib/source/sha512.c \
+ *     $EXT/fiat/src/curve25519.c -o rng_gate_check
+ * ./rng_gate_check
+ * @endcode
+ * Exits non-zero if any operation succeeds that should have failed, or
+ * the other way round.
+ */
+
+#include "tinycrypt_crypto_hal.h"
+#include <stdio.h>
+#include <string.h>
+
+/** @brief Any valid P-256 scalar: RFC 6979 A.2.5 test key */
+static const uint8_t k_p256_private[TINYCRYPT_P256_PRIVATE_KEY_SIZE] = {
+    0xC9, 0xAF, 0xA9, 0xD8, 0x45, 0xBA, 0x75, 0x16, 0x6B, 0x5C, 0x21, 0x57, 0x67, 0xB1, 0xD6, 0x93,
+    0x4E, 0x50, 0xC3, 0xDB, 0x36, 0xE8, 0x9B, 0x12, 0x7B, 0x8A, 0x62, 0x2B, 0x12, 0x0F, 0x67, 0x21,
+};
+
+static uint32_t g_failures;
+
+/**
+ * @brief Compare one result with the expected one and report a mismatch
+ */
+static void expect(const char* what, hal_result_t result, hal_result_t expected) {
+    if (result != expected) {
+        printf("[RNG_GATE] %s: %d, expected %d\n", what, result, expected);
+        g_failures++;
+    }
+}
+
+int main(void) {
+    const crypto_hal_t* crypto = &tinycrypt_crypto_hal;
+    uint8_t aes_key[16] = { 0 };
+    uint8_t message[32] = { 0 };
+    uint8_t output[128];
+    size_t length;
+    uint32_t bits = 1;
+    crypto_key_t p256 = { 0 };
+    crypto_key_t aes = { 0 };
+    crypto_key_t public_key = { 0 };
+    crypto_key_t private_key = { 0 };
+
+    expect("init", crypto->base.init(), HAL_SUCCESS);
+    expect("get_entropy_estimate", crypto->rng.get_entropy_estimate(&bits), HAL_SUCCESS);
+    if (bits != 0) {
+        printf("[RNG_GATE] host seed credited %u bits, build with -DTINYCRYPT_HOST_SEED_BITS=0\n",
+               (unsigned)bits);
+        return 1;
+    }
+
+    expect("generate_random", crypto->rng.generate_random(output, 16), HAL_ERROR_INVALID_STATE);
+    expect("generate_key_pair",
+           crypto->generate_key_pair(CRYPTO_ALG_ECC_P256, &public_key, &private_key),
+           HAL_ERROR_INVALID_STATE);
+
+    // Keys still arrive through import and unwrap; using them must not draw
+    expect("import P-256", crypto->import_key(k_p256_private, sizeof(k_p256_private),
+                                              CRYPTO_KEY_TYPE_ECC_PRIVATE, &p256), HAL_SUCCESS);
+    expect("import AES-128", crypto->import_key(aes_key, sizeof(aes_key),
+                                                CRYPTO_KEY_TYPE_SYMMETRIC, &aes), HAL_SUCCESS);
+
+    length = sizeof(output);
+    expect("sign P-256", crypto->sign(&p256, message, sizeof(message), output, &length),
+           HAL_ERROR_INVALID_STATE);
+    length = sizeof(output);
+    expect("encrypt", crypto->encrypt(&aes, message, sizeof(message), output, &length),
+           HAL_ERROR_INVALID_STATE);
+    length = sizeof(output);
+    expect("wrap_key", tinycrypt_crypto_wrap_key(&aes, &p256, NULL, 0, output, &length),
+           HAL_ERROR_INVALID_STATE);
+
+    // Caller data is mixed in, never credited: constant bytes must not open the gate
+    memset(output, 0x55, sizeof(output));
+    for (int i = 0; i < 4; i++) {
+        expect("add_entropy", crypto->rng.add_entropy(output, sizeof(output)), HAL_SUCCESS);
+    }
+    expect("get_entropy_estimate", crypto->rng.get_entropy_estimate(&bits), HAL_SUCCESS);
+    if (bits != 0) {
+        printf("[RNG_GATE] add_entropy() credited %u bits\n", (unsigned)bits);
+        g_failures++;
+    }
+    length = sizeof(output);
+    expect("sign P-256 after add_entropy",
+           crypto->sign(&p256, message, sizeof(message), output, &length),
+           HAL_ERROR_INVALID_STATE);
+
+    crypto->delete_key(&p256);
+    crypto->delete_key(&aes);
+    crypto->base.deinit();
+
+    printf("[RNG_GATE] %s\n", g_failures ? "FAIL" : "PASS");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,361 @@
+/**
+ * @file sha2.c
+ * @brief SHA-256 and SHA-512 with Caller-Allocated Contexts
+ * @author USB Key Authentication Team
+ * @date 2025-09-18
+ * @version 1.0
+ *
+ * Each compression pass runs 16 rounds from a 16-word schedule window. The
+ * first pass loads the block, later passes expand the window in place
+ * first, so the round code exists once. Rotating the argument list of the
+ * round macro replaces the eight moves per round of a rolled loop.
+ *
+ * On Cortex-M33 the rotations map to ROR and the big-endian loads to REV;
+ * SHA-512 has no native 64-bit rotate and costs roughly 3x per byte.
+ */
+
+#include "sha2.h"
+#include "crypto_util.h"
+#include <string.h>
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static inline uint32_t ror32(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32U - n));
+}
+
+static inline uint64_t ror64(uint64_t x, unsigned n) {
+    return (x >> n) | (x << (64U - n));
+}
+
+static inline uint32_t load_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline uint64_t load_be64(const uint8_t* p) {
+    return ((uint64_t)load_be32(p) << 32) | load_be32(p + 4);
+}
+
+static inline void store_be32(uint8_t* p, uint32_t x) {
+    p[0] = (uint8_t)(x >> 24);
+    p[1] = (uint8_t)(x >> 16);
+    p[2] = (uint8_t)(x >> 8);
+    p[3] = (uint8_t)x;
+}
+
+static inline void store_be64(uint8_t* p, uint64_t x) {
+    store_be32(p, (uint32_t)(x >> 32));
+    store_be32(p + 4, (uint32_t)x);
+}
+
+/** @brief Choose and majority, with one operation less than the FIPS forms */
+#define CH(x, y, z)     ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z)    (((x) & (y)) | ((z) & ((x) | (y))))
+
+/**
+ * @brief Sixteen rounds on w[0..15] and k[0..15]
+ *
+ * ROUND(a, ..., h, i) leaves the new a in h and the new e in d, so the
+ * next call passes the list rotated right by one.
+ */
+#define SIXTEEN_ROUNDS(ROUND) \
+    ROUND(a, b, c, d, e, f, g, h, 0);   ROUND(h, a, b, c, d, e, f, g, 1); \
+    ROUND(g, h, a, b, c, d, e, f, 2);   ROUND(f, g, h, a, b, c, d, e, 3); \
+    ROUND(e, f, g, h, a, b, c, d, 4);   ROUND(d, e, f, g, h, a, b, c, 5); \
+    ROUND(c, d, e, f, g, h, a, b, 6);   ROUND(b, c, d, e, f, g, h, a, 7); \
+    ROUND(a, b, c, d, e, f, g, h, 8);   ROUND(h, a, b, c, d, e, f, g, 9); \
+    ROUND(g, h, a, b, c, d, e, f, 10);  ROUND(f, g, h, a, b, c, d, e, 11); \
+    ROUND(e, f, g, h, a, b, c, d, 12);  ROUND(d, e, f, g, h, a, b, c, 13); \
+    ROUND(c, d, e, f, g, h, a, b, 14);  ROUND(b, c, d, e, f, g, h, a, 15)
+
+// =============================================================================
+// SHA-256
+// =============================================================================
+
+/** @brief Round constants */
+static const uint32_t k_sha256_k[64] = {
+    0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+    0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+    0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+    0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+    0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+    0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+    0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+    0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U,
+};
+
+/** @brief Initial chaining value */
+static const uint32_t k_sha256_iv[8] = {
+    0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+    0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U,
+};
+
+#define SHA256_S0(x)    (ror32((x), 2) ^ ror32((x), 13) ^ ror32((x), 22))
+#define SHA256_S1(x)    (ror32((x), 6) ^ ror32((x), 11) ^ ror32((x), 25))
+#define SHA256_G0(x)    (ror32((x), 7) ^ ror32((x), 18) ^ ((x) >> 3))
+#define SHA256_G1(x)    (ror32((x), 17) ^ ror32((x), 19) ^ ((x) >> 10))
+
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i) do { \
+    h += SHA256_S1(e) + CH(e, f, g) + k[i] + w[i]; \
+    d += h; \
+    h += SHA256_S0(a) + MAJ(a, b, c); \
+} while (0)
+
+/**
+ * @brief Compress whole blocks into the chaining value
+ */
+static void sha256_blocks(uint32_t* state, const uint8_t* data, size_t blocks) {
+    uint32_t w[16];
+
+    while (blocks-- > 0) {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        const uint32_t* k = k_sha256_k;
+
+        for (unsigned i = 0; i < 16; i++) {
+            w[i] = load_be32(data + 4 * i);
+        }
+
+        for (;;) {
+            SIXTEEN_ROUNDS(SHA256_ROUND);
+
+            k += 16;
+            if (k == k_sha256_k + 64) {
+                break;
+            }
+            for (unsigned i = 0; i < 16; i++) {
+                w[i] += SHA256_G1(w[(i + 14) & 15]) + w[(i + 9) & 15] + SHA256_G0(w[(i + 1) & 15]);
+            }
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        data += SHA256_BLOCK_SIZE;
+    }
+
+    crypto_secure_zero(w, sizeof(w));
+}
+
+void sha256_init(sha256_context_t* ctx) {
+    memcpy(ctx->h, k_sha256_iv, sizeof(ctx->h));
+    ctx->length = 0;
+}
+
+void sha256_update(sha256_context_t* ctx, const uint8_t* data, size_t length) {
+    size_t used = (size_t)(ctx->length % SHA256_BLOCK_SIZE);
+
+    if (length == 0) {
+        return;
+    }
+    ctx->length += length;
+
+    if (used > 0) {
+        size_t take = SHA256_BLOCK_SIZE - used;
+        if (take > length) {
+            take = length;
+        }
+        memcpy(ctx->block + used, data, take);
+        data += take;
+        length -= take;
+        if (used + take < SHA256_BLOCK_SIZE) {
+            return;
+        }
+        sha256_blocks(ctx->h, ctx->block, 1);
+    }
+
+    // Whole blocks straight from the caller's buffer
+    if (length >= SHA256_BLOCK_SIZE) {
+        sha256_blocks(ctx->h, data, length / SHA256_BLOCK_SIZE);
+        data += length & ~(size_t)(SHA256_BLOCK_SIZE - 1U);
+        length %= SHA256_BLOCK_SIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->block, data, length);
+    }
+}
+
+void sha256_final(sha256_context_t* ctx, uint8_t* digest) {
+    size_t used = (size_t)(ctx->length % SHA256_BLOCK_SIZE);
+
+    ctx->block[used++] = 0x80;
+    if (used > SHA256_BLOCK_SIZE - 8U) {
+        memset(ctx->block + used, 0, SHA256_BLOCK_SIZE - used);
+        sha256_blocks(ctx->h, ctx->block, 1);
+        used = 0;
+    }
+    memset(ctx->block + used, 0, SHA256_BLOCK_SIZE - 8U - used);
+    store_be64(ctx->block + SHA256_BLOCK_SIZE - 8U, ctx->length << 3);
+    sha256_blocks(ctx->h, ctx->block, 1);
+
+    for (unsigned i = 0; i < 8; i++) {
+        store_be32(digest + 4 * i, ctx->h[i]);
+    }
+    crypto_secure_zero(ctx, sizeof(*ctx));
+}
+
+void sha256_clone(sha256_context_t* dst, const sha256_context_t* src) {
+    memcpy(dst, src, sizeof(*dst));
+}
+
+void sha256(const uint8_t* data, size_t length, uint8_t* digest) {
+    sha256_context_t ctx;
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, length);
+    sha256_final(&ctx, digest);
+}
+
+// =============================================================================
+// SHA-512
+// =============================================================================
+
+/** @brief Round constants */
+static const uint64_t k_sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+/** @brief Initial chaining value */
+static const uint64_t k_sha512_iv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+#define SHA512_S0(x)    (ror64((x), 28) ^ ror64((x), 34) ^ ror64((x), 39))
+#define SHA512_S1(x)    (ror64((x), 14) ^ ror64((x), 18) ^ ror64((x), 41))
+#define SHA512_G0(x)    (ror64((x), 1) ^ ror64((x), 8) ^ ((x) >> 7))
+#define SHA512_G1(x)    (ror64((x), 19) ^ ror64((x), 61) ^ ((x) >> 6))
+
+#define SHA512_ROUND(a, b, c, d, e, f, g, h, i) do { \
+    h += SHA512_S1(e) + CH(e, f, g) + k[i] + w[i]; \
+    d += h; \
+    h += SHA512_S0(a) + MAJ(a, b, c); \
+} while (0)
+
+/**
+ * @brief Compress whole blocks into the chaining value
+ */
+static void sha512_blocks(uint64_t* state, const uint8_t* data, size_t blocks) {
+    uint64_t w[16];
+
+    while (blocks-- > 0) {
+        uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+        const uint64_t* k = k_sha512_k;
+
+        for (unsigned i = 0; i < 16; i++) {
+            w[i] = load_be64(data + 8 * i);
+        }
+
+        for (;;) {
+            SIXTEEN_ROUNDS(SHA512_ROUND);
+
+            k += 16;
+            if (k == k_sha512_k + 80) {
+                break;
+            }
+            for (unsigned i = 0; i < 16; i++) {
+                w[i] += SHA512_G1(w[(i + 14) & 15]) + w[(i + 9) & 15] + SHA512_G0(w[(i + 1) & 15]);
+            }
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        data += SHA512_BLOCK_SIZE;
+    }
+
+    crypto_secure_zero(w, sizeof(w));
+}
+
+void sha512_init(sha512_context_t* ctx) {
+    memcpy(ctx->h, k_sha512_iv, sizeof(ctx->h));
+    ctx->length = 0;
+}
+
+void sha512_update(sha512_context_t* ctx, const uint8_t* data, size_t length) {
+    size_t used = (size_t)(ctx->length % SHA512_BLOCK_SIZE);
+
+    if (length == 0) {
+        return;
+    }
+    ctx->length += length;
+
+    if (used > 0) {
+        size_t take = SHA512_BLOCK_SIZE - used;
+        if (take > length) {
+            take = length;
+        }
+        memcpy(ctx->block + used, data, take);
+        data += take;
+        length -= take;
+        if (used + take < SHA512_BLOCK_SIZE) {
+            return;
+        }
+        sha512_blocks(ctx->h, ctx->block, 1);
+    }
+
+    if (length >= SHA512_BLOCK_SIZE) {
+        sha512_blocks(ctx->h, data, length / SHA512_BLOCK_SIZE);
+        data += length & ~(size_t)(SHA512_BLOCK_SIZE - 1U);
+        length %= SHA512_BLOCK_SIZE;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->block, data, length);
+    }
+}
+
+void sha512_final(sha512_context_t* ctx, uint8_t* digest) {
+    size_t used = (size_t)(ctx->length % SHA512_BLOCK_SIZE);
+
+    // 128-bit length field; the upper 64 bits hold only the top 3 bits of the byte count
+    ctx->block[used++] = 0x80;
+    if (used > SHA512_BLOCK_SIZE - 16U) {
+        memset(ctx->block + used, 0, SHA512_BLOCK_SIZE - used);
+        sha512_blocks(ctx->h, ctx->block, 1);
+        used = 0;
+    }
+    memset(ctx->block + used, 0, SHA512_BLOCK_SIZE - 16U - used);
+    store_be64(ctx->block + SHA512_BLOCK_SIZE - 16U, ctx->length >> 61);
+    store_be64(ctx->block + SHA512_BLOCK_SIZE - 8U, ctx->length << 3);
+    sha512_blocks(ctx->h, ctx->block, 1);
+
+    for (unsigned i = 0; i < 8; i++) {
+        store_be64(digest + 8 * i, ctx->h[i]);
+    }
+    crypto_secure_zero(ctx, sizeof(*ctx));
+}
+
+void sha512_clone(sha512_context_t* dst, const sha512_context_t* src) {
+    memcpy(dst, src, sizeof(*dst));
+}
+
+void sha512(const uint8_t* data, size_t length, uint8_t* digest) {
+    sha512_context_t ctx;
+
+    sha512_init(&ctx);
+    sha512_update(&ctx, data, length);
+    sha512_final(&ctx, digest);
+}
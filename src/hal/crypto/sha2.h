@@ -0,0 +1,143 @@
+#ifndef SHA2_H
+#define SHA2_H
+
+/**
+ * @file sha2.h
+ * @brief SHA-256 and SHA-512 with Caller-Allocated Contexts
+ * @author USB Key Authentication Team
+ * @date 2025-09-18
+ * @version 1.0
+ *
+ * The compression functions run 16 rounds per pass fully unrolled, with
+ * the working variables renamed instead of shifted and the message
+ * schedule kept in a 16-word window. update() compresses whole blocks
+ * straight from the input, only a partial block is copied.
+ *
+ * A context is a plain fixed-size struct with no pointers: it can live on
+ * the stack or inside another struct, needs no cleanup when abandoned, and
+ * copying it (sha256_clone(), sha512_clone()) snapshots the midstate, so a
+ * common prefix such as authData is hashed once and finished several ways.
+ *
+ * Nothing branches on the data, only on lengths.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief SHA-256 digest size in bytes */
+#define SHA256_DIGEST_SIZE      32U
+
+/** @brief SHA-256 block size in bytes */
+#define SHA256_BLOCK_SIZE       64U
+
+/** @brief SHA-512 digest size in bytes */
+#define SHA512_DIGEST_SIZE      64U
+
+/** @brief SHA-512 block size in bytes */
+#define SHA512_BLOCK_SIZE       128U
+
+/**
+ * @brief SHA-256 state
+ */
+typedef struct {
+    uint32_t h[8];                          /**< Chaining value */
+    uint64_t length;                        /**< Bytes absorbed so far */
+    uint8_t block[SHA256_BLOCK_SIZE];       /**< Partial block, length % 64 bytes */
+} sha256_context_t;
+
+/**
+ * @brief SHA-512 state
+ *
+ * The length is kept in 64 bits, which limits a message to 2^64 - 1 bytes.
+ */
+typedef struct {
+    uint64_t h[8];                          /**< Chaining value */
+    uint64_t length;                        /**< Bytes absorbed so far */
+    uint8_t block[SHA512_BLOCK_SIZE];       /**< Partial block, length % 128 bytes */
+} sha512_context_t;
+
+/**
+ * @brief Start a SHA-256 computation
+ *
+ * @param ctx Context to initialize
+ */
+void sha256_init(sha256_context_t* ctx);
+
+/**
+ * @brief Absorb data
+ *
+ * @param ctx Initialized context
+ * @param data Data, may be NULL if length is 0
+ * @param length Size of data in bytes
+ */
+void sha256_update(sha256_context_t* ctx, const uint8_t* data, size_t length);
+
+/**
+ * @brief Finish and wipe the context
+ *
+ * @param ctx Context, must be initialized again before reuse
+ * @param digest Output SHA256_DIGEST_SIZE bytes
+ */
+void sha256_final(sha256_context_t* ctx, uint8_t* digest);
+
+/**
+ * @brief Copy a context, including its partial block
+ *
+ * The two continue independently afterwards.
+ *
+ * @param dst Output context
+ * @param src Context to copy
+ */
+void sha256_clone(sha256_context_t* dst, const sha256_context_t* src);
+
+/**
+ * @brief Single-shot SHA-256
+ *
+ * @param data Data, may be NULL if length is 0
+ * @param length Size of data in bytes
+ * @param digest Output SHA256_DIGEST_SIZE bytes
+ */
+void sha256(const uint8_t* data, size_t length, uint8_t* digest);
+
+/**
+ * @brief Start a SHA-512 computation
+ *
+ * @param ctx Context to initialize
+ */
+void sha512_init(sha512_context_t* ctx);
+
+/**
+ * @brief Absorb data
+ *
+ * @param ctx Initialized context
+ * @param data Data, may be NULL if length is 0
+ * @param length Size of data in bytes
+ */
+void sha512_update(sha512_context_t* ctx, const uint8_t* data, size_t length);
+
+/**
+ * @brief Finish and wipe the context
+ *
+ * @param ctx Context, must be initialized again before reuse
+ * @param digest Output SHA512_DIGEST_SIZE bytes
+ */
+void sha512_final(sha512_context_t* ctx, uint8_t* digest);
+
+/**
+ * @brief Copy a context, including its partial block
+ *
+ * @param dst Output context
+ * @param src Context to copy
+ */
+void sha512_clone(sha512_context_t* dst, const sha512_context_t* src);
+
+/**
+ * @brief Single-shot SHA-512
+ *
+ * @param data Data, may be NULL if length is 0
+ * @param length Size of data in bytes
+ * @param digest Output SHA512_DIGEST_SIZE bytes
+ */
+void sha512(const uint8_t* data, size_t length, uint8_t* digest);
+
+#endif // SHA2_H
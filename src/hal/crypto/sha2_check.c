@@ -0,0 +1,292 @@
+/**
+ * @file sha2_check.c
+ * @brief Differential Check and Timing of sha2.h
+ * @author USB Key Authentication Team
+ * @date 2025-09-18
+ * @version 1.0
+ *
+ * On MCXA156 call sha2_check_run() from a debug command; cycles are core
+ * clock cycles. On Linux the file builds as a program, where "cycles" are
+ * nanoseconds. From the repository root:
+ * @code
+ * EXT=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/mcuboot_opensource/ext
+ * gcc -std=c11 -O2 -I src -I $EXT/tinycrypt/lib/include \
+ *     -I $EXT/tinycrypt-sha512/lib/include \
+ *     src/hal/crypto/sha2_check.c src/hal/crypto/sha2.c src/hal/crypto/crypto_util.c \
+ *     src/platform/time/cycle_counter.c $EXT/tinycrypt/lib/source/sha256.c \
+ *     $EXT/tinycrypt/lib/source/utils.c $EXT/tinycrypt-sha512/lib/source/sha512.c \
+ *     -o sha2_check
+ * ./sha2_check [-n max_length]
+ * @endcode
+ *
+ * The host program exits non-zero on any mismatch.
+ */
+
+#include "sha2_check.h"
+#include "sha2.h"
+#include "platform/time/cycle_counter.h"
+#include <stdio.h>
+#include <string.h>
+
+#include <tinycrypt/sha256.h>
+#include <tinycrypt/sha512.h>
+
+/** @brief Size of the timed message */
+#define CHECK_TIMED_SIZE    1024U
+
+/** @brief Messages timed per implementation */
+#define CHECK_TIMED_RUNS    64U
+
+/** @brief Fixed xorshift seed, so host and target check the same messages */
+#define CHECK_SEED          0x6A09E667U
+
+/** @brief Longest message of the length sweep, also the buffer size */
+#define CHECK_MAX_LENGTH    1024U
+
+/**
+ * @brief FIPS 180-4 example
+ */
+typedef struct {
+    const char* message;            /**< ASCII message */
+    uint8_t sha256[SHA256_DIGEST_SIZE];
+    uint8_t sha512[SHA512_DIGEST_SIZE];
+} known_answer_t;
+
+static const known_answer_t k_known_answers[] = {
+    {
+        "abc",
+        { 0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+          0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad },
+        { 0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba, 0xcc, 0x41, 0x73, 0x49, 0xae, 0x20, 0x41, 0x31,
+          0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2, 0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a,
+          0x21, 0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8, 0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+          0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e, 0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f },
+    },
+    {
+        "",
+        { 0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+          0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55 },
+        { 0xcf, 0x83, 0xe1, 0x35, 0x7e, 0xef, 0xb8, 0xbd, 0xf1, 0x54, 0x28, 0x50, 0xd6, 0x6d, 0x80, 0x07,
+          0xd6, 0x20, 0xe4, 0x05, 0x0b, 0x57, 0x15, 0xdc, 0x83, 0xf4, 0xa9, 0x21, 0xd3, 0x6c, 0xe9, 0xce,
+          0x47, 0xd0, 0xd1, 0x3c, 0x5d, 0x85, 0xf2, 0xb0, 0xff, 0x83, 0x18, 0xd2, 0x87, 0x7e, 0xec, 0x2f,
+          0x63, 0xb9, 0x31, 0xbd, 0x47, 0x41, 0x7a, 0x81, 0xa5, 0x38, 0x32, 0x7a, 0xf9, 0x27, 0xda, 0x3e },
+    },
+};
+
+#define KNOWN_ANSWER_COUNT  (sizeof(k_known_answers) / sizeof(k_known_answers[0]))
+
+static uint32_t g_check_state;
+
+/** @brief Message buffer of the sweep and the timing */
+static uint8_t g_message[CHECK_MAX_LENGTH];
+
+/**
+ * @brief xorshift32, reproducible messages (not for key material)
+ */
+static uint32_t check_random(void) {
+    g_check_state ^= g_check_state << 13;
+    g_check_state ^= g_check_state >> 17;
+    g_check_state ^= g_check_state << 5;
+    return g_check_state;
+}
+
+static void report(const char* what, size_t length) {
+    printf("[SHA2] %s mismatch, length %lu\n", what, (unsigned long)length);
+}
+
+/**
+ * @brief Hash one message in random pieces, finishing a clone at the midpoint
+ *
+ * Returns the number of mismatches against the tinycrypt digests.
+ */
+static uint32_t check_length(size_t length) {
+    uint8_t expected[SHA512_DIGEST_SIZE], digest[SHA512_DIGEST_SIZE];
+    uint8_t expected_prefix[SHA512_DIGEST_SIZE];
+    struct tc_sha256_state_struct tc256;
+    struct tc_sha512_state_struct tc512;
+    sha256_context_t ctx256, prefix256;
+    sha512_context_t ctx512, prefix512;
+    size_t half = length / 2;
+    size_t offset = 0;
+    uint32_t mismatches = 0;
+
+    sha256_init(&ctx256);
+    sha512_init(&ctx512);
+    if (half == 0) {
+        sha256_clone(&prefix256, &ctx256);
+        sha512_clone(&prefix512, &ctx512);
+    }
+    while (offset < length) {
+        size_t piece = check_random() % 200U;
+        if (piece > length - offset) {
+            piece = length - offset;
+        }
+        // Split at the midpoint so the clone sees exactly the prefix
+        if (offset < half && offset + piece > half) {
+            piece = half - offset;
+        }
+        sha256_update(&ctx256, g_message + offset, piece);
+        sha512_update(&ctx512, g_message + offset, piece);
+        offset += piece;
+        if (offset == half) {
+            sha256_clone(&prefix256, &ctx256);
+            sha512_clone(&prefix512, &ctx512);
+        }
+    }
+
+    (void)tc_sha256_init(&tc256);
+    (void)tc_sha256_update(&tc256, g_message, length);
+    (void)tc_sha256_final(expected, &tc256);
+    sha256_final(&ctx256, digest);
+    if (memcmp(digest, expected, SHA256_DIGEST_SIZE) != 0) {
+        report("sha256", length);
+        mismatches++;
+    }
+
+    (void)tc_sha256_init(&tc256);
+    (void)tc_sha256_update(&tc256, g_message, half);
+    (void)tc_sha256_final(expected_prefix, &tc256);
+    sha256_final(&prefix256, digest);
+    if (memcmp(digest, expected_prefix, SHA256_DIGEST_SIZE) != 0) {
+        report("sha256 clone", length);
+        mismatches++;
+    }
+
+    (void)tc_sha512_init(&tc512);
+    (void)tc_sha512_update(&tc512, g_message, length);
+    (void)tc_sha512_final(expected, &tc512);
+    sha512_final(&ctx512, digest);
+    if (memcmp(digest, expected, SHA512_DIGEST_SIZE) != 0) {
+        report("sha512", length);
+        mismatches++;
+    }
+
+    (void)tc_sha512_init(&tc512);
+    (void)tc_sha512_update(&tc512, g_message, half);
+    (void)tc_sha512_final(expected_prefix, &tc512);
+    sha512_final(&prefix512, digest);
+    if (memcmp(digest, expected_prefix, SHA512_DIGEST_SIZE) != 0) {
+        report("sha512 clone", length);
+        mismatches++;
+    }
+
+    return mismatches;
+}
+
+/**
+ * @brief Implementations compared by the timing
+ */
+typedef enum {
+    TIMED_SHA256 = 0,
+    TIMED_TC_SHA256,
+    TIMED_SHA512,
+    TIMED_TC_SHA512
+} timed_t;
+
+/**
+ * @brief Average cycles to hash CHECK_TIMED_SIZE bytes
+ */
+static uint32_t time_hash(timed_t which) {
+    uint8_t digest[SHA512_DIGEST_SIZE];
+    struct tc_sha256_state_struct tc256;
+    struct tc_sha512_state_struct tc512;
+
+    uint32_t start = cycle_counter_read();
+    for (uint32_t i = 0; i < CHECK_TIMED_RUNS; i++) {
+        switch (which) {
+            case TIMED_SHA256:
+                sha256(g_message, CHECK_TIMED_SIZE, digest);
+                break;
+            case TIMED_TC_SHA256:
+                (void)tc_sha256_init(&tc256);
+                (void)tc_sha256_update(&tc256, g_message, CHECK_TIMED_SIZE);
+                (void)tc_sha256_final(digest, &tc256);
+                break;
+            case TIMED_SHA512:
+                sha512(g_message, CHECK_TIMED_SIZE, digest);
+                break;
+            case TIMED_TC_SHA512:
+                (void)tc_sha512_init(&tc512);
+                (void)tc_sha512_update(&tc512, g_message, CHECK_TIMED_SIZE);
+                (void)tc_sha512_final(digest, &tc512);
+                break;
+        }
+        // Chain the runs so nothing is hoisted out of the loop
+        g_message[0] ^= digest[0];
+    }
+    return (cycle_counter_read() - start) / CHECK_TIMED_RUNS;
+}
+
+hal_result_t sha2_check_run(uint32_t max_length, sha2_check_result_t* result) {
+    sha2_check_result_t summary = {0};
+    uint8_t digest[SHA512_DIGEST_SIZE];
+
+    (void)cycle_counter_init();
+    g_check_state = CHECK_SEED;
+    if (max_length > CHECK_MAX_LENGTH) {
+        max_length = CHECK_MAX_LENGTH;
+    }
+
+    for (size_t i = 0; i < KNOWN_ANSWER_COUNT; i++) {
+        const known_answer_t* vector = &k_known_answers[i];
+        size_t length = strlen(vector->message);
+
+        sha256((const uint8_t*)vector->message, length, digest);
+        if (memcmp(digest, vector->sha256, SHA256_DIGEST_SIZE) != 0) {
+            report("sha256 known answer", length);
+            summary.mismatches++;
+        }
+        sha512((const uint8_t*)vector->message, length, digest);
+        if (memcmp(digest, vector->sha512, SHA512_DIGEST_SIZE) != 0) {
+            report("sha512 known answer", length);
+            summary.mismatches++;
+        }
+        summary.vectors++;
+    }
+
+    for (size_t i = 0; i < sizeof(g_message); i++) {
+        g_message[i] = (uint8_t)check_random();
+    }
+    for (uint32_t length = 0; length <= max_length; length++) {
+        summary.mismatches += check_length(length);
+        summary.vectors++;
+    }
+
+    summary.sha256_cycles_per_kb = time_hash(TIMED_SHA256);
+    summary.tc_sha256_cycles_per_kb = time_hash(TIMED_TC_SHA256);
+    summary.sha512_cycles_per_kb = time_hash(TIMED_SHA512);
+    summary.tc_sha512_cycles_per_kb = time_hash(TIMED_TC_SHA512);
+
+    printf("[SHA2] %lu messages, %lu mismatches\n", (unsigned long)summary.vectors,
+           (unsigned long)summary.mismatches);
+    printf("1 KB: sha256 %lu, tinycrypt %lu; sha512 %lu, tinycrypt %lu (%lu cycles/s)\n",
+           (unsigned long)summary.sha256_cycles_per_kb,
+           (unsigned long)summary.tc_sha256_cycles_per_kb,
+           (unsigned long)summary.sha512_cycles_per_kb,
+           (unsigned long)summary.tc_sha512_cycles_per_kb,
+           (unsigned long)cycle_counter_get_hz());
+
+    if (result) {
+        *result = summary;
+    }
+    return summary.mismatches == 0 ? HAL_SUCCESS : HAL_ERROR_HARDWARE_FAILURE;
+}
+
+#if !defined(MCXA156_SERIES)
+#include <stdlib.h>
+
+int main(int argc, char** argv) {
+    uint32_t max_length = CHECK_MAX_LENGTH;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            max_length = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-n max_length]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    return sha2_check_run(max_length, NULL) == HAL_SUCCESS ? 0 : 1;
+}
+#endif
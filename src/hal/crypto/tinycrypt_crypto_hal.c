@@ -0,0 +1,1757 @@
+/**
+ * @file tinycrypt_crypto_hal.c
+ * @brief Software Crypto HAL Backend on tinycrypt
+ * @author USB Key Authentication Team
+ * @date 2025-09-09
+ * @version 1.0
+ */
+
+#include "tinycrypt_crypto_hal.h"
+#include "p256_comb.h"
+#include "p256_field.h"
+#include "p256_pool.h"
+#include "ed25519.h"
+#include "key_slot.h"
+#include "lpadc_entropy.h"
+#include "sha2.h"
+#include "crypto_util.h"
+#include "platform/time/cycle_counter.h"
+#include <string.h>
+
+#include <tinycrypt/constants.h>
+#include <tinycrypt/ecc.h>
+#include <tinycrypt/ecc_dh.h>
+#include <tinycrypt/ecc_dsa.h>
+#include <tinycrypt/aes.h>
+#include <tinycrypt/ccm_mode.h>
+#include <tinycrypt/hmac_prng.h>
+
+#if defined(MCXA156_SERIES)
+#include "fsl_romapi.h"
+#include "FreeRTOS.h"
+#include "task.h"
+/** @brief Serialize PRNG use with the precompute task, interrupts stay on */
+#define PRNG_LOCK()     vTaskSuspendAll()
+#define PRNG_UNLOCK()   (void)xTaskResumeAll()
+#else
+#include <tinycrypt/ecc_platform_specific.h>
+#define PRNG_LOCK()     do { } while (0)
+#define PRNG_UNLOCK()   do { } while (0)
+#endif
+
+/**
+ * @brief Entropy (bits) required before rng hands out bytes
+ *
+ * MCXA156 has no TRNG: the generator is seeded from LPADC noise
+ * (lpadc_entropy.h) mixed with the device UUID and cycle counter. If the
+ * ADC fails its health test only the latter, unique but not secret, go in
+ * and the estimate stays at 0 bits until a reseed brings real noise;
+ * until then generation fails. add_entropy() is mixed in uncredited. Bring-up builds may define 0 to
+ * run on an uncredited seed.
+ */
+#ifndef TINYCRYPT_RNG_MIN_ENTROPY_BITS
+#define TINYCRYPT_RNG_MIN_ENTROPY_BITS  256U
+#endif
+
+/** @brief Seed length passed to the HMAC-PRNG (its minimum) */
+#define RNG_SEED_SIZE               32U
+
+/**
+ * @brief Entropy credited to a host seed from /dev/urandom
+ *
+ * rng_gate_check.c builds with 0 to run the host like a board whose ADC
+ * failed its health test.
+ */
+#ifndef TINYCRYPT_HOST_SEED_BITS
+#define TINYCRYPT_HOST_SEED_BITS    (RNG_SEED_SIZE * 8U)
+#endif
+
+/** @brief Upper bound of the entropy estimate */
+#define RNG_MAX_ENTROPY_BITS        256U
+
+_Static_assert(TINYCRYPT_RNG_MIN_ENTROPY_BITS <= RNG_MAX_ENTROPY_BITS,
+               "TINYCRYPT_RNG_MIN_ENTROPY_BITS above what a seed can be credited");
+
+/** @brief Device UUID length on MCXA156 */
+#define DEVICE_ID_SIZE              16U
+
+/** @brief Hash context marker kept in crypto_context_t.flags, algorithm in the low bits */
+#define HASH_CONTEXT_ACTIVE         0x80000000UL
+
+_Static_assert(TINYCRYPT_P256_PUBLIC_KEY_SIZE <= KEY_SLOT_DATA_SIZE &&
+               TINYCRYPT_P256_PRIVATE_KEY_SIZE <= KEY_SLOT_DATA_SIZE &&
+               TC_AES_KEY_SIZE <= KEY_SLOT_DATA_SIZE,
+               "KEY_SLOT_DATA_SIZE too small for P-256 and AES-128 keys");
+#if TINYCRYPT_ED25519
+_Static_assert(ED25519_PRIVATE_KEY_SIZE <= KEY_SLOT_DATA_SIZE,
+               "KEY_SLOT_DATA_SIZE too small for Ed25519 keys");
+#endif
+
+/**
+ * @brief Streaming hash state, kept inline in crypto_context_t.state
+ */
+typedef union {
+    sha256_context_t sha256;                /**< CRYPTO_HASH_SHA256 */
+    sha512_context_t sha512;                /**< CRYPTO_HASH_SHA512 */
+} hash_state_t;
+
+_Static_assert(sizeof(hash_state_t) <= CRYPTO_CONTEXT_STATE_SIZE,
+               "CRYPTO_CONTEXT_STATE_SIZE too small for a SHA-512 state");
+
+/**
+ * @brief Backend state
+ */
+typedef struct {
+    struct tc_hmac_prng_struct prng;        /**< Random generator */
+    uint32_t entropy_bits;                  /**< Entropy credited to prng */
+    uint32_t output_since_reseed;           /**< DRBG bytes since the last credited reseed */
+#if TINYCRYPT_RNG_RESERVOIR_SIZE > 0
+    uint8_t reservoir[TINYCRYPT_RNG_RESERVOIR_SIZE]; /**< Pre-generated bytes */
+    uint32_t reservoir_ready;               /**< Bytes of reservoir in use, taken from the end */
+#endif
+    tinycrypt_rng_stats_t rng_stats;        /**< RNG counters */
+    crypto_op_stats_t stats[CRYPTO_OP_COUNT]; /**< Per-operation cycles */
+    bool initialized;                       /**< Initialization flag */
+} tinycrypt_state_t;
+
+/** @brief Global backend state */
+static tinycrypt_state_t g_tinycrypt = {0};
+
+/**
+ * @brief Account one completed operation
+ */
+static void record_op(crypto_op_t op, uint32_t start) {
+    uint32_t cycles = cycle_counter_read() - start;
+    crypto_op_stats_t* stats = &g_tinycrypt.stats[op];
+
+    if (stats->count == 0 || cycles < stats->min_cycles) {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    stats->last_cycles = cycles;
+    stats->total_cycles += cycles;
+    stats->count++;
+}
+
+// =============================================================================
+// Random number generation
+// =============================================================================
+
+/**
+ * @brief Gather seed material for the PRNG
+ *
+ * @param seed Output buffer of RNG_SEED_SIZE bytes
+ * @param entropy_bits Entropy the seed is credited with
+ * @return true on success
+ */
+static bool collect_seed(uint8_t* seed, uint32_t* entropy_bits) {
+#if defined(MCXA156_SERIES)
+    sha256_context_t sha;
+    uint8_t uuid[DEVICE_ID_SIZE];
+    uint8_t noise[LPADC_ENTROPY_SEED_SIZE];
+    uint32_t bits = 0;
+
+    // Unique per device and per boot timing, but predictable: credit nothing
+    ROMAPI_GetUUID(uuid);
+    sha256_init(&sha);
+    sha256_update(&sha, uuid, sizeof(uuid));
+    for (uint32_t i = 0; i < 64U; i++) {
+        uint32_t sample = cycle_counter_read();
+        sha256_update(&sha, (const uint8_t*)&sample, sizeof(sample));
+    }
+
+    // The only credited input
+    if (lpadc_entropy_read(noise, &bits) == HAL_SUCCESS) {
+        sha256_update(&sha, noise, sizeof(noise));
+    } else {
+        bits = 0;
+    }
+    sha256_final(&sha, seed);
+    crypto_secure_zero(noise, sizeof(noise));
+
+    *entropy_bits = bits;
+    return true;
+#else
+    if (!default_CSPRNG(seed, RNG_SEED_SIZE)) {
+        return false;
+    }
+
+    *entropy_bits = TINYCRYPT_HOST_SEED_BITS;
+    return true;
+#endif
+}
+
+static void precompute_wake(void);
+
+/**
+ * @brief Drop pre-generated bytes (caller holds the PRNG lock)
+ *
+ * After a reseed or add_entropy() the next output must depend on the new
+ * input, not on bytes generated before it.
+ */
+static void reservoir_discard(void) {
+#if TINYCRYPT_RNG_RESERVOIR_SIZE > 0
+    crypto_secure_zero(g_tinycrypt.reservoir, g_tinycrypt.reservoir_ready);
+    g_tinycrypt.reservoir_ready = 0;
+#endif
+}
+
+/**
+ * @brief Copy and wipe up to length bytes off the reservoir (caller holds the lock)
+ *
+ * @return Bytes copied
+ */
+static size_t reservoir_take(uint8_t* buffer, size_t length) {
+#if TINYCRYPT_RNG_RESERVOIR_SIZE > 0
+    size_t count = length < g_tinycrypt.reservoir_ready ? length : g_tinycrypt.reservoir_ready;
+    uint8_t* source = &g_tinycrypt.reservoir[g_tinycrypt.reservoir_ready - count];
+
+    memcpy(buffer, source, count);
+    crypto_secure_zero(source, count);
+    g_tinycrypt.reservoir_ready -= (uint32_t)count;
+    return count;
+#else
+    (void)buffer;
+    (void)length;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Reseed the PRNG from collect_seed()
+ *
+ * Samples the noise source without holding the PRNG lock; only the reseed
+ * itself runs under it.
+ *
+ * @param credited Output entropy credited to the new seed
+ * @return true if the PRNG was reseeded
+ */
+static bool reseed_prng(uint32_t* credited) {
+    uint8_t seed[RNG_SEED_SIZE];
+    uint32_t bits = 0;
+    bool ok = collect_seed(seed, &bits);
+
+    PRNG_LOCK();
+    ok = ok && tc_hmac_prng_reseed(&g_tinycrypt.prng, seed, sizeof(seed),
+                                   NULL, 0) == TC_CRYPTO_SUCCESS;
+    if (ok) {
+        reservoir_discard();
+        if (bits > 0) {
+            g_tinycrypt.output_since_reseed = 0;
+            g_tinycrypt.rng_stats.reseeds++;
+        }
+        if (bits > g_tinycrypt.entropy_bits) {
+            g_tinycrypt.entropy_bits = bits;
+        }
+    }
+    if (!ok || bits == 0) {
+        g_tinycrypt.rng_stats.reseed_failures++;
+    }
+    PRNG_UNLOCK();
+
+    crypto_secure_zero(seed, sizeof(seed));
+    *credited = ok ? bits : 0;
+    return ok;
+}
+
+/**
+ * @brief Run the DRBG (caller holds the lock)
+ *
+ * Stops when the DRBG asks for a reseed: collect_seed() must not run with
+ * the lock held, so the caller drops it, reseeds and calls again.
+ *
+ * @param buffer Output buffer
+ * @param length Total bytes wanted
+ * @param done In: bytes of buffer already filled; out: advanced past new output
+ * @return TC_CRYPTO_SUCCESS, TC_HMAC_PRNG_RESEED_REQ or TC_CRYPTO_FAIL
+ */
+static int prng_generate(uint8_t* buffer, size_t length, size_t* done) {
+    while (*done < length) {
+        size_t left = length - *done;
+        unsigned int chunk = left > 1024U ? 1024U : (unsigned int)left;
+        int rc = tc_hmac_prng_generate(&buffer[*done], chunk, &g_tinycrypt.prng);
+
+        if (rc != TC_CRYPTO_SUCCESS) {
+            return rc == TC_HMAC_PRNG_RESEED_REQ ? rc : TC_CRYPTO_FAIL;
+        }
+
+        if (g_tinycrypt.output_since_reseed < UINT32_MAX - chunk) {
+            g_tinycrypt.output_since_reseed += chunk;
+        }
+        *done += chunk;
+    }
+
+    return TC_CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Check that enough entropy has been credited to draw from the PRNG
+ */
+static bool rng_ready(void) {
+#if TINYCRYPT_RNG_MIN_ENTROPY_BITS > 0
+    return g_tinycrypt.entropy_bits >= TINYCRYPT_RNG_MIN_ENTROPY_BITS;
+#else
+    return true;
+#endif
+}
+
+/**
+ * @brief Random bytes for the request path: reservoir first, then the DRBG
+ *
+ * Fails while rng_ready() does not hold, so no key, ECDSA nonce or CCM
+ * nonce comes from an uncredited seed, whichever path asks for it.
+ */
+static bool prng_fill(uint8_t* buffer, size_t length) {
+    if (!rng_ready()) {
+        return false;
+    }
+
+    PRNG_LOCK();
+    size_t taken = reservoir_take(buffer, length);
+    size_t done = taken;
+    int rc = prng_generate(buffer, length, &done);
+
+    while (rc == TC_HMAC_PRNG_RESEED_REQ) {
+        uint32_t bits;
+
+        PRNG_UNLOCK();
+        bool reseeded = reseed_prng(&bits);
+        PRNG_LOCK();
+        rc = reseeded ? prng_generate(buffer, length, &done) : TC_CRYPTO_FAIL;
+    }
+
+    g_tinycrypt.rng_stats.reservoir_bytes += (uint32_t)taken;
+    g_tinycrypt.rng_stats.direct_bytes += (uint32_t)(length - taken);
+    PRNG_UNLOCK();
+
+    if (taken > 0) {
+        precompute_wake();
+    }
+    return rc == TC_CRYPTO_SUCCESS;
+}
+
+/**
+ * @brief Generate up to TINYCRYPT_RNG_REFILL_CHUNK reservoir bytes
+ *
+ * @return true if bytes were added
+ */
+static bool reservoir_refill(void) {
+#if TINYCRYPT_RNG_RESERVOIR_SIZE > 0
+    uint8_t chunk[TINYCRYPT_RNG_REFILL_CHUNK];
+    size_t done = 0;
+    int rc = TC_CRYPTO_FAIL;
+
+    PRNG_LOCK();
+    uint32_t missing = TINYCRYPT_RNG_RESERVOIR_SIZE - g_tinycrypt.reservoir_ready;
+    if (missing > sizeof(chunk)) {
+        missing = sizeof(chunk);
+    }
+    if (missing > 0) {
+        rc = prng_generate(chunk, missing, &done);
+    }
+    if (rc == TC_CRYPTO_SUCCESS) {
+        memcpy(&g_tinycrypt.reservoir[g_tinycrypt.reservoir_ready], chunk, missing);
+        g_tinycrypt.reservoir_ready += missing;
+    }
+    PRNG_UNLOCK();
+
+    crypto_secure_zero(chunk, sizeof(chunk));
+    if (rc == TC_HMAC_PRNG_RESEED_REQ) {
+        // Outside the lock; the reseed drops the reservoir, the next step refills it
+        uint32_t bits;
+        return reseed_prng(&bits);
+    }
+    return rc == TC_CRYPTO_SUCCESS;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief RNG hook used by tinycrypt for keys, nonces and blinding
+ */
+static int uecc_rng(uint8_t* dest, unsigned int size) {
+    return prng_fill(dest, size) ? 1 : 0;
+}
+
+static hal_result_t tinycrypt_generate_random(uint8_t* buffer, size_t length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!buffer || length == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!rng_ready()) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    return prng_fill(buffer, length) ? HAL_SUCCESS : HAL_ERROR_HARDWARE_FAILURE;
+}
+
+static hal_result_t tinycrypt_add_entropy(const uint8_t* data, size_t length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!data || length == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    // The PRNG wants at least 32 bytes of seed; condense the input
+    uint8_t seed[SHA256_DIGEST_SIZE];
+    sha256(data, length, seed);
+
+    // Mixed in but not credited: the source is unknown, and crediting caller
+    // data would let constant bytes open the TINYCRYPT_RNG_MIN_ENTROPY_BITS gate
+    PRNG_LOCK();
+    int rc = tc_hmac_prng_reseed(&g_tinycrypt.prng, seed, sizeof(seed), NULL, 0);
+    if (rc == TC_CRYPTO_SUCCESS) {
+        reservoir_discard();
+    }
+    PRNG_UNLOCK();
+
+    crypto_secure_zero(seed, sizeof(seed));
+    return rc == TC_CRYPTO_SUCCESS ? HAL_SUCCESS : HAL_ERROR_HARDWARE_FAILURE;
+}
+
+static hal_result_t tinycrypt_get_entropy_estimate(uint32_t* bits) {
+    if (!bits) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    *bits = g_tinycrypt.entropy_bits;
+    return HAL_SUCCESS;
+}
+
+// =============================================================================
+// Precomputation pool
+// =============================================================================
+
+#if defined(MCXA156_SERIES)
+/** @brief Task filling the pool and the RNG reservoir, NULL until started */
+static TaskHandle_t g_precompute_task = NULL;
+#endif
+
+/**
+ * @brief Let the precompute task replace a taken (or missing) entry
+ */
+static void precompute_wake(void) {
+#if defined(MCXA156_SERIES)
+    if (g_precompute_task) {
+        xTaskNotifyGive(g_precompute_task);
+    }
+#endif
+}
+
+/**
+ * @brief Take a precomputed P-256 key pair into freshly allocated buffers
+ */
+static bool take_pooled_key_pair(uint8_t* public_key, uint8_t* private_key) {
+#if TINYCRYPT_PRECOMPUTE
+    bool pooled = p256_pool_take_key_pair(public_key, private_key);
+    precompute_wake();
+    return pooled;
+#else
+    (void)public_key;
+    (void)private_key;
+    return false;
+#endif
+}
+
+// =============================================================================
+// Key management
+// =============================================================================
+
+/**
+ * @brief Claim a key slot and fill in the key descriptor
+ *
+ * @param data Output key storage
+ */
+static hal_result_t key_alloc(crypto_key_t* key, crypto_key_type_t type,
+                              crypto_algorithm_t algorithm, size_t size, uint8_t** data) {
+    hal_result_t result = key_slot_alloc(size, &key->handle, data);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    key->type = type;
+    key->algorithm = algorithm;
+    key->size = size;
+    // Software keys live in RAM and are persisted by export
+    key->flags = CRYPTO_KEY_FLAG_EXPORTABLE;
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Wipe and release key storage
+ */
+static void key_free(crypto_key_t* key) {
+    key_slot_free(key->handle);
+    memset(key, 0, sizeof(*key));
+}
+
+/**
+ * @brief Key material of a descriptor
+ *
+ * @return NULL for a deleted key or a handle that does not match the
+ *         descriptor's size
+ */
+static uint8_t* key_material(const crypto_key_t* key) {
+    return key ? key_slot_data(key->handle, key->size) : NULL;
+}
+
+/**
+ * @brief Public and private key sizes of a signature algorithm
+ *
+ * @return false if the backend does not sign with the algorithm
+ */
+static bool signature_key_sizes(crypto_algorithm_t algorithm, size_t* public_size,
+                                size_t* private_size) {
+    switch (algorithm) {
+        case CRYPTO_ALG_ECC_P256:
+            *public_size = TINYCRYPT_P256_PUBLIC_KEY_SIZE;
+            *private_size = TINYCRYPT_P256_PRIVATE_KEY_SIZE;
+            return true;
+
+#if TINYCRYPT_ED25519
+        case CRYPTO_ALG_ED25519:
+            *public_size = ED25519_PUBLIC_KEY_SIZE;
+            *private_size = ED25519_PRIVATE_KEY_SIZE;
+            return true;
+#endif
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Fill freshly allocated key buffers with a new key pair
+ */
+static bool make_key_pair(crypto_algorithm_t algorithm, uint8_t* public_key,
+                          uint8_t* private_key) {
+#if TINYCRYPT_ED25519
+    if (algorithm == CRYPTO_ALG_ED25519) {
+        uint8_t seed[ED25519_SEED_SIZE];
+
+        if (!prng_fill(seed, sizeof(seed))) {
+            return false;
+        }
+        ed25519_key_from_seed(private_key, seed);
+        memcpy(public_key, &private_key[ED25519_SEED_SIZE], ED25519_PUBLIC_KEY_SIZE);
+        crypto_secure_zero(seed, sizeof(seed));
+        return true;
+    }
+#else
+    (void)algorithm;
+#endif
+
+#if TINYCRYPT_P256_COMB
+    return p256_comb_make_key(public_key, private_key) != 0;
+#else
+    return uECC_make_key(public_key, private_key, p256_field_curve()) != 0;
+#endif
+}
+
+/**
+ * @brief Shared body of generate_key_pair() and the ephemeral key variant
+ *
+ * @param pooled Take a precomputed P-256 pair when one is ready
+ */
+static hal_result_t new_key_pair(crypto_algorithm_t algorithm, bool pooled,
+                                 crypto_key_t* public_key, crypto_key_t* private_key) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!public_key || !private_key || public_key == private_key) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    size_t public_size;
+    size_t private_size;
+    if (!signature_key_sizes(algorithm, &public_size, &private_size)) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (!rng_ready()) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    uint32_t start = cycle_counter_read();
+    uint8_t* public_data;
+    uint8_t* private_data;
+    hal_result_t result;
+
+    memset(public_key, 0, sizeof(*public_key));
+    memset(private_key, 0, sizeof(*private_key));
+
+    result = key_alloc(public_key, CRYPTO_KEY_TYPE_ECC_PUBLIC, algorithm, public_size,
+                       &public_data);
+    if (result != HAL_SUCCESS) {
+        goto cleanup_and_exit;
+    }
+
+    result = key_alloc(private_key, CRYPTO_KEY_TYPE_ECC_PRIVATE, algorithm, private_size,
+                       &private_data);
+    if (result != HAL_SUCCESS) {
+        goto cleanup_and_exit;
+    }
+
+    if (!(pooled && take_pooled_key_pair(public_data, private_data)) &&
+        !make_key_pair(algorithm, public_data, private_data)) {
+        result = HAL_ERROR_HARDWARE_FAILURE;
+        goto cleanup_and_exit;
+    }
+
+    record_op(CRYPTO_OP_GENERATE_KEY_PAIR, start);
+
+cleanup_and_exit:
+    if (result != HAL_SUCCESS) {
+        key_free(public_key);
+        key_free(private_key);
+    }
+    return result;
+}
+
+static hal_result_t tinycrypt_generate_key_pair(crypto_algorithm_t algorithm,
+                                                crypto_key_t* public_key,
+                                                crypto_key_t* private_key) {
+    return new_key_pair(algorithm, false, public_key, private_key);
+}
+
+/**
+ * @brief Check imported private key material
+ */
+static bool private_key_valid(crypto_algorithm_t algorithm, const uint8_t* key_data) {
+#if TINYCRYPT_ED25519
+    if (algorithm == CRYPTO_ALG_ED25519) {
+        // The public half must belong to the seed, signing trusts it
+        uint8_t derived[ED25519_PRIVATE_KEY_SIZE];
+        ed25519_key_from_seed(derived, key_data);
+        int mismatch = memcmp(&derived[ED25519_SEED_SIZE], &key_data[ED25519_SEED_SIZE],
+                              ED25519_PUBLIC_KEY_SIZE);
+        crypto_secure_zero(derived, sizeof(derived));
+        return mismatch == 0;
+    }
+#else
+    (void)algorithm;
+#endif
+
+    // Rejects 0 and scalars >= n
+    uint8_t public_key[TINYCRYPT_P256_PUBLIC_KEY_SIZE];
+    int ok = uECC_compute_public_key(key_data, public_key, p256_field_curve());
+    crypto_secure_zero(public_key, sizeof(public_key));
+    return ok != 0;
+}
+
+static hal_result_t tinycrypt_import_key(const uint8_t* key_data, size_t key_size,
+                                         crypto_key_type_t type, crypto_key_t* key) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!key_data || !key) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    crypto_algorithm_t algorithm;
+    size_t size = key_size;
+
+    switch (type) {
+        case CRYPTO_KEY_TYPE_SYMMETRIC:
+            if (key_size != TC_AES_KEY_SIZE) {
+                return key_size == 32U ? HAL_ERROR_NOT_SUPPORTED : HAL_ERROR_INVALID_PARAM;
+            }
+            algorithm = CRYPTO_ALG_AES_128;
+            break;
+
+        case CRYPTO_KEY_TYPE_ECC_PRIVATE:
+#if TINYCRYPT_ED25519
+            if (key_size == ED25519_PRIVATE_KEY_SIZE) {
+                algorithm = CRYPTO_ALG_ED25519;
+                break;
+            }
+#endif
+            if (key_size != TINYCRYPT_P256_PRIVATE_KEY_SIZE) {
+                return HAL_ERROR_INVALID_PARAM;
+            }
+            algorithm = CRYPTO_ALG_ECC_P256;
+            break;
+
+        case CRYPTO_KEY_TYPE_ECC_PUBLIC:
+#if TINYCRYPT_ED25519
+            if (key_size == ED25519_PUBLIC_KEY_SIZE) {
+                if (!ed25519_valid_public_key(key_data)) {
+                    return HAL_ERROR_INVALID_PARAM;
+                }
+                algorithm = CRYPTO_ALG_ED25519;
+                break;
+            }
+#endif
+            // Drop the SEC1 uncompressed point prefix
+            if (key_size == TINYCRYPT_P256_PUBLIC_KEY_SIZE + 1U && key_data[0] == 0x04) {
+                key_data++;
+                size--;
+            }
+            if (size != TINYCRYPT_P256_PUBLIC_KEY_SIZE ||
+                uECC_valid_public_key(key_data, p256_field_curve()) != 0) {
+                return HAL_ERROR_INVALID_PARAM;
+            }
+            algorithm = CRYPTO_ALG_ECC_P256;
+            break;
+
+        default:
+            return HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    if (type == CRYPTO_KEY_TYPE_ECC_PRIVATE && !private_key_valid(algorithm, key_data)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    uint8_t* data;
+    hal_result_t result = key_alloc(key, type, algorithm, size, &data);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    memcpy(data, key_data, size);
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_export_key(const crypto_key_t* key, uint8_t* buffer,
+                                         size_t* buffer_size) {
+    const uint8_t* data = key_material(key);
+    if (!data || !buffer || !buffer_size) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!(key->flags & CRYPTO_KEY_FLAG_EXPORTABLE)) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (*buffer_size < key->size) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    memcpy(buffer, data, key->size);
+    *buffer_size = key->size;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_delete_key(crypto_key_t* key) {
+    if (!key) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    key_free(key);
+    return HAL_SUCCESS;
+}
+
+// =============================================================================
+// Signatures
+// =============================================================================
+
+/**
+ * @brief Append a 32-byte big-endian integer as a DER INTEGER
+ *
+ * @return Bytes written
+ */
+static size_t der_put_integer(uint8_t* out, const uint8_t* value) {
+    size_t skip = 0;
+
+    // Minimal encoding: strip leading zeros, keep one byte
+    while (skip < NUM_ECC_BYTES - 1U && value[skip] == 0) {
+        skip++;
+    }
+
+    size_t length = NUM_ECC_BYTES - skip;
+    bool pad = (value[skip] & 0x80) != 0;
+
+    out[0] = 0x02;
+    out[1] = (uint8_t)(length + (pad ? 1U : 0U));
+    if (pad) {
+        out[2] = 0x00;
+    }
+    memcpy(&out[2 + (pad ? 1U : 0U)], &value[skip], length);
+    return 2U + (pad ? 1U : 0U) + length;
+}
+
+/**
+ * @brief Read a DER INTEGER into a right-aligned 32-byte value
+ *
+ * @return Bytes consumed, 0 if the encoding is invalid or too large
+ */
+static size_t der_get_integer(const uint8_t* in, size_t available, uint8_t* value) {
+    if (available < 3U || in[0] != 0x02) {
+        return 0;
+    }
+
+    size_t length = in[1];
+    const uint8_t* bytes = &in[2];
+
+    if (length == 0 || length > available - 2U || (bytes[0] & 0x80) != 0) {
+        return 0;
+    }
+    if (length > 1U && bytes[0] == 0 && (bytes[1] & 0x80) == 0) {
+        return 0;   // Not minimal
+    }
+
+    size_t consumed = 2U + length;
+    if (bytes[0] == 0 && length > 1U) {
+        bytes++;
+        length--;
+    }
+    if (length > NUM_ECC_BYTES) {
+        return 0;
+    }
+
+    memset(value, 0, NUM_ECC_BYTES);
+    memcpy(&value[NUM_ECC_BYTES - length], bytes, length);
+    return consumed;
+}
+
+/**
+ * @brief Raw P-256 r || s over a SHA-256 digest
+ *
+ * Uses a precomputed nonce when one is ready, which leaves two modular
+ * multiplications on the request path.
+ */
+static bool sign_p256_digest(const uint8_t* private_key, const uint8_t* digest,
+                             uint8_t* raw) {
+#if TINYCRYPT_PRECOMPUTE
+    p256_presign_t presign;
+    bool pooled = p256_pool_take_presign(&presign);
+    int ok = pooled && p256_comb_sign_presigned(private_key, digest, SHA256_DIGEST_SIZE,
+                                                &presign, raw);
+
+    crypto_secure_zero(&presign, sizeof(presign));
+    precompute_wake();
+    if (ok) {
+        return true;
+    }
+#endif
+
+#if TINYCRYPT_P256_COMB
+    return p256_comb_sign(private_key, digest, SHA256_DIGEST_SIZE, raw) != 0;
+#else
+    return uECC_sign(private_key, digest, SHA256_DIGEST_SIZE, raw, p256_field_curve()) != 0;
+#endif
+}
+
+#if TINYCRYPT_ED25519
+/**
+ * @brief Ed25519 branch of sign(): raw R || S over the whole message
+ */
+static hal_result_t sign_ed25519(const crypto_key_t* private_key, const uint8_t* key_data,
+                                 const uint8_t* data, size_t data_length,
+                                 uint8_t* signature, size_t* signature_length) {
+    if (private_key->size != ED25519_PRIVATE_KEY_SIZE) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (*signature_length < ED25519_SIGNATURE_SIZE) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    uint32_t start = cycle_counter_read();
+
+    ed25519_sign(signature, data, data_length, key_data);
+    *signature_length = ED25519_SIGNATURE_SIZE;
+
+    record_op(CRYPTO_OP_SIGN, start);
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Ed25519 branch of verify()
+ */
+static hal_result_t verify_ed25519(const crypto_key_t* public_key, const uint8_t* key_data,
+                                   const uint8_t* data, size_t data_length,
+                                   const uint8_t* signature, size_t signature_length) {
+    if (public_key->size != ED25519_PUBLIC_KEY_SIZE ||
+        signature_length != ED25519_SIGNATURE_SIZE) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    uint32_t start = cycle_counter_read();
+
+    if (!ed25519_verify(data, data_length, signature, key_data)) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    record_op(CRYPTO_OP_VERIFY, start);
+    return HAL_SUCCESS;
+}
+#endif
+
+static hal_result_t tinycrypt_sign(const crypto_key_t* private_key,
+                                   const uint8_t* data, size_t data_length,
+                                   uint8_t* signature, size_t* signature_length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    const uint8_t* key_data = key_material(private_key);
+    if (!key_data || (!data && data_length > 0) || !signature || !signature_length) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (private_key->type != CRYPTO_KEY_TYPE_ECC_PRIVATE) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+#if TINYCRYPT_ED25519
+    if (private_key->algorithm == CRYPTO_ALG_ED25519) {
+        return sign_ed25519(private_key, key_data, data, data_length,
+                            signature, signature_length);
+    }
+#endif
+    if (private_key->algorithm != CRYPTO_ALG_ECC_P256) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (private_key->size != TINYCRYPT_P256_PRIVATE_KEY_SIZE) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    // The nonce comes from the RNG (pooled nonces only exist once it is ready)
+    if (!rng_ready()) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    uint32_t start = cycle_counter_read();
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    uint8_t raw[2 * NUM_ECC_BYTES];
+    uint8_t der[TINYCRYPT_P256_MAX_DER_SIGNATURE];
+    hal_result_t result = HAL_SUCCESS;
+
+    sha256(data, data_length, digest);
+    if (!sign_p256_digest(key_data, digest, raw)) {
+        result = HAL_ERROR_HARDWARE_FAILURE;
+        goto cleanup_and_exit;
+    }
+
+    size_t length = 2;
+    length += der_put_integer(&der[length], raw);
+    length += der_put_integer(&der[length], &raw[NUM_ECC_BYTES]);
+    der[0] = 0x30;
+    der[1] = (uint8_t)(length - 2U);
+
+    if (*signature_length < length) {
+        result = HAL_ERROR_INSUFFICIENT_MEMORY;
+        goto cleanup_and_exit;
+    }
+
+    memcpy(signature, der, length);
+    *signature_length = length;
+    record_op(CRYPTO_OP_SIGN, start);
+
+cleanup_and_exit:
+    crypto_secure_zero(digest, sizeof(digest));
+    return result;
+}
+
+static hal_result_t tinycrypt_verify(const crypto_key_t* public_key,
+                                     const uint8_t* data, size_t data_length,
+                                     const uint8_t* signature, size_t signature_length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    const uint8_t* key_data = key_material(public_key);
+    if (!key_data || (!data && data_length > 0) || !signature) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (public_key->type != CRYPTO_KEY_TYPE_ECC_PUBLIC) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+#if TINYCRYPT_ED25519
+    if (public_key->algorithm == CRYPTO_ALG_ED25519) {
+        return verify_ed25519(public_key, key_data, data, data_length,
+                              signature, signature_length);
+    }
+#endif
+    if (public_key->algorithm != CRYPTO_ALG_ECC_P256) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (public_key->size != TINYCRYPT_P256_PUBLIC_KEY_SIZE) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    uint32_t start = cycle_counter_read();
+    uint8_t raw[2 * NUM_ECC_BYTES];
+    uint8_t digest[SHA256_DIGEST_SIZE];
+
+    // SEQUENCE { INTEGER r, INTEGER s }, short form length only
+    if (signature_length < 8U || signature[0] != 0x30 ||
+        signature[1] != signature_length - 2U) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    size_t offset = 2;
+    size_t used = der_get_integer(&signature[offset], signature_length - offset, raw);
+    if (used == 0) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    offset += used;
+
+    used = der_get_integer(&signature[offset], signature_length - offset, &raw[NUM_ECC_BYTES]);
+    if (used == 0 || offset + used != signature_length) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    sha256(data, data_length, digest);
+    if (!uECC_verify(key_data, digest, sizeof(digest), raw, p256_field_curve())) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    record_op(CRYPTO_OP_VERIFY, start);
+    return HAL_SUCCESS;
+}
+
+// =============================================================================
+// Hashing
+// =============================================================================
+
+/**
+ * @brief Digest size of a supported algorithm, 0 if unsupported
+ */
+static size_t hash_digest_size(crypto_hash_algorithm_t algorithm) {
+    switch (algorithm) {
+        case CRYPTO_HASH_SHA256:    return SHA256_DIGEST_SIZE;
+        case CRYPTO_HASH_SHA512:    return SHA512_DIGEST_SIZE;
+        default:                    return 0;
+    }
+}
+
+static hal_result_t tinycrypt_hash(crypto_hash_algorithm_t algorithm,
+                                   const uint8_t* data, size_t data_length,
+                                   uint8_t* hash, size_t* hash_length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if ((!data && data_length > 0) || !hash || !hash_length) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    size_t digest_size = hash_digest_size(algorithm);
+    if (digest_size == 0) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (*hash_length < digest_size) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    uint32_t start = cycle_counter_read();
+
+    if (algorithm == CRYPTO_HASH_SHA512) {
+        sha512(data, data_length, hash);
+    } else {
+        sha256(data, data_length, hash);
+    }
+    *hash_length = digest_size;
+
+    record_op(CRYPTO_OP_HASH, start);
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Check that a context was set up by hash_init() and get its algorithm
+ */
+static bool hash_context_active(const crypto_context_t* context,
+                                crypto_hash_algorithm_t* algorithm) {
+    if (!(context->flags & HASH_CONTEXT_ACTIVE)) {
+        return false;
+    }
+
+    *algorithm = (crypto_hash_algorithm_t)(context->flags & ~HASH_CONTEXT_ACTIVE);
+    return hash_digest_size(*algorithm) != 0;
+}
+
+/**
+ * @brief Hash state stored inline in a context
+ */
+static hash_state_t* hash_context_state(crypto_context_t* context) {
+    return (hash_state_t*)(void*)context->state.bytes;
+}
+
+static hal_result_t tinycrypt_hash_init(crypto_hash_algorithm_t algorithm,
+                                        crypto_context_t* context) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!context) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (hash_digest_size(algorithm) == 0) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    hash_state_t* state = hash_context_state(context);
+    if (algorithm == CRYPTO_HASH_SHA512) {
+        sha512_init(&state->sha512);
+    } else {
+        sha256_init(&state->sha256);
+    }
+    context->flags = HASH_CONTEXT_ACTIVE | (uint32_t)algorithm;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_hash_update(crypto_context_t* context,
+                                          const uint8_t* data, size_t length) {
+    if (!context || (!data && length > 0)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    crypto_hash_algorithm_t algorithm;
+    if (!hash_context_active(context, &algorithm)) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    hash_state_t* state = hash_context_state(context);
+    if (algorithm == CRYPTO_HASH_SHA512) {
+        sha512_update(&state->sha512, data, length);
+    } else {
+        sha256_update(&state->sha256, data, length);
+    }
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_hash_finalize(crypto_context_t* context,
+                                            uint8_t* hash, size_t* hash_length) {
+    if (!context || !hash || !hash_length) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    crypto_hash_algorithm_t algorithm;
+    if (!hash_context_active(context, &algorithm)) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    hash_state_t* state = hash_context_state(context);
+    size_t digest_size = hash_digest_size(algorithm);
+    if (*hash_length < digest_size) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    // Both wipe the state
+    if (algorithm == CRYPTO_HASH_SHA512) {
+        sha512_final(&state->sha512, hash);
+    } else {
+        sha256_final(&state->sha256, hash);
+    }
+    *hash_length = digest_size;
+    context->flags = 0;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_hash_clone(const crypto_context_t* source,
+                                         crypto_context_t* destination) {
+    if (!source || !destination) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    crypto_hash_algorithm_t algorithm;
+    if (!hash_context_active(source, &algorithm)) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    // The state has no pointers: copying the context copies the midstate
+    if (destination != source) {
+        *destination = *source;
+    }
+    return HAL_SUCCESS;
+}
+
+// =============================================================================
+// Symmetric encryption
+// =============================================================================
+
+/**
+ * @brief Check that a key is an AES-128 key
+ */
+static bool is_aes128_key(const crypto_key_t* key) {
+    return key_material(key) && key->type == CRYPTO_KEY_TYPE_SYMMETRIC &&
+           key->algorithm == CRYPTO_ALG_AES_128 && key->size == TC_AES_KEY_SIZE;
+}
+
+/**
+ * @brief AES-128-CCM seal: nonce || ciphertext || tag
+ *
+ * @param sealed Output of plaintext_length + TINYCRYPT_CCM_OVERHEAD bytes
+ */
+static bool ccm_seal(const crypto_key_t* key, const uint8_t* aad, size_t aad_length,
+                     const uint8_t* plaintext, size_t plaintext_length, uint8_t* sealed) {
+    struct tc_aes_key_sched_struct sched;
+    struct tc_ccm_mode_struct ccm;
+    bool ok;
+
+    // Fresh random nonce per message, sent in front of the ciphertext
+    if (!prng_fill(sealed, TINYCRYPT_CCM_NONCE_SIZE)) {
+        return false;
+    }
+
+    ok = tc_aes128_set_encrypt_key(&sched, key_material(key)) == TC_CRYPTO_SUCCESS &&
+         tc_ccm_config(&ccm, &sched, sealed, TINYCRYPT_CCM_NONCE_SIZE,
+                       TINYCRYPT_CCM_TAG_SIZE) == TC_CRYPTO_SUCCESS &&
+         tc_ccm_generation_encryption(&sealed[TINYCRYPT_CCM_NONCE_SIZE],
+                                      (unsigned int)(plaintext_length + TINYCRYPT_CCM_TAG_SIZE),
+                                      aad, (unsigned int)aad_length,
+                                      plaintext, (unsigned int)plaintext_length,
+                                      &ccm) == TC_CRYPTO_SUCCESS;
+
+    crypto_secure_zero(&sched, sizeof(sched));
+    return ok;
+}
+
+/**
+ * @brief AES-128-CCM open of a ccm_seal() output
+ *
+ * @param plaintext Output of sealed_length - TINYCRYPT_CCM_OVERHEAD bytes,
+ *                  zeroed when the tag does not match
+ */
+static bool ccm_open(const crypto_key_t* key, const uint8_t* aad, size_t aad_length,
+                     const uint8_t* sealed, size_t sealed_length, uint8_t* plaintext) {
+    struct tc_aes_key_sched_struct sched;
+    struct tc_ccm_mode_struct ccm;
+    uint8_t nonce[TINYCRYPT_CCM_NONCE_SIZE];
+    size_t length = sealed_length - TINYCRYPT_CCM_OVERHEAD;
+    bool ok;
+
+    memcpy(nonce, sealed, sizeof(nonce));
+    ok = tc_aes128_set_encrypt_key(&sched, key_material(key)) == TC_CRYPTO_SUCCESS &&
+         tc_ccm_config(&ccm, &sched, nonce, sizeof(nonce),
+                       TINYCRYPT_CCM_TAG_SIZE) == TC_CRYPTO_SUCCESS &&
+         tc_ccm_decryption_verification(plaintext, (unsigned int)length,
+                                        aad, (unsigned int)aad_length,
+                                        &sealed[TINYCRYPT_CCM_NONCE_SIZE],
+                                        (unsigned int)(sealed_length - TINYCRYPT_CCM_NONCE_SIZE),
+                                        &ccm) == TC_CRYPTO_SUCCESS;
+    if (!ok) {
+        // tinycrypt leaves unauthenticated plaintext behind
+        crypto_secure_zero(plaintext, length);
+    }
+
+    crypto_secure_zero(&sched, sizeof(sched));
+    return ok;
+}
+
+static hal_result_t tinycrypt_encrypt(const crypto_key_t* key,
+                                      const uint8_t* plaintext, size_t plaintext_length,
+                                      uint8_t* ciphertext, size_t* ciphertext_length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!key || (!plaintext && plaintext_length > 0) || !ciphertext || !ciphertext_length ||
+        plaintext_length >= TC_CCM_PAYLOAD_MAX_BYTES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!is_aes128_key(key)) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (*ciphertext_length < plaintext_length + TINYCRYPT_CCM_OVERHEAD) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+    if (!rng_ready()) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    if (!ccm_seal(key, NULL, 0, plaintext, plaintext_length, ciphertext)) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    *ciphertext_length = plaintext_length + TINYCRYPT_CCM_OVERHEAD;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_decrypt(const crypto_key_t* key,
+                                      const uint8_t* ciphertext, size_t ciphertext_length,
+                                      uint8_t* plaintext, size_t* plaintext_length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!key || !ciphertext || !plaintext || !plaintext_length ||
+        ciphertext_length < TINYCRYPT_CCM_OVERHEAD ||
+        ciphertext_length - TINYCRYPT_CCM_NONCE_SIZE >= TC_CCM_PAYLOAD_MAX_BYTES) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!is_aes128_key(key)) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    size_t length = ciphertext_length - TINYCRYPT_CCM_OVERHEAD;
+    if (*plaintext_length < length) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    if (!ccm_open(key, NULL, 0, ciphertext, ciphertext_length, plaintext)) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    *plaintext_length = length;
+    return HAL_SUCCESS;
+}
+
+// =============================================================================
+// Device information
+// =============================================================================
+
+static hal_result_t tinycrypt_get_capabilities(uint32_t* capabilities) {
+    if (!capabilities) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    // Everything runs in software
+    *capabilities = 0;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_get_device_id(uint8_t* device_id, size_t* id_length) {
+    if (!device_id || !id_length) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+#if defined(MCXA156_SERIES)
+    if (*id_length < DEVICE_ID_SIZE) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    ROMAPI_GetUUID(device_id);
+    *id_length = DEVICE_ID_SIZE;
+    return HAL_SUCCESS;
+#else
+    return HAL_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+// =============================================================================
+// Lifecycle
+// =============================================================================
+
+static hal_result_t tinycrypt_init(void) {
+    if (g_tinycrypt.initialized) {
+        return HAL_SUCCESS;
+    }
+
+    hal_result_t result = cycle_counter_init();
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    // A failing ADC leaves the RNG uncredited, see TINYCRYPT_RNG_MIN_ENTROPY_BITS
+    (void)lpadc_entropy_init();
+
+    // Personalization: device unique string, last line of defence if the seed is weak
+    static const uint8_t k_personalization[] = "usb-key tinycrypt rng";
+    uint8_t personalization[sizeof(k_personalization) + DEVICE_ID_SIZE];
+    size_t id_length = DEVICE_ID_SIZE;
+
+    memcpy(personalization, k_personalization, sizeof(k_personalization));
+    if (tinycrypt_get_device_id(&personalization[sizeof(k_personalization)],
+                                &id_length) != HAL_SUCCESS) {
+        id_length = 0;
+    }
+
+    uint32_t bits;
+
+    memset(&g_tinycrypt, 0, sizeof(g_tinycrypt));
+    if (tc_hmac_prng_init(&g_tinycrypt.prng, personalization,
+                          (unsigned int)(sizeof(k_personalization) + id_length)) != TC_CRYPTO_SUCCESS ||
+        !reseed_prng(&bits)) {
+        crypto_secure_zero(&g_tinycrypt.prng, sizeof(g_tinycrypt.prng));
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+    if (bits == 0) {
+        // No noise yet: the first precompute step tries again
+        g_tinycrypt.output_since_reseed = TINYCRYPT_RNG_RESEED_BYTES;
+    }
+
+    uECC_set_rng(uecc_rng);
+    g_tinycrypt.initialized = true;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_deinit(void) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_SUCCESS;
+    }
+
+    PRNG_LOCK();
+    uECC_set_rng(NULL);
+    crypto_secure_zero(&g_tinycrypt, sizeof(g_tinycrypt));
+    PRNG_UNLOCK();
+    lpadc_entropy_deinit();
+    key_slot_free_all();
+#if TINYCRYPT_PRECOMPUTE
+    p256_pool_clear();
+#endif
+    return HAL_SUCCESS;
+}
+
+static hal_result_t tinycrypt_reset(void) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    tinycrypt_crypto_reset_op_stats();
+#if TINYCRYPT_PRECOMPUTE
+    p256_pool_clear();
+    precompute_wake();
+#endif
+
+    uint32_t bits;
+    return reseed_prng(&bits) ? HAL_SUCCESS : HAL_ERROR_HARDWARE_FAILURE;
+}
+
+static bool tinycrypt_is_initialized(void) {
+    return g_tinycrypt.initialized;
+}
+
+// =============================================================================
+// COSE algorithms
+// =============================================================================
+
+size_t tinycrypt_crypto_get_cose_algorithms(int32_t* algorithms, size_t max_count) {
+    static const int32_t k_preference[] = {
+#if TINYCRYPT_ED25519
+        CRYPTO_COSE_ALG_EDDSA,
+#endif
+        CRYPTO_COSE_ALG_ES256,
+    };
+    size_t count = sizeof(k_preference) / sizeof(k_preference[0]);
+
+    if (!algorithms) {
+        return 0;
+    }
+    if (count > max_count) {
+        count = max_count;
+    }
+
+    memcpy(algorithms, k_preference, count * sizeof(k_preference[0]));
+    return count;
+}
+
+hal_result_t tinycrypt_crypto_algorithm_from_cose(int32_t cose_algorithm,
+                                                  crypto_algorithm_t* algorithm) {
+    if (!algorithm) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    switch (cose_algorithm) {
+        case CRYPTO_COSE_ALG_ES256:
+            *algorithm = CRYPTO_ALG_ECC_P256;
+            return HAL_SUCCESS;
+
+#if TINYCRYPT_ED25519
+        case CRYPTO_COSE_ALG_EDDSA:
+            *algorithm = CRYPTO_ALG_ED25519;
+            return HAL_SUCCESS;
+#endif
+
+        default:
+            return HAL_ERROR_NOT_SUPPORTED;
+    }
+}
+
+// =============================================================================
+// Key agreement
+// =============================================================================
+
+hal_result_t tinycrypt_crypto_generate_ephemeral_key(crypto_key_t* public_key,
+                                                     crypto_key_t* private_key) {
+    return new_key_pair(CRYPTO_ALG_ECC_P256, true, public_key, private_key);
+}
+
+hal_result_t tinycrypt_crypto_key_agreement(const crypto_key_t* private_key,
+                                            const crypto_key_t* peer_public_key,
+                                            uint8_t* shared_secret, size_t* secret_length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    const uint8_t* private_data = key_material(private_key);
+    const uint8_t* peer_data = key_material(peer_public_key);
+    if (!private_data || !peer_data || !shared_secret || !secret_length) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (private_key->type != CRYPTO_KEY_TYPE_ECC_PRIVATE ||
+        private_key->algorithm != CRYPTO_ALG_ECC_P256 ||
+        peer_public_key->type != CRYPTO_KEY_TYPE_ECC_PUBLIC ||
+        peer_public_key->algorithm != CRYPTO_ALG_ECC_P256) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (private_key->size != TINYCRYPT_P256_PRIVATE_KEY_SIZE ||
+        peer_public_key->size != TINYCRYPT_P256_PUBLIC_KEY_SIZE) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (*secret_length < TINYCRYPT_P256_SHARED_SECRET_SIZE) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    if (!uECC_shared_secret(peer_data, private_data, shared_secret,
+                            p256_field_curve())) {
+        crypto_secure_zero(shared_secret, TINYCRYPT_P256_SHARED_SECRET_SIZE);
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    *secret_length = TINYCRYPT_P256_SHARED_SECRET_SIZE;
+    return HAL_SUCCESS;
+}
+
+// =============================================================================
+// Key wrapping
+// =============================================================================
+
+/** @brief Algorithm tags inside a wrapped key, part of the stored format */
+enum {
+    WRAP_ALG_P256 = 1,
+    WRAP_ALG_ED25519 = 2,
+};
+
+/** @brief Plaintext of a wrapped key: tag || 32-byte secret */
+#define WRAP_PLAINTEXT_SIZE     (TINYCRYPT_WRAPPED_KEY_SIZE - TINYCRYPT_CCM_OVERHEAD)
+
+_Static_assert(TINYCRYPT_P256_PRIVATE_KEY_SIZE == WRAP_PLAINTEXT_SIZE - 1U,
+               "wrapped P-256 scalar size");
+#if TINYCRYPT_ED25519
+_Static_assert(ED25519_SEED_SIZE == WRAP_PLAINTEXT_SIZE - 1U, "wrapped Ed25519 seed size");
+#endif
+
+hal_result_t tinycrypt_crypto_wrap_key(const crypto_key_t* wrapping_key,
+                                       const crypto_key_t* private_key,
+                                       const uint8_t* aad, size_t aad_length,
+                                       uint8_t* wrapped, size_t* wrapped_length) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    const uint8_t* key_data = key_material(private_key);
+    if (!wrapping_key || !key_data || (!aad && aad_length > 0) ||
+        aad_length >= TC_CCM_AAD_MAX_BYTES || !wrapped || !wrapped_length) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!is_aes128_key(wrapping_key) || private_key->type != CRYPTO_KEY_TYPE_ECC_PRIVATE) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    uint8_t plaintext[WRAP_PLAINTEXT_SIZE];
+    hal_result_t result = HAL_SUCCESS;
+
+    // Ed25519 keeps only the seed: the public half is rederived on unwrap
+    if (private_key->algorithm == CRYPTO_ALG_ECC_P256 &&
+        private_key->size == TINYCRYPT_P256_PRIVATE_KEY_SIZE) {
+        plaintext[0] = WRAP_ALG_P256;
+#if TINYCRYPT_ED25519
+    } else if (private_key->algorithm == CRYPTO_ALG_ED25519 &&
+               private_key->size == ED25519_PRIVATE_KEY_SIZE) {
+        plaintext[0] = WRAP_ALG_ED25519;
+#endif
+    } else {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (*wrapped_length < TINYCRYPT_WRAPPED_KEY_SIZE) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+    if (!rng_ready()) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    memcpy(&plaintext[1], key_data, WRAP_PLAINTEXT_SIZE - 1U);
+    if (!ccm_seal(wrapping_key, aad, aad_length, plaintext, sizeof(plaintext), wrapped)) {
+        result = HAL_ERROR_HARDWARE_FAILURE;
+        goto cleanup_and_exit;
+    }
+
+    *wrapped_length = TINYCRYPT_WRAPPED_KEY_SIZE;
+
+cleanup_and_exit:
+    crypto_secure_zero(plaintext, sizeof(plaintext));
+    return result;
+}
+
+hal_result_t tinycrypt_crypto_unwrap_key(const crypto_key_t* wrapping_key,
+                                         const uint8_t* wrapped, size_t wrapped_length,
+                                         const uint8_t* aad, size_t aad_length,
+                                         crypto_key_t* private_key) {
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!wrapping_key || !wrapped || wrapped_length != TINYCRYPT_WRAPPED_KEY_SIZE ||
+        (!aad && aad_length > 0) || aad_length >= TC_CCM_AAD_MAX_BYTES || !private_key) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!is_aes128_key(wrapping_key)) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    uint8_t plaintext[WRAP_PLAINTEXT_SIZE];
+    uint8_t* data;
+    hal_result_t result;
+
+    memset(private_key, 0, sizeof(*private_key));
+    if (!ccm_open(wrapping_key, aad, aad_length, wrapped, wrapped_length, plaintext)) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    switch (plaintext[0]) {
+        case WRAP_ALG_P256:
+            result = key_alloc(private_key, CRYPTO_KEY_TYPE_ECC_PRIVATE, CRYPTO_ALG_ECC_P256,
+                               TINYCRYPT_P256_PRIVATE_KEY_SIZE, &data);
+            if (result == HAL_SUCCESS) {
+                memcpy(data, &plaintext[1], TINYCRYPT_P256_PRIVATE_KEY_SIZE);
+            }
+            break;
+
+#if TINYCRYPT_ED25519
+        case WRAP_ALG_ED25519:
+            result = key_alloc(private_key, CRYPTO_KEY_TYPE_ECC_PRIVATE, CRYPTO_ALG_ED25519,
+                               ED25519_PRIVATE_KEY_SIZE, &data);
+            if (result == HAL_SUCCESS) {
+                ed25519_key_from_seed(data, &plaintext[1]);
+            }
+            break;
+#endif
+
+        default:
+            result = HAL_ERROR_HARDWARE_FAILURE;
+            break;
+    }
+
+    crypto_secure_zero(plaintext, sizeof(plaintext));
+    return result;
+}
+
+// =============================================================================
+// Precomputation
+// =============================================================================
+
+bool tinycrypt_crypto_precompute(void) {
+    if (!g_tinycrypt.initialized) {
+        return false;
+    }
+
+    // Reseed off the request path; without noise, retry on the next call
+    if (g_tinycrypt.output_since_reseed >= TINYCRYPT_RNG_RESEED_BYTES) {
+        uint32_t bits;
+        if (reseed_prng(&bits) && bits > 0) {
+            return true;
+        }
+    }
+    if (!rng_ready()) {
+        return false;
+    }
+
+#if TINYCRYPT_PRECOMPUTE
+    // Draws from the reservoir, so refill it afterwards
+    if (p256_pool_fill()) {
+        return true;
+    }
+#endif
+    return reservoir_refill();
+}
+
+#if defined(MCXA156_SERIES)
+/**
+ * @brief Precompute task: reseed, fill the pool and the RNG reservoir, then
+ *        sleep until something is taken
+ *
+ * Runs just above idle, so every fill step is preempted by USB and request
+ * processing.
+ */
+static void precompute_task(void* param) {
+    (void)param;
+
+    for (;;) {
+        while (tinycrypt_crypto_precompute()) {
+        }
+        // Also retry periodically: the RNG may still be waiting for entropy
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TINYCRYPT_PRECOMPUTE_RETRY_MS));
+    }
+}
+#endif
+
+hal_result_t tinycrypt_crypto_start_precompute(void) {
+#if defined(MCXA156_SERIES)
+    if (g_precompute_task) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    if (xTaskCreate(precompute_task, "crypto precompute",
+                    TINYCRYPT_PRECOMPUTE_STACK_SIZE / sizeof(portSTACK_TYPE),
+                    NULL, TINYCRYPT_PRECOMPUTE_TASK_PRIORITY, &g_precompute_task) != pdPASS) {
+        g_precompute_task = NULL;
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+    return HAL_SUCCESS;
+#else
+    return HAL_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+hal_result_t tinycrypt_crypto_get_rng_stats(tinycrypt_rng_stats_t* stats) {
+    if (!stats) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!g_tinycrypt.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    PRNG_LOCK();
+    *stats = g_tinycrypt.rng_stats;
+    stats->entropy_bits = g_tinycrypt.entropy_bits;
+#if TINYCRYPT_RNG_RESERVOIR_SIZE > 0
+    stats->reservoir_ready = g_tinycrypt.reservoir_ready;
+#endif
+    PRNG_UNLOCK();
+    return HAL_SUCCESS;
+}
+
+// =============================================================================
+// Profiling
+// =============================================================================
+
+hal_result_t tinycrypt_crypto_get_op_stats(crypto_op_t op, crypto_op_stats_t* stats) {
+    if ((unsigned)op >= CRYPTO_OP_COUNT || !stats) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    *stats = g_tinycrypt.stats[op];
+    return HAL_SUCCESS;
+}
+
+void tinycrypt_crypto_reset_op_stats(void) {
+    memset(g_tinycrypt.stats, 0, sizeof(g_tinycrypt.stats));
+}
+
+const char* tinycrypt_crypto_op_name(crypto_op_t op) {
+    switch (op) {
+        case CRYPTO_OP_GENERATE_KEY_PAIR:   return "generate_key_pair";
+        case CRYPTO_OP_SIGN:                return "sign";
+        case CRYPTO_OP_VERIFY:              return "verify";
+        case CRYPTO_OP_HASH:                return "hash";
+        default:                            return "unknown";
+    }
+}
+
+/**
+ * @brief tinycrypt crypto HAL instance
+ */
+crypto_hal_t tinycrypt_crypto_hal = {
+    .base = {
+        .init = tinycrypt_init,
+        .deinit = tinycrypt_deinit,
+        .reset = tinycrypt_reset,
+        .is_initialized = tinycrypt_is_initialized,
+    },
+    .generate_key_pair = tinycrypt_generate_key_pair,
+    .import_key = tinycrypt_import_key,
+    .export_key = tinycrypt_export_key,
+    .delete_key = tinycrypt_delete_key,
+    .sign = tinycrypt_sign,
+    .verify = tinycrypt_verify,
+    .hash = tinycrypt_hash,
+    .hash_init = tinycrypt_hash_init,
+    .hash_update = tinycrypt_hash_update,
+    .hash_finalize = tinycrypt_hash_finalize,
+    .hash_clone = tinycrypt_hash_clone,
+    .encrypt = tinycrypt_encrypt,
+    .decrypt = tinycrypt_decrypt,
+    .rng = {
+        .generate_random = tinycrypt_generate_random,
+        .add_entropy = tinycrypt_add_entropy,
+        .get_entropy_estimate = tinycrypt_get_entropy_estimate,
+    },
+    .get_capabilities = tinycrypt_get_capabilities,
+    .get_device_id = tinycrypt_get_device_id,
+};
@@ -0,0 +1,349 @@
+#ifndef TINYCRYPT_CRYPTO_HAL_H
+#define TINYCRYPT_CRYPTO_HAL_H
+
+/**
+ * @file tinycrypt_crypto_hal.h
+ * @brief Software Crypto HAL Backend on tinycrypt
+ * @author USB Key Authentication Team
+ * @date 2025-09-09
+ * @version 1.0
+ *
+ * crypto_hal_t implementation built on the tinycrypt copy vendored by the
+ * MCXA156 SDK (middleware/mcuboot_opensource/ext/tinycrypt). Runs unchanged
+ * on MCXA156 and on the host, and records the cycle cost of every key
+ * generation, signature, verification and hash so the CTAP2 command budget
+ * can be checked on the real core.
+ *
+ * Supported:
+ * - CRYPTO_ALG_ECC_P256: generate_key_pair, sign (ECDSA over SHA-256,
+ *   DER encoded), verify. Private keys are 32-byte scalars, public keys
+ *   64-byte X||Y (import also accepts the 65-byte 0x04 uncompressed form).
+ *   Key generation and signing multiply G through a comb table in flash
+ * - CRYPTO_ALG_ED25519: generate_key_pair, sign, verify (RFC 8032 over the
+ *   whole message, 64-byte R||S). Private keys are seed || public key
+ *   (64 bytes), public keys the 32-byte encoding
+ * - CRYPTO_HASH_SHA256, CRYPTO_HASH_SHA512: hash, hash_init/update/finalize,
+ *   hash_clone, on the unrolled sha2.h. Streaming state lives inside the
+ *   caller's crypto_context_t
+ * - CRYPTO_ALG_AES_128: encrypt/decrypt with AES-128-CCM, output is
+ *   nonce || ciphertext || tag
+ * - rng: tinycrypt HMAC-PRNG (SHA-256), seeded on MCXA156 from LPADC noise
+ *   (lpadc_entropy.h) and served from a reservoir filled in idle time
+ * - P-256 ephemeral keys and ECDH for clientPIN key agreement
+ *   (tinycrypt_crypto_generate_ephemeral_key(), tinycrypt_crypto_key_agreement())
+ * - Private key wrapping under an AES-128 key with AES-128-CCM and
+ *   associated data (tinycrypt_crypto_wrap_key(), tinycrypt_crypto_unwrap_key())
+ *
+ * P-256 signing nonces and ephemeral key pairs are precomputed in idle time
+ * (p256_pool.h) when TINYCRYPT_PRECOMPUTE is set.
+ *
+ * Until TINYCRYPT_RNG_MIN_ENTROPY_BITS are credited, everything that needs
+ * fresh randomness fails with HAL_ERROR_INVALID_STATE: generate_random,
+ * key generation, P-256 sign, encrypt and key wrapping. Ed25519 signing,
+ * verification and decryption do not draw from the RNG and keep working.
+ *
+ * Keys live in the key-slot table (key_slot.h) and hash state in the
+ * caller's context. Nothing in the backend allocates.
+ *
+ * @warning Not thread-safe. All calls, including rng, must come from one
+ *          task at a time. The one exception is tinycrypt_crypto_precompute(),
+ *          which may run on a lower-priority task next to that one.
+ */
+
+#include "hal/interface/crypto_hal.h"
+
+/** @brief P-256 private key size in bytes */
+#define TINYCRYPT_P256_PRIVATE_KEY_SIZE     32U
+
+/** @brief P-256 public key size in bytes (X||Y) */
+#define TINYCRYPT_P256_PUBLIC_KEY_SIZE      64U
+
+/** @brief Largest DER encoded P-256 signature */
+#define TINYCRYPT_P256_MAX_DER_SIGNATURE    72U
+
+/** @brief CCM nonce prepended to every ciphertext */
+#define TINYCRYPT_CCM_NONCE_SIZE            13U
+
+/** @brief CCM tag appended to every ciphertext */
+#define TINYCRYPT_CCM_TAG_SIZE              16U
+
+/** @brief encrypt() output overhead over the plaintext */
+#define TINYCRYPT_CCM_OVERHEAD  (TINYCRYPT_CCM_NONCE_SIZE + TINYCRYPT_CCM_TAG_SIZE)
+
+/**
+ * @brief Use the fixed-base comb (p256_comb.h) for P-256 k*G
+ *
+ * Set to 0 to fall back to tinycrypt's ladder, e.g. to compare cycle
+ * counts with crypto_bench.
+ */
+#ifndef TINYCRYPT_P256_COMB
+#define TINYCRYPT_P256_COMB                 1
+#endif
+
+/**
+ * @brief Build Ed25519 (ed25519.h) into the backend
+ *
+ * Needs the SDK's fiat curve25519.c and tinycrypt-sha512 in the build.
+ */
+#ifndef TINYCRYPT_ED25519
+#define TINYCRYPT_ED25519                   1
+#endif
+
+/**
+ * @brief Precompute P-256 signing nonces and ephemeral keys in idle time
+ *
+ * sign() and tinycrypt_crypto_generate_ephemeral_key() take from the pool
+ * and fall back to computing on the spot when it is empty.
+ */
+#ifndef TINYCRYPT_PRECOMPUTE
+#define TINYCRYPT_PRECOMPUTE                1
+#endif
+
+/** @brief Precompute task priority (just above the FreeRTOS idle task) */
+#ifndef TINYCRYPT_PRECOMPUTE_TASK_PRIORITY
+#define TINYCRYPT_PRECOMPUTE_TASK_PRIORITY  1U
+#endif
+
+/** @brief Precompute task stack size in bytes */
+#ifndef TINYCRYPT_PRECOMPUTE_STACK_SIZE
+#define TINYCRYPT_PRECOMPUTE_STACK_SIZE     2048U
+#endif
+
+/** @brief Precompute task poll period while the RNG lacks entropy */
+#ifndef TINYCRYPT_PRECOMPUTE_RETRY_MS
+#define TINYCRYPT_PRECOMPUTE_RETRY_MS       1000U
+#endif
+
+/**
+ * @brief Random bytes generated ahead of the request path
+ *
+ * generate_random() and tinycrypt's key and nonce RNG copy out of this
+ * reservoir and only run the DRBG for what it cannot cover.
+ * tinycrypt_crypto_precompute() tops it up. 0 disables it.
+ */
+#ifndef TINYCRYPT_RNG_RESERVOIR_SIZE
+#define TINYCRYPT_RNG_RESERVOIR_SIZE        256U
+#endif
+
+/** @brief Reservoir bytes generated per precompute step (bounds the PRNG lock time) */
+#ifndef TINYCRYPT_RNG_REFILL_CHUNK
+#define TINYCRYPT_RNG_REFILL_CHUNK          64U
+#endif
+
+/** @brief DRBG output after which the precompute step reseeds from the noise source */
+#ifndef TINYCRYPT_RNG_RESEED_BYTES
+#define TINYCRYPT_RNG_RESEED_BYTES          4096U
+#endif
+
+/** @brief P-256 ECDH shared secret size (x coordinate) */
+#define TINYCRYPT_P256_SHARED_SECRET_SIZE   32U
+
+/**
+ * @brief Wrapped private key size: nonce || CCM(algorithm || secret) || tag
+ *
+ * The secret is the P-256 scalar or the Ed25519 seed, 32 bytes either way.
+ */
+#define TINYCRYPT_WRAPPED_KEY_SIZE          (TINYCRYPT_CCM_OVERHEAD + 1U + 32U)
+
+/**
+ * @brief Profiled operations
+ */
+typedef enum {
+    CRYPTO_OP_GENERATE_KEY_PAIR = 0,    /**< generate_key_pair() */
+    CRYPTO_OP_SIGN,                     /**< sign(), including the message hash */
+    CRYPTO_OP_VERIFY,                   /**< verify(), including the message hash */
+    CRYPTO_OP_HASH,                     /**< Single-shot hash() */
+    CRYPTO_OP_COUNT                     /**< Number of profiled operations */
+} crypto_op_t;
+
+/**
+ * @brief Cycle statistics of one operation
+ *
+ * Counts come from cycle_counter_read(): core cycles on MCXA156,
+ * nanoseconds on the host. Failed calls are not recorded.
+ */
+typedef struct {
+    uint32_t count;             /**< Completed calls */
+    uint32_t last_cycles;       /**< Cost of the latest call */
+    uint32_t min_cycles;        /**< Cheapest call */
+    uint32_t max_cycles;        /**< Most expensive call */
+    uint64_t total_cycles;      /**< Sum over all calls */
+} crypto_op_stats_t;
+
+/**
+ * @brief Random generator counters
+ */
+typedef struct {
+    uint32_t entropy_bits;          /**< Same value as get_entropy_estimate() */
+    uint32_t reseeds;               /**< Reseeds that credited entropy */
+    uint32_t reseed_failures;       /**< Reseeds without noise (source failed) */
+    uint32_t reservoir_ready;       /**< Bytes waiting in the reservoir */
+    uint32_t reservoir_bytes;       /**< Bytes served from the reservoir */
+    uint32_t direct_bytes;          /**< Bytes the DRBG produced on demand */
+} tinycrypt_rng_stats_t;
+
+/** @brief tinycrypt backend instance */
+extern crypto_hal_t tinycrypt_crypto_hal;
+
+/**
+ * @brief COSE algorithms the backend signs with, in preference order
+ *
+ * For the algorithms list of authenticatorGetInfo. EdDSA comes first: an
+ * Ed25519 signature is cheaper than a P-256 one on this backend.
+ *
+ * @param algorithms Output COSE identifiers (CRYPTO_COSE_ALG_*)
+ * @param max_count Capacity of algorithms
+ * @return Number of identifiers written
+ */
+size_t tinycrypt_crypto_get_cose_algorithms(int32_t* algorithms, size_t max_count);
+
+/**
+ * @brief Map a COSE algorithm identifier to a key algorithm
+ *
+ * @param cose_algorithm COSE identifier from pubKeyCredParams
+ * @param algorithm Output algorithm for generate_key_pair()
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM NULL algorithm
+ * @retval HAL_ERROR_NOT_SUPPORTED The backend cannot sign with it
+ */
+hal_result_t tinycrypt_crypto_algorithm_from_cose(int32_t cose_algorithm,
+                                                  crypto_algorithm_t* algorithm);
+
+/**
+ * @brief Generate an ephemeral P-256 key pair for key agreement
+ *
+ * Like generate_key_pair(CRYPTO_ALG_ECC_P256), but takes a precomputed
+ * pair from the pool when one is ready. For the clientPIN
+ * getKeyAgreement key; credential keys use generate_key_pair().
+ *
+ * @param public_key Output public key (64-byte X||Y)
+ * @param private_key Output private key (32-byte scalar)
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_STATE RNG below TINYCRYPT_RNG_MIN_ENTROPY_BITS
+ */
+hal_result_t tinycrypt_crypto_generate_ephemeral_key(crypto_key_t* public_key,
+                                                     crypto_key_t* private_key);
+
+/**
+ * @brief P-256 ECDH
+ *
+ * @param private_key Our private key
+ * @param peer_public_key Peer public key (validated when imported)
+ * @param shared_secret Output x coordinate of the shared point
+ * @param secret_length In: buffer size, out: TINYCRYPT_P256_SHARED_SECRET_SIZE
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_NOT_SUPPORTED Keys are not P-256
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Output buffer too small
+ * @retval HAL_ERROR_HARDWARE_FAILURE The shared point is the identity
+ */
+hal_result_t tinycrypt_crypto_key_agreement(const crypto_key_t* private_key,
+                                            const crypto_key_t* peer_public_key,
+                                            uint8_t* shared_secret, size_t* secret_length);
+
+/**
+ * @brief Encrypt a private key under an AES-128 key
+ *
+ * The key never leaves the backend in the clear. The associated data is
+ * authenticated but not stored; unwrapping needs the same bytes.
+ *
+ * @param wrapping_key AES-128 key
+ * @param private_key P-256 or Ed25519 private key
+ * @param aad Associated data, may be NULL if aad_length is 0
+ * @param aad_length Size of aad in bytes
+ * @param wrapped Output buffer
+ * @param wrapped_length In: buffer size, out: TINYCRYPT_WRAPPED_KEY_SIZE
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_NOT_SUPPORTED Not an AES-128 key or not a signing key
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Output buffer too small
+ * @retval HAL_ERROR_INVALID_STATE RNG below TINYCRYPT_RNG_MIN_ENTROPY_BITS
+ */
+hal_result_t tinycrypt_crypto_wrap_key(const crypto_key_t* wrapping_key,
+                                       const crypto_key_t* private_key,
+                                       const uint8_t* aad, size_t aad_length,
+                                       uint8_t* wrapped, size_t* wrapped_length);
+
+/**
+ * @brief Decrypt a key from tinycrypt_crypto_wrap_key() into a key slot
+ *
+ * The unwrapped scalar is not range-checked again: the tag proves this
+ * backend wrapped it. Ed25519 keys pay one base-point multiplication to
+ * recover the public half.
+ *
+ * @param wrapping_key AES-128 key used to wrap
+ * @param wrapped Wrapped key
+ * @param wrapped_length Must be TINYCRYPT_WRAPPED_KEY_SIZE
+ * @param aad Associated data given to tinycrypt_crypto_wrap_key()
+ * @param aad_length Size of aad in bytes
+ * @param private_key Output private key, delete with delete_key()
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM Wrong length
+ * @retval HAL_ERROR_HARDWARE_FAILURE Tag mismatch (other key, other aad,
+ *         corrupted data) or unknown algorithm
+ */
+hal_result_t tinycrypt_crypto_unwrap_key(const crypto_key_t* wrapping_key,
+                                         const uint8_t* wrapped, size_t wrapped_length,
+                                         const uint8_t* aad, size_t aad_length,
+                                         crypto_key_t* private_key);
+
+/**
+ * @brief Do one step of idle-time work
+ *
+ * Call from idle time; the MCXA156 precompute task does this in a loop.
+ * In order, one of: a reseed from the noise source once
+ * TINYCRYPT_RNG_RESEED_BYTES have been drawn, one precompute pool entry
+ * (a P-256 base-point multiplication), or TINYCRYPT_RNG_REFILL_CHUNK
+ * bytes into the RNG reservoir.
+ *
+ * @return true if work was done, false if there is nothing left to do,
+ *         the backend is not initialized or the RNG is not ready
+ */
+bool tinycrypt_crypto_precompute(void);
+
+/**
+ * @brief Start the precompute task
+ *
+ * Creates a task at TINYCRYPT_PRECOMPUTE_TASK_PRIORITY that runs
+ * tinycrypt_crypto_precompute() and sleeps until an entry or reservoir
+ * bytes are taken. Call after init().
+ *
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_STATE Task already started
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Task creation failed
+ * @retval HAL_ERROR_NOT_SUPPORTED Host build
+ */
+hal_result_t tinycrypt_crypto_start_precompute(void);
+
+/**
+ * @brief Read the random generator counters
+ *
+ * @param stats Output counters
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM NULL stats
+ * @retval HAL_ERROR_NOT_INITIALIZED Backend not initialized
+ */
+hal_result_t tinycrypt_crypto_get_rng_stats(tinycrypt_rng_stats_t* stats);
+
+/**
+ * @brief Get cycle statistics of an operation
+ *
+ * @param op Operation to query
+ * @param stats Output statistics
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM Unknown operation or NULL stats
+ */
+hal_result_t tinycrypt_crypto_get_op_stats(crypto_op_t op, crypto_op_stats_t* stats);
+
+/**
+ * @brief Clear all operation statistics
+ */
+void tinycrypt_crypto_reset_op_stats(void);
+
+/**
+ * @brief Get printable name of an operation
+ *
+ * @param op Operation
+ * @return Operation name, "unknown" for invalid values
+ */
+const char* tinycrypt_crypto_op_name(crypto_op_t op);
+
+#endif // TINYCRYPT_CRYPTO_HAL_H
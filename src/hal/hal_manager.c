@@ -10,12 +10,13 @@
  */
 
 #include "hal_manager.h"
+#include "crypto/tinycrypt_crypto_hal.h"
 #include <stdio.h>
 #include <string.h>
 
 // External HAL implementations - Mock (always available)
+// Crypto has no mock: the portable tinycrypt backend does the real work
 extern usb_hid_hal_t mock_usb_hid_hal;
-extern crypto_hal_t mock_crypto_hal;
 extern storage_hal_t mock_storage_hal;
 
 // STM32 HAL implementations (conditionally compiled)
@@ -113,7 +114,7 @@ hal_result_t hal_manager_init(hal_platform_t platform) {
         case HAL_PLATFORM_MOCK:
             printf("[HAL_MANAGER] Using Mock HAL implementations\n");
             g_hal_manager.usb_hid = &mock_usb_hid_hal;
-            g_hal_manager.crypto = &mock_crypto_hal;
+            g_hal_manager.crypto = &tinycrypt_crypto_hal;
             g_hal_manager.storage = &mock_storage_hal;
             break;
             
@@ -58,6 +58,12 @@ typedef enum {
     CRYPTO_KEY_TYPE_RSA_PUBLIC      /**< RSA public key */
 } crypto_key_type_t;
 
+/** @brief COSE algorithm identifier of ECDSA P-256 with SHA-256 (ES256) */
+#define CRYPTO_COSE_ALG_ES256       (-7)
+
+/** @brief COSE algorithm identifier of EdDSA, Ed25519 in CTAP2 */
+#define CRYPTO_COSE_ALG_EDDSA       (-8)
+
 /** @brief Maximum key size in bytes */
 #define CRYPTO_MAX_KEY_SIZE         512
 
@@ -67,15 +73,35 @@ typedef enum {
 /** @brief Maximum hash size in bytes (SHA-512) */
 #define CRYPTO_MAX_HASH_SIZE        64
 
+/**
+ * @brief State bytes inside every crypto_context_t
+ *
+ * Large enough for a SHA-512 state; backends check their state against it
+ * at compile time.
+ */
+#ifndef CRYPTO_CONTEXT_STATE_SIZE
+#define CRYPTO_CONTEXT_STATE_SIZE   200
+#endif
+
+/**
+ * @brief Opaque reference to key material held by the backend
+ */
+typedef uint32_t crypto_key_handle_t;
+
+/** @brief Handle of a deleted or never-created key */
+#define CRYPTO_KEY_HANDLE_INVALID   0U
+
 /**
  * @brief Cryptographic key structure
  * 
- * Represents a cryptographic key with its metadata.
+ * Represents a cryptographic key with its metadata. The key material stays
+ * in the backend's fixed key storage; the structure only names it, so it
+ * can be copied and kept on the stack without allocating.
  */
 typedef struct {
     crypto_key_type_t type;     /**< Key type */
     crypto_algorithm_t algorithm; /**< Algorithm this key is used with */
-    uint8_t* data;              /**< Key data buffer */
+    crypto_key_handle_t handle; /**< Backend key storage */
     size_t size;                /**< Size of key data in bytes */
     uint32_t flags;             /**< Key flags (CRYPTO_KEY_FLAG_*) */
 } crypto_key_t;
@@ -93,12 +119,17 @@ typedef struct {
  * @brief Cryptographic operation context
  * 
  * Maintains state for multi-step cryptographic operations like streaming hash.
+ * The state is stored inline: the caller owns the memory (stack, static or
+ * inside another struct), the backend never allocates, and a context that
+ * is abandoned before finalization needs no cleanup.
  */
 typedef struct {
     crypto_algorithm_t algorithm;   /**< Algorithm being used */
-    void* context_data;             /**< Algorithm-specific context */
-    size_t context_size;            /**< Size of context data */
-    uint32_t flags;                 /**< Operation flags */
+    uint32_t flags;                 /**< Operation flags, backend-defined */
+    union {
+        uint64_t align;             /**< Forces 8-byte alignment */
+        uint8_t bytes[CRYPTO_CONTEXT_STATE_SIZE];
+    } state;                        /**< Algorithm-specific state */
 } crypto_context_t;
 
 /**
@@ -176,7 +207,7 @@ typedef struct {
      * @retval HAL_ERROR_INVALID_PARAM Invalid algorithm or NULL pointers
      * @retval HAL_ERROR_NOT_SUPPORTED Algorithm not supported
      * @retval HAL_ERROR_HARDWARE_FAILURE Crypto hardware failure
-     * @retval HAL_ERROR_INSUFFICIENT_MEMORY Memory allocation failed
+     * @retval HAL_ERROR_INSUFFICIENT_MEMORY No free key storage
      * 
      * @note Generated keys must be freed with delete_key()
      * @see delete_key()
@@ -199,7 +230,7 @@ typedef struct {
      * @retval HAL_SUCCESS Key imported successfully
      * @retval HAL_ERROR_INVALID_PARAM Invalid parameters
      * @retval HAL_ERROR_NOT_SUPPORTED Key type not supported
-     * @retval HAL_ERROR_INSUFFICIENT_MEMORY Memory allocation failed
+     * @retval HAL_ERROR_INSUFFICIENT_MEMORY No free key storage
      * 
      * @note Key data format depends on key type and algorithm
      */
@@ -229,7 +260,7 @@ typedef struct {
     /**
      * @brief Delete cryptographic key
      * 
-     * Securely deletes a key and frees associated resources.
+     * Zeroes the key material and releases its storage.
      * 
      * @param key Key to delete
      * 
@@ -326,10 +357,9 @@ typedef struct {
      * @retval HAL_SUCCESS Hash context initialized
      * @retval HAL_ERROR_INVALID_PARAM Invalid parameters
      * @retval HAL_ERROR_NOT_SUPPORTED Hash algorithm not supported
-     * @retval HAL_ERROR_INSUFFICIENT_MEMORY Context allocation failed
      * 
-     * @note Context must be finalized with hash_finalize()
-     * @see hash_update(), hash_finalize()
+     * @note The context holds no resources; it may be dropped unfinalized
+     * @see hash_update(), hash_finalize(), hash_clone()
      */
     hal_result_t (*hash_init)(crypto_hash_algorithm_t algorithm, crypto_context_t* context);
     
@@ -372,6 +402,25 @@ typedef struct {
      */
     hal_result_t (*hash_finalize)(crypto_context_t* context, uint8_t* hash, size_t* hash_length);
     
+    /**
+     * @brief Copy a streaming hash midstate
+     * 
+     * Snapshots a context so a common prefix is hashed once and finished
+     * several ways (e.g. one authData with several suffixes, or keyed HMAC
+     * pads). The copies continue independently.
+     * 
+     * @param source Hash context from hash_init(), possibly updated
+     * @param destination Context to overwrite, may be uninitialized
+     * 
+     * @return HAL_SUCCESS on success, error code otherwise
+     * @retval HAL_SUCCESS Context copied
+     * @retval HAL_ERROR_INVALID_PARAM Invalid parameters
+     * @retval HAL_ERROR_INVALID_STATE Source not initialized
+     * 
+     * @see hash_init(), hash_finalize()
+     */
+    hal_result_t (*hash_clone)(const crypto_context_t* source, crypto_context_t* destination);
+    
     /**
      * @brief Encrypt data
      * 
@@ -28,7 +28,8 @@ typedef enum {
     HAL_ERROR_NOT_SUPPORTED = -5,       /**< Operation not supported */
     HAL_ERROR_HARDWARE_FAILURE = -6,    /**< Hardware malfunction detected */
     HAL_ERROR_INSUFFICIENT_MEMORY = -7, /**< Not enough memory available */
-    HAL_ERROR_INVALID_STATE = -8        /**< Invalid state for operation */
+    HAL_ERROR_INVALID_STATE = -8,       /**< Invalid state for operation */
+    HAL_ERROR_CANCELLED = -9            /**< Operation cancelled before completion */
 } hal_result_t;
 
 /**
@@ -38,6 +38,7 @@ typedef struct {
     uint32_t sector_size;       /**< Erase sector size in bytes (0 if not applicable) */
     uint32_t page_size;         /**< Write page size in bytes (0 if not applicable) */
     uint32_t capabilities;      /**< Hardware capability flags (STORAGE_CAP_*) */
+    uint32_t program_size;      /**< Smallest aligned write in bytes, e.g. a 16-byte flash phrase (0 if page_size) */
 } storage_info_t;
 
 /**
@@ -283,6 +283,29 @@ typedef struct {
      */
     hal_result_t (*resume)(void);
     
+    /**
+     * @brief Prime OUT endpoint with a caller-supplied buffer
+     * 
+     * Arms the next OUT transfer so the report is written by the USB
+     * controller directly into @p buffer. When it arrives, rx_callback is
+     * invoked with data == buffer. The endpoint must be primed again after
+     * each received report.
+     * 
+     * @param endpoint Endpoint number to receive on
+     * @param buffer Destination of the next report
+     * @param length Size of the destination (USB_HID_PACKET_SIZE)
+     * 
+     * @return HAL_SUCCESS on success, error code otherwise
+     * @retval HAL_SUCCESS Endpoint primed
+     * @retval HAL_ERROR_INVALID_PARAM Invalid parameters
+     * @retval HAL_ERROR_BUSY Endpoint already primed
+     * 
+     * @note Optional - leave NULL if the platform can only deliver reports
+     *       from its own buffers; callers then fall back to copying
+     * @note On MCUXpresso SDK this maps to USB_DeviceHidRecv()
+     */
+    hal_result_t (*prime_receive)(uint8_t endpoint, uint8_t* buffer, size_t length);
+    
 } usb_hid_hal_t;
 
 /** @brief USB device is connected to host */
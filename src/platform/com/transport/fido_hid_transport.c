@@ -4,9 +4,29 @@
  */
 
 #include "fido_hid_transport.h"
+#include "platform/time/platform_clock.h"
+#include "platform/time/timer_wheel.h"
 #include <string.h>
 #include <stdlib.h>
 
+#if defined(MCXA156_SERIES)
+#include "fsl_common.h"
+/** @brief Guard state shared with the USB interrupt */
+#define FIDO_CRITICAL_ENTER()   uint32_t fido_irq_state = DisableGlobalIRQ()
+#define FIDO_CRITICAL_EXIT()    EnableGlobalIRQ(fido_irq_state)
+#else
+#define FIDO_CRITICAL_ENTER()   do { } while (0)
+#define FIDO_CRITICAL_EXIT()    do { } while (0)
+#endif
+
+#if defined(FIDO_TRANSPORT_COPY_STATS)
+/** @brief Bytes moved by memcpy in the transport (benchmark instrumentation) */
+static uint64_t g_fido_bytes_copied = 0;
+#define FIDO_COPY(dst, src, n)  (g_fido_bytes_copied += (n), memcpy((dst), (src), (n)))
+#else
+#define FIDO_COPY(dst, src, n)  memcpy((dst), (src), (n))
+#endif
+
 /**
  * @brief FIDO HID Report Descriptor
  * Based on FIDO Alliance U2F HID specification
@@ -41,36 +61,92 @@ static const uint8_t fido_hid_report_descriptor[] = {
 const usb_hid_descriptor_t fido_hid_descriptor = {
     .vendor_id = FIDO_HID_VENDOR_ID,           // Yubico VID (example - cần thay đổi)
     .product_id = FIDO_HID_PRODUCT_ID,          // FIDO U2F Security Key
-    .version = FIDO_HID_VERSION,             // Version 1.0
-    .manufacturer = "USB Key Auth", // Manufacturer string
-    .product = "FIDO2 Authenticator", // Product string
-    .serial_number = "000001",      // Serial number
+    .device_version = FIDO_HID_VERSION,      // Version 1.0
+    .manufacturer_string = "USB Key Auth", // Manufacturer string
+    .product_string = "FIDO2 Authenticator", // Product string
+    .serial_string = "000001",      // Serial number
     
-    // HID specific
+    // HID specific: FIDO usage page, 64-byte IN/OUT reports
     .report_descriptor = fido_hid_report_descriptor,
-    .report_descriptor_length = sizeof(fido_hid_report_descriptor),
-    .endpoint_in = 1,              // IN endpoint (device to host)
-    .endpoint_out = 1,             // OUT endpoint (host to device)  
-    .max_packet_size = 64,         // FIDO HID packet size
-    .poll_interval = 1,            // 1ms polling interval
-    
-    // FIDO specific
-    .usage_page = FIDO_HID_USAGE_PAGE,          // FIDO Alliance Usage Page
-    .usage = FIDO_USAGE_FIDO2_HID,                 // U2F HID Usage
-    .report_count = 64,            // 64 bytes per report
-    .report_size = 8,              // 8 bits per byte
+    .report_descriptor_size = sizeof(fido_hid_report_descriptor),
 };
+/**
+ * @brief Channel table index type and sentinel
+ */
+typedef uint16_t fido_channel_index_t;
+#define FIDO_CHANNEL_NONE           0xFFFFu
+
+/**
+ * @brief CID layout
+ * 
+ * The low byte of an allocated CID is its channel table index and the
+ * upper bytes a serial number, so lookup is a single indexed compare and
+ * a reused table entry never hands out a CID a host saw before.
+ */
+#define FIDO_CID_INDEX_BITS         8
+#define FIDO_CID_INDEX_MASK         ((1u << FIDO_CID_INDEX_BITS) - 1u)
+#define FIDO_CID_SERIAL_FIRST       (0x00010000u >> FIDO_CID_INDEX_BITS)
+/** @brief Top serial left out: with index 0xFF it would form the broadcast CID */
+#define FIDO_CID_SERIAL_LAST        ((0xFFFFFFFFu >> FIDO_CID_INDEX_BITS) - 1u)
+
+_Static_assert(((FIDO_CID_SERIAL_LAST << FIDO_CID_INDEX_BITS) | FIDO_CID_INDEX_MASK) <
+               FIDO_BROADCAST_CID, "largest allocated CID must stay below broadcast");
+
+/**
+ * @brief Token bucket
+ * 
+ * Tokens are kept in 1/FIDO_TOKEN_SCALE packet units, so a rate in packets
+ * per second refills exactly rate units per millisecond.
+ */
+typedef struct {
+    uint32_t tokens;            /**< Available tokens, scaled */
+    uint32_t last_ms;           /**< Time of the last refill */
+} fido_token_bucket_t;
+
+#define FIDO_TOKEN_SCALE            1000u
+
+/**
+ * @brief Queued error responses allowed, keeping a TX slot for real responses
+ */
+#define FIDO_TX_ERROR_LIMIT         ((FIDO_TX_QUEUE_DEPTH > 1) ? (FIDO_TX_QUEUE_DEPTH - 1) : 1)
+
 /**
  * @brief Channel information structure
  */
 typedef struct {
     uint32_t cid;               /**< Channel identifier */
     uint32_t last_activity;     /**< Last activity timestamp */
+    timer_wheel_node_t timer;   /**< Inactivity timeout */
+    uint32_t messages_received; /**< Complete messages received */
+    uint32_t messages_sent;     /**< Messages fully transmitted */
+    uint32_t bytes_received;    /**< Payload bytes received */
+    uint32_t bytes_sent;        /**< Payload bytes transmitted */
+    uint32_t errors;            /**< Error responses and failed sends */
+    uint32_t last_latency_us;   /**< Last request-to-response time */
+    uint64_t request_time_us;   /**< Completion time of pending request */
+    bool request_pending;       /**< Request awaiting its response */
+    fido_token_bucket_t bucket; /**< Admission budget */
+    uint32_t packets_dropped;   /**< Reports over budget */
+    fido_channel_index_t lru_prev; /**< More recently active channel */
+    fido_channel_index_t lru_next; /**< Less recently active (or next free) */
     bool active;                /**< Channel is active */
 } fido_channel_t;
 
+/**
+ * @brief Size of reassembly slot storage
+ * 
+ * Payload is preceded by room for an INIT header and followed by room for
+ * the unused tail of the last continuation packet, so that any report can
+ * be received in place at the position its payload belongs.
+ */
+#define FIDO_RX_SLOT_STORAGE_SIZE   (FIDO_HID_INIT_HEADER_SIZE + FIDO_MAX_MESSAGE_SIZE + \
+                                     FIDO_HID_CONT_PAYLOAD_SIZE)
+
 /**
  * @brief Receive buffer for message assembly
+ * 
+ * One reassembly slot, owned by a single CID while a fragmented message
+ * is being received on that channel.
  */
 typedef struct {
     uint32_t cid;                           /**< Channel ID */
@@ -78,21 +154,78 @@ typedef struct {
     uint16_t total_length;                  /**< Total message length */
     uint16_t received_length;               /**< Bytes received so far */
     uint8_t expected_seq;                   /**< Expected sequence number */
-    uint32_t timeout_start;                 /**< Receive start timestamp */
-    uint8_t buffer[FIDO_MAX_MESSAGE_SIZE];  /**< Message buffer */
+    uint8_t successor;                      /**< Slot extended right after this one */
+    timer_wheel_node_t timer;               /**< Receive timeout */
+    uint8_t* buffer;                        /**< Message payload (points into storage) */
+    uint8_t storage[FIDO_RX_SLOT_STORAGE_SIZE]; /**< Payload plus header/tail room */
     bool active;                            /**< Buffer in use */
+    bool delivered;                         /**< Complete, held until released */
 } fido_receive_buffer_t;
 
+/**
+ * @brief Zero-copy receive landing zone
+ * 
+ * Describes where the OUT endpoint is currently primed. For a continuation
+ * landing, the 5-byte header overwrites the last payload bytes already in
+ * the slot; those bytes are stashed here and put back once the header has
+ * been parsed, which is the only copy left on the in-place path.
+ */
+typedef struct {
+    uint8_t* buffer;                        /**< Where the next report lands */
+    uint8_t stash[FIDO_HID_CONT_HEADER_SIZE]; /**< Payload bytes covered by the header */
+    bool stashed;                           /**< Stash holds valid bytes */
+} fido_rx_landing_t;
+
+/**
+ * @brief Outgoing message queued for transmission
+ */
+typedef struct {
+    uint32_t cid;                           /**< Channel ID */
+    uint8_t cmd;                            /**< Command */
+    uint16_t length;                        /**< Total message length */
+    fido_hid_framer_t framer;               /**< Fragmentation state */
+    fido_send_complete_callback_t on_complete; /**< Completion callback */
+    void* user_data;                        /**< Completion callback argument */
+    uint16_t buffered;                      /**< TX buffer bytes held, wasted tail included */
+    uint8_t inline_data[FIDO_TX_INLINE_SIZE]; /**< Copy of short payloads */
+} fido_tx_message_t;
+
 /**
  * @brief FIDO transport context
  */
 typedef struct {
     const usb_hid_hal_t* usb_hal;           /**< USB HID HAL interface */
     fido_message_callback_t msg_callback;   /**< Message callback */
+    fido_cancel_callback_t cancel_callback; /**< Cancel callback */
+    fido_chunk_callback_t chunk_callback;   /**< Streaming chunk callback */
+    fido_stream_complete_callback_t stream_complete_callback; /**< Streaming end callback */
+    bool deferred_delivery;                 /**< Hold messages until released */
     fido_transport_state_t state;           /**< Current state */
-    fido_receive_buffer_t rx_buffer;        /**< Receive buffer */
-    fido_channel_t channels[FIDO_MAX_CHANNELS]; /**< Channel tracking */
-    uint32_t next_cid;                      /**< Next CID to allocate */
+    fido_receive_buffer_t rx_slots[FIDO_MAX_RX_SLOTS]; /**< Per-CID reassembly slots */
+    uint8_t rx_active_count;                /**< Number of slots in use */
+    fido_receive_buffer_t* rx_last_slot;    /**< Slot most likely to receive next */
+    fido_rx_landing_t rx_landing;           /**< Current zero-copy landing */
+    uint8_t rx_bounce[FIDO_HID_PACKET_SIZE]; /**< Landing when no slot can take it */
+    fido_channel_t channels[FIDO_MAX_CHANNELS]; /**< Channel table */
+    fido_channel_index_t lru_head;          /**< Most recently active channel */
+    fido_channel_index_t lru_tail;          /**< Least recently active channel */
+    fido_channel_index_t free_head;         /**< First unused table entry */
+    timer_wheel_t timers;                   /**< Receive and channel timeouts */
+    fido_token_bucket_t global_bucket;      /**< Budget of all OUT reports */
+    fido_token_bucket_t unowned_bucket;     /**< Budget of reports without a channel */
+    fido_token_bucket_t error_bucket;       /**< Budget of error responses */
+    fido_admission_stats_t admission;       /**< Admission control counters */
+    fido_tx_message_t tx_queue[FIDO_TX_QUEUE_DEPTH]; /**< Outgoing message ring */
+    uint8_t tx_head;                        /**< Message being transmitted */
+    uint8_t tx_count;                       /**< Messages in the ring */
+    fido_hid_frame_t tx_frames[2];          /**< Ping-pong frames */
+    uint8_t tx_frame_in_flight;             /**< Frame owned by the endpoint */
+    bool tx_busy;                           /**< A frame is in flight */
+    bool tx_next_ready;                     /**< Other frame holds the next packet */
+    uint8_t tx_buffer[FIDO_TX_BUFFER_SIZE]; /**< Copies of long payloads, in queue order */
+    uint16_t tx_buffer_end;                 /**< End of the newest copy */
+    uint16_t tx_buffer_used;                /**< Bytes held by queued messages */
+    uint32_t next_cid_serial;               /**< Serial part of the next CID */
     bool initialized;                       /**< Initialization flag */
 } fido_transport_context_t;
 
@@ -105,13 +238,51 @@ static fido_transport_context_t g_transport_ctx = {0};
 static void usb_rx_callback(uint8_t endpoint, const uint8_t* data, size_t length);
 static void usb_tx_complete_callback(uint8_t endpoint, hal_result_t result);
 static void usb_event_callback(uint32_t event);
+static hal_result_t queue_message(uint32_t cid, uint8_t cmd, const uint8_t* data, size_t length,
+                                  fido_send_complete_callback_t on_complete, void* user_data);
+static bool build_next_frame(fido_tx_message_t* msg, uint8_t frame);
+static void tx_start_next(void);
+static void tx_finish_message(hal_result_t result);
+static void tx_abort_all(hal_result_t result);
+static uint8_t* tx_buffer_reserve(size_t length, uint16_t* held);
 static hal_result_t process_fido_packet(const uint8_t packet[FIDO_HID_PACKET_SIZE]);
+static hal_result_t process_parsed_packet(uint32_t cid, bool is_init, uint8_t cmd_or_seq,
+                                          uint16_t total_len, const uint8_t* payload);
+static hal_result_t process_landed_packet(size_t length);
+static void prime_next_receive(void);
+static hal_result_t process_init_packet(uint32_t cid, uint8_t cmd, uint16_t total_len,
+                                        const uint8_t* payload);
+static hal_result_t process_cont_packet(uint32_t cid, uint8_t seq, const uint8_t* payload);
 static hal_result_t send_error_response(uint32_t cid, uint8_t error_code);
-static void reset_receive_buffer(void);
+static bool error_response_queued(uint32_t cid, uint8_t error_code);
+static void bucket_init(fido_token_bucket_t* bucket, uint32_t burst, uint32_t now_ms);
+static bool bucket_take(fido_token_bucket_t* bucket, uint32_t rate, uint32_t burst,
+                        uint32_t now_ms);
+static bool admit_packet(uint32_t cid);
+static fido_receive_buffer_t* find_receive_slot(uint32_t cid);
+static fido_receive_buffer_t* find_delivered_slot(uint32_t cid);
+static void complete_message(fido_receive_buffer_t* slot);
+static void stream_chunk(uint32_t cid, uint8_t cmd, size_t offset, const uint8_t* data,
+                         size_t length);
+static void stream_end(uint32_t cid, uint8_t cmd, size_t length, hal_result_t status);
+static void abort_receive_slot(fido_receive_buffer_t* slot, hal_result_t reason);
+static fido_receive_buffer_t* allocate_receive_slot(uint32_t cid, const uint8_t* hint);
+static void release_receive_slot(fido_receive_buffer_t* slot);
+static void note_slot_extended(fido_receive_buffer_t* slot);
+static void reset_receive_slots(void);
+static fido_transport_state_t get_idle_state(void);
 static uint32_t get_timestamp_ms(void);
 static fido_channel_t* find_channel(uint32_t cid);
 static fido_channel_t* allocate_channel_slot(void);
+static void release_channel(fido_channel_t* channel);
+static void reset_channel_table(void);
+static bool channel_has_request(uint32_t cid);
 static void update_channel_activity(uint32_t cid);
+static void channel_note_received(uint32_t cid, size_t length);
+static void channel_note_sent(uint32_t cid, uint8_t cmd, size_t length, hal_result_t result);
+static void channel_note_error(uint32_t cid);
+static void receive_timeout_expired(void* owner);
+static void channel_timeout_expired(void* owner);
 
 /**
  * @brief Initialize FIDO HID transport
@@ -122,7 +293,7 @@ static hal_result_t fido_transport_init(const usb_hid_hal_t* usb_hal) {
     }
     
     if (g_transport_ctx.initialized) {
-        return HAL_ERROR_ALREADY_INITIALIZED;
+        return HAL_ERROR_INVALID_STATE;
     }
 
     // Configure HAL with FIDO HID descriptor
@@ -130,21 +301,40 @@ static hal_result_t fido_transport_init(const usb_hid_hal_t* usb_hal) {
     if (result != HAL_SUCCESS) {
         return result;
     }
+    result = platform_clock_init();
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+    
     // Initialize context
     memset(&g_transport_ctx, 0, sizeof(g_transport_ctx));
     g_transport_ctx.usb_hal = usb_hal;
     g_transport_ctx.state = FIDO_TRANSPORT_IDLE;
-    g_transport_ctx.next_cid = 0x00010000; // Start after reserved range
+    g_transport_ctx.next_cid_serial = FIDO_CID_SERIAL_FIRST; // Start after reserved range
+    timer_wheel_init(&g_transport_ctx.timers, FIDO_TIMER_TICK_MS, get_timestamp_ms());
+    bucket_init(&g_transport_ctx.global_bucket, FIDO_GLOBAL_BURST, get_timestamp_ms());
+    bucket_init(&g_transport_ctx.unowned_bucket, FIDO_UNOWNED_BURST, get_timestamp_ms());
+    bucket_init(&g_transport_ctx.error_bucket, FIDO_ERROR_BURST, get_timestamp_ms());
+    reset_channel_table();
+    for (int i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        g_transport_ctx.rx_slots[i].buffer = 
+            &g_transport_ctx.rx_slots[i].storage[FIDO_HID_INIT_HEADER_SIZE];
+        timer_wheel_node_init(&g_transport_ctx.rx_slots[i].timer, receive_timeout_expired,
+                              &g_transport_ctx.rx_slots[i]);
+    }
     
     // Set USB callbacks
-    hal_result_t result = usb_hal->set_callbacks(usb_rx_callback, 
-                                                usb_tx_complete_callback,
-                                                usb_event_callback);
+    result = usb_hal->set_callbacks(usb_rx_callback, 
+                                    usb_tx_complete_callback,
+                                    usb_event_callback);
     if (result != HAL_SUCCESS) {
         return result;
     }
     
     g_transport_ctx.initialized = true;
+    
+    // Receive the first report straight into a reassembly slot
+    prime_next_receive();
     return HAL_SUCCESS;
 }
 
@@ -161,6 +351,9 @@ static hal_result_t fido_transport_deinit(void) {
         g_transport_ctx.usb_hal->set_callbacks(NULL, NULL, NULL);
     }
     
+    // Owners of queued messages must not wait for a completion forever
+    tx_abort_all(HAL_ERROR_INVALID_STATE);
+    
     // Reset context
     memset(&g_transport_ctx, 0, sizeof(g_transport_ctx));
     
@@ -172,56 +365,17 @@ static hal_result_t fido_transport_deinit(void) {
  */
 static hal_result_t fido_transport_send_message(uint32_t cid, uint8_t cmd, 
                                                const uint8_t* data, size_t length) {
-    if (!g_transport_ctx.initialized || !g_transport_ctx.usb_hal) {
-        return HAL_ERROR_NOT_INITIALIZED;
-    }
-    
-    if (length > FIDO_MAX_MESSAGE_SIZE) {
-        return HAL_ERROR_INVALID_PARAM;
-    }
-    
-    if (g_transport_ctx.state == FIDO_TRANSPORT_SENDING) {
-        return HAL_ERROR_BUSY;
-    }
-    
-    g_transport_ctx.state = FIDO_TRANSPORT_SENDING;
-    
-    uint8_t packet[FIDO_HID_PACKET_SIZE];
-    hal_result_t result;
-    
-    // Send initialization packet
-    fido_hid_prepare_init_packet(packet, cid, cmd, data, (uint16_t)length);
-    result = g_transport_ctx.usb_hal->send_report(FIDO_HID_ENDPOINT, packet, FIDO_HID_PACKET_SIZE);
-    if (result != HAL_SUCCESS) {
-        g_transport_ctx.state = FIDO_TRANSPORT_IDLE;
-        return result;
-    }
-    
-    // Send continuation packets if needed
-    size_t sent = FIDO_HID_INIT_PAYLOAD_SIZE;
-    uint8_t seq = 0;
-    
-    while (sent < length) {
-        size_t remaining = length - sent;
-        
-        fido_hid_prepare_cont_packet(packet, cid, seq++, 
-                                   data + sent, remaining);
-        
-        result = g_transport_ctx.usb_hal->send_report(FIDO_HID_ENDPOINT, packet, FIDO_HID_PACKET_SIZE);
-        if (result != HAL_SUCCESS) {
-            g_transport_ctx.state = FIDO_TRANSPORT_IDLE;
-            return result;
-        }
-        
-        sent += (remaining > FIDO_HID_CONT_PAYLOAD_SIZE) ? 
-                FIDO_HID_CONT_PAYLOAD_SIZE : remaining;
-    }
-    
-    // Update channel activity
-    update_channel_activity(cid);
-    
-    g_transport_ctx.state = FIDO_TRANSPORT_IDLE;
-    return HAL_SUCCESS;
+    return queue_message(cid, cmd, data, length, NULL, NULL);
+}
+
+/**
+ * @brief Queue FIDO message with completion notification
+ */
+static hal_result_t fido_transport_send_message_async(uint32_t cid, uint8_t cmd,
+                                                     const uint8_t* data, size_t length,
+                                                     fido_send_complete_callback_t on_complete,
+                                                     void* user_data) {
+    return queue_message(cid, cmd, data, length, on_complete, user_data);
 }
 
 /**
@@ -243,6 +397,73 @@ static hal_result_t fido_transport_set_message_callback(fido_message_callback_t
     return HAL_SUCCESS;
 }
 
+/**
+ * @brief Set cancel callback
+ */
+static hal_result_t fido_transport_set_cancel_callback(fido_cancel_callback_t callback) {
+    if (!g_transport_ctx.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    g_transport_ctx.cancel_callback = callback;
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Set streaming callbacks
+ */
+static hal_result_t fido_transport_set_stream_callbacks(fido_chunk_callback_t on_chunk,
+                                                        fido_stream_complete_callback_t on_complete) {
+    if (!g_transport_ctx.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    FIDO_CRITICAL_ENTER();
+    g_transport_ctx.chunk_callback = on_chunk;
+    g_transport_ctx.stream_complete_callback = on_complete;
+    FIDO_CRITICAL_EXIT();
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Enable deferred message delivery
+ */
+static hal_result_t fido_transport_set_deferred_delivery(bool enable) {
+    if (!g_transport_ctx.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    g_transport_ctx.deferred_delivery = enable;
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Release a message delivered in deferred mode
+ */
+static hal_result_t fido_transport_release_message(const uint8_t* data) {
+    if (!g_transport_ctx.initialized || !data) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_result_t result = HAL_ERROR_INVALID_STATE;
+    
+    FIDO_CRITICAL_ENTER();
+    for (int i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        fido_receive_buffer_t* slot = &g_transport_ctx.rx_slots[i];
+        if (slot->active && slot->delivered && slot->buffer == data) {
+            release_receive_slot(slot);
+            result = HAL_SUCCESS;
+            break;
+        }
+    }
+    
+    // A slot may have been freed while every slot was taken
+    prime_next_receive();
+    FIDO_CRITICAL_EXIT();
+    
+    return result;
+}
+
 /**
  * @brief Allocate new channel
  */
@@ -251,25 +472,39 @@ static hal_result_t fido_transport_allocate_channel(uint32_t* new_cid) {
         return HAL_ERROR_INVALID_PARAM;
     }
     
-    // Find available channel slot
+    // Find available channel slot, evicting the least recently active one
     fido_channel_t* channel = allocate_channel_slot();
     if (!channel) {
-        return HAL_ERROR_RESOURCE_BUSY;
+        return HAL_ERROR_BUSY;
     }
     
-    // Allocate new CID
-    *new_cid = g_transport_ctx.next_cid++;
+    // Allocate new CID: serial number above the table index
+    fido_channel_index_t index = (fido_channel_index_t)(channel - g_transport_ctx.channels);
+    *new_cid = (g_transport_ctx.next_cid_serial << FIDO_CID_INDEX_BITS) | index;
     
-    // Avoid reserved range and wrap around
-    if (g_transport_ctx.next_cid == 0) {
-        g_transport_ctx.next_cid = 0x00010000;
+    // Avoid reserved range and broadcast CID on wrap around
+    if (++g_transport_ctx.next_cid_serial > FIDO_CID_SERIAL_LAST) {
+        g_transport_ctx.next_cid_serial = FIDO_CID_SERIAL_FIRST;
     }
     
     // Initialize channel
+    memset(channel, 0, sizeof(*channel));
     channel->cid = *new_cid;
-    channel->last_activity = get_timestamp_ms();
     channel->active = true;
+    timer_wheel_node_init(&channel->timer, channel_timeout_expired, channel);
+    bucket_init(&channel->bucket, FIDO_CHANNEL_BURST, get_timestamp_ms());
+    
+    // Link as most recently active
+    channel->lru_prev = FIDO_CHANNEL_NONE;
+    channel->lru_next = g_transport_ctx.lru_head;
+    if (g_transport_ctx.lru_head != FIDO_CHANNEL_NONE) {
+        g_transport_ctx.channels[g_transport_ctx.lru_head].lru_prev = index;
+    } else {
+        g_transport_ctx.lru_tail = index;
+    }
+    g_transport_ctx.lru_head = index;
     
+    update_channel_activity(*new_cid);
     return HAL_SUCCESS;
 }
 
@@ -296,24 +531,64 @@ static bool fido_transport_is_channel_active(uint32_t cid) {
  * @brief USB receive callback
  */
 static void usb_rx_callback(uint8_t endpoint, const uint8_t* data, size_t length) {
-    if (endpoint != FIDO_HID_ENDPOINT || length != FIDO_HID_PACKET_SIZE) {
+    if (endpoint != FIDO_HID_ENDPOINT) {
         return;
     }
     
-    // Convert to fixed-size packet and process
-    uint8_t packet[FIDO_HID_PACKET_SIZE];
-    memcpy(packet, data, FIDO_HID_PACKET_SIZE);
+    if (g_transport_ctx.rx_landing.buffer && data == g_transport_ctx.rx_landing.buffer) {
+        // Report was received in place into the landing zone
+        process_landed_packet(length);
+    } else if (length == FIDO_HID_PACKET_SIZE) {
+        // HAL delivered from its own buffer, parse it where it is
+        process_fido_packet(data);
+    }
     
-    process_fido_packet(packet);
+    prime_next_receive();
 }
 
 /**
  * @brief USB transmit complete callback
+ * 
+ * Sends the frame prepared while the previous one was on the bus, then
+ * refills the frame just released with the packet after it.
  */
 static void usb_tx_complete_callback(uint8_t endpoint, hal_result_t result) {
-    // Handle transmission completion if needed
-    (void)endpoint;
-    (void)result;
+    if (endpoint != FIDO_HID_ENDPOINT || !g_transport_ctx.tx_busy) {
+        return;
+    }
+    
+    g_transport_ctx.tx_busy = false;
+    
+    if (result != HAL_SUCCESS) {
+        tx_finish_message(result);
+        tx_start_next();
+        return;
+    }
+    
+    if (!g_transport_ctx.tx_next_ready) {
+        // Last packet of the message is out
+        tx_finish_message(HAL_SUCCESS);
+        tx_start_next();
+        return;
+    }
+    
+    fido_tx_message_t* msg = &g_transport_ctx.tx_queue[g_transport_ctx.tx_head];
+    uint8_t next = g_transport_ctx.tx_frame_in_flight ^ 1;
+    
+    g_transport_ctx.tx_frame_in_flight = next;
+    g_transport_ctx.tx_busy = true;
+    result = g_transport_ctx.usb_hal->send_report(FIDO_HID_ENDPOINT, 
+                                                  (const uint8_t*)g_transport_ctx.tx_frames[next],
+                                                  FIDO_HID_PACKET_SIZE);
+    if (result != HAL_SUCCESS) {
+        g_transport_ctx.tx_busy = false;
+        tx_finish_message(result);
+        tx_start_next();
+        return;
+    }
+    
+    // Refill the frame that just completed while this one is on the bus
+    g_transport_ctx.tx_next_ready = build_next_frame(msg, next ^ 1);
 }
 
 /**
@@ -321,11 +596,18 @@ static void usb_tx_complete_callback(uint8_t endpoint, hal_result_t result) {
  */
 static void usb_event_callback(uint32_t event) {
     if (event & USB_HID_EVENT_DISCONNECT) {
-        reset_receive_buffer();
+        reset_receive_slots();
+        tx_abort_all(HAL_ERROR_INVALID_STATE);
         g_transport_ctx.state = FIDO_TRANSPORT_IDLE;
         
         // Reset all channels
-        memset(g_transport_ctx.channels, 0, sizeof(g_transport_ctx.channels));
+        reset_channel_table();
+    }
+    
+    if (event & (USB_HID_EVENT_CONNECT | USB_HID_EVENT_RESET)) {
+        // Controller dropped any primed transfer, arm the endpoint again
+        g_transport_ctx.rx_landing.buffer = NULL;
+        prime_next_receive();
     }
 }
 
@@ -344,183 +626,1049 @@ static hal_result_t process_fido_packet(const uint8_t packet[FIDO_HID_PACKET_SIZ
     fido_hid_parse_packet(packet, &cid, &is_init, &cmd_or_seq, 
                          &total_len, &payload, &payload_len);
     
-    if (is_init) {
-        // Initialization packet
-        uint8_t cmd = cmd_or_seq;
-        
-        // Special handling for broadcast CID (INIT command)
-        if (cid == FIDO_BROADCAST_CID && cmd != FIDO_HID_INIT) {
-            send_error_response(cid, FIDO_ERR_INVALID_CID);
-            return HAL_ERROR_INVALID_PARAM;
-        }
-        
-        // Validate channel for non-broadcast
-        if (cid != FIDO_BROADCAST_CID && !fido_transport_is_channel_active(cid)) {
-            send_error_response(cid, FIDO_ERR_INVALID_CID);
-            return HAL_ERROR_INVALID_PARAM;
-        }
-        
-        // Reset receive buffer for new message
-        reset_receive_buffer();
-        
-        g_transport_ctx.rx_buffer.cid = cid;
-        g_transport_ctx.rx_buffer.cmd = cmd;
-        g_transport_ctx.rx_buffer.total_length = total_len;
-        g_transport_ctx.rx_buffer.received_length = 0;
-        g_transport_ctx.rx_buffer.expected_seq = 0;
-        g_transport_ctx.rx_buffer.timeout_start = get_timestamp_ms();
-        g_transport_ctx.rx_buffer.active = true;
-        
-        // Copy data from initialization packet
-        size_t copy_len = (total_len > FIDO_HID_INIT_PAYLOAD_SIZE) ? 
-                         FIDO_HID_INIT_PAYLOAD_SIZE : total_len;
-        memcpy(g_transport_ctx.rx_buffer.buffer, payload, copy_len);
-        g_transport_ctx.rx_buffer.received_length = copy_len;
-        
-        if (total_len <= FIDO_HID_INIT_PAYLOAD_SIZE) {
-            // Complete message received
-            if (g_transport_ctx.msg_callback) {
-                g_transport_ctx.msg_callback(cid, cmd, 
-                                           g_transport_ctx.rx_buffer.buffer, 
-                                           total_len);
-            }
-            reset_receive_buffer();
-            update_channel_activity(cid);
-        } else {
-            g_transport_ctx.state = FIDO_TRANSPORT_RECEIVING;
-        }
-    } else {
-        // Continuation packet
-        if (!g_transport_ctx.rx_buffer.active) {
-            send_error_response(cid, FIDO_ERR_INVALID_SEQ);
-            return HAL_ERROR_INVALID_STATE;
-        }
-        
-        if (g_transport_ctx.rx_buffer.cid != cid) {
-            send_error_response(cid, FIDO_ERR_INVALID_CID);
-            return HAL_ERROR_INVALID_PARAM;
-        }
-        
-        uint8_t seq = cmd_or_seq;
-        if (seq != g_transport_ctx.rx_buffer.expected_seq) {
-            send_error_response(cid, FIDO_ERR_INVALID_SEQ);
-            reset_receive_buffer();
-            return HAL_ERROR_INVALID_PARAM;
-        }
-        
-        // Copy continuation data
-        size_t remaining = g_transport_ctx.rx_buffer.total_length - 
-                          g_transport_ctx.rx_buffer.received_length;
-        size_t copy_len = (remaining > FIDO_HID_CONT_PAYLOAD_SIZE) ? 
-                         FIDO_HID_CONT_PAYLOAD_SIZE : remaining;
-        
-        memcpy(g_transport_ctx.rx_buffer.buffer + g_transport_ctx.rx_buffer.received_length,
-               payload, copy_len);
-        g_transport_ctx.rx_buffer.received_length += copy_len;
-        g_transport_ctx.rx_buffer.expected_seq++;
-        
-        if (g_transport_ctx.rx_buffer.received_length >= g_transport_ctx.rx_buffer.total_length) {
-            // Complete message received
-            if (g_transport_ctx.msg_callback) {
-                g_transport_ctx.msg_callback(g_transport_ctx.rx_buffer.cid, 
-                                           g_transport_ctx.rx_buffer.cmd,
-                                           g_transport_ctx.rx_buffer.buffer, 
-                                           g_transport_ctx.rx_buffer.total_length);
-            }
-            update_channel_activity(cid);
-            reset_receive_buffer();
-            g_transport_ctx.state = FIDO_TRANSPORT_IDLE;
-        }
-    }
-    
-    return HAL_SUCCESS;
-}
-
-/**
- * @brief Send error response
- */
-static hal_result_t send_error_response(uint32_t cid, uint8_t error_code) {
-    return fido_transport_send_error(cid, error_code);
+    return process_parsed_packet(cid, is_init, cmd_or_seq, total_len, payload);
 }
 
 /**
- * @brief Reset receive buffer
+ * @brief Admit a parsed packet and hand it to reassembly
  */
-static void reset_receive_buffer(void) {
-    memset(&g_transport_ctx.rx_buffer, 0, sizeof(g_transport_ctx.rx_buffer));
+static hal_result_t process_parsed_packet(uint32_t cid, bool is_init, uint8_t cmd_or_seq,
+                                          uint16_t total_len, const uint8_t* payload) {
+    // Over-budget reports never reach reassembly or produce a response
+    if (!admit_packet(cid)) {
+        return HAL_ERROR_BUSY;
+    }
+    
+    if (is_init) {
+        return process_init_packet(cid, cmd_or_seq, total_len, payload);
+    }
+    
+    return process_cont_packet(cid, cmd_or_seq, payload);
 }
 
 /**
- * @brief Get current timestamp (placeholder implementation)
+ * @brief Process report received in place into the landing zone
+ * 
+ * A report that landed in a slot tail has its header parsed first, then
+ * the stashed bytes under the header are put back. The payload is left
+ * where it landed: a continuation for that slot is already in place, and
+ * any other report is copied once, from there into the slot that owns it.
  */
-static uint32_t get_timestamp_ms(void) {
-    // TODO: Implement actual timestamp function
-    static uint32_t counter = 0;
-    return counter++;
+static hal_result_t process_landed_packet(size_t length) {
+    fido_rx_landing_t* landing = &g_transport_ctx.rx_landing;
+    uint8_t* packet = landing->buffer;
+    
+    landing->buffer = NULL;
+    
+    if (length != FIDO_HID_PACKET_SIZE) {
+        if (landing->stashed) {
+            FIDO_COPY(packet, landing->stash, FIDO_HID_CONT_HEADER_SIZE);
+            landing->stashed = false;
+        }
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!landing->stashed) {
+        return process_fido_packet(packet);
+    }
+    
+    uint32_t cid;
+    bool is_init;
+    uint8_t cmd_or_seq;
+    uint16_t total_len;
+    const uint8_t* payload;
+    size_t payload_len;
+    
+    // The stash only covers the first header bytes, never the payload
+    fido_hid_parse_packet(packet, &cid, &is_init, &cmd_or_seq, 
+                         &total_len, &payload, &payload_len);
+    FIDO_COPY(packet, landing->stash, FIDO_HID_CONT_HEADER_SIZE);
+    landing->stashed = false;
+    
+    return process_parsed_packet(cid, is_init, cmd_or_seq, total_len, payload);
 }
 
 /**
- * @brief Find channel by CID
+ * @brief Prime the OUT endpoint at the next payload position
+ * 
+ * The next report is received at the end of the likeliest slot's payload,
+ * header first. That is the slot that followed the most recently extended
+ * one last time: the same slot for a single stream, the next channel in
+ * turn when channels interleave. With no message in flight, a free slot
+ * is primed so an INIT packet lands with its payload at the start of the
+ * slot buffer.
  */
-static fido_channel_t* find_channel(uint32_t cid) {
-    for (int i = 0; i < FIDO_MAX_CHANNELS; i++) {
-        if (g_transport_ctx.channels[i].active && 
-            g_transport_ctx.channels[i].cid == cid) {
-            return &g_transport_ctx.channels[i];
+static void prime_next_receive(void) {
+    const usb_hid_hal_t* usb_hal = g_transport_ctx.usb_hal;
+    fido_rx_landing_t* landing = &g_transport_ctx.rx_landing;
+    
+    if (!g_transport_ctx.initialized || !usb_hal || !usb_hal->prime_receive ||
+        landing->buffer) {
+        return;
+    }
+    
+    fido_receive_buffer_t* slot = g_transport_ctx.rx_last_slot;
+    if (slot) {
+        fido_receive_buffer_t* next = &g_transport_ctx.rx_slots[slot->successor];
+        if (next->active && !next->delivered && next->received_length < next->total_length) {
+            slot = next;
         }
     }
-    return NULL;
+    landing->buffer = g_transport_ctx.rx_bounce;
+    
+    if (slot && slot->active && slot->received_length < slot->total_length) {
+        // Continuation: header overlays the tail of the payload so far
+        landing->buffer = slot->buffer + slot->received_length - FIDO_HID_CONT_HEADER_SIZE;
+        FIDO_COPY(landing->stash, landing->buffer, FIDO_HID_CONT_HEADER_SIZE);
+        landing->stashed = true;
+    } else {
+        for (int i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+            if (!g_transport_ctx.rx_slots[i].active) {
+                landing->buffer = g_transport_ctx.rx_slots[i].storage;
+                break;
+            }
+        }
+    }
+    
+    if (usb_hal->prime_receive(FIDO_HID_ENDPOINT, landing->buffer, 
+                               FIDO_HID_PACKET_SIZE) != HAL_SUCCESS) {
+        landing->stashed = false;
+        landing->buffer = NULL;
+    }
 }
 
 /**
- * @brief Allocate channel slot
+ * @brief Process initialization packet
+ * 
+ * Single-packet messages are delivered straight from the packet payload
+ * and never occupy a reassembly slot (in deferred mode, only INIT is).
+ * Fragmented messages get a slot of their own, so traffic on one CID never
+ * disturbs another CID.
  */
-static fido_channel_t* allocate_channel_slot(void) {
-    // Find free slot
-    for (int i = 0; i < FIDO_MAX_CHANNELS; i++) {
-        if (!g_transport_ctx.channels[i].active) {
-            return &g_transport_ctx.channels[i];
+static hal_result_t process_init_packet(uint32_t cid, uint8_t cmd, uint16_t total_len,
+                                        const uint8_t* payload) {
+    // Special handling for broadcast CID (INIT command)
+    if (cid == FIDO_BROADCAST_CID && cmd != FIDO_HID_INIT) {
+        send_error_response(cid, FIDO_ERR_INVALID_CID);
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    // Validate channel for non-broadcast
+    if (cid != FIDO_BROADCAST_CID && !fido_transport_is_channel_active(cid)) {
+        send_error_response(cid, FIDO_ERR_INVALID_CID);
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (total_len > FIDO_MAX_MESSAGE_SIZE) {
+        send_error_response(cid, FIDO_ERR_INVALID_LEN);
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    // A new INIT packet restarts any message in flight on the same CID only
+    fido_receive_buffer_t* slot = find_receive_slot(cid);
+    if (slot) {
+        abort_receive_slot(slot, HAL_ERROR_INVALID_STATE);
+    }
+    
+    if (cmd == FIDO_HID_CANCEL) {
+        // Fast path: abort the outstanding request, CANCEL has no response.
+        // Only CBOR requests can be cancelled, anything else runs to the end
+        fido_receive_buffer_t* held = find_delivered_slot(cid);
+        if (g_transport_ctx.cancel_callback && (!held || held->cmd == FIDO_HID_CBOR)) {
+            g_transport_ctx.cancel_callback(cid);
         }
+        return HAL_SUCCESS;
     }
     
-    // No free slots, try to find expired channel
-    uint32_t current_time = get_timestamp_ms();
-    for (int i = 0; i < FIDO_MAX_CHANNELS; i++) {
-        if (current_time - g_transport_ctx.channels[i].last_activity > FIDO_CHANNEL_TIMEOUT_MS) {
-            memset(&g_transport_ctx.channels[i], 0, sizeof(fido_channel_t));
-            return &g_transport_ctx.channels[i];
+    if (find_delivered_slot(cid)) {
+        // Previous request on this channel is still being processed
+        if (cmd != FIDO_HID_INIT) {
+            send_error_response(cid, FIDO_ERR_CHANNEL_BUSY);
+            return HAL_ERROR_BUSY;
+        }
+        
+        // INIT resynchronizes the channel and abandons that request
+        if (g_transport_ctx.cancel_callback) {
+            g_transport_ctx.cancel_callback(cid);
+        }
+    }
+    
+    // A single-packet INIT is answered during the callback even in deferred
+    // mode, so it never waits for a slot behind requests still being held
+    if (total_len <= FIDO_HID_INIT_PAYLOAD_SIZE &&
+        (!g_transport_ctx.deferred_delivery || cmd == FIDO_HID_INIT)) {
+        // Complete message received
+        channel_note_received(cid, total_len);
+        stream_chunk(cid, cmd, 0, payload, total_len);
+        stream_end(cid, cmd, total_len, HAL_SUCCESS);
+        if (g_transport_ctx.msg_callback) {
+            g_transport_ctx.msg_callback(cid, cmd, payload, total_len);
         }
+        return HAL_SUCCESS;
+    }
+    
+    slot = allocate_receive_slot(cid, payload);
+    if (!slot) {
+        // Every slot is assembling a message for another channel
+        send_error_response(cid, FIDO_ERR_CHANNEL_BUSY);
+        return HAL_ERROR_BUSY;
+    }
+    
+    slot->cmd = cmd;
+    slot->total_length = total_len;
+    slot->expected_seq = 0;
+    timer_wheel_schedule(&g_transport_ctx.timers, &slot->timer, FIDO_RECEIVE_TIMEOUT_MS);
+    
+    // Copy data from initialization packet unless it was received in place
+    if (payload != slot->buffer) {
+        FIDO_COPY(slot->buffer, payload, FIDO_HID_INIT_PAYLOAD_SIZE);
+    }
+    slot->received_length = FIDO_HID_INIT_PAYLOAD_SIZE;
+    note_slot_extended(slot);
+    
+    if (total_len <= FIDO_HID_INIT_PAYLOAD_SIZE) {
+        // Single packet kept in a slot for deferred delivery
+        slot->received_length = total_len;
+        stream_chunk(cid, cmd, 0, slot->buffer, total_len);
+        complete_message(slot);
+    } else {
+        stream_chunk(cid, cmd, 0, slot->buffer, FIDO_HID_INIT_PAYLOAD_SIZE);
     }
     
-    return NULL; // No available slots
+    return HAL_SUCCESS;
 }
 
 /**
- * @brief Update channel activity
+ * @brief Process continuation packet
  */
-static void update_channel_activity(uint32_t cid) {
-    if (cid == FIDO_BROADCAST_CID) {
-        return; // Don't track broadcast channel
+static hal_result_t process_cont_packet(uint32_t cid, uint8_t seq, const uint8_t* payload) {
+    fido_receive_buffer_t* slot = find_receive_slot(cid);
+    if (!slot) {
+        send_error_response(cid, FIDO_ERR_INVALID_SEQ);
+        return HAL_ERROR_INVALID_STATE;
     }
     
-    fido_channel_t* channel = find_channel(cid);
-    if (channel) {
-        channel->last_activity = get_timestamp_ms();
+    if (seq != slot->expected_seq) {
+        abort_receive_slot(slot, HAL_ERROR_INVALID_PARAM);
+        send_error_response(cid, FIDO_ERR_INVALID_SEQ);
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    // Copy continuation data
+    size_t remaining = slot->total_length - slot->received_length;
+    size_t copy_len = (remaining > FIDO_HID_CONT_PAYLOAD_SIZE) ? 
+                     FIDO_HID_CONT_PAYLOAD_SIZE : remaining;
+    
+    if (payload != slot->buffer + slot->received_length) {
+        FIDO_COPY(slot->buffer + slot->received_length, payload, copy_len);
     }
+    stream_chunk(cid, slot->cmd, slot->received_length, 
+                 slot->buffer + slot->received_length, copy_len);
+    slot->received_length += copy_len;
+    slot->expected_seq++;
+    note_slot_extended(slot);
+    
+    if (slot->received_length >= slot->total_length) {
+        complete_message(slot);
+    }
+    
+    return HAL_SUCCESS;
 }
 
 /**
- * @brief FIDO transport interface instance
+ * @brief Deliver an assembled message
+ * 
+ * In deferred mode the slot stays reserved for the receiver until it calls
+ * release_message(); otherwise it is recycled as soon as the callback returns.
  */
-static const fido_hid_transport_t g_fido_transport = {
-    .init = fido_transport_init,
-    .deinit = fido_transport_deinit,
+static void complete_message(fido_receive_buffer_t* slot) {
+    uint32_t cid = slot->cid;
+    
+    timer_wheel_cancel(&slot->timer);
+    stream_end(cid, slot->cmd, slot->total_length, HAL_SUCCESS);
+    if (g_transport_ctx.deferred_delivery) {
+        slot->delivered = true;
+        if (g_transport_ctx.rx_last_slot == slot) {
+            g_transport_ctx.rx_last_slot = NULL;
+        }
+    }
+    
+    channel_note_received(cid, slot->total_length);
+    if (g_transport_ctx.msg_callback) {
+        g_transport_ctx.msg_callback(cid, slot->cmd, slot->buffer, slot->total_length);
+    }
+    
+    if (!g_transport_ctx.deferred_delivery) {
+        release_receive_slot(slot);
+    }
+}
+
+/**
+ * @brief Pass a payload chunk to the streaming receiver
+ */
+static void stream_chunk(uint32_t cid, uint8_t cmd, size_t offset, const uint8_t* data,
+                         size_t length) {
+    if (g_transport_ctx.chunk_callback) {
+        g_transport_ctx.chunk_callback(cid, cmd, offset, data, length);
+    }
+}
+
+/**
+ * @brief Close the stream of a message, complete or abandoned
+ */
+static void stream_end(uint32_t cid, uint8_t cmd, size_t length, hal_result_t status) {
+    if (g_transport_ctx.chunk_callback && g_transport_ctx.stream_complete_callback) {
+        g_transport_ctx.stream_complete_callback(cid, cmd, length, status);
+    }
+}
+
+/**
+ * @brief Drop a message still being assembled
+ * 
+ * Tells the streaming receiver to discard the chunks it was given.
+ */
+static void abort_receive_slot(fido_receive_buffer_t* slot, hal_result_t reason) {
+    if (slot->active && !slot->delivered) {
+        stream_end(slot->cid, slot->cmd, slot->total_length, reason);
+    }
+    release_receive_slot(slot);
+}
+
+/**
+ * @brief Add message to the transmit queue
+ * 
+ * Starts transmission right away when the endpoint is idle; otherwise the
+ * message is picked up from the transmit complete callback.
+ */
+static hal_result_t queue_message(uint32_t cid, uint8_t cmd, const uint8_t* data, size_t length,
+                                  fido_send_complete_callback_t on_complete, void* user_data) {
+    if (!g_transport_ctx.initialized || !g_transport_ctx.usb_hal) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    if (length > FIDO_MAX_MESSAGE_SIZE || (length > 0 && !data)) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    FIDO_CRITICAL_ENTER();
+    
+    if (g_transport_ctx.tx_count >= FIDO_TX_QUEUE_DEPTH) {
+        FIDO_CRITICAL_EXIT();
+        return HAL_ERROR_BUSY;
+    }
+    
+    uint8_t index = (g_transport_ctx.tx_head + g_transport_ctx.tx_count) % FIDO_TX_QUEUE_DEPTH;
+    fido_tx_message_t* msg = &g_transport_ctx.tx_queue[index];
+    
+    msg->cid = cid;
+    msg->cmd = cmd;
+    msg->length = (uint16_t)length;
+    msg->on_complete = on_complete;
+    msg->user_data = user_data;
+    msg->buffered = 0;
+    
+    if (!on_complete) {
+        // Nobody is told when the send ends, so the caller's buffer is not kept
+        uint8_t* copy = msg->inline_data;
+        if (length > FIDO_TX_INLINE_SIZE) {
+            copy = tx_buffer_reserve(length, &msg->buffered);
+            if (!copy) {
+                FIDO_CRITICAL_EXIT();
+                return HAL_ERROR_BUSY;
+            }
+        }
+        if (length > 0) {
+            FIDO_COPY(copy, data, length);
+        }
+        data = copy;
+    }
+    fido_hid_framer_init(&msg->framer, cid, cmd, data, (uint16_t)length);
+    
+    g_transport_ctx.tx_count++;
+    g_transport_ctx.state = FIDO_TRANSPORT_SENDING;
+    
+    if (!g_transport_ctx.tx_busy) {
+        tx_start_next();
+    }
+    
+    FIDO_CRITICAL_EXIT();
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Build next packet of a queued message into a ping-pong frame
+ * 
+ * @return true if a packet was built, false if the message is fully framed
+ */
+static bool build_next_frame(fido_tx_message_t* msg, uint8_t frame) {
+    return fido_hid_framer_build(&msg->framer, g_transport_ctx.tx_frames, 2, frame, 1) == 1;
+}
+
+/**
+ * @brief Start transmitting the message at the head of the queue
+ * 
+ * Emits the INIT packet and prepares the first continuation packet in the
+ * other ping-pong frame so it can be sent as soon as the INIT completes.
+ */
+static void tx_start_next(void) {
+    while (g_transport_ctx.tx_count > 0 && !g_transport_ctx.tx_busy) {
+        fido_tx_message_t* msg = &g_transport_ctx.tx_queue[g_transport_ctx.tx_head];
+        uint8_t frame = g_transport_ctx.tx_frame_in_flight;
+        
+        // INIT and first continuation in one pass over the ring
+        g_transport_ctx.tx_next_ready = 
+            fido_hid_framer_build(&msg->framer, g_transport_ctx.tx_frames, 2, frame, 2) == 2;
+        
+        g_transport_ctx.tx_busy = true;
+        hal_result_t result = g_transport_ctx.usb_hal->send_report(
+            FIDO_HID_ENDPOINT, (const uint8_t*)g_transport_ctx.tx_frames[frame], 
+            FIDO_HID_PACKET_SIZE);
+        if (result == HAL_SUCCESS) {
+            return;
+        }
+        
+        g_transport_ctx.tx_busy = false;
+        tx_finish_message(result);
+    }
+    
+    if (g_transport_ctx.tx_count == 0 && !g_transport_ctx.tx_busy &&
+        g_transport_ctx.state == FIDO_TRANSPORT_SENDING) {
+        g_transport_ctx.state = get_idle_state();
+    }
+}
+
+/**
+ * @brief Retire the message at the head of the queue
+ */
+static void tx_finish_message(hal_result_t result) {
+    if (g_transport_ctx.tx_count == 0) {
+        return;
+    }
+    
+    fido_tx_message_t* msg = &g_transport_ctx.tx_queue[g_transport_ctx.tx_head];
+    uint32_t cid = msg->cid;
+    uint8_t cmd = msg->cmd;
+    size_t length = msg->length;
+    fido_send_complete_callback_t on_complete = msg->on_complete;
+    void* user_data = msg->user_data;
+    
+    g_transport_ctx.tx_head = (g_transport_ctx.tx_head + 1) % FIDO_TX_QUEUE_DEPTH;
+    g_transport_ctx.tx_count--;
+    g_transport_ctx.tx_next_ready = false;
+    g_transport_ctx.tx_buffer_used -= msg->buffered;
+    
+    channel_note_sent(cid, cmd, length, result);
+    
+    if (on_complete) {
+        on_complete(cid, cmd, result, user_data);
+    }
+}
+
+/**
+ * @brief Drop every queued message, notifying their owners
+ */
+static void tx_abort_all(hal_result_t result) {
+    g_transport_ctx.tx_busy = false;
+    while (g_transport_ctx.tx_count > 0) {
+        tx_finish_message(result);
+    }
+}
+
+/**
+ * @brief Take room for a payload copy from the TX buffer
+ * 
+ * Copies are taken and released in queue order, so the buffer is a ring
+ * of contiguous spans. A span that does not fit before the end of the
+ * buffer starts over at the front, and the skipped tail is held with it.
+ * 
+ * @param length Payload length
+ * @param held Output bytes held, released when the message retires
+ * @return Copy destination, NULL if the buffer is full
+ */
+static uint8_t* tx_buffer_reserve(size_t length, uint16_t* held) {
+    uint32_t end = g_transport_ctx.tx_buffer_end;
+    uint32_t used = g_transport_ctx.tx_buffer_used;
+    uint32_t start;
+    uint32_t skip = 0;
+    
+    if (used == 0) {
+        end = 0;
+    }
+    
+    // Oldest copy still held, where the free space ends
+    uint32_t oldest = (end >= used) ? end - used : end + FIDO_TX_BUFFER_SIZE - used;
+    
+    if (used == 0 || end > oldest) {
+        // Held spans are [oldest, end): free space after end and before oldest
+        if (length <= FIDO_TX_BUFFER_SIZE - end) {
+            start = end;
+        } else if (length <= oldest) {
+            skip = FIDO_TX_BUFFER_SIZE - end;
+            start = 0;
+        } else {
+            return NULL;
+        }
+    } else if (used < FIDO_TX_BUFFER_SIZE && length <= oldest - end) {
+        // Held spans wrapped: free space is [end, oldest)
+        start = end;
+    } else {
+        return NULL;
+    }
+    
+    *held = (uint16_t)(skip + length);
+    g_transport_ctx.tx_buffer_end = (uint16_t)(start + length);
+    g_transport_ctx.tx_buffer_used = (uint16_t)(used + skip + length);
+    return &g_transport_ctx.tx_buffer[start];
+}
+
+/**
+ * @brief Send error response
+ */
+static hal_result_t send_error_response(uint32_t cid, uint8_t error_code) {
+    channel_note_error(cid);
+    
+    if (error_response_queued(cid, error_code)) {
+        // The host gets one copy of a repeated error
+        g_transport_ctx.admission.errors_coalesced++;
+        return HAL_SUCCESS;
+    }
+    
+    // Errors never take the last TX slot, so replies to good requests still fit
+    if (g_transport_ctx.tx_count >= FIDO_TX_ERROR_LIMIT ||
+        !bucket_take(&g_transport_ctx.error_bucket, FIDO_ERROR_RATE_PPS, FIDO_ERROR_BURST,
+                     get_timestamp_ms())) {
+        g_transport_ctx.admission.errors_suppressed++;
+        return HAL_ERROR_BUSY;
+    }
+    
+    g_transport_ctx.admission.errors_sent++;
+    return fido_transport_send_error(cid, error_code);
+}
+
+/**
+ * @brief Check if the same error is already waiting in the TX queue
+ *
+ * Reads the payload through the framer: only copied sends live in
+ * inline_data, asynchronous ones point at the caller's buffer.
+ */
+static bool error_response_queued(uint32_t cid, uint8_t error_code) {
+    for (uint8_t i = 0; i < g_transport_ctx.tx_count; i++) {
+        const fido_tx_message_t* msg = 
+            &g_transport_ctx.tx_queue[(g_transport_ctx.tx_head + i) % FIDO_TX_QUEUE_DEPTH];
+        if (msg->cmd == FIDO_HID_ERROR && msg->cid == cid && msg->length == 1 &&
+            msg->framer.data[0] == error_code) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Fill a token bucket
+ */
+static void bucket_init(fido_token_bucket_t* bucket, uint32_t burst, uint32_t now_ms) {
+    bucket->tokens = burst * FIDO_TOKEN_SCALE;
+    bucket->last_ms = now_ms;
+}
+
+/**
+ * @brief Refill a token bucket and take one packet's worth
+ * 
+ * @return true if a token was available
+ */
+static bool bucket_take(fido_token_bucket_t* bucket, uint32_t rate, uint32_t burst,
+                        uint32_t now_ms) {
+    uint32_t capacity = burst * FIDO_TOKEN_SCALE;
+    uint32_t elapsed = now_ms - bucket->last_ms;
+    
+    bucket->last_ms = now_ms;
+    if (elapsed >= capacity / rate) {
+        bucket->tokens = capacity; // Also keeps elapsed * rate from overflowing
+    } else {
+        bucket->tokens += elapsed * rate;
+        if (bucket->tokens > capacity) {
+            bucket->tokens = capacity;
+        }
+    }
+    
+    if (bucket->tokens < FIDO_TOKEN_SCALE) {
+        return false;
+    }
+    bucket->tokens -= FIDO_TOKEN_SCALE;
+    return true;
+}
+
+/**
+ * @brief Admission control for one OUT report
+ * 
+ * The report's own bucket is charged first, so a channel over its budget
+ * is stopped without draining the global budget shared with the others.
+ * 
+ * @return true if the report may be processed
+ */
+static bool admit_packet(uint32_t cid) {
+    uint32_t now = get_timestamp_ms();
+    fido_channel_t* channel = find_channel(cid);
+    
+    if (channel) {
+        if (!bucket_take(&channel->bucket, FIDO_CHANNEL_RATE_PPS, FIDO_CHANNEL_BURST, now)) {
+            channel->packets_dropped++;
+            g_transport_ctx.admission.dropped_channel++;
+            return false;
+        }
+    } else if (!bucket_take(&g_transport_ctx.unowned_bucket, FIDO_UNOWNED_RATE_PPS,
+                            FIDO_UNOWNED_BURST, now)) {
+        // Broadcast INIT storms and unknown CIDs share one budget
+        g_transport_ctx.admission.dropped_unowned++;
+        return false;
+    }
+    
+    if (!bucket_take(&g_transport_ctx.global_bucket, FIDO_GLOBAL_RATE_PPS, FIDO_GLOBAL_BURST,
+                     now)) {
+        if (channel) {
+            channel->packets_dropped++;
+        }
+        g_transport_ctx.admission.dropped_global++;
+        return false;
+    }
+    
+    g_transport_ctx.admission.packets_admitted++;
+    return true;
+}
+
+/**
+ * @brief Find reassembly slot owned by CID
+ */
+static fido_receive_buffer_t* find_receive_slot(uint32_t cid) {
+    if (g_transport_ctx.rx_active_count == 0) {
+        return NULL;
+    }
+    
+    for (int i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        if (g_transport_ctx.rx_slots[i].active && 
+            !g_transport_ctx.rx_slots[i].delivered &&
+            g_transport_ctx.rx_slots[i].cid == cid) {
+            return &g_transport_ctx.rx_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find message delivered on CID and not yet released
+ */
+static fido_receive_buffer_t* find_delivered_slot(uint32_t cid) {
+    if (g_transport_ctx.rx_active_count == 0) {
+        return NULL;
+    }
+    
+    for (int i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        if (g_transport_ctx.rx_slots[i].active && 
+            g_transport_ctx.rx_slots[i].delivered &&
+            g_transport_ctx.rx_slots[i].cid == cid) {
+            return &g_transport_ctx.rx_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Claim a free reassembly slot for CID
+ * 
+ * @param hint Payload already received in place; the slot holding it is
+ *             preferred so the payload does not have to move
+ */
+static fido_receive_buffer_t* allocate_receive_slot(uint32_t cid, const uint8_t* hint) {
+    fido_receive_buffer_t* slot = NULL;
+    
+    for (int i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        if (!g_transport_ctx.rx_slots[i].active) {
+            if (!slot || g_transport_ctx.rx_slots[i].buffer == hint) {
+                slot = &g_transport_ctx.rx_slots[i];
+            }
+        }
+    }
+    
+    if (!slot) {
+        return NULL;
+    }
+    
+    slot->cid = cid;
+    slot->active = true;
+    slot->successor = (uint8_t)(slot - g_transport_ctx.rx_slots);
+    g_transport_ctx.rx_active_count++;
+    if (g_transport_ctx.state == FIDO_TRANSPORT_IDLE) {
+        g_transport_ctx.state = FIDO_TRANSPORT_RECEIVING;
+    }
+    return slot;
+}
+
+/**
+ * @brief Record which slot a report extended, for prime_next_receive()
+ */
+static void note_slot_extended(fido_receive_buffer_t* slot) {
+    if (g_transport_ctx.rx_last_slot) {
+        g_transport_ctx.rx_last_slot->successor = (uint8_t)(slot - g_transport_ctx.rx_slots);
+    }
+    g_transport_ctx.rx_last_slot = slot;
+}
+
+/**
+ * @brief Return reassembly slot to the pool
+ * 
+ * Only the bookkeeping is cleared; the payload area is overwritten by
+ * the next message, so the 7609-byte buffer is not wiped on every reuse.
+ */
+static void release_receive_slot(fido_receive_buffer_t* slot) {
+    if (!slot->active) {
+        return;
+    }
+    
+    timer_wheel_cancel(&slot->timer);
+    slot->active = false;
+    slot->delivered = false;
+    slot->cid = 0;
+    if (g_transport_ctx.rx_last_slot == slot) {
+        g_transport_ctx.rx_last_slot = NULL;
+    }
+    slot->total_length = 0;
+    slot->received_length = 0;
+    slot->expected_seq = 0;
+    
+    if (--g_transport_ctx.rx_active_count == 0 &&
+        g_transport_ctx.state == FIDO_TRANSPORT_RECEIVING) {
+        g_transport_ctx.state = FIDO_TRANSPORT_IDLE;
+    }
+}
+
+/**
+ * @brief State to fall back to once a transmission finishes
+ */
+static fido_transport_state_t get_idle_state(void) {
+    return (g_transport_ctx.rx_active_count > 0) ? FIDO_TRANSPORT_RECEIVING 
+                                                 : FIDO_TRANSPORT_IDLE;
+}
+
+/**
+ * @brief Release every reassembly slot
+ */
+static void reset_receive_slots(void) {
+    for (int i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        abort_receive_slot(&g_transport_ctx.rx_slots[i], HAL_ERROR_INVALID_STATE);
+    }
+}
+
+/**
+ * @brief Get current timestamp
+ */
+static uint32_t get_timestamp_ms(void) {
+    return platform_clock_get_ms();
+}
+
+/**
+ * @brief Find channel by CID
+ */
+static fido_channel_t* find_channel(uint32_t cid) {
+    uint32_t index = cid & FIDO_CID_INDEX_MASK;
+    
+    if (index >= FIDO_MAX_CHANNELS) {
+        return NULL;
+    }
+    
+    fido_channel_t* channel = &g_transport_ctx.channels[index];
+    return (channel->active && channel->cid == cid) ? channel : NULL;
+}
+
+/**
+ * @brief Allocate channel slot
+ * 
+ * Takes an unused entry if there is one, otherwise evicts the least
+ * recently active channel that has no request outstanding.
+ */
+static fido_channel_t* allocate_channel_slot(void) {
+    fido_channel_index_t index = g_transport_ctx.free_head;
+    
+    if (index == FIDO_CHANNEL_NONE) {
+        // At most FIDO_MAX_RX_SLOTS channels can be skipped here
+        for (index = g_transport_ctx.lru_tail; index != FIDO_CHANNEL_NONE;
+             index = g_transport_ctx.channels[index].lru_prev) {
+            if (!channel_has_request(g_transport_ctx.channels[index].cid)) {
+                release_channel(&g_transport_ctx.channels[index]);
+                break;
+            }
+        }
+        
+        if (index == FIDO_CHANNEL_NONE) {
+            return NULL; // Every channel has a request in progress
+        }
+    }
+    
+    // Pop from the free list
+    g_transport_ctx.free_head = g_transport_ctx.channels[index].lru_next;
+    return &g_transport_ctx.channels[index];
+}
+
+/**
+ * @brief Return a channel to the free list
+ */
+static void release_channel(fido_channel_t* channel) {
+    fido_channel_index_t index = (fido_channel_index_t)(channel - g_transport_ctx.channels);
+    
+    if (!channel->active) {
+        return;
+    }
+    
+    timer_wheel_cancel(&channel->timer);
+    
+    // Unlink from the LRU list
+    if (channel->lru_prev != FIDO_CHANNEL_NONE) {
+        g_transport_ctx.channels[channel->lru_prev].lru_next = channel->lru_next;
+    } else {
+        g_transport_ctx.lru_head = channel->lru_next;
+    }
+    if (channel->lru_next != FIDO_CHANNEL_NONE) {
+        g_transport_ctx.channels[channel->lru_next].lru_prev = channel->lru_prev;
+    } else {
+        g_transport_ctx.lru_tail = channel->lru_prev;
+    }
+    
+    channel->active = false;
+    channel->cid = 0;
+    channel->lru_prev = FIDO_CHANNEL_NONE;
+    channel->lru_next = g_transport_ctx.free_head;
+    g_transport_ctx.free_head = index;
+}
+
+/**
+ * @brief Free every channel
+ */
+static void reset_channel_table(void) {
+    for (int i = 0; i < FIDO_MAX_CHANNELS; i++) {
+        fido_channel_t* channel = &g_transport_ctx.channels[i];
+        timer_wheel_cancel(&channel->timer);
+        memset(channel, 0, sizeof(*channel));
+        channel->lru_prev = FIDO_CHANNEL_NONE;
+        channel->lru_next = (i + 1 < FIDO_MAX_CHANNELS) ? (fido_channel_index_t)(i + 1)
+                                                         : FIDO_CHANNEL_NONE;
+    }
+    
+    g_transport_ctx.free_head = 0;
+    g_transport_ctx.lru_head = FIDO_CHANNEL_NONE;
+    g_transport_ctx.lru_tail = FIDO_CHANNEL_NONE;
+}
+
+/**
+ * @brief Check if a request on CID is being assembled or processed
+ */
+static bool channel_has_request(uint32_t cid) {
+    return find_receive_slot(cid) || find_delivered_slot(cid);
+}
+
+/**
+ * @brief Update channel activity
+ * 
+ * Restarts the inactivity timeout and moves the channel to the head of
+ * the LRU list.
+ */
+static void update_channel_activity(uint32_t cid) {
+    if (cid == FIDO_BROADCAST_CID) {
+        return; // Don't track broadcast channel
+    }
+    
+    fido_channel_t* channel = find_channel(cid);
+    if (!channel) {
+        return;
+    }
+    
+    channel->last_activity = get_timestamp_ms();
+    timer_wheel_schedule(&g_transport_ctx.timers, &channel->timer, FIDO_CHANNEL_TIMEOUT_MS);
+    
+    fido_channel_index_t index = (fido_channel_index_t)(channel - g_transport_ctx.channels);
+    if (g_transport_ctx.lru_head == index) {
+        return;
+    }
+    
+    // Unlink (never the head here, so lru_prev is valid)
+    g_transport_ctx.channels[channel->lru_prev].lru_next = channel->lru_next;
+    if (channel->lru_next != FIDO_CHANNEL_NONE) {
+        g_transport_ctx.channels[channel->lru_next].lru_prev = channel->lru_prev;
+    } else {
+        g_transport_ctx.lru_tail = channel->lru_prev;
+    }
+    
+    // Relink at the head
+    channel->lru_prev = FIDO_CHANNEL_NONE;
+    channel->lru_next = g_transport_ctx.lru_head;
+    g_transport_ctx.channels[g_transport_ctx.lru_head].lru_prev = index;
+    g_transport_ctx.lru_head = index;
+}
+
+/**
+ * @brief Account a complete message received on CID
+ */
+static void channel_note_received(uint32_t cid, size_t length) {
+    fido_channel_t* channel = find_channel(cid);
+    
+    if (channel) {
+        channel->messages_received++;
+        channel->bytes_received += (uint32_t)length;
+        channel->request_time_us = platform_clock_get_us();
+        channel->request_pending = true;
+    }
+    update_channel_activity(cid);
+}
+
+/**
+ * @brief Account a finished transmission on CID
+ */
+static void channel_note_sent(uint32_t cid, uint8_t cmd, size_t length, hal_result_t result) {
+    fido_channel_t* channel = find_channel(cid);
+    
+    if (!channel) {
+        return;
+    }
+    
+    if (result != HAL_SUCCESS) {
+        channel->errors++;
+        return;
+    }
+    
+    channel->messages_sent++;
+    channel->bytes_sent += (uint32_t)length;
+    
+    // KEEPALIVE reports progress, it is not the response
+    if (channel->request_pending && cmd != FIDO_HID_KEEPALIVE) {
+        channel->last_latency_us = (uint32_t)(platform_clock_get_us() - channel->request_time_us);
+        channel->request_pending = false;
+    }
+    update_channel_activity(cid);
+}
+
+/**
+ * @brief Account an error response on CID
+ */
+static void channel_note_error(uint32_t cid) {
+    fido_channel_t* channel = find_channel(cid);
+    
+    if (channel) {
+        channel->errors++;
+    }
+}
+
+/**
+ * @brief Read diagnostic counters of a channel table entry
+ */
+static hal_result_t fido_transport_get_channel_stats(uint32_t index, fido_channel_stats_t* stats) {
+    if (!g_transport_ctx.initialized || !stats || index >= FIDO_MAX_CHANNELS) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_result_t result = HAL_ERROR_INVALID_STATE;
+    
+    FIDO_CRITICAL_ENTER();
+    const fido_channel_t* channel = &g_transport_ctx.channels[index];
+    if (channel->active) {
+        stats->cid = channel->cid;
+        stats->messages_received = channel->messages_received;
+        stats->messages_sent = channel->messages_sent;
+        stats->bytes_received = channel->bytes_received;
+        stats->bytes_sent = channel->bytes_sent;
+        stats->errors = channel->errors;
+        stats->last_latency_us = channel->last_latency_us;
+        stats->idle_ms = get_timestamp_ms() - channel->last_activity;
+        stats->packets_dropped = channel->packets_dropped;
+        result = HAL_SUCCESS;
+    }
+    FIDO_CRITICAL_EXIT();
+    
+    return result;
+}
+
+/**
+ * @brief Read admission control counters
+ */
+static hal_result_t fido_transport_get_admission_stats(fido_admission_stats_t* stats) {
+    if (!g_transport_ctx.initialized || !stats) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    FIDO_CRITICAL_ENTER();
+    *stats = g_transport_ctx.admission;
+    FIDO_CRITICAL_EXIT();
+    
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Reassembly did not complete within FIDO_RECEIVE_TIMEOUT_MS
+ */
+static void receive_timeout_expired(void* owner) {
+    fido_receive_buffer_t* slot = (fido_receive_buffer_t*)owner;
+    uint32_t cid = slot->cid;
+    
+    if (!slot->active || slot->delivered) {
+        return;
+    }
+    
+    abort_receive_slot(slot, HAL_ERROR_TIMEOUT);
+    send_error_response(cid, FIDO_ERR_MSG_TIMEOUT);
+}
+
+/**
+ * @brief Channel was idle for FIDO_CHANNEL_TIMEOUT_MS
+ */
+static void channel_timeout_expired(void* owner) {
+    fido_channel_t* channel = (fido_channel_t*)owner;
+    
+    if (!channel->active) {
+        return;
+    }
+    
+    // A request still being assembled or processed keeps the channel alive
+    if (channel_has_request(channel->cid)) {
+        timer_wheel_schedule(&g_transport_ctx.timers, &channel->timer, FIDO_CHANNEL_TIMEOUT_MS);
+        return;
+    }
+    
+    release_channel(channel);
+}
+
+/**
+ * @brief Expire stale reassemblies and idle channels
+ */
+static void fido_transport_process_timeouts(void) {
+    if (!g_transport_ctx.initialized) {
+        return;
+    }
+    
+    FIDO_CRITICAL_ENTER();
+    timer_wheel_advance(&g_transport_ctx.timers, get_timestamp_ms());
+    
+    // An expired reassembly frees a slot the endpoint may be waiting for
+    prime_next_receive();
+    FIDO_CRITICAL_EXIT();
+}
+
+/**
+ * @brief FIDO transport interface instance
+ */
+static const fido_hid_transport_t g_fido_transport = {
+    .init = fido_transport_init,
+    .deinit = fido_transport_deinit,
     .send_message = fido_transport_send_message,
+    .send_message_async = fido_transport_send_message_async,
     .send_error = fido_transport_send_error,
     .set_message_callback = fido_transport_set_message_callback,
+    .set_stream_callbacks = fido_transport_set_stream_callbacks,
+    .set_cancel_callback = fido_transport_set_cancel_callback,
+    .set_deferred_delivery = fido_transport_set_deferred_delivery,
+    .release_message = fido_transport_release_message,
     .allocate_channel = fido_transport_allocate_channel,
     .get_state = fido_transport_get_state,
-    .is_channel_active = fido_transport_is_channel_active
+    .is_channel_active = fido_transport_is_channel_active,
+    .process_timeouts = fido_transport_process_timeouts,
+    .get_channel_stats = fido_transport_get_channel_stats,
+    .get_admission_stats = fido_transport_get_admission_stats
 };
 
 /**
@@ -530,19 +1678,51 @@ const fido_hid_transport_t* fido_hid_transport_get_instance(void) {
     return &g_fido_transport;
 }
 
+#if defined(FIDO_TRANSPORT_COPY_STATS)
+/**
+ * @brief Get bytes copied by the transport since start-up
+ */
+uint64_t fido_hid_transport_get_bytes_copied(void) {
+    return g_fido_bytes_copied;
+}
+#endif
+
+/**
+ * @brief Copy payload into a frame, zeroing only a short last frame's tail
+ * 
+ * Full frames take the constant-size branch, which the compiler expands to
+ * word loads and stores (Cortex-M33 allows unaligned word access).
+ */
+static inline void frame_put_payload(uint8_t* dst, const uint8_t* src, size_t length,
+                                     size_t room) {
+    if (length >= room) {
+        FIDO_COPY(dst, src, room);
+        return;
+    }
+    
+    if (length > 0) {
+        FIDO_COPY(dst, src, length);
+    }
+    memset(dst + length, 0, room - length);
+}
+
+/**
+ * @brief Put a CID in wire (big-endian) byte order
+ */
+static inline void frame_put_cid(uint8_t* packet, uint32_t cid) {
+    packet[0] = (uint8_t)(cid >> 24);
+    packet[1] = (uint8_t)(cid >> 16);
+    packet[2] = (uint8_t)(cid >> 8);
+    packet[3] = (uint8_t)cid;
+}
+
 /**
  * @brief Prepare FIDO initialization packet
  */
 void fido_hid_prepare_init_packet(uint8_t packet[FIDO_HID_PACKET_SIZE],
                                  uint32_t cid, uint8_t cmd,
                                  const uint8_t* data, uint16_t data_len) {
-    memset(packet, 0, FIDO_HID_PACKET_SIZE);
-    
-    // CID (big-endian)
-    packet[0] = (cid >> 24) & 0xFF;
-    packet[1] = (cid >> 16) & 0xFF;
-    packet[2] = (cid >> 8) & 0xFF;
-    packet[3] = cid & 0xFF;
+    frame_put_cid(packet, cid);
     
     // Command and byte count
     packet[4] = cmd | 0x80;  // Initialization packet marker
@@ -550,11 +1730,8 @@ void fido_hid_prepare_init_packet(uint8_t packet[FIDO_HID_PACKET_SIZE],
     packet[6] = data_len & 0xFF;
     
     // Data (max 57 bytes in init packet)
-    if (data && data_len > 0) {
-        size_t copy_len = (data_len > FIDO_HID_INIT_PAYLOAD_SIZE) ? 
-                         FIDO_HID_INIT_PAYLOAD_SIZE : data_len;
-        memcpy(&packet[7], data, copy_len);
-    }
+    frame_put_payload(&packet[FIDO_HID_INIT_HEADER_SIZE], data, data ? data_len : 0,
+                      FIDO_HID_INIT_PAYLOAD_SIZE);
 }
 
 /**
@@ -563,23 +1740,128 @@ void fido_hid_prepare_init_packet(uint8_t packet[FIDO_HID_PACKET_SIZE],
 void fido_hid_prepare_cont_packet(uint8_t packet[FIDO_HID_PACKET_SIZE],
                                  uint32_t cid, uint8_t seq,
                                  const uint8_t* data, size_t data_len) {
-    memset(packet, 0, FIDO_HID_PACKET_SIZE);
-    
-    // CID (big-endian)
-    packet[0] = (cid >> 24) & 0xFF;
-    packet[1] = (cid >> 16) & 0xFF;
-    packet[2] = (cid >> 8) & 0xFF;
-    packet[3] = cid & 0xFF;
+    frame_put_cid(packet, cid);
     
     // Sequence number
     packet[4] = seq & 0x7F;  // Continuation packet (no 0x80 bit)
     
     // Data (max 59 bytes in continuation packet)
-    if (data && data_len > 0) {
-        size_t copy_len = (data_len > FIDO_HID_CONT_PAYLOAD_SIZE) ? 
-                         FIDO_HID_CONT_PAYLOAD_SIZE : data_len;
-        memcpy(&packet[5], data, copy_len);
+    frame_put_payload(&packet[FIDO_HID_CONT_HEADER_SIZE], data, data ? data_len : 0,
+                      FIDO_HID_CONT_PAYLOAD_SIZE);
+}
+
+/**
+ * @brief Number of packets a message is fragmented into
+ */
+size_t fido_hid_frame_count(size_t length) {
+    if (length <= FIDO_HID_INIT_PAYLOAD_SIZE) {
+        return 1;
     }
+    
+    return 1 + (length - FIDO_HID_INIT_PAYLOAD_SIZE + FIDO_HID_CONT_PAYLOAD_SIZE - 1) /
+               FIDO_HID_CONT_PAYLOAD_SIZE;
+}
+
+/**
+ * @brief Start fragmenting a message
+ */
+void fido_hid_framer_init(fido_hid_framer_t* framer, uint32_t cid, uint8_t cmd,
+                          const uint8_t* data, uint16_t length) {
+    uint8_t wire[sizeof(uint32_t)];
+    
+    // Byte order conversion done once, every frame then stores one word
+    frame_put_cid(wire, cid);
+    memcpy(&framer->cid_word, wire, sizeof(wire));
+    
+    framer->data = data;
+    framer->length = data ? length : 0;
+    framer->offset = 0;
+    framer->cmd = cmd;
+    framer->next_seq = 0;
+    framer->init_framed = false;
+}
+
+/**
+ * @brief Build the next packets of a message into a ring of frames
+ */
+size_t fido_hid_framer_build(fido_hid_framer_t* framer, fido_hid_frame_t* ring,
+                             size_t ring_size, size_t head, size_t max_frames) {
+    size_t built = 0;
+    
+    if (!framer || !ring || ring_size == 0) {
+        return 0;
+    }
+    if (max_frames > ring_size) {
+        max_frames = ring_size;
+    }
+    if (max_frames == 0 || fido_hid_framer_done(framer)) {
+        return 0;
+    }
+    
+    if (!framer->init_framed) {
+        uint32_t* frame = ring[head];
+        uint8_t* packet = (uint8_t*)frame;
+        size_t remaining = framer->length;
+        
+        frame[0] = framer->cid_word;
+        packet[4] = framer->cmd | 0x80;
+        packet[5] = (uint8_t)(framer->length >> 8);
+        packet[6] = (uint8_t)framer->length;
+        frame_put_payload(&packet[FIDO_HID_INIT_HEADER_SIZE], framer->data, remaining,
+                          FIDO_HID_INIT_PAYLOAD_SIZE);
+        framer->offset = (remaining > FIDO_HID_INIT_PAYLOAD_SIZE) ?
+                         FIDO_HID_INIT_PAYLOAD_SIZE : (uint16_t)remaining;
+        framer->init_framed = true;
+        head = (head + 1 == ring_size) ? 0 : head + 1;
+        built++;
+    }
+    
+    // Full continuation frames: header word, sequence and a fixed-size copy
+    size_t full = (size_t)(framer->length - framer->offset) / FIDO_HID_CONT_PAYLOAD_SIZE;
+    if (full > max_frames - built) {
+        full = max_frames - built;
+    }
+    const uint8_t* src = framer->data + framer->offset;
+    uint32_t cid_word = framer->cid_word;
+    uint8_t seq = framer->next_seq;
+    for (size_t i = 0; i < full; i++) {
+        uint32_t* frame = ring[head];
+        uint8_t* packet = (uint8_t*)frame;
+        
+        frame[0] = cid_word;
+        packet[4] = seq++ & 0x7F;
+        memcpy(&packet[FIDO_HID_CONT_HEADER_SIZE], src, FIDO_HID_CONT_PAYLOAD_SIZE);
+        src += FIDO_HID_CONT_PAYLOAD_SIZE;
+        head = (head + 1 == ring_size) ? 0 : head + 1;
+    }
+#ifdef FIDO_TRANSPORT_COPY_STATS
+    g_fido_bytes_copied += full * FIDO_HID_CONT_PAYLOAD_SIZE;
+#endif
+    framer->offset += (uint16_t)(full * FIDO_HID_CONT_PAYLOAD_SIZE);
+    framer->next_seq = seq;
+    built += full;
+    
+    // Last, partial frame: only its tail is zeroed
+    if (built < max_frames && framer->offset < framer->length) {
+        uint32_t* frame = ring[head];
+        uint8_t* packet = (uint8_t*)frame;
+        
+        frame[0] = cid_word;
+        packet[4] = framer->next_seq++ & 0x7F;
+        frame_put_payload(&packet[FIDO_HID_CONT_HEADER_SIZE], src,
+                          framer->length - framer->offset, FIDO_HID_CONT_PAYLOAD_SIZE);
+        framer->offset = framer->length;
+        built++;
+    }
+    
+    return built;
+}
+
+/**
+ * @brief Check if every packet of the message has been built
+ */
+bool fido_hid_framer_done(const fido_hid_framer_t* framer) {
+    return framer->init_framed && framer->offset >= framer->length;
 }
 
 /**
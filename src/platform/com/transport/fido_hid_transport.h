@@ -21,6 +21,10 @@
 /** @brief FIDO HID packet size (matches USB_HID_PACKET_SIZE) */
 #define FIDO_HID_PACKET_SIZE        64
 
+/** @brief FIDO HID header sizes */
+#define FIDO_HID_INIT_HEADER_SIZE   7   // 4(CID) + 1(CMD) + 2(BCNT)
+#define FIDO_HID_CONT_HEADER_SIZE   5   // 4(CID) + 1(SEQ)
+
 /** @brief FIDO HID payload sizes */
 #define FIDO_HID_INIT_PAYLOAD_SIZE  57  // 64 - 4(CID) - 3(CMD+BCNT)
 #define FIDO_HID_CONT_PAYLOAD_SIZE  59  // 64 - 4(CID) - 1(SEQ)
@@ -32,11 +36,18 @@
 #define FIDO_HID_ENDPOINT           1
 
 /** @brief FIDO HID command codes */
-#define FIDO_HID_MSG                0x03    /**< CTAP2 message */
+#define FIDO_HID_MSG                0x03    /**< CTAP1/U2F message */
+#define FIDO_HID_CBOR               0x10    /**< CTAP2 CBOR message */
 #define FIDO_HID_INIT               0x06    /**< Channel initialization */
 #define FIDO_HID_PING               0x01    /**< Ping/echo */
+#define FIDO_HID_CANCEL             0x11    /**< Cancel outstanding request */
+#define FIDO_HID_KEEPALIVE          0x3B    /**< Processing status notification */
 #define FIDO_HID_ERROR              0x3F    /**< Error response */
 
+/** @brief FIDO HID KEEPALIVE status codes */
+#define FIDO_KEEPALIVE_STATUS_PROCESSING    0x01    /**< Still processing */
+#define FIDO_KEEPALIVE_STATUS_UPNEEDED      0x02    /**< Waiting for user presence */
+
 /** @brief FIDO HID error codes */
 #define FIDO_ERR_INVALID_CMD        0x01    /**< Invalid command */
 #define FIDO_ERR_INVALID_PAR        0x02    /**< Invalid parameter */
@@ -55,7 +66,98 @@
 /** @brief Transport configuration */
 #define FIDO_RECEIVE_TIMEOUT_MS     3000    /**< Message receive timeout */
 #define FIDO_CHANNEL_TIMEOUT_MS     30000   /**< Channel inactivity timeout */
-#define FIDO_MAX_CHANNELS           4       /**< Maximum concurrent channels */
+#define FIDO_KEEPALIVE_INTERVAL_MS  100     /**< KEEPALIVE period while processing */
+#define FIDO_TIMER_TICK_MS          50      /**< Timeout resolution (process_timeouts period) */
+
+/**
+ * @brief Capacity of the channel (CID) table
+ *
+ * Once the table is full, allocating a channel evicts the least recently
+ * active one. Each entry costs about 72 bytes of RAM.
+ */
+#ifndef FIDO_MAX_CHANNELS
+#define FIDO_MAX_CHANNELS           16
+#endif
+
+#if (FIDO_MAX_CHANNELS < 1) || (FIDO_MAX_CHANNELS > 256)
+#error "FIDO_MAX_CHANNELS must be between 1 and 256"
+#endif
+
+/**
+ * @brief Number of concurrent message reassembly slots
+ *
+ * Each slot holds one FIDO_MAX_MESSAGE_SIZE buffer, so this is the main
+ * RAM cost of the transport. Independent of the channel table capacity:
+ * this many channels can have fragmented messages assembling in parallel.
+ */
+#ifndef FIDO_MAX_RX_SLOTS
+#define FIDO_MAX_RX_SLOTS           4
+#endif
+
+/** @brief Number of outgoing messages that can be queued for transmission */
+#ifndef FIDO_TX_QUEUE_DEPTH
+#define FIDO_TX_QUEUE_DEPTH         4
+#endif
+
+/**
+ * @brief Bytes of transport-owned storage for send_message() payloads
+ *
+ * Payloads longer than FIDO_TX_INLINE_SIZE are copied here until they are
+ * sent, so the caller may reuse its buffer (for example the receive slot a
+ * PING is echoed from) as soon as send_message() returns. Must hold at
+ * least one maximum size message.
+ */
+#ifndef FIDO_TX_BUFFER_SIZE
+#define FIDO_TX_BUFFER_SIZE         FIDO_MAX_MESSAGE_SIZE
+#endif
+
+#if (FIDO_TX_BUFFER_SIZE < FIDO_MAX_MESSAGE_SIZE) || (FIDO_TX_BUFFER_SIZE > 0xFFFF)
+#error "FIDO_TX_BUFFER_SIZE must hold one FIDO_MAX_MESSAGE_SIZE message and fit 16 bits"
+#endif
+
+/**
+ * @brief Admission control (token buckets)
+ *
+ * Rates are packets per second, bursts are packets. Every OUT report takes
+ * a token from its channel's bucket (or from the bucket shared by reports
+ * without a channel: broadcast and unknown CIDs), then one from the global
+ * bucket. Reports over budget are dropped before reassembly, without a
+ * response. Error responses have a bucket of their own on top of
+ * coalescing. The channel burst covers one maximum size message (130
+ * packets) sent back to back.
+ */
+#ifndef FIDO_GLOBAL_RATE_PPS
+#define FIDO_GLOBAL_RATE_PPS        1000    /**< Full-speed interrupt endpoint limit */
+#endif
+#ifndef FIDO_GLOBAL_BURST
+#define FIDO_GLOBAL_BURST           256
+#endif
+#ifndef FIDO_CHANNEL_RATE_PPS
+#define FIDO_CHANNEL_RATE_PPS       500
+#endif
+#ifndef FIDO_CHANNEL_BURST
+#define FIDO_CHANNEL_BURST          160
+#endif
+#ifndef FIDO_UNOWNED_RATE_PPS
+#define FIDO_UNOWNED_RATE_PPS       50
+#endif
+#ifndef FIDO_UNOWNED_BURST
+#define FIDO_UNOWNED_BURST          16
+#endif
+#ifndef FIDO_ERROR_RATE_PPS
+#define FIDO_ERROR_RATE_PPS         50
+#endif
+#ifndef FIDO_ERROR_BURST
+#define FIDO_ERROR_BURST            8
+#endif
+
+#if (FIDO_GLOBAL_RATE_PPS < 1) || (FIDO_CHANNEL_RATE_PPS < 1) || \
+    (FIDO_UNOWNED_RATE_PPS < 1) || (FIDO_ERROR_RATE_PPS < 1)
+#error "FIDO admission rates must be at least 1 packet per second"
+#endif
+
+/** @brief Messages up to this size are copied into their TX queue entry */
+#define FIDO_TX_INLINE_SIZE         FIDO_HID_INIT_PAYLOAD_SIZE
 
 /**
  * @brief FIDO HID configuration constants
@@ -81,10 +183,38 @@
 typedef enum {
     FIDO_TRANSPORT_IDLE,        /**< No active operations */
     FIDO_TRANSPORT_RECEIVING,   /**< Assembling fragmented message */
-    FIDO_TRANSPORT_SENDING,     /**< Transmitting message */
+    FIDO_TRANSPORT_SENDING,     /**< Transmitting queued messages */
     FIDO_TRANSPORT_ERROR        /**< Error state */
 } fido_transport_state_t;
 
+/**
+ * @brief Per-channel diagnostic counters
+ */
+typedef struct {
+    uint32_t cid;                           /**< Channel identifier */
+    uint32_t messages_received;             /**< Complete messages received */
+    uint32_t messages_sent;                 /**< Messages fully transmitted */
+    uint32_t bytes_received;                /**< Payload bytes received */
+    uint32_t bytes_sent;                    /**< Payload bytes transmitted */
+    uint32_t errors;                        /**< Error responses and failed sends */
+    uint32_t last_latency_us;               /**< Last request-to-response time */
+    uint32_t idle_ms;                       /**< Time since last activity */
+    uint32_t packets_dropped;               /**< Reports over the channel budget */
+} fido_channel_stats_t;
+
+/**
+ * @brief Admission control counters
+ */
+typedef struct {
+    uint32_t packets_admitted;              /**< Reports passed to reassembly */
+    uint32_t dropped_channel;               /**< Over a channel's budget */
+    uint32_t dropped_unowned;               /**< Over the shared budget of unknown CIDs */
+    uint32_t dropped_global;                /**< Over the global budget */
+    uint32_t errors_sent;                   /**< Error responses queued */
+    uint32_t errors_coalesced;              /**< Identical to one already queued */
+    uint32_t errors_suppressed;             /**< Over the error budget or TX queue reserve */
+} fido_admission_stats_t;
+
 /**
  * @brief FIDO message received callback function type
  * 
@@ -101,6 +231,80 @@ typedef enum {
 typedef void (*fido_message_callback_t)(uint32_t cid, uint8_t cmd, 
                                         const uint8_t* data, size_t length);
 
+/**
+ * @brief Streaming payload chunk callback function type
+ * 
+ * Called for every packet of a message as its payload lands, in order,
+ * so a parser can consume the message while the rest is still arriving.
+ * A chunk at offset 0 starts a new message on the channel.
+ * 
+ * @param cid Channel identifier
+ * @param cmd FIDO command code of the message
+ * @param offset Position of this chunk in the message
+ * @param data Chunk payload
+ * @param length Chunk length (up to FIDO_HID_CONT_PAYLOAD_SIZE)
+ * 
+ * @note Callback is called from transport (USB receive) context. Chunks of
+ *       fragmented messages are stored in the reassembly buffer, so data
+ *       stays valid until the complete message is delivered (and released
+ *       in deferred mode); single-packet chunks only during the callback.
+ * @warning Keep processing time below one packet interval (1 ms)
+ */
+typedef void (*fido_chunk_callback_t)(uint32_t cid, uint8_t cmd, size_t offset,
+                                      const uint8_t* data, size_t length);
+
+/**
+ * @brief Streaming end-of-message callback function type
+ * 
+ * Closes every message started with a chunk at offset 0. On success it
+ * runs before the message callback delivers the same message.
+ * 
+ * @param cid Channel identifier
+ * @param cmd FIDO command code of the message
+ * @param length Total message length
+ * @param status HAL_SUCCESS if the message is complete, otherwise why the
+ *               chunks received so far were abandoned:
+ *               HAL_ERROR_TIMEOUT (receive timeout),
+ *               HAL_ERROR_INVALID_PARAM (sequence error),
+ *               HAL_ERROR_INVALID_STATE (restarted by INIT or USB reset)
+ * 
+ * @note Callback is called from transport context
+ */
+typedef void (*fido_stream_complete_callback_t)(uint32_t cid, uint8_t cmd, size_t length,
+                                                hal_result_t status);
+
+/**
+ * @brief FIDO cancel callback function type
+ * 
+ * Called as soon as a CTAPHID_CANCEL packet arrives, or when CTAPHID_INIT
+ * resynchronizes a channel whose message is still being processed.
+ * CTAPHID_CANCEL only applies to CTAPHID_CBOR: when the channel holds any
+ * other request in deferred mode, the CANCEL is ignored.
+ * 
+ * @param cid Channel whose outstanding request must be aborted
+ * 
+ * @note Callback is called from transport context
+ * @warning Keep processing time minimal, only flag the operation
+ */
+typedef void (*fido_cancel_callback_t)(uint32_t cid);
+
+/**
+ * @brief FIDO message sent callback function type
+ * 
+ * Called when the last packet of a queued message has been transmitted,
+ * or when transmission was aborted.
+ * 
+ * @param cid Channel identifier the message was sent on
+ * @param cmd FIDO command code of the message
+ * @param result HAL_SUCCESS if every packet was sent, error code otherwise
+ * @param user_data Opaque pointer given to send_message_async()
+ * 
+ * @note Callback is called from USB transmit complete context
+ * @warning Keep processing time minimal
+ */
+typedef void (*fido_send_complete_callback_t)(uint32_t cid, uint8_t cmd,
+                                              hal_result_t result, void* user_data);
+
 /**
  * @brief FIDO HID transport interface structure
  */
@@ -124,16 +328,44 @@ typedef struct {
      * @brief Send FIDO message
      * 
      * Automatically fragments large messages into multiple packets.
+     * The message is queued and sent in the background, driven by USB
+     * transmit complete events.
      * 
      * @param cid Channel identifier
      * @param cmd FIDO command code
      * @param data Pointer to message data
      * @param length Length of message data
-     * @return HAL_SUCCESS on success, error code otherwise
+     * @return HAL_SUCCESS if queued, error code otherwise
+     * @retval HAL_ERROR_BUSY Transmit queue or TX buffer full
+     * 
+     * @note The payload is copied (into the queue entry, or into the
+     *       FIDO_TX_BUFFER_SIZE buffer), so data may be reused on return.
+     *       Use send_message_async() to send a buffer in place.
      */
     hal_result_t (*send_message)(uint32_t cid, uint8_t cmd, 
                                 const uint8_t* data, size_t length);
     
+    /**
+     * @brief Queue FIDO message with completion notification
+     * 
+     * Returns as soon as the message is queued. Each continuation packet is
+     * built from the transmit complete callback of the previous one, so the
+     * caller is never blocked for the duration of the transfer.
+     * 
+     * @param cid Channel identifier
+     * @param cmd FIDO command code
+     * @param data Pointer to message data (sent in place, must stay valid until on_complete)
+     * @param length Length of message data
+     * @param on_complete Completion callback (NULL: data is copied as by send_message())
+     * @param user_data Opaque pointer passed to on_complete
+     * @return HAL_SUCCESS if queued, error code otherwise
+     * @retval HAL_ERROR_BUSY Transmit queue full
+     */
+    hal_result_t (*send_message_async)(uint32_t cid, uint8_t cmd,
+                                      const uint8_t* data, size_t length,
+                                      fido_send_complete_callback_t on_complete,
+                                      void* user_data);
+    
     /**
      * @brief Send FIDO error response
      * 
@@ -151,6 +383,52 @@ typedef struct {
      */
     hal_result_t (*set_message_callback)(fido_message_callback_t callback);
     
+    /**
+     * @brief Set streaming callbacks
+     * 
+     * Optional and independent of the message callback, which still
+     * receives every complete message. Lets an incremental decoder parse
+     * a request while its continuation packets are still on the bus.
+     * 
+     * @param on_chunk Chunk callback (NULL to disable streaming)
+     * @param on_complete End-of-message callback (can be NULL)
+     * @return HAL_SUCCESS on success, error code otherwise
+     */
+    hal_result_t (*set_stream_callbacks)(fido_chunk_callback_t on_chunk,
+                                         fido_stream_complete_callback_t on_complete);
+    
+    /**
+     * @brief Set cancel callback
+     * 
+     * @param callback Callback function (NULL to disable)
+     * @return HAL_SUCCESS on success, error code otherwise
+     */
+    hal_result_t (*set_cancel_callback)(fido_cancel_callback_t callback);
+    
+    /**
+     * @brief Enable deferred message delivery
+     * 
+     * When enabled, the buffer passed to the message callback stays valid
+     * after the callback returns, so the message can be handed to another
+     * task. The channel is reported busy until release_message() is called.
+     * A single-packet CTAPHID_INIT is the exception: it takes no reassembly
+     * slot, so it is answered even while every slot is held, and its
+     * buffer is only valid during the callback.
+     * 
+     * @param enable true to keep delivered messages until released
+     * @return HAL_SUCCESS on success, error code otherwise
+     */
+    hal_result_t (*set_deferred_delivery)(bool enable);
+    
+    /**
+     * @brief Release a message delivered in deferred mode
+     * 
+     * @param data Data pointer received by the message callback
+     * @return HAL_SUCCESS on success, error code otherwise
+     * @retval HAL_ERROR_INVALID_STATE No such message (e.g. after disconnect)
+     */
+    hal_result_t (*release_message)(const uint8_t* data);
+    
     /**
      * @brief Allocate new channel identifier
      * 
@@ -174,6 +452,41 @@ typedef struct {
      */
     bool (*is_channel_active)(uint32_t cid);
     
+    /**
+     * @brief Expire stale reassemblies and idle channels
+     * 
+     * Advances the transport timer wheel to the current time. Reassemblies
+     * older than FIDO_RECEIVE_TIMEOUT_MS are dropped with FIDO_ERR_MSG_TIMEOUT
+     * and channels idle for FIDO_CHANNEL_TIMEOUT_MS are freed.
+     * 
+     * @note Call every FIDO_TIMER_TICK_MS, e.g. from a FreeRTOS software timer
+     */
+    void (*process_timeouts)(void);
+    
+    /**
+     * @brief Read diagnostic counters of a channel table entry
+     * 
+     * Iterate index from 0 to FIDO_MAX_CHANNELS - 1 to dump every channel.
+     * Latency is measured from the last packet of a request to the
+     * completion of the next response sent on that channel.
+     * 
+     * @param index Channel table index
+     * @param stats Output counters
+     * @return HAL_SUCCESS on success, error code otherwise
+     * @retval HAL_ERROR_INVALID_PARAM Index out of range or NULL stats
+     * @retval HAL_ERROR_INVALID_STATE Entry is not in use
+     */
+    hal_result_t (*get_channel_stats)(uint32_t index, fido_channel_stats_t* stats);
+    
+    /**
+     * @brief Read admission control counters
+     * 
+     * @param stats Output counters (totals since init)
+     * @return HAL_SUCCESS on success, error code otherwise
+     * @retval HAL_ERROR_INVALID_PARAM Not initialized or NULL stats
+     */
+    hal_result_t (*get_admission_stats)(fido_admission_stats_t* stats);
+    
 } fido_hid_transport_t;
 
 /**
@@ -183,13 +496,93 @@ typedef struct {
  */
 const fido_hid_transport_t* fido_hid_transport_get_instance(void);
 
+#if defined(FIDO_TRANSPORT_COPY_STATS)
+/**
+ * @brief Get bytes copied by the transport since start-up
+ * 
+ * Counts every memcpy on the receive and transmit paths (reassembly,
+ * bounce buffer, header stash, inline payloads and frame building).
+ * Only available in instrumented builds, e.g. the host benchmark.
+ * 
+ * @return Total bytes copied
+ */
+uint64_t fido_hid_transport_get_bytes_copied(void);
+#endif
+
 /**
  * @brief FIDO HID packet helper functions
  */
 
+/**
+ * @brief One 64-byte HID report, word aligned
+ */
+typedef uint32_t fido_hid_frame_t[FIDO_HID_PACKET_SIZE / sizeof(uint32_t)];
+
+/**
+ * @brief Single-pass message fragmenter
+ * 
+ * Walks a message once, writing its INIT and CONT packets straight into
+ * frames. The CID is converted to wire order once per message and stored
+ * as one aligned word per frame; full frames get a fixed-size payload copy
+ * and only the last frame has its tail zeroed. Building stops when the
+ * frames supplied run out and resumes where it left off on the next call.
+ */
+typedef struct {
+    const uint8_t* data;                    /**< Message payload */
+    uint16_t length;                        /**< Total message length */
+    uint16_t offset;                        /**< Payload bytes framed so far */
+    uint32_t cid_word;                      /**< CID in wire byte order */
+    uint8_t cmd;                            /**< Command */
+    uint8_t next_seq;                       /**< Sequence of next continuation */
+    bool init_framed;                       /**< INIT packet already built */
+} fido_hid_framer_t;
+
+/**
+ * @brief Number of packets a message is fragmented into
+ * 
+ * @param length Message length (0 to FIDO_MAX_MESSAGE_SIZE)
+ * @return INIT packet plus continuation packets
+ */
+size_t fido_hid_frame_count(size_t length);
+
+/**
+ * @brief Start fragmenting a message
+ * 
+ * @param framer Framer state
+ * @param cid Channel identifier
+ * @param cmd FIDO command
+ * @param data Payload, must stay valid until the last frame is built
+ * @param length Payload length (at most FIDO_MAX_MESSAGE_SIZE)
+ */
+void fido_hid_framer_init(fido_hid_framer_t* framer, uint32_t cid, uint8_t cmd,
+                          const uint8_t* data, uint16_t length);
+
+/**
+ * @brief Build the next packets of a message into a ring of frames
+ * 
+ * Frames are written at ring[head], ring[head + 1], ... wrapping at
+ * ring_size, until max_frames are built or the message is complete.
+ * 
+ * @param framer Framer state
+ * @param ring Caller-supplied frame ring
+ * @param ring_size Number of frames in the ring
+ * @param head Index of the first frame to fill
+ * @param max_frames Maximum frames to build (at most ring_size)
+ * @return Number of frames built, 0 once the message is fully framed
+ */
+size_t fido_hid_framer_build(fido_hid_framer_t* framer, fido_hid_frame_t* ring,
+                             size_t ring_size, size_t head, size_t max_frames);
+
+/**
+ * @brief Check if every packet of the message has been built
+ */
+bool fido_hid_framer_done(const fido_hid_framer_t* framer);
+
 /**
  * @brief Prepare FIDO initialization packet
  * 
+ * @note Fragmenting a whole message is cheaper with fido_hid_framer_build()
+ * 
  * @param packet Output 64-byte packet buffer
  * @param cid Channel identifier
  * @param cmd FIDO command
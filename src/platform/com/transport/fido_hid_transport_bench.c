@@ -0,0 +1,1004 @@
+/**
+ * @file fido_hid_transport_bench.c
+ * @brief Host-side CTAPHID throughput and latency benchmark
+ * @author USB Key Authentication Team
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ * Drives fido_hid_transport_get_instance() through a loopback USB HID HAL
+ * and replays packet traces against it: PING floods, maximum size
+ * messages, interleaved channels, malformed sequences and a flooding
+ * channel next to a well-behaved one. The transport runs on a simulated
+ * clock paced like a full-speed interrupt endpoint (one OUT and one IN
+ * report per millisecond), so admission control sees bus timing. Reports
+ * packets/s, reassembly latency percentiles and bytes copied per message,
+ * and exits non-zero when a trace misbehaves, a PING echo differs from
+ * the request it answers, or a threshold is missed.
+ * Also checks CANCEL against requests queued in deferred delivery mode and
+ * times the TX frame builder against a plain memcpy of the message.
+ *
+ * Build and run on Linux from the repository root:
+ * @code
+ * gcc -std=c11 -O2 -DFIDO_TRANSPORT_COPY_STATS -DPLATFORM_CLOCK_SIMULATED -I src \
+ *     src/platform/com/transport/fido_hid_transport_bench.c \
+ *     src/platform/com/transport/fido_hid_transport.c \
+ *     src/platform/time/platform_clock.c src/platform/time/timer_wheel.c \
+ *     -o fido_hid_bench
+ * ./fido_hid_bench [-i iterations] [-n] [-r trace.bin] [-P min_pps] [-C max_copy]
+ * @endcode
+ *
+ * Options:
+ * - -i  Replays of each trace (default 200)
+ * - -n  Loopback HAL without prime_receive (reports delivered from HAL buffer)
+ * - -r  Replay a recorded trace: raw concatenated 64-byte OUT reports
+ * - -P  Fail if any trace runs below this many packets/s
+ * - -C  Fail if any trace copies more than this many bytes per message
+ *
+ * Every CID in a trace other than broadcast and 0 is a placeholder mapped
+ * to a freshly allocated channel on first use, so recorded traces replay
+ * regardless of the CIDs the recording device handed out.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "fido_hid_transport.h"
+#include "platform/time/platform_clock.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(FIDO_TRANSPORT_COPY_STATS)
+#error "Build the benchmark with -DFIDO_TRANSPORT_COPY_STATS"
+#endif
+
+#if !defined(PLATFORM_CLOCK_SIMULATED)
+#error "Build the benchmark with -DPLATFORM_CLOCK_SIMULATED"
+#endif
+
+#define BENCH_DEFAULT_ITERATIONS    200
+#define BENCH_MAX_CIDS              FIDO_MAX_CHANNELS
+#define BENCH_REPORT_INTERVAL_US    1000    /**< Full-speed frame */
+#define BENCH_ROUND_GAP_US          1000000 /**< Idle time between replays */
+
+/**
+ * @brief Packet trace: one replay round of OUT reports
+ */
+typedef struct {
+    const char* name;                       /**< Trace name */
+    uint8_t (*reports)[FIDO_HID_PACKET_SIZE]; /**< Reports */
+    size_t count;                           /**< Number of reports */
+    size_t capacity;                        /**< Allocated reports */
+    uint32_t expected_messages;             /**< Messages delivered per round */
+    uint32_t expected_errors;               /**< Error responses per round */
+    bool errors_at_most;                    /**< expected_errors is an upper bound */
+    bool reads_late;                        /**< Host polls IN only after the round */
+} bench_trace_t;
+
+/**
+ * @brief Loopback USB HID HAL state
+ */
+typedef struct {
+    usb_hid_rx_callback_t rx_cb;            /**< Transport receive callback */
+    usb_hid_tx_complete_callback_t tx_cb;   /**< Transport TX complete callback */
+    uint8_t* primed;                        /**< Buffer primed by the transport */
+    bool tx_pending;                        /**< Report awaiting completion */
+    bool reads_late;                        /**< IN reports wait for loopback_pump() */
+    uint64_t reports_out;                   /**< OUT reports delivered */
+    uint64_t reports_in;                    /**< IN reports sent by the device */
+    uint64_t errors_in;                     /**< ERROR responses sent */
+    uint8_t echo[FIDO_MAX_MESSAGE_SIZE];    /**< PING response being reassembled */
+    uint16_t echo_length;                   /**< Its BCNT */
+    uint16_t echo_received;                 /**< Payload bytes seen */
+    bool echo_open;                         /**< A PING response is in progress */
+} bench_loopback_t;
+
+/**
+ * @brief Measurement state
+ */
+typedef struct {
+    uint32_t cid_from[BENCH_MAX_CIDS];      /**< Trace CIDs */
+    uint32_t cid_to[BENCH_MAX_CIDS];        /**< Allocated CIDs */
+    uint64_t start_ns[BENCH_MAX_CIDS];      /**< First packet of message in flight */
+    size_t cid_count;                       /**< Mapped CIDs */
+    uint64_t* latency_ns;                   /**< Reassembly latency samples */
+    size_t latency_count;                   /**< Samples recorded */
+    size_t latency_capacity;                /**< Sample capacity */
+    uint64_t messages;                      /**< Messages delivered */
+    uint64_t send_failures;                 /**< Responses the transport refused */
+    uint64_t bytes_delivered;               /**< Payload bytes of delivered messages */
+    uint64_t stream_bytes;                  /**< Chunk bytes of completed streams */
+    uint64_t stream_pending;                /**< Chunk bytes of the open streams */
+    uint64_t stream_completed;              /**< Streams closed with HAL_SUCCESS */
+    uint8_t echo_expected[FIDO_TX_QUEUE_DEPTH][FIDO_MAX_MESSAGE_SIZE]; /**< PINGs queued */
+    uint16_t echo_expected_length[FIDO_TX_QUEUE_DEPTH]; /**< Their lengths */
+    size_t echo_head;                       /**< Oldest PING awaiting its echo */
+    size_t echo_count;                      /**< PINGs awaiting their echo */
+    uint64_t echo_mismatches;               /**< Echoes that differ from their PING */
+} bench_stats_t;
+
+static bench_loopback_t g_loopback = {0};
+static bench_stats_t g_stats = {0};
+static const fido_hid_transport_t* g_transport = NULL;
+
+/**
+ * @brief Monotonic time in nanoseconds
+ */
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Loopback HAL                                                              */
+/* ------------------------------------------------------------------------ */
+
+static hal_result_t loopback_init(void) {
+    return HAL_SUCCESS;
+}
+
+static hal_result_t loopback_deinit(void) {
+    return HAL_SUCCESS;
+}
+
+static hal_result_t loopback_configure(const usb_hid_descriptor_t* descriptor) {
+    return descriptor ? HAL_SUCCESS : HAL_ERROR_INVALID_PARAM;
+}
+
+static hal_result_t loopback_set_callbacks(usb_hid_rx_callback_t rx_cb,
+                                           usb_hid_tx_complete_callback_t tx_cb,
+                                           usb_hid_event_callback_t event_cb) {
+    (void)event_cb;
+    g_loopback.rx_cb = rx_cb;
+    g_loopback.tx_cb = tx_cb;
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Reassemble PING responses and compare them with their requests
+ *
+ * The transport sends queued messages one after the other, so IN reports
+ * of different messages never interleave.
+ */
+static void loopback_check_echo(const uint8_t* report) {
+    size_t take;
+
+    if (report[4] & 0x80) {
+        g_loopback.echo_open = (report[4] == (FIDO_HID_PING | 0x80));
+        g_loopback.echo_length = (uint16_t)((report[5] << 8) | report[6]);
+        g_loopback.echo_received = 0;
+        take = FIDO_HID_INIT_PAYLOAD_SIZE;
+        report += FIDO_HID_INIT_HEADER_SIZE;
+    } else {
+        take = FIDO_HID_CONT_PAYLOAD_SIZE;
+        report += FIDO_HID_CONT_HEADER_SIZE;
+    }
+    if (!g_loopback.echo_open) {
+        return;
+    }
+
+    if (take > (size_t)(g_loopback.echo_length - g_loopback.echo_received)) {
+        take = g_loopback.echo_length - g_loopback.echo_received;
+    }
+    memcpy(&g_loopback.echo[g_loopback.echo_received], report, take);
+    g_loopback.echo_received += (uint16_t)take;
+    if (g_loopback.echo_received < g_loopback.echo_length) {
+        return;
+    }
+
+    g_loopback.echo_open = false;
+    if (g_stats.echo_count == 0 ||
+        g_stats.echo_expected_length[g_stats.echo_head] != g_loopback.echo_length ||
+        memcmp(g_stats.echo_expected[g_stats.echo_head], g_loopback.echo,
+               g_loopback.echo_length) != 0) {
+        g_stats.echo_mismatches++;
+    }
+    if (g_stats.echo_count > 0) {
+        g_stats.echo_head = (g_stats.echo_head + 1) % FIDO_TX_QUEUE_DEPTH;
+        g_stats.echo_count--;
+    }
+}
+
+static hal_result_t loopback_send_report(uint8_t endpoint, const uint8_t* data, size_t length) {
+    (void)endpoint;
+
+    if (!data || length != FIDO_HID_PACKET_SIZE || g_loopback.tx_pending) {
+        return g_loopback.tx_pending ? HAL_ERROR_BUSY : HAL_ERROR_INVALID_PARAM;
+    }
+
+    g_loopback.reports_in++;
+    if (data[4] == (FIDO_HID_ERROR | 0x80)) {
+        g_loopback.errors_in++;
+    }
+    loopback_check_echo(data);
+    g_loopback.tx_pending = true;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t loopback_prime_receive(uint8_t endpoint, uint8_t* buffer, size_t length) {
+    (void)endpoint;
+    (void)length;
+    g_loopback.primed = buffer;
+    return HAL_SUCCESS;
+}
+
+static usb_hid_hal_t g_loopback_hal = {
+    .base = {
+        .init = loopback_init,
+        .deinit = loopback_deinit,
+    },
+    .configure = loopback_configure,
+    .set_callbacks = loopback_set_callbacks,
+    .send_report = loopback_send_report,
+    .prime_receive = loopback_prime_receive,
+};
+
+/**
+ * @brief Complete IN transfers until the device stops sending
+ */
+static void loopback_pump(void) {
+    while (g_loopback.tx_pending) {
+        platform_clock_advance_us(BENCH_REPORT_INTERVAL_US);
+        g_loopback.tx_pending = false;
+        g_loopback.tx_cb(FIDO_HID_ENDPOINT, HAL_SUCCESS);
+    }
+}
+
+/**
+ * @brief Deliver one OUT report the way a USB controller would
+ *
+ * One bus frame: the OUT report is received and at most one IN report
+ * completes.
+ */
+static void loopback_host_send(const uint8_t report[FIDO_HID_PACKET_SIZE]) {
+    const uint8_t* data = report;
+
+    platform_clock_advance_us(BENCH_REPORT_INTERVAL_US);
+
+    if (g_loopback.primed) {
+        // DMA into the buffer the transport primed
+        memcpy(g_loopback.primed, report, FIDO_HID_PACKET_SIZE);
+        data = g_loopback.primed;
+        g_loopback.primed = NULL;
+    }
+
+    g_loopback.reports_out++;
+    g_loopback.rx_cb(FIDO_HID_ENDPOINT, data, FIDO_HID_PACKET_SIZE);
+
+    if (g_loopback.tx_pending && !g_loopback.reads_late) {
+        g_loopback.tx_pending = false;
+        g_loopback.tx_cb(FIDO_HID_ENDPOINT, HAL_SUCCESS);
+    }
+}
+
+/* ------------------------------------------------------------------------ */
+/* Measurement                                                               */
+/* ------------------------------------------------------------------------ */
+
+static int find_mapped_cid(uint32_t cid, const uint32_t* table) {
+    for (size_t i = 0; i < g_stats.cid_count; i++) {
+        if (table[i] == cid) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Application handler: echo PING, answer MSG with a status byte
+ */
+static void bench_on_message(uint32_t cid, uint8_t cmd, const uint8_t* data, size_t length) {
+    int index = find_mapped_cid(cid, g_stats.cid_to);
+
+    if (index >= 0 && g_stats.latency_count < g_stats.latency_capacity) {
+        g_stats.latency_ns[g_stats.latency_count++] = now_ns() - g_stats.start_ns[index];
+    }
+    g_stats.messages++;
+    g_stats.bytes_delivered += length;
+
+    hal_result_t result;
+    if (cmd == FIDO_HID_PING) {
+        // Expected first: the INIT report may go out before send_message() returns
+        size_t tail = (g_stats.echo_head + g_stats.echo_count) % FIDO_TX_QUEUE_DEPTH;
+        memcpy(g_stats.echo_expected[tail], data, length);
+        g_stats.echo_expected_length[tail] = (uint16_t)length;
+        g_stats.echo_count++;
+
+        // Echo straight from the receive slot, which is reused once this returns
+        result = g_transport->send_message(cid, FIDO_HID_PING, data, length);
+        if (result != HAL_SUCCESS) {
+            g_stats.echo_count--;
+        }
+    } else {
+        static const uint8_t status = 0x00;
+        result = g_transport->send_message(cid, cmd, &status, 1);
+    }
+    if (result != HAL_SUCCESS) {
+        g_stats.send_failures++;
+    }
+}
+
+/**
+ * @brief Streaming receiver: account chunk bytes per stream
+ */
+static void bench_on_chunk(uint32_t cid, uint8_t cmd, size_t offset, const uint8_t* data,
+                           size_t length) {
+    (void)cid;
+    (void)cmd;
+    (void)offset;
+    (void)data;
+    g_stats.stream_pending += length;
+}
+
+static void bench_on_stream_complete(uint32_t cid, uint8_t cmd, size_t length,
+                                     hal_result_t status) {
+    (void)cid;
+    (void)cmd;
+    (void)length;
+    if (status == HAL_SUCCESS) {
+        g_stats.stream_completed++;
+        g_stats.stream_bytes += g_stats.stream_pending;
+    }
+    g_stats.stream_pending = 0;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_us(const uint64_t* sorted, size_t count, double p) {
+    if (count == 0) {
+        return 0.0;
+    }
+    size_t index = (size_t)(p * (double)(count - 1) + 0.5);
+    return (double)sorted[index] / 1000.0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Traces                                                                    */
+/* ------------------------------------------------------------------------ */
+
+static uint8_t* trace_append(bench_trace_t* trace) {
+    if (trace->count == trace->capacity) {
+        size_t capacity = trace->capacity ? trace->capacity * 2 : 256;
+        void* reports = realloc(trace->reports, capacity * FIDO_HID_PACKET_SIZE);
+        if (!reports) {
+            fprintf(stderr, "out of memory\n");
+            exit(2);
+        }
+        trace->reports = reports;
+        trace->capacity = capacity;
+    }
+    uint8_t* report = trace->reports[trace->count++];
+    memset(report, 0, FIDO_HID_PACKET_SIZE);
+    return report;
+}
+
+static void trace_raw(bench_trace_t* trace, uint32_t cid, uint8_t b4, uint8_t b5, uint8_t b6) {
+    uint8_t* report = trace_append(trace);
+    report[0] = (uint8_t)(cid >> 24);
+    report[1] = (uint8_t)(cid >> 16);
+    report[2] = (uint8_t)(cid >> 8);
+    report[3] = (uint8_t)cid;
+    report[4] = b4;
+    report[5] = b5;
+    report[6] = b6;
+}
+
+/**
+ * @brief Append a message fragmented into INIT + CONT reports
+ *
+ * The payload depends on where the message starts in the trace, so
+ * consecutive messages differ.
+ */
+static void trace_message(bench_trace_t* trace, uint32_t cid, uint8_t cmd, uint16_t length) {
+    static uint8_t payload[FIDO_MAX_MESSAGE_SIZE];
+    for (size_t i = 0; i < length; i++) {
+        payload[i] = (uint8_t)(i * 7 + cid + trace->count * 13);
+    }
+
+    fido_hid_prepare_init_packet(trace_append(trace), cid, cmd, payload, length);
+    size_t offset = FIDO_HID_INIT_PAYLOAD_SIZE;
+    for (uint8_t seq = 0; offset < length; seq++) {
+        fido_hid_prepare_cont_packet(trace_append(trace), cid, seq,
+                                     payload + offset, length - offset);
+        offset += FIDO_HID_CONT_PAYLOAD_SIZE;
+    }
+}
+
+static void build_ping_flood(bench_trace_t* trace) {
+    trace->name = "ping-flood";
+    for (int i = 0; i < 64; i++) {
+        trace_message(trace, 1, FIDO_HID_PING, FIDO_HID_INIT_PAYLOAD_SIZE);
+    }
+    trace->expected_messages = 64;
+}
+
+/**
+ * @brief Two multi-packet PINGs while the host is not reading IN reports
+ *
+ * The second PING is received into the slot the first one is echoed
+ * from, before that echo is on the bus.
+ */
+static void build_ping_echo(bench_trace_t* trace) {
+    trace->name = "ping-echo-200";
+    trace_message(trace, 1, FIDO_HID_PING, 200);
+    trace_message(trace, 1, FIDO_HID_PING, 200);
+    trace->expected_messages = 2;
+    trace->reads_late = true;
+}
+
+static void build_max_message(bench_trace_t* trace) {
+    trace->name = "msg-7609";
+    trace_message(trace, 1, FIDO_HID_MSG, FIDO_MAX_MESSAGE_SIZE);
+    trace->expected_messages = 1;
+}
+
+/**
+ * @brief Four channels send maximum size messages packet by packet
+ */
+static void build_interleaved(bench_trace_t* trace) {
+    bench_trace_t single[4] = {{0}};
+
+    trace->name = "interleaved-4cid";
+    for (uint32_t c = 0; c < 4; c++) {
+        trace_message(&single[c], c + 1, FIDO_HID_MSG, FIDO_MAX_MESSAGE_SIZE);
+    }
+    for (size_t i = 0; i < single[0].count; i++) {
+        for (int c = 0; c < 4; c++) {
+            memcpy(trace_append(trace), single[c].reports[i], FIDO_HID_PACKET_SIZE);
+        }
+    }
+    for (int c = 0; c < 4; c++) {
+        free(single[c].reports);
+    }
+    trace->expected_messages = 4;
+}
+
+static void build_malformed(bench_trace_t* trace) {
+    trace->name = "malformed";
+
+    // Continuation without an initialization packet
+    trace_raw(trace, 1, 0x00, 0, 0);
+    // Length above the CTAPHID maximum
+    trace_raw(trace, 1, FIDO_HID_MSG | 0x80, 0x1D, 0xBA);
+    // Sequence gap inside a fragmented message
+    trace_raw(trace, 1, FIDO_HID_MSG | 0x80, 0x00, 200);
+    trace_raw(trace, 1, 0x01, 0, 0);
+    // Reserved CID
+    trace_raw(trace, 0, FIDO_HID_PING | 0x80, 0, 1);
+    // Broadcast CID with a command other than INIT
+    trace_raw(trace, FIDO_BROADCAST_CID, FIDO_HID_PING | 0x80, 0, 1);
+    // The channel still works afterwards
+    trace_message(trace, 1, FIDO_HID_PING, 16);
+
+    trace->expected_messages = 1;
+    trace->expected_errors = 5;
+}
+
+/**
+ * @brief One channel floods orphan continuations next to a PING client
+ *
+ * Nine of every ten reports are CONT packets on CID 1 with no message in
+ * progress, each of which would cost an INVALID_SEQ response. Every PING
+ * on CID 2 must still be answered, and the error responses must stay
+ * within the error budget.
+ */
+static void build_flood(bench_trace_t* trace) {
+    trace->name = "flood+victim";
+    for (int i = 0; i < 1000; i++) {
+        if (i % 10 == 9) {
+            trace_message(trace, 2, FIDO_HID_PING, 16);
+        } else {
+            trace_raw(trace, 1, 0x00, 0, 0);
+        }
+    }
+
+    uint64_t round_us = 1000u * BENCH_REPORT_INTERVAL_US + BENCH_ROUND_GAP_US;
+    trace->expected_messages = 100;
+    trace->expected_errors = FIDO_ERROR_BURST +
+                             (uint32_t)(FIDO_ERROR_RATE_PPS * round_us / 1000000u) + 1;
+    trace->errors_at_most = true;
+}
+
+/**
+ * @brief Load raw 64-byte OUT reports recorded from a host
+ */
+static bool load_trace(bench_trace_t* trace, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+
+    uint8_t report[FIDO_HID_PACKET_SIZE];
+    while (fread(report, 1, sizeof(report), file) == sizeof(report)) {
+        memcpy(trace_append(trace), report, sizeof(report));
+    }
+    fclose(file);
+
+    trace->name = path;
+    trace->expected_messages = UINT32_MAX; // Unknown, not checked
+    trace->expected_errors = UINT32_MAX;
+    return trace->count > 0;
+}
+
+/**
+ * @brief Map placeholder CIDs of a trace to allocated channels
+ */
+static bool map_trace_cids(bench_trace_t* trace) {
+    g_stats.cid_count = 0;
+
+    for (size_t i = 0; i < trace->count; i++) {
+        uint8_t* report = trace->reports[i];
+        uint32_t cid = ((uint32_t)report[0] << 24) | ((uint32_t)report[1] << 16) |
+                       ((uint32_t)report[2] << 8) | report[3];
+        if (cid == 0 || cid == FIDO_BROADCAST_CID) {
+            continue;
+        }
+
+        int index = find_mapped_cid(cid, g_stats.cid_from);
+        if (index < 0) {
+            if (g_stats.cid_count == BENCH_MAX_CIDS) {
+                fprintf(stderr, "%s: more than %d CIDs\n", trace->name, BENCH_MAX_CIDS);
+                return false;
+            }
+            index = (int)g_stats.cid_count++;
+            g_stats.cid_from[index] = cid;
+            if (g_transport->allocate_channel(&g_stats.cid_to[index]) != HAL_SUCCESS) {
+                return false;
+            }
+        }
+
+        uint32_t mapped = g_stats.cid_to[index];
+        report[0] = (uint8_t)(mapped >> 24);
+        report[1] = (uint8_t)(mapped >> 16);
+        report[2] = (uint8_t)(mapped >> 8);
+        report[3] = (uint8_t)mapped;
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Runner                                                                    */
+/* ------------------------------------------------------------------------ */
+
+typedef struct {
+    unsigned iterations;                    /**< Replays per trace */
+    bool use_prime;                         /**< Loopback supports prime_receive */
+    double min_pps;                         /**< Gate: minimum packets/s */
+    double max_copy;                        /**< Gate: maximum bytes copied per message */
+} bench_options_t;
+
+/**
+ * @brief Replay a trace and print its results
+ *
+ * @return true if the trace behaved and met the thresholds
+ */
+static bool run_trace(bench_trace_t* trace, const bench_options_t* options) {
+    memset(&g_loopback, 0, sizeof(g_loopback));
+    g_loopback.reads_late = trace->reads_late;
+    g_loopback_hal.prime_receive = options->use_prime ? loopback_prime_receive : NULL;
+
+    if (g_transport->init(&g_loopback_hal) != HAL_SUCCESS ||
+        g_transport->set_message_callback(bench_on_message) != HAL_SUCCESS ||
+        g_transport->set_stream_callbacks(bench_on_chunk,
+                                          bench_on_stream_complete) != HAL_SUCCESS ||
+        !map_trace_cids(trace)) {
+        fprintf(stderr, "%s: transport setup failed\n", trace->name);
+        g_transport->deinit();
+        return false;
+    }
+
+    g_stats.latency_count = 0;
+    g_stats.messages = 0;
+    g_stats.send_failures = 0;
+    g_stats.bytes_delivered = 0;
+    g_stats.stream_bytes = 0;
+    g_stats.stream_pending = 0;
+    g_stats.stream_completed = 0;
+    g_stats.echo_head = 0;
+    g_stats.echo_count = 0;
+    g_stats.echo_mismatches = 0;
+    g_stats.latency_capacity = trace->count * options->iterations;
+    g_stats.latency_ns = malloc(g_stats.latency_capacity * sizeof(uint64_t));
+    if (!g_stats.latency_ns) {
+        fprintf(stderr, "out of memory\n");
+        exit(2);
+    }
+
+    uint64_t copied_before = fido_hid_transport_get_bytes_copied();
+    uint64_t start = now_ns();
+
+    for (unsigned round = 0; round < options->iterations; round++) {
+        for (size_t i = 0; i < trace->count; i++) {
+            const uint8_t* report = trace->reports[i];
+            if (report[4] & 0x80) {
+                uint32_t cid = ((uint32_t)report[0] << 24) | ((uint32_t)report[1] << 16) |
+                               ((uint32_t)report[2] << 8) | report[3];
+                int index = find_mapped_cid(cid, g_stats.cid_to);
+                if (index >= 0) {
+                    g_stats.start_ns[index] = now_ns();
+                }
+            }
+            loopback_host_send(report);
+        }
+        loopback_pump();
+        platform_clock_advance_us(BENCH_ROUND_GAP_US);
+    }
+
+    uint64_t elapsed = now_ns() - start;
+    uint64_t copied = fido_hid_transport_get_bytes_copied() - copied_before;
+    g_transport->deinit();
+
+    double seconds = (double)elapsed / 1e9;
+    double pps = (double)(g_loopback.reports_out + g_loopback.reports_in) / seconds;
+    double copy_per_msg = g_stats.messages ? (double)copied / (double)g_stats.messages : 0.0;
+
+    qsort(g_stats.latency_ns, g_stats.latency_count, sizeof(uint64_t), compare_u64);
+    printf("%-18s %10.0f %9.2f %9.2f %9.2f %9.2f %12.1f %8llu %6llu\n",
+           trace->name, pps,
+           percentile_us(g_stats.latency_ns, g_stats.latency_count, 0.50),
+           percentile_us(g_stats.latency_ns, g_stats.latency_count, 0.90),
+           percentile_us(g_stats.latency_ns, g_stats.latency_count, 0.99),
+           g_stats.latency_count ? (double)g_stats.latency_ns[g_stats.latency_count - 1] / 1000.0
+                                 : 0.0,
+           copy_per_msg,
+           (unsigned long long)g_stats.messages,
+           (unsigned long long)g_loopback.errors_in);
+    free(g_stats.latency_ns);
+    g_stats.latency_ns = NULL;
+
+    bool ok = true;
+    if (trace->expected_messages != UINT32_MAX &&
+        g_stats.messages != (uint64_t)trace->expected_messages * options->iterations) {
+        fprintf(stderr, "%s: delivered %llu messages, expected %llu\n", trace->name,
+                (unsigned long long)g_stats.messages,
+                (unsigned long long)trace->expected_messages * options->iterations);
+        ok = false;
+    }
+    uint64_t errors_expected = (uint64_t)trace->expected_errors * options->iterations;
+    if (trace->expected_errors != UINT32_MAX &&
+        (trace->errors_at_most ? g_loopback.errors_in > errors_expected
+                               : g_loopback.errors_in != errors_expected)) {
+        fprintf(stderr, "%s: sent %llu error responses, expected %s%llu\n", trace->name,
+                (unsigned long long)g_loopback.errors_in,
+                trace->errors_at_most ? "at most " : "",
+                (unsigned long long)errors_expected);
+        ok = false;
+    }
+    if (g_stats.stream_completed != g_stats.messages ||
+        g_stats.stream_bytes != g_stats.bytes_delivered) {
+        fprintf(stderr, "%s: streamed %llu messages / %llu bytes, delivered %llu / %llu\n",
+                trace->name, (unsigned long long)g_stats.stream_completed,
+                (unsigned long long)g_stats.stream_bytes, (unsigned long long)g_stats.messages,
+                (unsigned long long)g_stats.bytes_delivered);
+        ok = false;
+    }
+    if (g_stats.echo_mismatches > 0) {
+        fprintf(stderr, "%s: %llu PING echoes differ from their request\n", trace->name,
+                (unsigned long long)g_stats.echo_mismatches);
+        ok = false;
+    }
+    if (g_stats.send_failures > 0) {
+        fprintf(stderr, "%s: %llu responses refused by the transport\n", trace->name,
+                (unsigned long long)g_stats.send_failures);
+        ok = false;
+    }
+    if (options->min_pps > 0 && pps < options->min_pps) {
+        fprintf(stderr, "%s: %.0f packets/s below gate %.0f\n", trace->name, pps, options->min_pps);
+        ok = false;
+    }
+    if (options->max_copy > 0 && copy_per_msg > options->max_copy) {
+        fprintf(stderr, "%s: %.1f bytes copied per message above gate %.1f\n",
+                trace->name, copy_per_msg, options->max_copy);
+        ok = false;
+    }
+    return ok;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Deferred delivery                                                         */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief Message held by the transport, as the worker queue sees it
+ */
+typedef struct {
+    uint32_t cid;                           /**< Channel ID */
+    uint8_t cmd;                            /**< Command */
+    const uint8_t* data;                    /**< Payload in its reassembly slot */
+    size_t length;                          /**< Payload length */
+} bench_held_t;
+
+static bench_held_t g_held[FIDO_MAX_RX_SLOTS + 1];
+static size_t g_held_count = 0;
+static uint32_t g_cancels = 0;
+static uint32_t g_inits = 0;
+
+static void deferred_on_message(uint32_t cid, uint8_t cmd, const uint8_t* data, size_t length) {
+    if (cmd == FIDO_HID_INIT) {
+        // Answered during the callback, like the worker task does
+        g_inits++;
+        bench_on_message(cid, cmd, data, length);
+        return;
+    }
+    if (g_held_count < sizeof(g_held) / sizeof(g_held[0])) {
+        g_held[g_held_count++] = (bench_held_t){ cid, cmd, data, length };
+    }
+}
+
+static void deferred_on_cancel(uint32_t cid) {
+    (void)cid;
+    g_cancels++;
+}
+
+/**
+ * @brief Run the oldest held message and release it, like the worker task
+ */
+static void deferred_run_one(void) {
+    if (g_held_count == 0) {
+        return;
+    }
+    bench_held_t job = g_held[0];
+    memmove(&g_held[0], &g_held[1], --g_held_count * sizeof(g_held[0]));
+    bench_on_message(job.cid, job.cmd, job.data, job.length);
+    g_transport->release_message(job.data);
+    loopback_pump();
+}
+
+/**
+ * @brief Send a single-packet request from the host
+ */
+static void deferred_send(uint32_t cid, uint8_t cmd, const uint8_t* data, uint16_t length) {
+    uint8_t report[FIDO_HID_PACKET_SIZE];
+
+    fido_hid_prepare_init_packet(report, cid, cmd, data, length);
+    loopback_host_send(report);
+}
+
+/**
+ * @brief Check CANCEL and INIT handling against queued requests in deferred mode
+ *
+ * A CANCEL only applies to a CBOR request: a queued PING must still be
+ * echoed, while a queued CBOR request is reported to the cancel callback.
+ * With every reassembly slot held by a queued request, a broadcast INIT
+ * must still be answered rather than refused with CHANNEL_BUSY.
+ *
+ * @return true if every request behaved
+ */
+static bool run_deferred(const bench_options_t* options) {
+    static const uint8_t ping[] = "queued ping";
+    static const uint8_t cbor[] = { 0x04 };
+    static const uint8_t nonce[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint32_t cid = 0;
+
+    memset(&g_loopback, 0, sizeof(g_loopback));
+    g_loopback_hal.prime_receive = options->use_prime ? loopback_prime_receive : NULL;
+    g_held_count = 0;
+    g_cancels = 0;
+    g_inits = 0;
+    g_stats.latency_capacity = 0;
+    g_stats.messages = 0;
+    g_stats.send_failures = 0;
+    g_stats.echo_head = 0;
+    g_stats.echo_count = 0;
+    g_stats.echo_mismatches = 0;
+
+    if (g_transport->init(&g_loopback_hal) != HAL_SUCCESS ||
+        g_transport->set_message_callback(deferred_on_message) != HAL_SUCCESS ||
+        g_transport->set_cancel_callback(deferred_on_cancel) != HAL_SUCCESS ||
+        g_transport->set_deferred_delivery(true) != HAL_SUCCESS ||
+        g_transport->allocate_channel(&cid) != HAL_SUCCESS) {
+        fprintf(stderr, "deferred: transport setup failed\n");
+        g_transport->deinit();
+        return false;
+    }
+
+    bool ok = true;
+
+    deferred_send(cid, FIDO_HID_PING, ping, sizeof(ping));
+    deferred_send(cid, FIDO_HID_CANCEL, NULL, 0);
+    if (g_cancels != 0) {
+        fprintf(stderr, "deferred: CANCEL reached a queued PING\n");
+        ok = false;
+    }
+    deferred_run_one();
+    if (g_stats.echo_count != 0 || g_stats.echo_mismatches != 0) {
+        fprintf(stderr, "deferred: queued PING not echoed after CANCEL\n");
+        ok = false;
+    }
+
+    uint32_t cancels = g_cancels;
+    deferred_send(cid, FIDO_HID_CBOR, cbor, sizeof(cbor));
+    deferred_send(cid, FIDO_HID_CANCEL, NULL, 0);
+    if (g_cancels != cancels + 1) {
+        fprintf(stderr, "deferred: CANCEL of a queued CBOR request not reported\n");
+        ok = false;
+    }
+    deferred_run_one();
+
+    // Hold a request in every slot, then open a channel
+    deferred_send(cid, FIDO_HID_PING, ping, sizeof(ping));
+    for (int i = 1; i < FIDO_MAX_RX_SLOTS; i++) {
+        uint32_t other = 0;
+        if (g_transport->allocate_channel(&other) != HAL_SUCCESS) {
+            fprintf(stderr, "deferred: channel %d not allocated\n", i);
+            ok = false;
+            break;
+        }
+        deferred_send(other, FIDO_HID_PING, ping, sizeof(ping));
+    }
+    size_t held = g_held_count;
+    deferred_send(FIDO_BROADCAST_CID, FIDO_HID_INIT, nonce, sizeof(nonce));
+    loopback_pump();
+    if (held != FIDO_MAX_RX_SLOTS || g_inits != 1 || g_loopback.errors_in != 0) {
+        fprintf(stderr, "deferred: INIT with %zu requests held %s\n", held,
+                g_loopback.errors_in != 0 ? "refused" : "not answered");
+        ok = false;
+    }
+    while (g_held_count > 0) {
+        deferred_run_one();
+    }
+
+    if (g_stats.messages != 3U + FIDO_MAX_RX_SLOTS || g_stats.send_failures != 0 ||
+        g_loopback.errors_in != 0 || g_stats.echo_count != 0 || g_stats.echo_mismatches != 0) {
+        fprintf(stderr, "deferred: %llu requests run, %llu refused, %llu errors\n",
+                (unsigned long long)g_stats.messages,
+                (unsigned long long)g_stats.send_failures,
+                (unsigned long long)g_loopback.errors_in);
+        ok = false;
+    }
+    g_transport->set_cancel_callback(NULL);
+    g_transport->deinit();
+
+    printf("deferred: CANCEL of queued PING %s, of queued CBOR %s, INIT with all slots held %s\n",
+           ok ? "ignored" : "FAILED", ok ? "reported" : "FAILED", ok ? "answered" : "FAILED");
+    return ok;
+}
+
+/**
+ * @brief Time fragmenting a 7609-byte message against one plain memcpy
+ *
+ * Frames go into a 4-frame ring that is checked against the per-packet
+ * helpers, so a framer change that alters the wire format fails here.
+ *
+ * @return true if the framer output matched
+ */
+static bool run_framing(const bench_options_t* options) {
+    static uint8_t payload[FIDO_MAX_MESSAGE_SIZE];
+    static uint8_t flat[FIDO_MAX_MESSAGE_SIZE];
+    fido_hid_frame_t ring[4];
+    uint8_t expected[FIDO_HID_PACKET_SIZE];
+    const uint32_t cid = 0x01020304;
+    unsigned rounds = options->iterations * 50;
+    volatile uint32_t sink = 0;
+
+    for (size_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 13);
+    }
+
+    // Wire format check
+    fido_hid_framer_t framer;
+    fido_hid_framer_init(&framer, cid, FIDO_HID_MSG, payload, FIDO_MAX_MESSAGE_SIZE);
+    size_t frames = 0;
+    size_t offset = 0;
+    size_t built;
+    while ((built = fido_hid_framer_build(&framer, ring, 4, 0, 4)) > 0) {
+        for (size_t i = 0; i < built; i++, frames++) {
+            if (frames == 0) {
+                fido_hid_prepare_init_packet(expected, cid, FIDO_HID_MSG, payload,
+                                             FIDO_MAX_MESSAGE_SIZE);
+                offset = FIDO_HID_INIT_PAYLOAD_SIZE;
+            } else {
+                fido_hid_prepare_cont_packet(expected, cid, (uint8_t)(frames - 1),
+                                             payload + offset, FIDO_MAX_MESSAGE_SIZE - offset);
+                offset += FIDO_HID_CONT_PAYLOAD_SIZE;
+            }
+            if (memcmp(ring[i], expected, FIDO_HID_PACKET_SIZE) != 0) {
+                fprintf(stderr, "framing: frame %zu differs from packet helpers\n", frames);
+                return false;
+            }
+        }
+    }
+    if (frames != fido_hid_frame_count(FIDO_MAX_MESSAGE_SIZE)) {
+        fprintf(stderr, "framing: built %zu frames, expected %zu\n", frames,
+                fido_hid_frame_count(FIDO_MAX_MESSAGE_SIZE));
+        return false;
+    }
+
+    uint64_t start = now_ns();
+    for (unsigned round = 0; round < rounds; round++) {
+        fido_hid_framer_init(&framer, cid, FIDO_HID_MSG, payload, FIDO_MAX_MESSAGE_SIZE);
+        size_t head = 0;
+        while ((built = fido_hid_framer_build(&framer, ring, 4, head, 4)) > 0) {
+            sink += ring[head][1];
+            head = (head + built) % 4;
+        }
+    }
+    uint64_t framer_ns = now_ns() - start;
+
+    start = now_ns();
+    for (unsigned round = 0; round < rounds; round++) {
+        memcpy(flat, payload, sizeof(flat));
+        sink += flat[round % sizeof(flat)];
+        payload[0] = (uint8_t)round;
+    }
+    uint64_t memcpy_ns = now_ns() - start;
+    (void)sink;
+
+    double framer_us = (double)framer_ns / rounds / 1000.0;
+    double memcpy_us = (double)memcpy_ns / rounds / 1000.0;
+    printf("framing 7609 B: %.2f us/msg (%zu frames), memcpy %.2f us, ratio %.2f\n",
+           framer_us, frames, memcpy_us, memcpy_us > 0 ? framer_us / memcpy_us : 0.0);
+    return true;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s [-i iterations] [-n] [-r trace.bin] [-P min_pps] [-C max_copy]\n",
+            program);
+}
+
+int main(int argc, char** argv) {
+    bench_options_t options = {
+        .iterations = BENCH_DEFAULT_ITERATIONS,
+        .use_prime = true,
+    };
+    const char* replay = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n")) {
+            options.use_prime = false;
+        } else if (i + 1 < argc && !strcmp(argv[i], "-i")) {
+            options.iterations = (unsigned)strtoul(argv[++i], NULL, 0);
+        } else if (i + 1 < argc && !strcmp(argv[i], "-r")) {
+            replay = argv[++i];
+        } else if (i + 1 < argc && !strcmp(argv[i], "-P")) {
+            options.min_pps = strtod(argv[++i], NULL);
+        } else if (i + 1 < argc && !strcmp(argv[i], "-C")) {
+            options.max_copy = strtod(argv[++i], NULL);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (options.iterations == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    g_transport = fido_hid_transport_get_instance();
+
+    bench_trace_t traces[7] = {{0}};
+    size_t trace_count = 0;
+    if (replay) {
+        if (!load_trace(&traces[trace_count++], replay)) {
+            return 2;
+        }
+    } else {
+        build_ping_flood(&traces[trace_count++]);
+        build_ping_echo(&traces[trace_count++]);
+        build_max_message(&traces[trace_count++]);
+        build_interleaved(&traces[trace_count++]);
+        build_malformed(&traces[trace_count++]);
+        build_flood(&traces[trace_count++]);
+    }
+
+    printf("FIDO HID transport benchmark: %u iterations, %s receive\n",
+           options.iterations, options.use_prime ? "primed (zero-copy)" : "HAL buffer");
+    printf("%-18s %10s %9s %9s %9s %9s %12s %8s %6s\n", "trace", "pkt/s",
+           "p50 us", "p90 us", "p99 us", "max us", "copied/msg", "msgs", "errs");
+
+    bool ok = true;
+    for (size_t i = 0; i < trace_count; i++) {
+        ok &= run_trace(&traces[i], &options);
+        free(traces[i].reports);
+    }
+    ok &= run_deferred(&options);
+    ok &= run_framing(&options);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+/**
+ * @file fido_hid_worker.c
+ * @brief FIDO HID Deferred Request Worker Implementation
+ * @author USB Key Authentication Team
+ * @date 2025-09-08
+ * @version 1.0
+ */
+
+#include "fido_hid_worker.h"
+#include "platform/crypto/crypto_job.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include <string.h>
+
+_Static_assert(FIDO_WORKER_TASK_PRIORITY < FIDO_USB_TASK_PRIORITY,
+               "worker must not preempt the USB device task");
+
+/**
+ * @brief Request handed from the transport to the worker task
+ */
+typedef struct {
+    uint32_t cid;                           /**< Channel ID */
+    uint8_t cmd;                            /**< Command */
+    const uint8_t* data;                    /**< Payload held by the transport */
+    size_t length;                          /**< Payload length */
+} fido_worker_job_t;
+
+/**
+ * @brief Request waiting in the job queue
+ */
+typedef struct {
+    uint32_t cid;                           /**< Channel ID, 0 when unused */
+    bool cancelled;                         /**< CANCEL arrived while queued */
+} fido_worker_pending_t;
+
+/**
+ * @brief Worker context
+ */
+typedef struct {
+    const fido_hid_transport_t* transport;  /**< Transport instance */
+    fido_message_callback_t handler;        /**< Request handler */
+    QueueHandle_t jobs;                     /**< Pending requests */
+    TaskHandle_t task;                      /**< Worker task */
+    TimerHandle_t keepalive_timer;          /**< KEEPALIVE period */
+    TimerHandle_t timeout_timer;            /**< Transport timer wheel tick */
+    volatile uint32_t current_cid;          /**< Channel being processed */
+    volatile bool busy;                     /**< Handler running */
+    volatile bool cancelled;                /**< Current request cancelled */
+    fido_worker_pending_t pending[FIDO_MAX_RX_SLOTS]; /**< Queued requests, one per channel */
+    volatile uint8_t keepalive_status;      /**< Status for KEEPALIVE */
+} fido_worker_context_t;
+
+/** @brief Global worker context */
+static fido_worker_context_t g_worker_ctx = {0};
+
+/**
+ * @brief Queue a delivered message for the worker task
+ */
+static void worker_on_message(uint32_t cid, uint8_t cmd, const uint8_t* data, size_t length) {
+    const fido_hid_transport_t* transport = g_worker_ctx.transport;
+
+    if (cmd == FIDO_HID_INIT) {
+        // Answered straight away, channel allocation is cheap. Only a
+        // fragmented INIT holds a slot; the release is a no-op otherwise
+        g_worker_ctx.handler(cid, cmd, data, length);
+        (void)transport->release_message(data);
+        return;
+    }
+
+    fido_worker_job_t job = {
+        .cid = cid,
+        .cmd = cmd,
+        .data = data,
+        .length = length,
+    };
+
+    // A channel has one request outstanding, and the queue holds one per slot
+    fido_worker_pending_t* pending = NULL;
+    for (uint32_t i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        if (g_worker_ctx.pending[i].cid == 0) {
+            pending = &g_worker_ctx.pending[i];
+            pending->cancelled = false;
+            pending->cid = cid;
+            break;
+        }
+    }
+
+    BaseType_t queued = pdFAIL;
+    if (pending && xPortIsInsideInterrupt()) {
+        BaseType_t woken = pdFALSE;
+        queued = xQueueSendFromISR(g_worker_ctx.jobs, &job, &woken);
+        portYIELD_FROM_ISR(woken);
+    } else if (pending) {
+        queued = xQueueSend(g_worker_ctx.jobs, &job, 0);
+    }
+
+    if (queued != pdPASS) {
+        if (pending) {
+            pending->cid = 0;
+        }
+        transport->release_message(data);
+        transport->send_error(cid, FIDO_ERR_CHANNEL_BUSY);
+    }
+}
+
+/**
+ * @brief Flag the request running (or queued) on CID
+ *
+ * Crypto jobs the request submitted with the CID as owner are cancelled
+ * too, so the handler's crypto_job_wait() returns HAL_ERROR_CANCELLED.
+ * A CANCEL for a channel with no request outstanding is ignored.
+ */
+static void worker_on_cancel(uint32_t cid) {
+    if (g_worker_ctx.busy && g_worker_ctx.current_cid == cid) {
+        g_worker_ctx.cancelled = true;
+    }
+    for (uint32_t i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        if (g_worker_ctx.pending[i].cid == cid) {
+            g_worker_ctx.pending[i].cancelled = true;
+        }
+    }
+    (void)crypto_job_cancel(cid);
+}
+
+/**
+ * @brief Mark a dequeued request running and drop its queued entry
+ *
+ * The USB task outranks the worker and the USB interrupt is masked here,
+ * so a CANCEL lands either on the entry or on the running request.
+ *
+ * @return true if the request was cancelled while queued
+ */
+static bool worker_begin_request(uint32_t cid) {
+    bool cancelled = false;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < FIDO_MAX_RX_SLOTS; i++) {
+        if (g_worker_ctx.pending[i].cid == cid) {
+            cancelled = g_worker_ctx.pending[i].cancelled;
+            g_worker_ctx.pending[i].cid = 0;
+            break;
+        }
+    }
+    g_worker_ctx.current_cid = cid;
+    g_worker_ctx.cancelled = cancelled;
+    g_worker_ctx.busy = true;
+    taskEXIT_CRITICAL();
+
+    return cancelled;
+}
+
+/**
+ * @brief Send KEEPALIVE for the request being processed
+ *
+ * Runs on the timer service task. A KEEPALIVE that races the final
+ * response is skipped by the host like any other KEEPALIVE.
+ */
+static void worker_keepalive_callback(TimerHandle_t timer) {
+    (void)timer;
+
+    if (!g_worker_ctx.busy || g_worker_ctx.cancelled) {
+        return;
+    }
+
+    uint8_t status = g_worker_ctx.keepalive_status;
+    // Best effort: a full TX queue already tells the host we are alive
+    (void)g_worker_ctx.transport->send_message(g_worker_ctx.current_cid,
+                                               FIDO_HID_KEEPALIVE, &status, 1);
+}
+
+/**
+ * @brief Advance the transport timer wheel
+ *
+ * Runs on the timer service task every FIDO_TIMER_TICK_MS.
+ */
+static void worker_timeout_callback(TimerHandle_t timer) {
+    (void)timer;
+    g_worker_ctx.transport->process_timeouts();
+}
+
+/**
+ * @brief Worker task: run requests one at a time
+ */
+static void worker_task(void* param) {
+    (void)param;
+    fido_worker_job_t job;
+
+    for (;;) {
+        if (xQueueReceive(g_worker_ctx.jobs, &job, portMAX_DELAY) != pdPASS) {
+            continue;
+        }
+
+        g_worker_ctx.keepalive_status = FIDO_KEEPALIVE_STATUS_PROCESSING;
+
+        if (!worker_begin_request(job.cid)) {
+            xTimerStart(g_worker_ctx.keepalive_timer, 0);
+            g_worker_ctx.handler(job.cid, job.cmd, job.data, job.length);
+            xTimerStop(g_worker_ctx.keepalive_timer, 0);
+        } else if (job.cmd == FIDO_HID_CBOR) {
+            // Same answer a running handler gives when it sees the cancel
+            static const uint8_t status = FIDO_CTAP2_ERR_KEEPALIVE_CANCEL;
+            (void)g_worker_ctx.transport->send_message(job.cid, job.cmd, &status, 1);
+        }
+        // Other requests are only cancelled by an INIT, which resynced the channel
+
+        g_worker_ctx.busy = false;
+        g_worker_ctx.transport->release_message(job.data);
+    }
+}
+
+hal_result_t fido_hid_worker_init(const fido_hid_transport_t* transport,
+                                  fido_message_callback_t handler) {
+    if (!transport || !handler) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (g_worker_ctx.task) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    memset(&g_worker_ctx, 0, sizeof(g_worker_ctx));
+    g_worker_ctx.transport = transport;
+    g_worker_ctx.handler = handler;
+
+    // At most one delivered message per reassembly slot
+    g_worker_ctx.jobs = xQueueCreate(FIDO_MAX_RX_SLOTS, sizeof(fido_worker_job_t));
+    g_worker_ctx.keepalive_timer = xTimerCreate("fido keepalive",
+                                                pdMS_TO_TICKS(FIDO_KEEPALIVE_INTERVAL_MS),
+                                                pdTRUE, NULL, worker_keepalive_callback);
+    g_worker_ctx.timeout_timer = xTimerCreate("fido timeouts",
+                                              pdMS_TO_TICKS(FIDO_TIMER_TICK_MS),
+                                              pdTRUE, NULL, worker_timeout_callback);
+    if (!g_worker_ctx.jobs || !g_worker_ctx.keepalive_timer || !g_worker_ctx.timeout_timer) {
+        goto cleanup_and_exit;
+    }
+
+    if (xTaskCreate(worker_task, "fido worker",
+                    FIDO_WORKER_STACK_SIZE / sizeof(portSTACK_TYPE),
+                    NULL, FIDO_WORKER_TASK_PRIORITY, &g_worker_ctx.task) != pdPASS) {
+        g_worker_ctx.task = NULL;
+        goto cleanup_and_exit;
+    }
+
+    transport->set_cancel_callback(worker_on_cancel);
+    transport->set_deferred_delivery(true);
+    transport->set_message_callback(worker_on_message);
+    xTimerStart(g_worker_ctx.timeout_timer, 0);
+
+    return HAL_SUCCESS;
+
+cleanup_and_exit:
+    if (g_worker_ctx.timeout_timer) {
+        xTimerDelete(g_worker_ctx.timeout_timer, 0);
+    }
+    if (g_worker_ctx.keepalive_timer) {
+        xTimerDelete(g_worker_ctx.keepalive_timer, 0);
+    }
+    if (g_worker_ctx.jobs) {
+        vQueueDelete(g_worker_ctx.jobs);
+    }
+    memset(&g_worker_ctx, 0, sizeof(g_worker_ctx));
+    return HAL_ERROR_INSUFFICIENT_MEMORY;
+}
+
+void fido_hid_worker_set_keepalive_status(uint8_t status) {
+    g_worker_ctx.keepalive_status = status;
+}
+
+bool fido_hid_worker_is_cancelled(void) {
+    return g_worker_ctx.cancelled;
+}
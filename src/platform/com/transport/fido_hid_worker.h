@@ -0,0 +1,87 @@
+#ifndef FIDO_HID_WORKER_H
+#define FIDO_HID_WORKER_H
+
+/**
+ * @file fido_hid_worker.h
+ * @brief FIDO HID Deferred Request Worker
+ * @author USB Key Authentication Team
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ * Runs CTAPHID request handlers on a dedicated FreeRTOS task so the USB
+ * path never blocks on long operations (signatures, user presence).
+ * While a request is processed the worker emits CTAPHID_KEEPALIVE every
+ * FIDO_KEEPALIVE_INTERVAL_MS, and CTAPHID_CANCEL flags the running request
+ * and cancels the crypto jobs (crypto_job.h) submitted with its CID as
+ * owner.
+ */
+
+#include "fido_hid_transport.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Priority hid_generic.c gives the SDK USB device task */
+#ifndef FIDO_USB_TASK_PRIORITY
+#define FIDO_USB_TASK_PRIORITY      5U
+#endif
+
+/** @brief Worker task priority (below the SDK USB device task) */
+#ifndef FIDO_WORKER_TASK_PRIORITY
+#define FIDO_WORKER_TASK_PRIORITY   4U
+#endif
+
+/** @brief CTAP2 status answering a request cancelled before its handler ran */
+#define FIDO_CTAP2_ERR_KEEPALIVE_CANCEL 0x2DU
+
+/** @brief Worker task stack size in bytes */
+#ifndef FIDO_WORKER_STACK_SIZE
+#define FIDO_WORKER_STACK_SIZE      4096U
+#endif
+
+/**
+ * @brief Start the worker and attach it to the transport
+ *
+ * Creates the worker task, its job queue, the keepalive timer and the
+ * timer that drives transport->process_timeouts() from the FreeRTOS tick,
+ * then registers itself as the transport's message and cancel callback
+ * and enables deferred delivery. Every request except CTAPHID_INIT is passed
+ * to the handler from the worker task; the message buffer is released
+ * when the handler returns.
+ *
+ * @param transport Initialized transport instance
+ * @param handler Request handler run on the worker task
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM NULL transport or handler
+ * @retval HAL_ERROR_INVALID_STATE Worker already started
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Task, queue or timer creation failed
+ *
+ * @note CTAPHID_INIT is handled inline so channel allocation never waits
+ *       behind a long-running request
+ * @note A request cancelled while still queued never reaches the handler;
+ *       the worker answers a CTAPHID_CBOR request with
+ *       FIDO_CTAP2_ERR_KEEPALIVE_CANCEL and drops any other (only an INIT
+ *       resynchronizing the channel cancels those)
+ */
+hal_result_t fido_hid_worker_init(const fido_hid_transport_t* transport,
+                                  fido_message_callback_t handler);
+
+/**
+ * @brief Set status reported by the next KEEPALIVE packets
+ *
+ * @param status FIDO_KEEPALIVE_STATUS_PROCESSING or FIDO_KEEPALIVE_STATUS_UPNEEDED
+ *
+ * @note Reset to PROCESSING at the start of every request
+ */
+void fido_hid_worker_set_keepalive_status(uint8_t status);
+
+/**
+ * @brief Check whether the current request has been cancelled
+ *
+ * Long-running handlers (user presence wait, multi-step operations) poll
+ * this and abort with CTAP2_ERR_KEEPALIVE_CANCEL when it returns true.
+ *
+ * @return true if CTAPHID_CANCEL (or INIT) arrived for the current request
+ */
+bool fido_hid_worker_is_cancelled(void);
+
+#endif // FIDO_HID_WORKER_H
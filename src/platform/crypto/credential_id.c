@@ -0,0 +1,134 @@
+/**
+ * @file credential_id.c
+ * @brief Stateless Credential IDs for Non-Resident FIDO2 Credentials
+ * @author USB Key Authentication Team
+ * @date 2025-09-15
+ * @version 1.0
+ */
+
+#include "credential_id.h"
+#include "hal/crypto/tinycrypt_crypto_hal.h"
+#include <string.h>
+
+/** @brief Associated data: version || rpIdHash */
+#define CREDENTIAL_ID_AAD_SIZE  (1U + CREDENTIAL_ID_RP_ID_HASH_SIZE)
+
+_Static_assert(CREDENTIAL_ID_SIZE == 1U + TINYCRYPT_WRAPPED_KEY_SIZE,
+               "CREDENTIAL_ID_SIZE does not match the wrapped key size");
+
+/**
+ * @brief Module state
+ */
+typedef struct {
+    crypto_key_t master_key;    /**< AES-128 wrapping key */
+    bool initialized;           /**< Master key loaded */
+} credential_id_state_t;
+
+/** @brief Global module state */
+static credential_id_state_t g_credential_id = {0};
+
+/**
+ * @brief Build the associated data binding an ID to its format and RP
+ */
+static void build_aad(uint8_t* aad, const uint8_t* rp_id_hash) {
+    aad[0] = CREDENTIAL_ID_VERSION;
+    memcpy(&aad[1], rp_id_hash, CREDENTIAL_ID_RP_ID_HASH_SIZE);
+}
+
+hal_result_t credential_id_init(const uint8_t* master_key) {
+    if (!master_key) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    credential_id_deinit();
+
+    hal_result_t result = tinycrypt_crypto_hal.import_key(master_key, CREDENTIAL_ID_MASTER_KEY_SIZE,
+                                                          CRYPTO_KEY_TYPE_SYMMETRIC,
+                                                          &g_credential_id.master_key);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    // Wrapped keys are only as safe as this key: never export it
+    g_credential_id.master_key.flags &= ~CRYPTO_KEY_FLAG_EXPORTABLE;
+    g_credential_id.initialized = true;
+    return HAL_SUCCESS;
+}
+
+void credential_id_deinit(void) {
+    if (g_credential_id.initialized) {
+        (void)tinycrypt_crypto_hal.delete_key(&g_credential_id.master_key);
+    }
+    memset(&g_credential_id, 0, sizeof(g_credential_id));
+}
+
+hal_result_t credential_id_generate_master_key(uint8_t* master_key) {
+    if (!master_key) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    return tinycrypt_crypto_hal.rng.generate_random(master_key, CREDENTIAL_ID_MASTER_KEY_SIZE);
+}
+
+hal_result_t credential_id_create(crypto_algorithm_t algorithm, const uint8_t* rp_id_hash,
+                                  uint8_t* credential_id, size_t* id_length,
+                                  crypto_key_t* public_key) {
+    if (!g_credential_id.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!rp_id_hash || !credential_id || !id_length || !public_key) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (*id_length < CREDENTIAL_ID_SIZE) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    uint8_t aad[CREDENTIAL_ID_AAD_SIZE];
+    crypto_key_t private_key;
+    size_t wrapped_length = CREDENTIAL_ID_SIZE - 1U;
+    hal_result_t result;
+
+    result = tinycrypt_crypto_hal.generate_key_pair(algorithm, public_key, &private_key);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    build_aad(aad, rp_id_hash);
+    credential_id[0] = CREDENTIAL_ID_VERSION;
+    result = tinycrypt_crypto_wrap_key(&g_credential_id.master_key, &private_key,
+                                       aad, sizeof(aad), &credential_id[1], &wrapped_length);
+    if (result != HAL_SUCCESS) {
+        (void)tinycrypt_crypto_hal.delete_key(public_key);
+        goto cleanup_and_exit;
+    }
+
+    *id_length = CREDENTIAL_ID_SIZE;
+
+cleanup_and_exit:
+    // The ID is the only copy of the private key from here on
+    (void)tinycrypt_crypto_hal.delete_key(&private_key);
+    return result;
+}
+
+hal_result_t credential_id_open(const uint8_t* credential_id, size_t id_length,
+                                const uint8_t* rp_id_hash, crypto_key_t* private_key) {
+    if (!g_credential_id.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    if (!credential_id || !rp_id_hash || !private_key) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (id_length != CREDENTIAL_ID_SIZE || credential_id[0] != CREDENTIAL_ID_VERSION) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    uint8_t aad[CREDENTIAL_ID_AAD_SIZE];
+    hal_result_t result;
+
+    build_aad(aad, rp_id_hash);
+    result = tinycrypt_crypto_unwrap_key(&g_credential_id.master_key, &credential_id[1],
+                                         id_length - 1U, aad, sizeof(aad), private_key);
+
+    // Wrong RP, wrong authenticator or tampered: all just "not ours"
+    return result == HAL_ERROR_HARDWARE_FAILURE ? HAL_ERROR_INVALID_PARAM : result;
+}
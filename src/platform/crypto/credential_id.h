@@ -0,0 +1,109 @@
+#ifndef CREDENTIAL_ID_H
+#define CREDENTIAL_ID_H
+
+/**
+ * @file credential_id.h
+ * @brief Stateless Credential IDs for Non-Resident FIDO2 Credentials
+ * @author USB Key Authentication Team
+ * @date 2025-09-15
+ * @version 1.0
+ *
+ * A non-discoverable credential does not need to be stored: its private
+ * key travels inside the credential ID, AES-128-CCM wrapped under a device
+ * master key, and comes back in the allowList of every GetAssertion. So
+ * MakeCredential without rk never programs flash, and the number of such
+ * credentials is unlimited.
+ *
+ * Credential ID layout (CREDENTIAL_ID_SIZE bytes):
+ * @code
+ * version (1) || nonce (13) || CCM(algorithm (1) || secret (32)) || tag (16)
+ * @endcode
+ * The version byte and the rpIdHash are the CCM associated data, so an ID
+ * only opens for the relying party it was made for, and any other ID
+ * (a resident credential's, another authenticator's) fails the tag check.
+ *
+ * The master key is the caller's to keep: generate it once with
+ * credential_id_generate_master_key(), store it in STORAGE_REGION_CONFIG
+ * and pass it to credential_id_init() at boot. Replacing it on
+ * authenticatorReset invalidates every credential ID issued before.
+ *
+ * @warning Not thread-safe; call from the CTAP task only.
+ */
+
+#include "hal/interface/crypto_hal.h"
+
+/** @brief Master key size (AES-128) */
+#define CREDENTIAL_ID_MASTER_KEY_SIZE   16U
+
+/** @brief rpIdHash size (SHA-256) */
+#define CREDENTIAL_ID_RP_ID_HASH_SIZE   32U
+
+/** @brief Format version in the first byte of every ID */
+#define CREDENTIAL_ID_VERSION           0x01U
+
+/** @brief Credential ID size, fits FIDO2_CREDENTIAL_ID_LENGTH (64) */
+#define CREDENTIAL_ID_SIZE              63U
+
+/**
+ * @brief Load the master key
+ *
+ * @param master_key CREDENTIAL_ID_MASTER_KEY_SIZE bytes, copied into a key slot
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM NULL master_key
+ * @retval HAL_ERROR_NOT_INITIALIZED Crypto backend not initialized
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY No free key storage
+ */
+hal_result_t credential_id_init(const uint8_t* master_key);
+
+/**
+ * @brief Drop the master key
+ */
+void credential_id_deinit(void);
+
+/**
+ * @brief Draw a new master key from the crypto RNG
+ *
+ * @param master_key Output CREDENTIAL_ID_MASTER_KEY_SIZE bytes
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_STATE RNG not seeded yet
+ */
+hal_result_t credential_id_generate_master_key(uint8_t* master_key);
+
+/**
+ * @brief Create a credential key pair and its wrapped credential ID
+ *
+ * @param algorithm CRYPTO_ALG_ECC_P256 or CRYPTO_ALG_ED25519
+ * @param rp_id_hash SHA-256 of the RP ID
+ * @param credential_id Output buffer
+ * @param id_length In: buffer size, out: CREDENTIAL_ID_SIZE
+ * @param public_key Output public key for the attested credential data,
+ *                   delete with delete_key()
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_NOT_INITIALIZED No master key loaded
+ * @retval HAL_ERROR_NOT_SUPPORTED Algorithm not supported
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Buffer too small or no free key storage
+ */
+hal_result_t credential_id_create(crypto_algorithm_t algorithm, const uint8_t* rp_id_hash,
+                                  uint8_t* credential_id, size_t* id_length,
+                                  crypto_key_t* public_key);
+
+/**
+ * @brief Recover the private key of an allowList entry
+ *
+ * Runs entirely in RAM: one AES-CCM decryption, plus a base-point
+ * multiplication for Ed25519.
+ *
+ * @param credential_id Credential ID from the allowList
+ * @param id_length Its length
+ * @param rp_id_hash SHA-256 of the RP ID of the request
+ * @param private_key Output signing key, delete with delete_key()
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_NOT_INITIALIZED No master key loaded
+ * @retval HAL_ERROR_INVALID_PARAM Not a credential ID of this authenticator
+ *         for this RP; skip to the next allowList entry
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY No free key storage
+ */
+hal_result_t credential_id_open(const uint8_t* credential_id, size_t id_length,
+                                const uint8_t* rp_id_hash, crypto_key_t* private_key);
+
+#endif // CREDENTIAL_ID_H
@@ -0,0 +1,330 @@
+/**
+ * @file crypto_job.c
+ * @brief Asynchronous Crypto Jobs on a Dedicated Task
+ * @author USB Key Authentication Team
+ * @date 2025-09-17
+ * @version 1.0
+ *
+ * Submitted jobs sit on an intrusive list until they complete, so
+ * crypto_job_cancel() can find them whether they are still in the queue
+ * or running. The list and the job state change under a short critical
+ * section; cancel may come from the USB interrupt.
+ */
+
+#include "crypto_job.h"
+#include <string.h>
+
+#if defined(MCXA156_SERIES)
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "fsl_common.h"
+/** @brief Guard the active list, also against the USB interrupt */
+#define JOB_CRITICAL_ENTER()    uint32_t job_irq_state = DisableGlobalIRQ()
+#define JOB_CRITICAL_EXIT()     EnableGlobalIRQ(job_irq_state)
+#else
+#define JOB_CRITICAL_ENTER()    do { } while (0)
+#define JOB_CRITICAL_EXIT()     do { } while (0)
+#endif
+
+_Static_assert(CRYPTO_JOB_TASK_PRIORITY > 0U &&
+               CRYPTO_JOB_TASK_PRIORITY < FIDO_WORKER_TASK_PRIORITY &&
+               CRYPTO_JOB_TASK_PRIORITY < FIDO_USB_TASK_PRIORITY,
+               "crypto jobs must run above idle and below the worker and USB tasks");
+
+/**
+ * @brief Module context
+ */
+typedef struct {
+    crypto_hal_t* crypto;                   /**< HAL the jobs run on */
+    crypto_job_t* active;                   /**< Queued and running jobs */
+#if defined(MCXA156_SERIES)
+    QueueHandle_t queue;                    /**< Jobs for the crypto task */
+    TaskHandle_t task;                      /**< Crypto task */
+#endif
+    bool initialized;                       /**< Initialization flag */
+} crypto_job_context_t;
+
+/** @brief Global module context */
+static crypto_job_context_t g_crypto_job = {0};
+
+/**
+ * @brief Remove a job from the active list (caller holds the lock)
+ */
+static void unlink_job(crypto_job_t* job) {
+    crypto_job_t** link = &g_crypto_job.active;
+
+    while (*link && *link != job) {
+        link = &(*link)->next;
+    }
+    if (*link) {
+        *link = job->next;
+    }
+    job->next = NULL;
+}
+
+/**
+ * @brief Make the crypto_hal_t call of a job
+ */
+static hal_result_t execute(crypto_job_t* job) {
+    crypto_hal_t* crypto = g_crypto_job.crypto;
+
+    switch (job->type) {
+        case CRYPTO_JOB_GENERATE_KEY_PAIR:
+            return crypto->generate_key_pair(job->params.generate_key_pair.algorithm,
+                                             job->params.generate_key_pair.public_key,
+                                             job->params.generate_key_pair.private_key);
+
+        case CRYPTO_JOB_SIGN:
+            return crypto->sign(job->params.sign.private_key,
+                                job->params.sign.data, job->params.sign.data_length,
+                                job->params.sign.signature, job->params.sign.signature_length);
+
+        case CRYPTO_JOB_VERIFY:
+            return crypto->verify(job->params.verify.public_key,
+                                  job->params.verify.data, job->params.verify.data_length,
+                                  job->params.verify.signature,
+                                  job->params.verify.signature_length);
+
+        case CRYPTO_JOB_HASH:
+            return crypto->hash(job->params.hash.algorithm,
+                                job->params.hash.data, job->params.hash.data_length,
+                                job->params.hash.hash, job->params.hash.hash_length);
+
+        case CRYPTO_JOB_CALL:
+            return job->params.call.function ? job->params.call.function(job->params.call.argument)
+                                             : HAL_ERROR_INVALID_PARAM;
+
+        default:
+            return HAL_ERROR_INVALID_PARAM;
+    }
+}
+
+/**
+ * @brief Throw away the output of a job cancelled while it ran
+ */
+static void discard_output(crypto_job_t* job, hal_result_t result) {
+    if (job->type == CRYPTO_JOB_GENERATE_KEY_PAIR && result == HAL_SUCCESS) {
+        (void)g_crypto_job.crypto->delete_key(job->params.generate_key_pair.public_key);
+        (void)g_crypto_job.crypto->delete_key(job->params.generate_key_pair.private_key);
+    }
+}
+
+/**
+ * @brief Report a job's outcome and hand the descriptor back
+ *
+ * The callback runs while the job still counts as running; once the
+ * state is IDLE the submitter may free the descriptor, so nothing
+ * touches it afterwards.
+ */
+static void complete(crypto_job_t* job, hal_result_t result) {
+    void* waiter;
+
+    job->result = result;
+    if (job->callback) {
+        job->callback(job);
+    }
+
+    JOB_CRITICAL_ENTER();
+    unlink_job(job);
+    waiter = job->waiter;
+    job->waiter = NULL;
+    job->state = CRYPTO_JOB_STATE_IDLE;
+    JOB_CRITICAL_EXIT();
+
+#if defined(MCXA156_SERIES)
+    if (waiter) {
+        xTaskNotifyGive((TaskHandle_t)waiter);
+    }
+#else
+    (void)waiter;
+#endif
+}
+
+/**
+ * @brief Run one dequeued job
+ */
+static void run_job(crypto_job_t* job) {
+    bool skip;
+
+    JOB_CRITICAL_ENTER();
+    skip = job->cancelled;
+    if (!skip) {
+        job->state = CRYPTO_JOB_STATE_RUNNING;
+    }
+    JOB_CRITICAL_EXIT();
+
+    if (skip) {
+        complete(job, HAL_ERROR_CANCELLED);
+        return;
+    }
+
+    hal_result_t result = execute(job);
+
+    // Too late to stop the computation, not to drop its result
+    if (job->cancelled) {
+        discard_output(job, result);
+        result = HAL_ERROR_CANCELLED;
+    }
+    complete(job, result);
+}
+
+#if defined(MCXA156_SERIES)
+/**
+ * @brief Crypto task: run jobs one at a time
+ */
+static void crypto_job_task(void* param) {
+    (void)param;
+    crypto_job_t* job;
+
+    for (;;) {
+        if (xQueueReceive(g_crypto_job.queue, &job, portMAX_DELAY) == pdPASS) {
+            run_job(job);
+        }
+    }
+}
+#endif
+
+hal_result_t crypto_job_init(crypto_hal_t* crypto) {
+    if (!crypto) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (g_crypto_job.initialized) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    memset(&g_crypto_job, 0, sizeof(g_crypto_job));
+    g_crypto_job.crypto = crypto;
+
+#if defined(MCXA156_SERIES)
+    g_crypto_job.queue = xQueueCreate(CRYPTO_JOB_QUEUE_LENGTH, sizeof(crypto_job_t*));
+    if (!g_crypto_job.queue) {
+        goto cleanup_and_exit;
+    }
+
+    if (xTaskCreate(crypto_job_task, "crypto jobs",
+                    CRYPTO_JOB_STACK_SIZE / sizeof(portSTACK_TYPE),
+                    NULL, CRYPTO_JOB_TASK_PRIORITY, &g_crypto_job.task) != pdPASS) {
+        g_crypto_job.task = NULL;
+        goto cleanup_and_exit;
+    }
+#endif
+
+    g_crypto_job.initialized = true;
+    return HAL_SUCCESS;
+
+#if defined(MCXA156_SERIES)
+cleanup_and_exit:
+    if (g_crypto_job.queue) {
+        vQueueDelete(g_crypto_job.queue);
+    }
+    memset(&g_crypto_job, 0, sizeof(g_crypto_job));
+    return HAL_ERROR_INSUFFICIENT_MEMORY;
+#endif
+}
+
+hal_result_t crypto_job_submit(crypto_job_t* job) {
+    if (!job || (unsigned)job->type > CRYPTO_JOB_CALL) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (!g_crypto_job.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    JOB_CRITICAL_ENTER();
+    bool idle = (job->state == CRYPTO_JOB_STATE_IDLE);
+    if (idle) {
+        job->state = CRYPTO_JOB_STATE_QUEUED;
+        job->cancelled = false;
+        job->waiter = NULL;
+        job->result = HAL_ERROR_BUSY;
+        job->next = g_crypto_job.active;
+        g_crypto_job.active = job;
+    }
+    JOB_CRITICAL_EXIT();
+
+    if (!idle) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+#if defined(MCXA156_SERIES)
+    if (xQueueSend(g_crypto_job.queue, &job, 0) != pdPASS) {
+        JOB_CRITICAL_ENTER();
+        unlink_job(job);
+        job->state = CRYPTO_JOB_STATE_IDLE;
+        JOB_CRITICAL_EXIT();
+        return HAL_ERROR_BUSY;
+    }
+#else
+    // No task on the host: complete before returning
+    run_job(job);
+#endif
+
+    return HAL_SUCCESS;
+}
+
+hal_result_t crypto_job_wait(crypto_job_t* job, uint32_t timeout_ms) {
+    if (!job) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+#if defined(MCXA156_SERIES)
+    TickType_t start = xTaskGetTickCount();
+    TickType_t limit = (timeout_ms == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+
+    JOB_CRITICAL_ENTER();
+    if (job->state != CRYPTO_JOB_STATE_IDLE) {
+        job->waiter = xTaskGetCurrentTaskHandle();
+    }
+    JOB_CRITICAL_EXIT();
+
+    // Other notifications to this task only cause another look at the state
+    while (job->state != CRYPTO_JOB_STATE_IDLE) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+
+        if (limit != portMAX_DELAY && elapsed >= limit) {
+            JOB_CRITICAL_ENTER();
+            bool done = (job->state == CRYPTO_JOB_STATE_IDLE);
+            job->waiter = NULL;
+            JOB_CRITICAL_EXIT();
+            if (!done) {
+                return HAL_ERROR_TIMEOUT;
+            }
+            break;
+        }
+        (void)ulTaskNotifyTake(pdTRUE, limit == portMAX_DELAY ? portMAX_DELAY : limit - elapsed);
+    }
+#else
+    (void)timeout_ms;
+#endif
+
+    return job->result;
+}
+
+hal_result_t crypto_job_run(crypto_job_t* job) {
+    hal_result_t result = crypto_job_submit(job);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    return crypto_job_wait(job, UINT32_MAX);
+}
+
+uint32_t crypto_job_cancel(uint32_t owner) {
+    uint32_t count = 0;
+
+    if (owner == CRYPTO_JOB_NO_OWNER) {
+        return 0;
+    }
+
+    JOB_CRITICAL_ENTER();
+    for (crypto_job_t* job = g_crypto_job.active; job; job = job->next) {
+        if (job->owner == owner && !job->cancelled) {
+            job->cancelled = true;
+            count++;
+        }
+    }
+    JOB_CRITICAL_EXIT();
+
+    return count;
+}
@@ -0,0 +1,198 @@
+#ifndef CRYPTO_JOB_H
+#define CRYPTO_JOB_H
+
+/**
+ * @file crypto_job.h
+ * @brief Asynchronous Crypto Jobs on a Dedicated Task
+ * @author USB Key Authentication Team
+ * @date 2025-09-17
+ * @version 1.0
+ *
+ * crypto_hal_t calls are synchronous: a P-256 key generation holds the
+ * calling task for its whole duration. This module runs them on a crypto
+ * task instead. The caller fills a job descriptor, submits it and gets
+ * the result through a completion callback (run on the crypto task) or
+ * by blocking in crypto_job_wait(), which only suspends the calling task.
+ *
+ * Jobs carry an owner tag, the CTAPHID channel ID for CTAP requests.
+ * crypto_job_cancel() completes every queued job of an owner with
+ * HAL_ERROR_CANCELLED without running it; a job already running finishes,
+ * its output is discarded (generated keys are deleted) and it completes
+ * with HAL_ERROR_CANCELLED too. fido_hid_worker forwards CTAPHID_CANCEL
+ * here.
+ *
+ * Descriptors are caller-owned and must stay valid until completion.
+ * Nothing is allocated per job.
+ *
+ * On the host there is no task: crypto_job_submit() runs the job inline
+ * and completes it before returning.
+ *
+ * @warning The crypto backend is not thread-safe. While jobs run, other
+ *          tasks must not use the same crypto_hal_t directly; in the CTAP
+ *          flow the worker task waits for its jobs, which serializes them.
+ */
+
+#include "hal/interface/crypto_hal.h"
+#include "platform/com/transport/fido_hid_worker.h"
+
+/** @brief Crypto task priority (one below the worker, so below the USB task too) */
+#ifndef CRYPTO_JOB_TASK_PRIORITY
+#define CRYPTO_JOB_TASK_PRIORITY    (FIDO_WORKER_TASK_PRIORITY - 1U)
+#endif
+
+/** @brief Crypto task stack size in bytes (P-256 and Ed25519 need about 2 KB) */
+#ifndef CRYPTO_JOB_STACK_SIZE
+#define CRYPTO_JOB_STACK_SIZE       3072U
+#endif
+
+/** @brief Jobs that can be queued at once */
+#ifndef CRYPTO_JOB_QUEUE_LENGTH
+#define CRYPTO_JOB_QUEUE_LENGTH     4U
+#endif
+
+/** @brief Owner tag of jobs nobody cancels */
+#define CRYPTO_JOB_NO_OWNER         0U
+
+/**
+ * @brief Job operations, each mapping to one crypto_hal_t call
+ */
+typedef enum {
+    CRYPTO_JOB_GENERATE_KEY_PAIR = 0,   /**< generate_key_pair() */
+    CRYPTO_JOB_SIGN,                    /**< sign() */
+    CRYPTO_JOB_VERIFY,                  /**< verify() */
+    CRYPTO_JOB_HASH,                    /**< hash() */
+    CRYPTO_JOB_CALL                     /**< Any function, e.g. key agreement */
+} crypto_job_type_t;
+
+/**
+ * @brief Job lifecycle
+ */
+typedef enum {
+    CRYPTO_JOB_STATE_IDLE = 0,          /**< Not submitted, or completed */
+    CRYPTO_JOB_STATE_QUEUED,            /**< Waiting for the crypto task */
+    CRYPTO_JOB_STATE_RUNNING            /**< On the crypto task */
+} crypto_job_state_t;
+
+typedef struct crypto_job crypto_job_t;
+
+/**
+ * @brief Completion callback, runs on the crypto task
+ *
+ * The descriptor is still owned by the module here: read the result, do
+ * not resubmit it.
+ *
+ * @param job Completed job, result in job->result
+ */
+typedef void (*crypto_job_callback_t)(crypto_job_t* job);
+
+/**
+ * @brief Job descriptor
+ *
+ * Fill type, the matching params member, owner and optionally callback
+ * and context, then submit. The output buffers in params are written
+ * exactly as the crypto_hal_t call would write them.
+ */
+struct crypto_job {
+    crypto_job_type_t type;             /**< Operation */
+    union {
+        struct {
+            crypto_algorithm_t algorithm;
+            crypto_key_t* public_key;
+            crypto_key_t* private_key;
+        } generate_key_pair;            /**< CRYPTO_JOB_GENERATE_KEY_PAIR */
+        struct {
+            const crypto_key_t* private_key;
+            const uint8_t* data;
+            size_t data_length;
+            uint8_t* signature;
+            size_t* signature_length;
+        } sign;                         /**< CRYPTO_JOB_SIGN */
+        struct {
+            const crypto_key_t* public_key;
+            const uint8_t* data;
+            size_t data_length;
+            const uint8_t* signature;
+            size_t signature_length;
+        } verify;                       /**< CRYPTO_JOB_VERIFY */
+        struct {
+            crypto_hash_algorithm_t algorithm;
+            const uint8_t* data;
+            size_t data_length;
+            uint8_t* hash;
+            size_t* hash_length;
+        } hash;                         /**< CRYPTO_JOB_HASH */
+        struct {
+            hal_result_t (*function)(void* argument);
+            void* argument;
+        } call;                         /**< CRYPTO_JOB_CALL */
+    } params;
+    uint32_t owner;                     /**< Cancel tag, e.g. the CTAPHID CID */
+    crypto_job_callback_t callback;     /**< Completion callback, may be NULL */
+    void* context;                      /**< Free for the callback */
+
+    // Owned by the module from submit to completion
+    volatile hal_result_t result;       /**< Outcome, valid once IDLE again */
+    volatile crypto_job_state_t state;  /**< Lifecycle */
+    volatile bool cancelled;            /**< Cancel requested */
+    void* waiter;                       /**< Task blocked in crypto_job_wait() */
+    crypto_job_t* next;                 /**< Active job list link */
+};
+
+/**
+ * @brief Create the crypto task and its queue
+ *
+ * @param crypto Initialized crypto HAL the jobs run on
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM NULL crypto
+ * @retval HAL_ERROR_INVALID_STATE Already initialized
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Task or queue creation failed
+ */
+hal_result_t crypto_job_init(crypto_hal_t* crypto);
+
+/**
+ * @brief Queue a job for the crypto task
+ *
+ * @param job Filled descriptor, not currently submitted
+ * @return HAL_SUCCESS when queued (the outcome comes with completion),
+ *         error code otherwise, in which case the job does not complete
+ * @retval HAL_ERROR_INVALID_PARAM NULL job or unknown type
+ * @retval HAL_ERROR_NOT_INITIALIZED crypto_job_init() not called
+ * @retval HAL_ERROR_INVALID_STATE Job already submitted
+ * @retval HAL_ERROR_BUSY Queue full
+ */
+hal_result_t crypto_job_submit(crypto_job_t* job);
+
+/**
+ * @brief Block the calling task until a submitted job completes
+ *
+ * Uses the calling task's notification. Call it from the submitting
+ * side only, at most one waiter per job; it may be called after the job
+ * completed.
+ *
+ * @param job Submitted job
+ * @param timeout_ms Longest wait, UINT32_MAX for no limit
+ * @return The job's result, or HAL_ERROR_TIMEOUT (the job keeps running;
+ *         cancel it or wait again before reusing the descriptor)
+ */
+hal_result_t crypto_job_wait(crypto_job_t* job, uint32_t timeout_ms);
+
+/**
+ * @brief Submit and wait
+ *
+ * @param job Filled descriptor
+ * @return The job's result, or the error of crypto_job_submit()
+ */
+hal_result_t crypto_job_run(crypto_job_t* job);
+
+/**
+ * @brief Cancel every queued or running job of an owner
+ *
+ * Safe from any task and from interrupts; jobs complete with
+ * HAL_ERROR_CANCELLED on the crypto task.
+ *
+ * @param owner Owner tag, CRYPTO_JOB_NO_OWNER cancels nothing
+ * @return Number of jobs flagged
+ */
+uint32_t crypto_job_cancel(uint32_t owner);
+
+#endif // CRYPTO_JOB_H
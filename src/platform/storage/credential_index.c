@@ -0,0 +1,56 @@
+/**
+ * @file credential_index.c
+ * @brief Resident Credential Lookup by rpIdHash and Credential ID
+ * @author USB Key Authentication Team
+ * @date 2025-09-21
+ * @version 1.0
+ */
+
+#include "credential_index.h"
+
+#define FNV_OFFSET_BASIS    0x811C9DC5UL    /**< FNV-1a 32-bit */
+#define FNV_PRIME           0x01000193UL    /**< FNV-1a 32-bit */
+
+static uint16_t rp_group(const uint8_t* rp_id_hash) {
+    return (uint16_t)((rp_id_hash[0] << 8) | rp_id_hash[1]);
+}
+
+uint32_t credential_index_key(const uint8_t* rp_id_hash, const uint8_t* credential_id,
+                              size_t length) {
+    if (!rp_id_hash || (!credential_id && length != 0)) {
+        return 0;
+    }
+
+    uint32_t h = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < length; i++) {
+        h = (h ^ credential_id[i]) * FNV_PRIME;
+    }
+
+    return ((uint32_t)rp_group(rp_id_hash) << 16) | ((h ^ (h >> 16)) & 0xFFFFU);
+}
+
+uint32_t credential_index_find_rp(const uint8_t* rp_id_hash, uint32_t* record_ids,
+                                  uint32_t max_ids) {
+    if (!rp_id_hash) {
+        return 0;
+    }
+
+    return credential_log_find_group(rp_group(rp_id_hash), record_ids, max_ids);
+}
+
+bool credential_index_find_id(const uint8_t* rp_id_hash, const uint8_t* credential_id,
+                              size_t length, uint32_t* record_id) {
+    if (!rp_id_hash || !credential_id || length == 0) {
+        return false;
+    }
+
+    uint32_t key = credential_index_key(rp_id_hash, credential_id, length);
+    if (!credential_log_contains(key)) {
+        return false;
+    }
+
+    if (record_id) {
+        *record_id = key;
+    }
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef CREDENTIAL_INDEX_H
+#define CREDENTIAL_INDEX_H
+
+/**
+ * @file credential_index.h
+ * @brief Resident Credential Lookup by rpIdHash and Credential ID
+ * @author USB Key Authentication Team
+ * @date 2025-09-21
+ * @version 1.0
+ *
+ * Names resident credentials in the credential log so GetAssertion finds
+ * them from the log's RAM table instead of scanning flash:
+ * @code
+ * record_id = rpIdHash[0..1] (16, big-endian) || fold16(FNV-1a(credential ID)) (16)
+ * @endcode
+ * The rpIdHash prefix is the record's group, so all credentials of a
+ * relying party share one probe run of the table. A discoverable lookup is
+ * credential_log_find_group(), an allowList entry is
+ * credential_log_contains(). Both cost the same with 25 or 1000 credentials
+ * stored, and a miss reads no flash.
+ *
+ * Both keys are truncated, so a hit is a candidate: read the record and
+ * compare the full rpIdHash and credential ID kept in its payload. A
+ * relying party sharing the 16-bit prefix costs one extra record read.
+ * Two credentials of one relying party must not share a member tag: the
+ * authenticator picks resident credential IDs, so on a collision
+ * (credential_index_key() already live) it draws another ID.
+ *
+ * @warning Not thread-safe; call from the CTAP task only.
+ */
+
+#include "credential_log.h"
+
+/** @brief rpIdHash size (SHA-256) */
+#define CREDENTIAL_INDEX_RP_ID_HASH_SIZE    32U
+
+/**
+ * @brief Record ID of a resident credential
+ *
+ * @param rp_id_hash CREDENTIAL_INDEX_RP_ID_HASH_SIZE bytes
+ * @param credential_id Credential ID
+ * @param length Credential ID size
+ * @return Record ID for credential_log_write() and credential_log_read()
+ */
+uint32_t credential_index_key(const uint8_t* rp_id_hash, const uint8_t* credential_id,
+                              size_t length);
+
+/**
+ * @brief Candidate credentials of a relying party (discoverable lookup)
+ *
+ * @param rp_id_hash CREDENTIAL_INDEX_RP_ID_HASH_SIZE bytes
+ * @param record_ids Output record IDs
+ * @param max_ids Capacity of record_ids
+ * @return Candidates found; only the first max_ids are written
+ */
+uint32_t credential_index_find_rp(const uint8_t* rp_id_hash, uint32_t* record_ids,
+                                  uint32_t max_ids);
+
+/**
+ * @brief Candidate credential for an allowList entry
+ *
+ * @param rp_id_hash CREDENTIAL_INDEX_RP_ID_HASH_SIZE bytes
+ * @param credential_id Credential ID from the allowList
+ * @param length Credential ID size
+ * @param record_id Output record ID, may be NULL
+ * @return true if a resident credential may match
+ */
+bool credential_index_find_id(const uint8_t* rp_id_hash, const uint8_t* credential_id,
+                              size_t length, uint32_t* record_id);
+
+#endif // CREDENTIAL_INDEX_H
@@ -0,0 +1,356 @@
+/**
+ * @file credential_index_bench.c
+ * @brief Host-side benchmark of resident credential lookups
+ * @author USB Key Authentication Team
+ * @date 2025-09-21
+ * @version 1.0
+ *
+ * Stores resident credentials for a set of relying parties in
+ * credential_log.h on a RAM flash shaped like the MCXA156 internal flash
+ * (8 KB sectors, 128-byte pages), named by credential_index.h. It then
+ * times the two GetAssertion lookups, each for a hit and for a miss:
+ * - discoverable: every credential of an rpIdHash
+ * - allowList: one credential ID of an rpIdHash
+ * A hit reads each candidate record and compares its rpIdHash and
+ * credential ID, as the CTAP layer would. The flash reads are counted in
+ * the HAL, so the output shows what each lookup costs in flash traffic,
+ * next to a scan of every record.
+ *
+ * Build and run on Linux from the repository root:
+ * @code
+ * gcc -std=c11 -O2 -DCREDENTIAL_LOG_MAX_RECORDS=2048 -DCREDENTIAL_LOG_MAX_SEGMENTS=64 \
+ *     -I src -I src/platform/storage \
+ *     src/platform/storage/credential_index_bench.c src/platform/storage/credential_index.c \
+ *     src/platform/storage/credential_log.c src/platform/storage/storage_util.c \
+ *     src/platform/storage/storage_bench_flash.c -o credential_index_bench
+ * ./credential_index_bench [-n credentials] [-r relying_parties] [-l lookups]
+ * @endcode
+ *
+ * Options:
+ * - -n  Resident credentials stored (default 1000)
+ * - -r  Relying parties they belong to (default 400)
+ * - -l  Lookups of each kind (default 20000)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "credential_index.h"
+#include "storage_bench_flash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FLASH_SIZE        (512U * 1024U)  /**< RAM flash, 64 segments */
+#define BENCH_SECTOR_SIZE       8192U           /**< Erase sector */
+#define BENCH_PAGE_SIZE         128U            /**< Program page */
+#define BENCH_ID_SIZE           16U             /**< Resident credential ID */
+#define BENCH_RECORD_SIZE       96U             /**< Payload: one page with the header */
+#define BENCH_MAX_CREDENTIALS   4096U           /**< Largest -n */
+#define BENCH_MAX_CANDIDATES    64U             /**< Records one RP lookup may return */
+
+// ============================================================================
+// Workload
+// ============================================================================
+
+/**
+ * @brief A stored credential, as the CTAP layer knows it
+ */
+typedef struct {
+    uint32_t rp;                            /**< Relying party index */
+    uint8_t id[BENCH_ID_SIZE];              /**< Credential ID */
+} bench_credential_t;
+
+static bench_flash_t* g_flash;
+static bench_credential_t g_credentials[BENCH_MAX_CREDENTIALS];
+static uint8_t (*g_rp_hashes)[CREDENTIAL_INDEX_RP_ID_HASH_SIZE];
+
+static void random_bytes(uint8_t* out, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        out[i] = (uint8_t)bench_random();
+    }
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/**
+ * @brief Payload: rpIdHash || credential ID length || credential ID || key material
+ */
+static void record_for(uint8_t* record, const uint8_t* rp_id_hash, const uint8_t* id) {
+    memcpy(record, rp_id_hash, CREDENTIAL_INDEX_RP_ID_HASH_SIZE);
+    record[CREDENTIAL_INDEX_RP_ID_HASH_SIZE] = BENCH_ID_SIZE;
+    memcpy(&record[CREDENTIAL_INDEX_RP_ID_HASH_SIZE + 1U], id, BENCH_ID_SIZE);
+    random_bytes(&record[CREDENTIAL_INDEX_RP_ID_HASH_SIZE + 1U + BENCH_ID_SIZE],
+                 BENCH_RECORD_SIZE - CREDENTIAL_INDEX_RP_ID_HASH_SIZE - 1U - BENCH_ID_SIZE);
+}
+
+/**
+ * @brief Read a candidate and check it belongs to the relying party (and ID)
+ */
+static bool confirm(uint32_t record_id, const uint8_t* rp_id_hash, const uint8_t* id) {
+    uint8_t record[BENCH_RECORD_SIZE];
+    size_t length;
+    if (credential_log_read(record_id, record, sizeof(record), &length) != HAL_SUCCESS ||
+        memcmp(record, rp_id_hash, CREDENTIAL_INDEX_RP_ID_HASH_SIZE) != 0) {
+        return false;
+    }
+    return !id || (record[CREDENTIAL_INDEX_RP_ID_HASH_SIZE] == BENCH_ID_SIZE &&
+                   memcmp(&record[CREDENTIAL_INDEX_RP_ID_HASH_SIZE + 1U], id,
+                          BENCH_ID_SIZE) == 0);
+}
+
+/**
+ * @brief Discoverable lookup: credentials of an rpIdHash that check out
+ */
+static uint32_t lookup_rp(const uint8_t* rp_id_hash) {
+    uint32_t candidates[BENCH_MAX_CANDIDATES];
+    uint32_t found = credential_index_find_rp(rp_id_hash, candidates, BENCH_MAX_CANDIDATES);
+    uint32_t matches = 0;
+    for (uint32_t i = 0; i < found && i < BENCH_MAX_CANDIDATES; i++) {
+        matches += confirm(candidates[i], rp_id_hash, NULL) ? 1U : 0U;
+    }
+    return matches;
+}
+
+/**
+ * @brief allowList lookup: whether a credential ID is stored for an rpIdHash
+ */
+static bool lookup_id(const uint8_t* rp_id_hash, const uint8_t* id) {
+    uint32_t record_id;
+    return credential_index_find_id(rp_id_hash, id, BENCH_ID_SIZE, &record_id) &&
+           confirm(record_id, rp_id_hash, id);
+}
+
+/**
+ * @brief Counts of one lookup kind
+ */
+typedef struct {
+    double us;                  /**< Total time */
+    uint64_t reads;             /**< HAL reads */
+    uint64_t bytes;             /**< Bytes read */
+    uint32_t errors;            /**< Wrong answers */
+} bench_result_t;
+
+static void report(const char* name, const bench_result_t* result, uint32_t lookups) {
+    printf("  %-22s %8.3f us  %6.3f reads  %8.1f bytes read per lookup%s\n", name,
+           result->us / lookups, (double)result->reads / lookups,
+           (double)result->bytes / lookups, result->errors ? "  WRONG" : "");
+}
+
+/**
+ * @brief Scan state: the rpIdHash looked for and the records that match
+ */
+typedef struct {
+    const uint8_t* rp_id_hash;  /**< Relying party */
+    uint32_t matches;           /**< Its records seen */
+} bench_scan_t;
+
+static bool scan_visitor(uint32_t record_id, const uint8_t* data, size_t length,
+                         void* context) {
+    bench_scan_t* scan = context;
+    (void)record_id;
+    if (length >= CREDENTIAL_INDEX_RP_ID_HASH_SIZE &&
+        memcmp(data, scan->rp_id_hash, CREDENTIAL_INDEX_RP_ID_HASH_SIZE) == 0) {
+        scan->matches++;
+    }
+    return true;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    uint32_t credentials = 1000;
+    uint32_t relying_parties = 400;
+    uint32_t lookups = 20000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            credentials = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            relying_parties = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            lookups = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-n credentials] [-r relying_parties] [-l lookups]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (credentials == 0 || credentials > BENCH_MAX_CREDENTIALS ||
+        credentials > CREDENTIAL_LOG_MAX_RECORDS || relying_parties == 0 ||
+        relying_parties > BENCH_MAX_CREDENTIALS || lookups == 0) {
+        fprintf(stderr, "need 1..%u credentials and relying parties, one lookup\n",
+                (unsigned)(CREDENTIAL_LOG_MAX_RECORDS < BENCH_MAX_CREDENTIALS ?
+                           CREDENTIAL_LOG_MAX_RECORDS : BENCH_MAX_CREDENTIALS));
+        return 2;
+    }
+
+    g_rp_hashes = calloc(relying_parties, sizeof(*g_rp_hashes));
+    if (!g_rp_hashes) {
+        return 1;
+    }
+    for (uint32_t i = 0; i < relying_parties; i++) {
+        random_bytes(g_rp_hashes[i], CREDENTIAL_INDEX_RP_ID_HASH_SIZE);
+    }
+
+    const bench_flash_geometry_t geometry = {
+        .size = BENCH_FLASH_SIZE,
+        .sector_size = BENCH_SECTOR_SIZE,
+        .page_size = BENCH_PAGE_SIZE,
+    };
+    g_flash = bench_flash_init(&geometry);
+    if (!g_flash) {
+        return 1;
+    }
+    uint32_t size = BENCH_SECTOR_SIZE * CREDENTIAL_LOG_MAX_SEGMENTS;
+    if (size > BENCH_FLASH_SIZE) {
+        size = BENCH_FLASH_SIZE;
+    }
+    if (credential_log_mount(bench_flash_hal(), 0, size, true) != HAL_SUCCESS) {
+        fprintf(stderr, "mount failed\n");
+        return 1;
+    }
+
+    // MakeCredential with rk: draw another ID while the record ID is taken
+    uint32_t redraws = 0;
+    for (uint32_t i = 0; i < credentials; i++) {
+        bench_credential_t* credential = &g_credentials[i];
+        const uint8_t* rp_id_hash;
+        do {
+            credential->rp = bench_random() % relying_parties;
+            rp_id_hash = g_rp_hashes[credential->rp];
+            random_bytes(credential->id, BENCH_ID_SIZE);
+        } while (credential_log_contains(
+                     credential_index_key(rp_id_hash, credential->id, BENCH_ID_SIZE)) &&
+                 ++redraws);
+
+        uint8_t record[BENCH_RECORD_SIZE];
+        record_for(record, rp_id_hash, credential->id);
+        hal_result_t result = credential_log_write(
+            credential_index_key(rp_id_hash, credential->id, BENCH_ID_SIZE), record,
+            sizeof(record));
+        if (result != HAL_SUCCESS) {
+            fprintf(stderr, "write %u failed: %d (region of %u KB)\n", (unsigned)i, (int)result,
+                    (unsigned)(size / 1024U));
+            return 1;
+        }
+    }
+
+    // Mount replays the log and rebuilds the table
+    credential_log_unmount();
+    g_flash->reads = 0;
+    g_flash->bytes_read = 0;
+    double start = now_us();
+    if (credential_log_mount(bench_flash_hal(), 0, size, false) != HAL_SUCCESS) {
+        fprintf(stderr, "remount failed\n");
+        return 1;
+    }
+    double mount_us = now_us() - start;
+    uint64_t mount_bytes = g_flash->bytes_read;
+
+    uint32_t per_rp[BENCH_MAX_CREDENTIALS] = { 0 };
+    uint32_t largest = 0;
+    for (uint32_t i = 0; i < credentials; i++) {
+        if (++per_rp[g_credentials[i].rp] > largest) {
+            largest = per_rp[g_credentials[i].rp];
+        }
+    }
+    if (largest > BENCH_MAX_CANDIDATES) {
+        fprintf(stderr, "an RP holds %u credentials, more than %u\n", (unsigned)largest,
+                BENCH_MAX_CANDIDATES);
+        return 1;
+    }
+
+    printf("credential_index: %u credentials over %u relying parties, %u lookups each\n",
+           (unsigned)credentials, (unsigned)relying_parties, (unsigned)lookups);
+    printf("  table:        %u slots, %u bytes of RAM; %u ID redraws at creation\n",
+           (unsigned)CREDENTIAL_LOG_TABLE_SLOTS, (unsigned)(CREDENTIAL_LOG_TABLE_SLOTS * 6U),
+           (unsigned)redraws);
+    printf("  mount:        %8.1f us, %llu bytes read\n", mount_us,
+           (unsigned long long)mount_bytes);
+
+    bench_result_t rp_hit = { 0 }, rp_miss = { 0 }, id_hit = { 0 }, id_miss = { 0 };
+    bench_result_t scan = { 0 };
+    uint8_t unknown[CREDENTIAL_INDEX_RP_ID_HASH_SIZE];
+    uint8_t id[BENCH_ID_SIZE];
+
+    for (uint32_t n = 0; n < lookups; n++) {
+        const bench_credential_t* credential = &g_credentials[bench_random() % credentials];
+        const uint8_t* rp_id_hash = g_rp_hashes[credential->rp];
+        uint64_t reads = g_flash->reads;
+        uint64_t bytes = g_flash->bytes_read;
+
+        start = now_us();
+        uint32_t matches = lookup_rp(rp_id_hash);
+        rp_hit.us += now_us() - start;
+        rp_hit.errors += (matches != per_rp[credential->rp]) ? 1U : 0U;
+        rp_hit.reads += g_flash->reads - reads;
+        rp_hit.bytes += g_flash->bytes_read - bytes;
+
+        reads = g_flash->reads;
+        bytes = g_flash->bytes_read;
+        random_bytes(unknown, sizeof(unknown));
+        start = now_us();
+        matches = lookup_rp(unknown);
+        rp_miss.us += now_us() - start;
+        rp_miss.errors += (matches != 0) ? 1U : 0U;
+        rp_miss.reads += g_flash->reads - reads;
+        rp_miss.bytes += g_flash->bytes_read - bytes;
+
+        reads = g_flash->reads;
+        bytes = g_flash->bytes_read;
+        start = now_us();
+        bool found = lookup_id(rp_id_hash, credential->id);
+        id_hit.us += now_us() - start;
+        id_hit.errors += found ? 0U : 1U;
+        id_hit.reads += g_flash->reads - reads;
+        id_hit.bytes += g_flash->bytes_read - bytes;
+
+        // An allowList ID from another authenticator, for a known RP
+        reads = g_flash->reads;
+        bytes = g_flash->bytes_read;
+        random_bytes(id, sizeof(id));
+        start = now_us();
+        found = lookup_id(rp_id_hash, id);
+        id_miss.us += now_us() - start;
+        id_miss.errors += found ? 1U : 0U;
+        id_miss.reads += g_flash->reads - reads;
+        id_miss.bytes += g_flash->bytes_read - bytes;
+    }
+
+    // Without the index: read every record to answer one lookup
+    uint32_t scans = (credentials < 100U) ? credentials : 100U;
+    for (uint32_t n = 0; n < scans; n++) {
+        uint64_t reads = g_flash->reads;
+        uint64_t bytes = g_flash->bytes_read;
+        bench_scan_t visit = { .rp_id_hash = g_rp_hashes[g_credentials[n].rp] };
+        start = now_us();
+        if (credential_log_foreach(scan_visitor, &visit) != HAL_SUCCESS ||
+            visit.matches != per_rp[g_credentials[n].rp]) {
+            scan.errors++;
+        }
+        scan.us += now_us() - start;
+        scan.reads += g_flash->reads - reads;
+        scan.bytes += g_flash->bytes_read - bytes;
+    }
+
+    report("discoverable hit:", &rp_hit, lookups);
+    report("discoverable miss:", &rp_miss, lookups);
+    report("allowList hit:", &id_hit, lookups);
+    report("allowList miss:", &id_miss, lookups);
+    report("scan every record:", &scan, scans);
+
+    bool pass = !rp_hit.errors && !rp_miss.errors && !id_hit.errors && !id_miss.errors &&
+                !scan.errors;
+    credential_log_unmount();
+    bench_flash_deinit();
+    free(g_rp_hashes);
+    printf("%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,847 @@
+/**
+ * @file credential_log.c
+ * @brief Log-Structured Record Store for the CREDENTIALS Region
+ * @author USB Key Authentication Team
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ * Locations are byte offsets from the region start. Records are page
+ * aligned, so the table keeps a 16-bit page index: 6 bytes per slot in two
+ * parallel arrays. Page 0 is always a segment header, so index 0 marks an
+ * empty slot.
+ *
+ * The table is Robin Hood open addressing with linear probing and
+ * backward-shift deletion, about 1.125 slots per record. A record's home
+ * slot is a hash of its group (the upper 16 bits of its ID). Robin Hood
+ * keeps every probe run ordered by home slot, so the records of one group
+ * sit next to each other, and a lookup for a missing ID or group stops as
+ * soon as it meets an entry closer to its own home than the probe is.
+ */
+
+#include "credential_log.h"
+#include "storage_util.h"
+#include <string.h>
+
+#define RECORD_MAGIC            0x4352U         /**< "CR" */
+#define RECORD_TYPE_DATA        0x01U           /**< Payload record */
+#define RECORD_TYPE_TOMBSTONE   0x02U           /**< Deletes the record ID */
+#define RECORD_HEADER_SIZE      12U             /**< magic .. ~length */
+#define RECORD_CRC_SIZE         4U              /**< Trailing CRC-32 */
+
+#define SEGMENT_MAGIC           0x474C5243UL    /**< "CRLG" */
+#define SEGMENT_VERSION         1U              /**< Layout version */
+#define SEGMENT_HEADER_SIZE     16U             /**< magic, sequence, version, CRC */
+
+#define NO_SEGMENT              0xFFFFFFFFUL    /**< No head or tail yet */
+#define EMPTY_LOCATION          0U              /**< No location */
+#define EMPTY_PAGE              0U              /**< Free table slot */
+#define NO_SLOT                 0xFFFFFFFFUL    /**< Record ID not in the table */
+#define MAX_PAGES               0xFFFFU         /**< Pages a 16-bit index can reach */
+#define TABLE_SLOTS             CREDENTIAL_LOG_TABLE_SLOTS
+
+/** @brief Record buffer, the largest record at the largest page size */
+#define RECORD_BUFFER_SIZE \
+    ((RECORD_HEADER_SIZE + CREDENTIAL_LOG_MAX_PAYLOAD + RECORD_CRC_SIZE + \
+      CREDENTIAL_LOG_MAX_PAGE_SIZE - 1U) / CREDENTIAL_LOG_MAX_PAGE_SIZE * \
+     CREDENTIAL_LOG_MAX_PAGE_SIZE)
+
+/**
+ * @brief Result of reading a record from flash
+ */
+typedef enum {
+    RECORD_VALID = 0,       /**< Header and CRC check out */
+    RECORD_END,             /**< Erased space: end of the segment's log */
+    RECORD_CORRUPT          /**< Torn or damaged: the segment ends here */
+} record_status_t;
+
+/**
+ * @brief Decoded record header
+ */
+typedef struct {
+    uint8_t type;           /**< RECORD_TYPE_* */
+    uint32_t record_id;     /**< Record ID */
+    uint16_t length;        /**< Payload size */
+    uint32_t size;          /**< Flash footprint, page aligned */
+} record_info_t;
+
+/**
+ * @brief Store state
+ */
+typedef struct {
+    storage_hal_t* hal;                                 /**< Storage HAL */
+    uint32_t base_address;                              /**< Region start */
+    uint32_t segment_size;                              /**< Erase sector */
+    uint32_t segment_count;                             /**< Segments in the region */
+    uint32_t page_size;                                 /**< Record alignment */
+    uint32_t head;                                      /**< Segment appended to */
+    uint32_t head_offset;                               /**< Next free byte in head */
+    uint32_t tail;                                      /**< Oldest segment in use */
+    uint32_t next_sequence;                             /**< Sequence of the next segment */
+    uint32_t free_segments;                             /**< Segments with sequence 0 */
+    uint32_t live_records;                              /**< Occupied table slots */
+    bool mounted;                                       /**< Store usable */
+    uint32_t sequence[CREDENTIAL_LOG_MAX_SEGMENTS];     /**< Segment sequence, 0 if free */
+    uint32_t live[CREDENTIAL_LOG_MAX_SEGMENTS];         /**< Live record bytes per segment */
+    bool erased[CREDENTIAL_LOG_MAX_SEGMENTS];           /**< Free and known to be erased */
+    credential_log_stats_t stats;                       /**< Counters */
+} credential_log_state_t;
+
+static credential_log_state_t g_log;
+static uint32_t g_record_ids[TABLE_SLOTS];     /**< Record ID per slot */
+static uint16_t g_record_pages[TABLE_SLOTS];   /**< Page of the newest version, 0 if free */
+static uint8_t g_buffer[RECORD_BUFFER_SIZE];
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+static uint32_t record_size(uint32_t length) {
+    uint32_t size = RECORD_HEADER_SIZE + length + RECORD_CRC_SIZE;
+    return (size + g_log.page_size - 1U) / g_log.page_size * g_log.page_size;
+}
+
+static uint32_t segment_of(uint32_t location) {
+    return location / g_log.segment_size;
+}
+
+// ============================================================================
+// Flash Access
+// ============================================================================
+
+static hal_result_t flash_read(uint32_t location, uint8_t* buffer, size_t length) {
+    return g_log.hal->read(g_log.base_address + location, buffer, length);
+}
+
+static hal_result_t flash_program(uint32_t location, const uint8_t* data, size_t length) {
+    g_log.stats.programs++;
+    g_log.stats.bytes_programmed += (uint32_t)length;
+    return g_log.hal->write(g_log.base_address + location, data, length);
+}
+
+static hal_result_t segment_erase(uint32_t segment) {
+    g_log.stats.erases++;
+    hal_result_t result = g_log.hal->erase(g_log.base_address + segment * g_log.segment_size,
+                                           g_log.segment_size);
+    g_log.erased[segment] = (result == HAL_SUCCESS);
+    return result;
+}
+
+/**
+ * @brief Read and check the record at a location into g_buffer
+ *
+ * @param location Region offset of the record
+ * @param info Output header fields
+ * @return Record status
+ */
+static record_status_t read_record(uint32_t location, record_info_t* info) {
+    uint32_t room = g_log.segment_size - (location % g_log.segment_size);
+    if (room < RECORD_HEADER_SIZE + RECORD_CRC_SIZE) {
+        return RECORD_END;
+    }
+
+    if (flash_read(location, g_buffer, RECORD_HEADER_SIZE) != HAL_SUCCESS) {
+        return RECORD_CORRUPT;
+    }
+
+    bool erased = true;
+    for (uint32_t i = 0; i < RECORD_HEADER_SIZE; i++) {
+        erased = erased && (g_buffer[i] == 0xFF);
+    }
+    if (erased) {
+        return RECORD_END;
+    }
+
+    info->type = g_buffer[2];
+    info->record_id = storage_get_u32(&g_buffer[4]);
+    info->length = storage_get_u16(&g_buffer[8]);
+    if (storage_get_u16(&g_buffer[0]) != RECORD_MAGIC || g_buffer[3] != 0xFF ||
+        (uint32_t)storage_get_u16(&g_buffer[10]) + info->length != 0xFFFFU ||
+        (info->type != RECORD_TYPE_DATA && info->type != RECORD_TYPE_TOMBSTONE) ||
+        info->length > CREDENTIAL_LOG_MAX_PAYLOAD ||
+        (info->type == RECORD_TYPE_TOMBSTONE && info->length != 0)) {
+        return RECORD_CORRUPT;
+    }
+
+    info->size = record_size(info->length);
+    if (info->size > room) {
+        return RECORD_CORRUPT;
+    }
+
+    uint32_t body = RECORD_HEADER_SIZE + info->length;
+    if (flash_read(location + RECORD_HEADER_SIZE, &g_buffer[RECORD_HEADER_SIZE],
+                   info->size - RECORD_HEADER_SIZE) != HAL_SUCCESS ||
+        storage_get_u32(&g_buffer[body]) != storage_crc32(g_buffer, body)) {
+        return RECORD_CORRUPT;
+    }
+
+    return RECORD_VALID;
+}
+
+/**
+ * @brief Flash footprint of the record at a location, from its header
+ */
+static uint32_t stored_size(uint32_t location) {
+    uint8_t header[RECORD_HEADER_SIZE];
+    if (flash_read(location, header, sizeof(header)) != HAL_SUCCESS) {
+        return 0;
+    }
+    return record_size(storage_get_u16(&header[8]));
+}
+
+// ============================================================================
+// Record Table
+// ============================================================================
+
+/**
+ * @brief Home slot of a record: a hash of its group, scaled to the table
+ */
+static uint32_t home_of(uint32_t record_id) {
+    uint32_t h = (record_id >> 16) * 0x9E3779B1UL;
+    h ^= h >> 15;
+    return (uint32_t)(((uint64_t)h * TABLE_SLOTS) >> 32);
+}
+
+static uint32_t next_slot(uint32_t slot) {
+    return (slot + 1U == TABLE_SLOTS) ? 0U : slot + 1U;
+}
+
+/**
+ * @brief How far the entry in a slot sits from its home
+ */
+static uint32_t displacement(uint32_t slot) {
+    uint32_t home = home_of(g_record_ids[slot]);
+    return (slot >= home) ? slot - home : slot + TABLE_SLOTS - home;
+}
+
+static uint32_t slot_location(uint32_t slot) {
+    return (uint32_t)g_record_pages[slot] * g_log.page_size;
+}
+
+/**
+ * @brief Find a record ID, from RAM only
+ *
+ * @return Its slot, NO_SLOT if it is not live
+ */
+static uint32_t table_find(uint32_t record_id) {
+    uint32_t slot = home_of(record_id);
+
+    // The table always has free slots, so the probe ends
+    for (uint32_t probe = 0;; probe++) {
+        if (g_record_pages[slot] == EMPTY_PAGE || displacement(slot) < probe) {
+            return NO_SLOT;
+        }
+        if (g_record_ids[slot] == record_id) {
+            return slot;
+        }
+        slot = next_slot(slot);
+    }
+}
+
+/**
+ * @brief Point a record ID at a new location
+ *
+ * @return Previous location, EMPTY_LOCATION if the ID was new
+ */
+static uint32_t table_put(uint32_t record_id, uint32_t location) {
+    uint16_t page = (uint16_t)(location / g_log.page_size);
+    uint32_t slot = table_find(record_id);
+    if (slot != NO_SLOT) {
+        uint32_t previous = slot_location(slot);
+        g_record_pages[slot] = page;
+        return previous;
+    }
+
+    // Robin Hood: take the slot of any entry closer to its home, and move it on
+    slot = home_of(record_id);
+    for (uint32_t probe = 0; g_record_pages[slot] != EMPTY_PAGE; probe++) {
+        uint32_t resident = displacement(slot);
+        if (resident < probe) {
+            uint32_t id = g_record_ids[slot];
+            uint16_t displaced = g_record_pages[slot];
+            g_record_ids[slot] = record_id;
+            g_record_pages[slot] = page;
+            record_id = id;
+            page = displaced;
+            probe = resident;
+        }
+        slot = next_slot(slot);
+    }
+
+    g_record_ids[slot] = record_id;
+    g_record_pages[slot] = page;
+    g_log.live_records++;
+    return EMPTY_LOCATION;
+}
+
+/**
+ * @brief Drop a record ID
+ *
+ * @return Its location, EMPTY_LOCATION if it was not there
+ */
+static uint32_t table_remove(uint32_t record_id) {
+    uint32_t hole = table_find(record_id);
+    if (hole == NO_SLOT) {
+        return EMPTY_LOCATION;
+    }
+
+    uint32_t location = slot_location(hole);
+
+    // Shift the rest of the probe run back one slot, up to an entry at home
+    for (uint32_t slot = next_slot(hole);
+         g_record_pages[slot] != EMPTY_PAGE && displacement(slot) != 0; slot = next_slot(slot)) {
+        g_record_ids[hole] = g_record_ids[slot];
+        g_record_pages[hole] = g_record_pages[slot];
+        hole = slot;
+    }
+
+    g_record_pages[hole] = EMPTY_PAGE;
+    g_log.live_records--;
+    return location;
+}
+
+/**
+ * @brief Apply a record to the table and the live byte counts
+ */
+static void apply_record(const record_info_t* info, uint32_t location) {
+    uint32_t previous;
+
+    if (info->type == RECORD_TYPE_DATA) {
+        previous = table_put(info->record_id, location);
+        g_log.live[segment_of(location)] += info->size;
+    } else {
+        previous = table_remove(info->record_id);
+    }
+
+    if (previous != EMPTY_LOCATION) {
+        g_log.live[segment_of(previous)] -= stored_size(previous);
+    }
+}
+
+// ============================================================================
+// Segments
+// ============================================================================
+
+static uint32_t segment_end(uint32_t segment) {
+    return (segment == g_log.head) ? g_log.head_offset : g_log.segment_size;
+}
+
+static uint32_t segment_garbage(uint32_t segment) {
+    return segment_end(segment) - g_log.page_size - g_log.live[segment];
+}
+
+static void find_tail(void) {
+    g_log.tail = NO_SEGMENT;
+    for (uint32_t i = 0; i < g_log.segment_count; i++) {
+        if (g_log.sequence[i] != 0 &&
+            (g_log.tail == NO_SEGMENT || g_log.sequence[i] < g_log.sequence[g_log.tail])) {
+            g_log.tail = i;
+        }
+    }
+}
+
+/**
+ * @brief Close the head and start the next free segment
+ *
+ * Takes reserve segments too; callers decide whether they may.
+ */
+static hal_result_t open_segment(void) {
+    uint32_t start = (g_log.head == NO_SEGMENT) ? 0 : g_log.head + 1U;
+    uint32_t segment = NO_SEGMENT;
+
+    for (uint32_t i = 0; i < g_log.segment_count; i++) {
+        uint32_t candidate = (start + i) % g_log.segment_count;
+        if (g_log.sequence[candidate] == 0) {
+            segment = candidate;
+            break;
+        }
+    }
+    if (segment == NO_SEGMENT) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    if (!g_log.erased[segment]) {
+        hal_result_t result = segment_erase(segment);
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    }
+
+    uint32_t location = segment * g_log.segment_size;
+    memset(g_buffer, 0xFF, g_log.page_size);
+    storage_put_u32(&g_buffer[0], SEGMENT_MAGIC);
+    storage_put_u32(&g_buffer[4], g_log.next_sequence);
+    storage_put_u32(&g_buffer[8], SEGMENT_VERSION);
+    storage_put_u32(&g_buffer[12], storage_crc32(g_buffer, 12));
+
+    g_log.erased[segment] = false;
+    hal_result_t result = flash_program(location, g_buffer, g_log.page_size);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    g_log.sequence[segment] = g_log.next_sequence++;
+    g_log.live[segment] = 0;
+    g_log.free_segments--;
+    g_log.head = segment;
+    g_log.head_offset = g_log.page_size;
+    if (g_log.tail == NO_SEGMENT) {
+        g_log.tail = segment;
+    }
+
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Program a record held in g_buffer at the head
+ *
+ * The caller has made room: opening a segment here would overwrite g_buffer.
+ *
+ * @param size Record footprint
+ * @param location Output region offset
+ */
+static hal_result_t program_at_head(uint32_t size, uint32_t* location) {
+    if (g_log.head == NO_SEGMENT || g_log.head_offset + size > g_log.segment_size) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    *location = g_log.head * g_log.segment_size + g_log.head_offset;
+    hal_result_t result = flash_program(*location, g_buffer, size);
+
+    // A failed program may have left partial data: never write there again
+    g_log.head_offset = (result == HAL_SUCCESS) ? g_log.head_offset + size : g_log.segment_size;
+    return result;
+}
+
+/**
+ * @brief Check whether a segment holds a version of a record before an offset
+ */
+static bool segment_has_data(uint32_t segment, uint32_t end, uint32_t record_id) {
+    uint8_t header[RECORD_HEADER_SIZE];
+    uint32_t offset = g_log.page_size;
+
+    while (offset < end) {
+        uint32_t location = segment * g_log.segment_size + offset;
+        if (flash_read(location, header, sizeof(header)) != HAL_SUCCESS) {
+            return true;
+        }
+        if (header[2] == RECORD_TYPE_DATA && storage_get_u32(&header[4]) == record_id) {
+            return true;
+        }
+        offset += record_size(storage_get_u16(&header[8]));
+    }
+
+    return false;
+}
+
+/**
+ * @brief Move the tail's live records to the head and erase the tail
+ */
+static hal_result_t compact_tail(void) {
+    uint32_t segment = g_log.tail;
+    if (segment == NO_SEGMENT) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    if (segment == g_log.head) {
+        hal_result_t result = open_segment();
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    }
+
+    uint32_t offset = g_log.page_size;
+    while (offset < g_log.segment_size) {
+        uint32_t location = segment * g_log.segment_size + offset;
+        record_info_t info;
+        if (read_record(location, &info) != RECORD_VALID) {
+            break;
+        }
+
+        bool copy = false;
+        if (info.type == RECORD_TYPE_DATA) {
+            uint32_t slot = table_find(info.record_id);
+            copy = (slot != NO_SLOT && slot_location(slot) == location);
+        } else if (table_find(info.record_id) == NO_SLOT) {
+            // Carry a tombstone forward while the version it deletes sits in
+            // this segment: a torn erase could otherwise bring that back
+            copy = segment_has_data(segment, offset, info.record_id);
+        }
+
+        if (copy) {
+            // Opening a segment builds its header in g_buffer: read the record again
+            if (g_log.head_offset + info.size > g_log.segment_size) {
+                hal_result_t result = open_segment();
+                if (result != HAL_SUCCESS) {
+                    return result;
+                }
+                if (read_record(location, &info) != RECORD_VALID) {
+                    return HAL_ERROR_HARDWARE_FAILURE;
+                }
+            }
+
+            uint32_t moved;
+            hal_result_t result = program_at_head(info.size, &moved);
+            if (result != HAL_SUCCESS) {
+                return result;
+            }
+            if (info.type == RECORD_TYPE_DATA) {
+                table_put(info.record_id, moved);
+                g_log.live[segment] -= info.size;
+                g_log.live[g_log.head] += info.size;
+            }
+            g_log.stats.records_copied++;
+        }
+
+        offset += info.size;
+    }
+
+    hal_result_t result = segment_erase(segment);
+    g_log.sequence[segment] = 0;
+    g_log.live[segment] = 0;
+    g_log.free_segments++;
+    g_log.stats.compactions++;
+    find_tail();
+    return result;
+}
+
+/**
+ * @brief Make room for a record at the head
+ */
+static hal_result_t make_room(uint32_t size) {
+    uint32_t usable = g_log.segment_size - g_log.page_size;
+    uint32_t live_bytes = 0;
+    for (uint32_t i = 0; i < g_log.segment_count; i++) {
+        live_bytes += g_log.live[i];
+    }
+    if (live_bytes + size >
+        (g_log.segment_count - CREDENTIAL_LOG_RESERVE_SEGMENTS - 1U) * usable) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    for (uint32_t attempt = 0; attempt <= g_log.segment_count; attempt++) {
+        if (g_log.head != NO_SEGMENT && g_log.head_offset + size <= g_log.segment_size) {
+            return HAL_SUCCESS;
+        }
+        if (g_log.free_segments > CREDENTIAL_LOG_RESERVE_SEGMENTS) {
+            return open_segment();
+        }
+
+        g_log.stats.foreground_compactions++;
+        hal_result_t result = compact_tail();
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    }
+
+    return HAL_ERROR_INSUFFICIENT_MEMORY;
+}
+
+/**
+ * @brief Append a record or tombstone
+ */
+static hal_result_t append_record(uint8_t type, uint32_t record_id, const uint8_t* data,
+                                  size_t length, record_info_t* info, uint32_t* location) {
+    info->type = type;
+    info->record_id = record_id;
+    info->length = (uint16_t)length;
+    info->size = record_size((uint32_t)length);
+
+    hal_result_t result = make_room(info->size);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    // make_room() may have used g_buffer for compaction, build the record now
+    uint32_t body = RECORD_HEADER_SIZE + (uint32_t)length;
+    memset(g_buffer, 0xFF, info->size);
+    storage_put_u16(&g_buffer[0], RECORD_MAGIC);
+    g_buffer[2] = type;
+    storage_put_u32(&g_buffer[4], record_id);
+    storage_put_u16(&g_buffer[8], (uint16_t)length);
+    storage_put_u16(&g_buffer[10], (uint16_t)~length);
+    if (length > 0) {
+        memcpy(&g_buffer[RECORD_HEADER_SIZE], data, length);
+    }
+    storage_put_u32(&g_buffer[body], storage_crc32(g_buffer, body));
+
+    g_log.stats.appends++;
+    return program_at_head(info->size, location);
+}
+
+// ============================================================================
+// Public Interface
+// ============================================================================
+
+hal_result_t credential_log_mount(storage_hal_t* hal, uint32_t base_address, uint32_t size,
+                                  bool format) {
+    if (!hal) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (g_log.mounted) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    storage_info_t info;
+    hal_result_t result = hal->get_info(&info);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    uint32_t page = (info.page_size != 0) ? info.page_size : 16U;
+    if (info.sector_size == 0 || page < SEGMENT_HEADER_SIZE ||
+        page > CREDENTIAL_LOG_MAX_PAGE_SIZE || (info.sector_size % page) != 0 ||
+        (base_address % info.sector_size) != 0 || (size % info.sector_size) != 0 ||
+        size / info.sector_size < CREDENTIAL_LOG_RESERVE_SEGMENTS + 2U ||
+        size / info.sector_size > CREDENTIAL_LOG_MAX_SEGMENTS || size / page > MAX_PAGES ||
+        base_address + size > info.total_size) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    memset(&g_log, 0, sizeof(g_log));
+    memset(g_record_pages, 0, sizeof(g_record_pages));
+    g_log.hal = hal;
+    g_log.base_address = base_address;
+    g_log.segment_size = info.sector_size;
+    g_log.segment_count = size / info.sector_size;
+    g_log.page_size = page;
+    g_log.head = NO_SEGMENT;
+    g_log.tail = NO_SEGMENT;
+    g_log.next_sequence = 1;
+
+    if (record_size(CREDENTIAL_LOG_MAX_PAYLOAD) > g_log.segment_size - g_log.page_size) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    // Segment headers: which segments are in use, and in what order
+    uint32_t order[CREDENTIAL_LOG_MAX_SEGMENTS];
+    uint32_t in_use = 0;
+    for (uint32_t i = 0; i < g_log.segment_count; i++) {
+        uint8_t header[SEGMENT_HEADER_SIZE];
+        if (format) {
+            result = segment_erase(i);
+            if (result != HAL_SUCCESS) {
+                return result;
+            }
+        } else if (flash_read(i * g_log.segment_size, header, sizeof(header)) == HAL_SUCCESS &&
+                   storage_get_u32(&header[0]) == SEGMENT_MAGIC &&
+                   storage_get_u32(&header[8]) == SEGMENT_VERSION &&
+                   storage_get_u32(&header[12]) == storage_crc32(header, 12) && storage_get_u32(&header[4]) != 0) {
+            g_log.sequence[i] = storage_get_u32(&header[4]);
+            if (g_log.sequence[i] >= g_log.next_sequence) {
+                g_log.next_sequence = g_log.sequence[i] + 1U;
+            }
+
+            // Insertion sort by sequence, the region has few segments
+            uint32_t j = in_use++;
+            while (j > 0 && g_log.sequence[order[j - 1U]] > g_log.sequence[i]) {
+                order[j] = order[j - 1U];
+                j--;
+            }
+            order[j] = i;
+            continue;
+        }
+        g_log.free_segments++;
+    }
+
+    // Replay oldest first so the newest version of every record wins
+    for (uint32_t n = 0; n < in_use; n++) {
+        uint32_t segment = order[n];
+        uint32_t offset = g_log.page_size;
+        record_status_t status = RECORD_END;
+
+        while (offset < g_log.segment_size) {
+            uint32_t location = segment * g_log.segment_size + offset;
+            record_info_t record;
+            status = read_record(location, &record);
+            if (status != RECORD_VALID) {
+                break;
+            }
+            if (record.type == RECORD_TYPE_DATA && table_find(record.record_id) == NO_SLOT &&
+                g_log.live_records >= CREDENTIAL_LOG_MAX_RECORDS) {
+                memset(&g_log, 0, sizeof(g_log));
+                return HAL_ERROR_INSUFFICIENT_MEMORY;
+            }
+            apply_record(&record, location);
+            offset += record.size;
+        }
+
+        g_log.head = segment;
+        g_log.head_offset = (status == RECORD_CORRUPT) ? g_log.segment_size : offset;
+    }
+    find_tail();
+
+    if (g_log.head == NO_SEGMENT) {
+        result = open_segment();
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    }
+
+    g_log.mounted = true;
+    return HAL_SUCCESS;
+}
+
+void credential_log_unmount(void) {
+    memset(&g_log, 0, sizeof(g_log));
+    memset(g_record_pages, 0, sizeof(g_record_pages));
+}
+
+hal_result_t credential_log_write(uint32_t record_id, const uint8_t* data, size_t length) {
+    if (!g_log.mounted) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    if (!data || length == 0 || length > CREDENTIAL_LOG_MAX_PAYLOAD) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (table_find(record_id) == NO_SLOT && g_log.live_records >= CREDENTIAL_LOG_MAX_RECORDS) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    record_info_t info;
+    uint32_t location;
+    hal_result_t result = append_record(RECORD_TYPE_DATA, record_id, data, length, &info,
+                                        &location);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    apply_record(&info, location);
+    return HAL_SUCCESS;
+}
+
+hal_result_t credential_log_read(uint32_t record_id, uint8_t* buffer, size_t buffer_size,
+                                 size_t* length) {
+    if (!g_log.mounted) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    if (!buffer || !length) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    uint32_t slot = table_find(record_id);
+    if (slot == NO_SLOT) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    record_info_t info;
+    if (read_record(slot_location(slot), &info) != RECORD_VALID || info.record_id != record_id) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    *length = info.length;
+    if (buffer_size < info.length) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    memcpy(buffer, &g_buffer[RECORD_HEADER_SIZE], info.length);
+    return HAL_SUCCESS;
+}
+
+bool credential_log_contains(uint32_t record_id) {
+    return g_log.mounted && table_find(record_id) != NO_SLOT;
+}
+
+uint32_t credential_log_find_group(uint16_t group, uint32_t* record_ids, uint32_t max_ids) {
+    if (!g_log.mounted || (!record_ids && max_ids != 0)) {
+        return 0;
+    }
+
+    // The group's records share a home slot, and Robin Hood keeps them in one run
+    uint32_t slot = home_of((uint32_t)group << 16);
+    uint32_t found = 0;
+    for (uint32_t probe = 0;; probe++) {
+        if (g_record_pages[slot] == EMPTY_PAGE || displacement(slot) < probe) {
+            return found;
+        }
+        if ((uint16_t)(g_record_ids[slot] >> 16) == group) {
+            if (found < max_ids) {
+                record_ids[found] = g_record_ids[slot];
+            }
+            found++;
+        }
+        slot = next_slot(slot);
+    }
+}
+
+hal_result_t credential_log_delete(uint32_t record_id) {
+    if (!g_log.mounted) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    if (table_find(record_id) == NO_SLOT) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    record_info_t info;
+    uint32_t location;
+    hal_result_t result = append_record(RECORD_TYPE_TOMBSTONE, record_id, NULL, 0, &info,
+                                        &location);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    apply_record(&info, location);
+    return HAL_SUCCESS;
+}
+
+hal_result_t credential_log_foreach(credential_log_visitor_t visitor, void* context) {
+    if (!g_log.mounted) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    if (!visitor) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    for (uint32_t i = 0; i < TABLE_SLOTS; i++) {
+        if (g_record_pages[i] == EMPTY_PAGE) {
+            continue;
+        }
+        record_info_t info;
+        if (read_record(slot_location(i), &info) != RECORD_VALID) {
+            return HAL_ERROR_HARDWARE_FAILURE;
+        }
+        if (!visitor(info.record_id, &g_buffer[RECORD_HEADER_SIZE], info.length, context)) {
+            break;
+        }
+    }
+
+    return HAL_SUCCESS;
+}
+
+bool credential_log_compact(void) {
+    if (!g_log.mounted || g_log.tail == NO_SEGMENT || g_log.tail == g_log.head) {
+        return false;
+    }
+
+    // Compacting late finds more garbage per erase, so wait for the low-water mark
+    if (g_log.free_segments >= CREDENTIAL_LOG_RESERVE_SEGMENTS + CREDENTIAL_LOG_IDLE_FREE_SEGMENTS ||
+        segment_garbage(g_log.tail) == 0) {
+        return false;
+    }
+
+    return compact_tail() == HAL_SUCCESS;
+}
+
+void credential_log_get_stats(credential_log_stats_t* stats) {
+    if (!stats) {
+        return;
+    }
+
+    *stats = g_log.stats;
+    stats->segments = g_log.segment_count;
+    stats->free_segments = g_log.free_segments;
+    stats->live_records = g_log.live_records;
+    stats->live_bytes = 0;
+    stats->garbage_bytes = 0;
+    for (uint32_t i = 0; i < g_log.segment_count; i++) {
+        if (g_log.sequence[i] != 0) {
+            stats->live_bytes += g_log.live[i];
+            stats->garbage_bytes += segment_garbage(i);
+        }
+    }
+}
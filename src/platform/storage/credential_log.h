@@ -0,0 +1,218 @@
+#ifndef CREDENTIAL_LOG_H
+#define CREDENTIAL_LOG_H
+
+/**
+ * @file credential_log.h
+ * @brief Log-Structured Record Store for the CREDENTIALS Region
+ * @author USB Key Authentication Team
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ * Replaces the fixed-slot layout (STORAGE_RESIDENT_CREDS_OFFSET, 25 slots),
+ * where any change is a read-erase-rewrite of an 8 KB sector, with an
+ * append-only log. The region is cut into erase-sector segments used
+ * round-robin. Creating or updating a record appends it at the head,
+ * deleting appends a one-page tombstone, and the previous version simply
+ * becomes garbage, so the common case is a single program operation and
+ * no erase.
+ *
+ * Record layout, padded with 0xFF to the HAL page size:
+ * @code
+ * magic (2) || type (1) || 0xFF (1) || record_id (4) || length (2) || ~length (2)
+ *   || payload (length) || CRC-32 of everything before (4)
+ * @endcode
+ * A segment starts with a one-page header carrying a sequence number, so
+ * mount replays segments oldest first and a later record for an ID wins.
+ * A torn append fails its CRC and closes its segment; the previous version
+ * of the record is still in the log.
+ *
+ * Compaction takes the oldest segment (the tail), copies its live records
+ * to the head and erases it, so erases walk the whole region in turn.
+ * credential_log_compact() does this from idle time once free segments run
+ * low, as late as possible so each erase reclaims as much garbage as it
+ * can; an append only compacts in the foreground when idle time did not
+ * keep up. One segment stays in reserve so the copy always has room.
+ *
+ * The live-record table (record_id to location) is in static RAM, built at
+ * mount and updated by every append, 6 bytes per slot. The upper 16 bits of
+ * a record ID are its group. Records of one group share a probe run, so
+ * credential_log_find_group() lists them from RAM, and a lookup for an ID
+ * or group that is not stored ends without reading flash.
+ *
+ * @warning Not thread-safe; call from the CTAP task only.
+ */
+
+#include "hal/interface/storage_hal.h"
+
+/** @brief Live records the store can hold */
+#ifndef CREDENTIAL_LOG_MAX_RECORDS
+#define CREDENTIAL_LOG_MAX_RECORDS      512U
+#endif
+
+/** @brief Record table slots, 6 bytes of RAM each */
+#define CREDENTIAL_LOG_TABLE_SLOTS      (CREDENTIAL_LOG_MAX_RECORDS + CREDENTIAL_LOG_MAX_RECORDS / 8U + 1U)
+
+/** @brief Group of a record ID */
+#define CREDENTIAL_LOG_GROUP(record_id) ((uint16_t)((uint32_t)(record_id) >> 16))
+
+/** @brief Largest record payload in bytes */
+#ifndef CREDENTIAL_LOG_MAX_PAYLOAD
+#define CREDENTIAL_LOG_MAX_PAYLOAD      1024U
+#endif
+
+/** @brief Segments the region may be cut into */
+#ifndef CREDENTIAL_LOG_MAX_SEGMENTS
+#define CREDENTIAL_LOG_MAX_SEGMENTS     32U
+#endif
+
+/** @brief Largest HAL page size supported (records are page aligned) */
+#ifndef CREDENTIAL_LOG_MAX_PAGE_SIZE
+#define CREDENTIAL_LOG_MAX_PAGE_SIZE    128U
+#endif
+
+/** @brief Free segments kept back for compaction */
+#ifndef CREDENTIAL_LOG_RESERVE_SEGMENTS
+#define CREDENTIAL_LOG_RESERVE_SEGMENTS 1U
+#endif
+
+/** @brief Free segments beyond the reserve that idle compaction keeps ready */
+#ifndef CREDENTIAL_LOG_IDLE_FREE_SEGMENTS
+#define CREDENTIAL_LOG_IDLE_FREE_SEGMENTS   2U
+#endif
+
+/**
+ * @brief Store counters
+ */
+typedef struct {
+    uint32_t segments;              /**< Segments in the region */
+    uint32_t free_segments;         /**< Segments holding no records */
+    uint32_t live_records;          /**< Records that can be read */
+    uint32_t live_bytes;            /**< Flash bytes of live records */
+    uint32_t garbage_bytes;         /**< Flash bytes of superseded records and tombstones */
+    uint32_t appends;               /**< Records and tombstones written by callers */
+    uint32_t programs;              /**< HAL write calls */
+    uint32_t bytes_programmed;      /**< Bytes passed to HAL write */
+    uint32_t erases;                /**< Segments erased */
+    uint32_t compactions;           /**< Segments compacted */
+    uint32_t foreground_compactions;/**< Compactions an append had to wait for */
+    uint32_t records_copied;        /**< Live records moved by compaction */
+} credential_log_stats_t;
+
+/**
+ * @brief Visitor for credential_log_foreach()
+ *
+ * @param record_id Record ID
+ * @param data Payload, valid during the call only
+ * @param length Payload size in bytes
+ * @param context Caller context
+ * @return true to continue, false to stop
+ */
+typedef bool (*credential_log_visitor_t)(uint32_t record_id, const uint8_t* data,
+                                         size_t length, void* context);
+
+/**
+ * @brief Mount the store on a range of the storage HAL
+ *
+ * @param hal Storage HAL
+ * @param base_address Region start, sector aligned
+ * @param size Region size, whole sectors, at least 3
+ * @param format Erase the region first; otherwise replay the log found there
+ *               (an empty region mounts as an empty store)
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM Geometry not supported
+ * @retval HAL_ERROR_INVALID_STATE Already mounted
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY More live records than CREDENTIAL_LOG_MAX_RECORDS
+ */
+hal_result_t credential_log_mount(storage_hal_t* hal, uint32_t base_address, uint32_t size,
+                                  bool format);
+
+/**
+ * @brief Forget the mounted store (flash is already consistent)
+ */
+void credential_log_unmount(void);
+
+/**
+ * @brief Create or replace a record
+ *
+ * @param record_id Record ID
+ * @param data Payload
+ * @param length Payload size, 1 to CREDENTIAL_LOG_MAX_PAYLOAD bytes
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Store or record table full
+ * @retval HAL_ERROR_HARDWARE_FAILURE Program failed; the previous version remains
+ */
+hal_result_t credential_log_write(uint32_t record_id, const uint8_t* data, size_t length);
+
+/**
+ * @brief Read a record
+ *
+ * @param record_id Record ID
+ * @param buffer Output payload
+ * @param buffer_size Size of buffer
+ * @param length Output payload size
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY buffer too small (length is set)
+ * @retval HAL_ERROR_HARDWARE_FAILURE No such record, or CRC mismatch
+ */
+hal_result_t credential_log_read(uint32_t record_id, uint8_t* buffer, size_t buffer_size,
+                                 size_t* length);
+
+/**
+ * @brief Check whether a record exists, without touching flash
+ *
+ * @param record_id Record ID
+ * @return true if the record is live
+ */
+bool credential_log_contains(uint32_t record_id);
+
+/**
+ * @brief List the live records of a group, without touching flash
+ *
+ * Costs one short probe run whatever the number of records stored.
+ *
+ * @param group Upper 16 bits of the record IDs wanted
+ * @param record_ids Output record IDs, in no particular order
+ * @param max_ids Capacity of record_ids
+ * @return Records in the group; only the first max_ids are written
+ */
+uint32_t credential_log_find_group(uint16_t group, uint32_t* record_ids, uint32_t max_ids);
+
+/**
+ * @brief Delete a record by appending a tombstone
+ *
+ * @param record_id Record ID
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_HARDWARE_FAILURE No such record, or program failed
+ */
+hal_result_t credential_log_delete(uint32_t record_id);
+
+/**
+ * @brief Visit every live record
+ *
+ * The log must not be modified from the visitor.
+ *
+ * @param visitor Called once per record, in no particular order
+ * @param context Passed to visitor
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_HARDWARE_FAILURE A record failed its CRC
+ */
+hal_result_t credential_log_foreach(credential_log_visitor_t visitor, void* context);
+
+/**
+ * @brief Compact the tail segment if it is worth it
+ *
+ * Call from idle time. Does nothing while CREDENTIAL_LOG_IDLE_FREE_SEGMENTS
+ * segments beyond the reserve are free, or when the tail holds no garbage.
+ *
+ * @return true if a segment was compacted
+ */
+bool credential_log_compact(void);
+
+/**
+ * @brief Read the store counters
+ *
+ * @param stats Output counters
+ */
+void credential_log_get_stats(credential_log_stats_t* stats);
+
+#endif // CREDENTIAL_LOG_H
@@ -0,0 +1,330 @@
+/**
+ * @file credential_log_bench.c
+ * @brief Host-side credential log benchmark and power-loss check
+ * @author USB Key Authentication Team
+ * @date 2025-09-20
+ * @version 1.0
+ *
+ * Runs credential_log.h on a RAM flash shaped like the MCXA156 internal
+ * flash. The flash has 8 KB sectors and 128-byte pages, and only programs
+ * erased bytes. The run fills the store with resident credentials, then
+ * replays a MakeCredential / update / delete mix. Between requests it
+ * calls credential_log_compact() as idle time would. Reports
+ * - HAL program calls, bytes programmed and erases per request, next to
+ *   the fixed-slot layout's read-erase-rewrite of a whole sector
+ * - foreground compactions (requests that waited for an erase)
+ * - erase counts per sector, lowest and highest
+ * With -p it also cuts power during random programs and erases, tearing
+ * the operation halfway. It then remounts and checks that every credential
+ * reads back at its old or new version.
+ *
+ * Build and run on Linux from the repository root:
+ * @code
+ * gcc -std=c11 -O2 -I src -I src/platform/storage \
+ *     src/platform/storage/credential_log_bench.c src/platform/storage/credential_log.c \
+ *     src/platform/storage/storage_util.c src/platform/storage/storage_bench_flash.c \
+ *     -o credential_log_bench
+ * ./credential_log_bench [-n credentials] [-r requests] [-s max_size] [-I] [-p cuts]
+ * @endcode
+ *
+ * Options:
+ * - -n  Resident credentials kept in the store (default 25)
+ * - -r  Requests after the fill (default 5000)
+ * - -s  Largest credential record, bytes (default 400; sizes vary from 1/4 of it)
+ * - -I  No idle compaction: every compaction happens in the foreground
+ * - -p  Power cuts to inject (default 0)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "credential_log.h"
+#include "storage_bench_flash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_FLASH_SIZE        (128U * 1024U)  /**< RAM flash, 16 segments */
+#define BENCH_SECTOR_SIZE       8192U           /**< Erase sector */
+#define BENCH_PAGE_SIZE         128U            /**< Program page */
+#define BENCH_SECTORS           (BENCH_FLASH_SIZE / BENCH_SECTOR_SIZE)
+#define BENCH_RECORD_ID(index)  (((uint32_t)(index) << 16) | 0xC0DEU)    /**< One group each */
+
+static bench_flash_t* g_flash;
+
+// ============================================================================
+// Model
+// ============================================================================
+
+/**
+ * @brief Expected state of one credential slot in the workload
+ */
+typedef struct {
+    uint32_t generation;        /**< Version written last, 0 if absent */
+    uint32_t size;              /**< Payload size of that version */
+} bench_credential_t;
+
+static size_t record_for(uint8_t* record, uint32_t index, uint32_t generation, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        record[i] = (uint8_t)(index * 131U + generation * 17U + i);
+    }
+    return size;
+}
+
+/**
+ * @brief Check which of two states a credential reads back as
+ *
+ * @return 0 for expected, 1 for alternative, -1 for neither
+ */
+static int check_credential(uint32_t index, const bench_credential_t* expected,
+                            const bench_credential_t* alternative) {
+    static uint8_t buffer[CREDENTIAL_LOG_MAX_PAYLOAD];
+    static uint8_t record[CREDENTIAL_LOG_MAX_PAYLOAD];
+    size_t length = 0;
+    hal_result_t result = credential_log_read(BENCH_RECORD_ID(index), buffer, sizeof(buffer),
+                                              &length);
+
+    for (int n = 0; n < 2; n++) {
+        const bench_credential_t* state = n ? alternative : expected;
+        if (!state) {
+            continue;
+        }
+        if (state->generation == 0) {
+            if (result != HAL_SUCCESS && !credential_log_contains(BENCH_RECORD_ID(index))) {
+                return n;
+            }
+            continue;
+        }
+        record_for(record, index, state->generation, state->size);
+        if (result == HAL_SUCCESS && length == state->size &&
+            memcmp(buffer, record, length) == 0) {
+            return n;
+        }
+    }
+
+    printf("credential %u: result %d, %zu bytes, expected generation %u\n", index, result,
+           length, expected->generation);
+    return -1;
+}
+
+/** @brief Counters summed over mounts, a remount starts credential_log's from zero */
+static credential_log_stats_t g_totals;
+
+/**
+ * @brief Add the current mount's counters since a snapshot to g_totals
+ */
+static void add_session(const credential_log_stats_t* since) {
+    credential_log_stats_t now;
+    credential_log_get_stats(&now);
+    g_totals.programs += now.programs - since->programs;
+    g_totals.bytes_programmed += now.bytes_programmed - since->bytes_programmed;
+    g_totals.erases += now.erases - since->erases;
+    g_totals.compactions += now.compactions - since->compactions;
+    g_totals.foreground_compactions += now.foreground_compactions - since->foreground_compactions;
+    g_totals.records_copied += now.records_copied - since->records_copied;
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+    uint32_t credentials = 25;
+    uint32_t requests = 5000;
+    uint32_t max_size = 400;
+    bool idle = true;
+    uint32_t cuts = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            credentials = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            requests = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            max_size = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-I") == 0) {
+            idle = false;
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            cuts = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-n credentials] [-r requests] [-s max_size] [-I] "
+                    "[-p cuts]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (credentials == 0 || credentials > CREDENTIAL_LOG_MAX_RECORDS || max_size < 4 ||
+        max_size > CREDENTIAL_LOG_MAX_PAYLOAD) {
+        fprintf(stderr, "need 1..%u credentials of 4..%u bytes\n", CREDENTIAL_LOG_MAX_RECORDS,
+                CREDENTIAL_LOG_MAX_PAYLOAD);
+        return 2;
+    }
+
+    bench_credential_t* model = calloc(credentials, sizeof(*model));
+    uint8_t* record = malloc(max_size);
+    if (!model || !record) {
+        return 1;
+    }
+
+    const bench_flash_geometry_t geometry = {
+        .size = BENCH_FLASH_SIZE,
+        .sector_size = BENCH_SECTOR_SIZE,
+        .page_size = BENCH_PAGE_SIZE,
+    };
+    g_flash = bench_flash_init(&geometry);
+    if (!g_flash) {
+        return 1;
+    }
+    bench_flash_fill(0, BENCH_FLASH_SIZE, 0xA5);
+    if (credential_log_mount(bench_flash_hal(), 0, BENCH_FLASH_SIZE, true) != HAL_SUCCESS) {
+        fprintf(stderr, "mount failed\n");
+        return 1;
+    }
+    memset(g_flash->sector_erases, 0, BENCH_SECTORS * sizeof(uint32_t));
+
+    int failures = 0;
+
+    // Fill
+    for (uint32_t i = 0; i < credentials; i++) {
+        model[i].generation = 1;
+        model[i].size = max_size / 4U + bench_random() % (max_size - max_size / 4U + 1U);
+        record_for(record, i, 1, model[i].size);
+        if (credential_log_write(BENCH_RECORD_ID(i), record, model[i].size) != HAL_SUCCESS) {
+            printf("fill: credential %u failed\n", i);
+            failures++;
+        }
+    }
+
+    credential_log_stats_t session;
+    credential_log_get_stats(&session);
+
+    // Requests: 70% update an existing credential, 30% delete one and
+    // make a new one in its place. Power cuts land at random requests.
+    uint32_t cut_every = cuts ? requests / cuts : 0;
+    uint32_t cuts_done = 0;
+    uint32_t writes = 0;
+    uint32_t deletes = 0;
+    for (uint32_t r = 0; r < requests; r++) {
+        uint32_t index = bench_random() % credentials;
+        bench_credential_t previous = model[index];
+        bench_credential_t next = previous;
+        bool remove = (previous.generation != 0) && (bench_random() % 10U) < 3U;
+
+        if (cut_every && (r % cut_every) == cut_every / 2U && cuts_done < cuts) {
+            g_flash->cut_after = (int32_t)(bench_random() % 3U);
+        }
+
+        hal_result_t result;
+        if (remove) {
+            next.generation = 0;
+            result = credential_log_delete(BENCH_RECORD_ID(index));
+            deletes++;
+        } else {
+            next.generation = previous.generation + 1U;
+            next.size = max_size / 4U + bench_random() % (max_size - max_size / 4U + 1U);
+            record_for(record, index, next.generation, next.size);
+            result = credential_log_write(BENCH_RECORD_ID(index), record, next.size);
+            writes++;
+        }
+
+        if (idle && !g_flash->powered_off) {
+            credential_log_compact();
+        }
+
+        if (g_flash->powered_off) {
+            // Power comes back: remount and check every credential. A cut
+            // in the request itself may leave either version of the
+            // credential, a cut in the idle compaction after it may not.
+            bool torn_request = (result != HAL_SUCCESS);
+            g_flash->powered_off = false;
+            g_flash->cut_after = -1;
+            cuts_done++;
+            add_session(&session);
+            memset(&session, 0, sizeof(session));
+            credential_log_unmount();
+            if (credential_log_mount(bench_flash_hal(), 0, BENCH_FLASH_SIZE, false) != HAL_SUCCESS) {
+                printf("request %u: remount after power cut failed\n", r);
+                failures++;
+                break;
+            }
+            if (!torn_request) {
+                model[index] = next;
+            }
+            for (uint32_t i = 0; i < credentials; i++) {
+                bool in_flight = torn_request && i == index;
+                int state = check_credential(i, &model[i], in_flight ? &next : NULL);
+                if (state < 0) {
+                    failures++;
+                } else if (in_flight && state == 1) {
+                    model[i] = next;
+                }
+            }
+            continue;
+        }
+        g_flash->cut_after = -1;
+
+        if (result != HAL_SUCCESS) {
+            printf("request %u: credential %u failed: %d\n", r, index, result);
+            failures++;
+            break;
+        }
+        model[index] = next;
+    }
+
+    credential_log_stats_t after;
+    credential_log_get_stats(&after);
+    add_session(&session);
+
+    // Remount and verify everything
+    credential_log_unmount();
+    if (credential_log_mount(bench_flash_hal(), 0, BENCH_FLASH_SIZE, false) != HAL_SUCCESS) {
+        printf("final remount failed\n");
+        failures++;
+    } else {
+        for (uint32_t i = 0; i < credentials; i++) {
+            if (check_credential(i, &model[i], NULL) < 0) {
+                failures++;
+            }
+        }
+    }
+
+    uint32_t done = writes + deletes;
+    uint32_t min_erases = UINT32_MAX;
+    uint32_t max_erases = 0;
+    for (uint32_t s = 0; s < BENCH_SECTORS; s++) {
+        min_erases = g_flash->sector_erases[s] < min_erases ? g_flash->sector_erases[s] : min_erases;
+        max_erases = g_flash->sector_erases[s] > max_erases ? g_flash->sector_erases[s] : max_erases;
+    }
+
+    printf("credential_log: %u credentials up to %u bytes, %u requests (%u writes, %u deletes), "
+           "%s compaction\n", credentials, max_size, done, writes, deletes,
+           idle ? "idle" : "foreground");
+    if (done > 0) {
+        double n = (double)done;
+        printf("  per request:   %6.2f programs  %8.1f bytes programmed  %6.4f erases\n",
+               g_totals.programs / n, g_totals.bytes_programmed / n, g_totals.erases / n);
+        printf("  fixed slots:   %6.2f programs  %8.1f bytes programmed  %6.4f erases\n",
+               (double)(BENCH_SECTOR_SIZE / BENCH_PAGE_SIZE), (double)BENCH_SECTOR_SIZE, 1.0);
+        printf("  compactions:   %u (%u in the foreground), %u records copied\n",
+               g_totals.compactions, g_totals.foreground_compactions, g_totals.records_copied);
+    }
+    printf("  sector erases: %u..%u over %u sectors\n", min_erases, max_erases, BENCH_SECTORS);
+    printf("  store:         %u live records, %u live bytes, %u garbage bytes, "
+           "%u free segments\n", after.live_records, after.live_bytes, after.garbage_bytes,
+           after.free_segments);
+    if (cuts) {
+        printf("  power cuts:    %u, every credential at its old or new version\n", cuts_done);
+    }
+
+    if (g_flash->violations != 0) {
+        printf("FAIL: %u writes to unerased or misaligned flash\n", g_flash->violations);
+        failures++;
+    }
+
+    credential_log_unmount();
+    bench_flash_deinit();
+    free(model);
+    free(record);
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file sign_counter.c
+ * @brief Wear-Free Monotonic Signature Counters for the COUNTERS Region
+ * @author USB Key Authentication Team
+ * @date 2025-09-22
+ * @version 1.0
+ *
+ * Offsets are byte offsets from the start of a sector. Each record takes
+ * one slot: 16 bytes rounded up to the HAL program unit. The slot at
+ * offset 0 is the sector header. The append offset only moves forward,
+ * even when a program fails, so no slot is programmed twice.
+ */
+
+#include "sign_counter.h"
+#include "storage_util.h"
+#include <string.h>
+
+#define RECORD_SIZE             16U             /**< Header or counter record */
+#define RECORD_MAGIC            0x5343U         /**< "SC" */
+#define SECTOR_MAGIC            0x52544353UL    /**< "SCTR" */
+#define SECTOR_VERSION          1U              /**< Layout version */
+#define NO_SECTOR               0xFFFFFFFFUL    /**< No valid sector found */
+
+/**
+ * @brief Result of reading a record slot
+ */
+typedef enum {
+    SLOT_VALID = 0,         /**< Counter record that checks out */
+    SLOT_BLANK,             /**< Erased: end of the sector's records */
+    SLOT_CORRUPT            /**< Torn or damaged: skipped */
+} slot_status_t;
+
+/**
+ * @brief Store state
+ */
+typedef struct {
+    storage_hal_t* hal;                                 /**< Storage HAL */
+    uint32_t base_address;                              /**< Region start */
+    uint32_t sector_size;                               /**< Erase sector */
+    uint32_t sector_count;                              /**< Sectors in the region */
+    uint32_t slot_size;                                 /**< Flash footprint of a record */
+    uint32_t active;                                    /**< Sector appended to */
+    uint32_t next_offset;                               /**< Next free slot in active */
+    uint32_t sequence;                                  /**< Sequence of active */
+    bool mounted;                                       /**< Store usable */
+    bool erased[SIGN_COUNTER_MAX_SECTORS];              /**< Known to be erased */
+    uint32_t value[SIGN_COUNTER_MAX_COUNTERS];          /**< Current counter values */
+    sign_counter_stats_t stats;                         /**< Counters */
+} sign_counter_state_t;
+
+static sign_counter_state_t g_counter;
+static uint8_t g_slot[SIGN_COUNTER_MAX_PROGRAM_SIZE];
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+/**
+ * @brief Build a counter record in g_slot
+ */
+static void encode_record(uint32_t counter, uint32_t value) {
+    memset(g_slot, 0xFF, g_counter.slot_size);
+    storage_put_u16(&g_slot[0], RECORD_MAGIC);
+    g_slot[2] = (uint8_t)counter;
+    g_slot[3] = (uint8_t)~counter;
+    storage_put_u32(&g_slot[4], value);
+    storage_put_u32(&g_slot[12], storage_crc32(g_slot, 12));
+}
+
+/**
+ * @brief Build a sector header in g_slot
+ */
+static void encode_header(uint32_t sequence) {
+    memset(g_slot, 0xFF, g_counter.slot_size);
+    storage_put_u32(&g_slot[0], SECTOR_MAGIC);
+    storage_put_u32(&g_slot[4], sequence);
+    storage_put_u32(&g_slot[8], SECTOR_VERSION);
+    storage_put_u32(&g_slot[12], storage_crc32(g_slot, 12));
+}
+
+// ============================================================================
+// Flash Access
+// ============================================================================
+
+static uint32_t sector_address(uint32_t sector, uint32_t offset) {
+    return g_counter.base_address + sector * g_counter.sector_size + offset;
+}
+
+static hal_result_t slot_program(uint32_t sector, uint32_t offset) {
+    g_counter.stats.programs++;
+    g_counter.stats.bytes_programmed += g_counter.slot_size;
+    return g_counter.hal->write(sector_address(sector, offset), g_slot, g_counter.slot_size);
+}
+
+static hal_result_t sector_erase(uint32_t sector) {
+    g_counter.stats.erases++;
+    hal_result_t result = g_counter.hal->erase(sector_address(sector, 0),
+                                               g_counter.sector_size);
+    g_counter.erased[sector] = (result == HAL_SUCCESS);
+    return result;
+}
+
+/**
+ * @brief Sequence number of a sector, 0 if its header is not valid
+ */
+static uint32_t read_header(uint32_t sector) {
+    uint8_t header[RECORD_SIZE];
+    if (g_counter.hal->read(sector_address(sector, 0), header, sizeof(header)) != HAL_SUCCESS ||
+        storage_get_u32(&header[0]) != SECTOR_MAGIC || storage_get_u32(&header[8]) != SECTOR_VERSION ||
+        storage_get_u32(&header[12]) != storage_crc32(header, 12)) {
+        return 0;
+    }
+    return storage_get_u32(&header[4]);
+}
+
+/**
+ * @brief Read the record slot at an offset
+ */
+static slot_status_t read_slot(uint32_t sector, uint32_t offset, uint32_t* counter,
+                               uint32_t* value) {
+    uint8_t record[RECORD_SIZE];
+    if (g_counter.hal->read(sector_address(sector, offset), record, sizeof(record)) !=
+        HAL_SUCCESS) {
+        return SLOT_CORRUPT;
+    }
+
+    bool blank = true;
+    for (uint32_t i = 0; i < RECORD_SIZE; i++) {
+        blank = blank && (record[i] == 0xFF);
+    }
+    if (blank) {
+        return SLOT_BLANK;
+    }
+
+    if (storage_get_u16(&record[0]) != RECORD_MAGIC || (record[2] ^ record[3]) != 0xFFU ||
+        storage_get_u32(&record[12]) != storage_crc32(record, 12)) {
+        return SLOT_CORRUPT;
+    }
+
+    *counter = record[2];
+    *value = storage_get_u32(&record[4]);
+    return SLOT_VALID;
+}
+
+/**
+ * @brief Fold a sector's records into the counter values
+ *
+ * @return Offset of its first blank slot, sector_size if it is full
+ */
+static uint32_t replay_sector(uint32_t sector) {
+    uint32_t offset = g_counter.slot_size;
+    for (; offset < g_counter.sector_size; offset += g_counter.slot_size) {
+        uint32_t counter;
+        uint32_t value;
+        slot_status_t status = read_slot(sector, offset, &counter, &value);
+        if (status == SLOT_BLANK) {
+            break;
+        }
+        if (status == SLOT_VALID && counter < SIGN_COUNTER_MAX_COUNTERS &&
+            value > g_counter.value[counter]) {
+            g_counter.value[counter] = value;
+        }
+    }
+    return offset;
+}
+
+/**
+ * @brief Check that a whole sector reads as erased
+ */
+static bool sector_blank(uint32_t sector) {
+    for (uint32_t offset = 0; offset < g_counter.sector_size; offset += g_counter.slot_size) {
+        if (g_counter.hal->read(sector_address(sector, offset), g_slot, g_counter.slot_size) !=
+            HAL_SUCCESS) {
+            return false;
+        }
+        for (uint32_t i = 0; i < g_counter.slot_size; i++) {
+            if (g_slot[i] != 0xFF) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Sectors
+// ============================================================================
+
+/**
+ * @brief Start a sector: checkpoint every counter, then the header
+ *
+ * The header goes last, so a sector cut short of it is never trusted.
+ */
+static hal_result_t start_sector(uint32_t sector, uint32_t sequence) {
+    if (!g_counter.erased[sector]) {
+        hal_result_t result = sector_erase(sector);
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    }
+    g_counter.erased[sector] = false;
+
+    uint32_t offset = g_counter.slot_size;
+    for (uint32_t i = 0; i < SIGN_COUNTER_MAX_COUNTERS; i++) {
+        if (g_counter.value[i] == 0) {
+            continue;
+        }
+        encode_record(i, g_counter.value[i]);
+        hal_result_t result = slot_program(sector, offset);
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+        offset += g_counter.slot_size;
+    }
+
+    encode_header(sequence);
+    hal_result_t result = slot_program(sector, 0);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    g_counter.active = sector;
+    g_counter.next_offset = offset;
+    g_counter.sequence = sequence;
+    return HAL_SUCCESS;
+}
+
+static uint32_t next_sector(void) {
+    return (g_counter.active + 1U) % g_counter.sector_count;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+hal_result_t sign_counter_mount(storage_hal_t* hal, uint32_t base_address, uint32_t size,
+                                bool format) {
+    if (!hal) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (g_counter.mounted) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    storage_info_t info;
+    hal_result_t result = hal->get_info(&info);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    uint32_t unit = (info.program_size != 0) ? info.program_size : info.page_size;
+    if (unit == 0) {
+        unit = RECORD_SIZE;
+    }
+    uint32_t slot = (RECORD_SIZE + unit - 1U) / unit * unit;
+    if (info.sector_size == 0 || slot > SIGN_COUNTER_MAX_PROGRAM_SIZE ||
+        (info.sector_size % slot) != 0 ||
+        info.sector_size / slot < SIGN_COUNTER_MAX_COUNTERS + 2U ||
+        (base_address % info.sector_size) != 0 || (size % info.sector_size) != 0 ||
+        size / info.sector_size < 2U || size / info.sector_size > SIGN_COUNTER_MAX_SECTORS ||
+        base_address + size > info.total_size) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    memset(&g_counter, 0, sizeof(g_counter));
+    g_counter.hal = hal;
+    g_counter.base_address = base_address;
+    g_counter.sector_size = info.sector_size;
+    g_counter.sector_count = size / info.sector_size;
+    g_counter.slot_size = slot;
+    g_counter.active = NO_SECTOR;
+
+    // Every valid sector counts: a counter is the largest value recorded
+    for (uint32_t i = 0; i < g_counter.sector_count && !format; i++) {
+        uint32_t sequence = read_header(i);
+        if (sequence == 0) {
+            continue;
+        }
+        uint32_t end = replay_sector(i);
+        if (g_counter.active == NO_SECTOR || sequence > g_counter.sequence) {
+            g_counter.active = i;
+            g_counter.next_offset = end;
+            g_counter.sequence = sequence;
+        }
+    }
+
+    if (g_counter.active == NO_SECTOR) {
+        for (uint32_t i = 0; i < g_counter.sector_count && format; i++) {
+            result = sector_erase(i);
+            if (result != HAL_SUCCESS) {
+                return result;
+            }
+        }
+        result = start_sector(0, 1);
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    } else {
+        // Idle time may have erased the next sector before the reset
+        g_counter.erased[next_sector()] = sector_blank(next_sector());
+    }
+
+    g_counter.mounted = true;
+    return HAL_SUCCESS;
+}
+
+void sign_counter_unmount(void) {
+    memset(&g_counter, 0, sizeof(g_counter));
+}
+
+hal_result_t sign_counter_get(uint32_t counter, uint32_t* value) {
+    if (!g_counter.mounted) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    if (counter >= SIGN_COUNTER_MAX_COUNTERS || !value) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    *value = g_counter.value[counter];
+    return HAL_SUCCESS;
+}
+
+hal_result_t sign_counter_increment(uint32_t counter, uint32_t* value) {
+    if (!g_counter.mounted) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    if (counter >= SIGN_COUNTER_MAX_COUNTERS || !value) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (g_counter.value[counter] == 0xFFFFFFFFUL) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    if (g_counter.next_offset + g_counter.slot_size > g_counter.sector_size) {
+        uint32_t sector = next_sector();
+        if (!g_counter.erased[sector]) {
+            g_counter.stats.foreground_erases++;
+        }
+        hal_result_t result = start_sector(sector, g_counter.sequence + 1U);
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+        g_counter.stats.rolls++;
+    }
+
+    // Move past the slot first: a failed program is never programmed over
+    uint32_t offset = g_counter.next_offset;
+    g_counter.next_offset += g_counter.slot_size;
+
+    encode_record(counter, g_counter.value[counter] + 1U);
+    hal_result_t result = slot_program(g_counter.active, offset);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    g_counter.value[counter]++;
+    g_counter.stats.increments++;
+    *value = g_counter.value[counter];
+    return HAL_SUCCESS;
+}
+
+bool sign_counter_prepare(void) {
+    if (!g_counter.mounted) {
+        return false;
+    }
+
+    uint32_t free_records = (g_counter.sector_size - g_counter.next_offset) / g_counter.slot_size;
+    uint32_t sector = next_sector();
+    if (free_records >= SIGN_COUNTER_PREPARE_RECORDS || g_counter.erased[sector]) {
+        return false;
+    }
+
+    // The active sector's checkpoint covers everything the next one holds
+    return sector_erase(sector) == HAL_SUCCESS;
+}
+
+void sign_counter_get_stats(sign_counter_stats_t* stats) {
+    if (!stats) {
+        return;
+    }
+
+    *stats = g_counter.stats;
+    stats->sectors = g_counter.sector_count;
+    stats->active_sector = g_counter.active;
+    stats->free_records = g_counter.mounted ?
+        (g_counter.sector_size - g_counter.next_offset) / g_counter.slot_size : 0;
+}
@@ -0,0 +1,142 @@
+#ifndef SIGN_COUNTER_H
+#define SIGN_COUNTER_H
+
+/**
+ * @file sign_counter.h
+ * @brief Wear-Free Monotonic Signature Counters for the COUNTERS Region
+ * @author USB Key Authentication Team
+ * @date 2025-09-22
+ * @version 1.0
+ *
+ * Every assertion increments a signature counter. Rewriting it in place
+ * would cost an 8 KB sector erase per login. Instead each increment
+ * appends one 16-byte record carrying the counter's new value, programmed
+ * as a single flash phrase (mflash_drv_phrase_program() on MCXA156, a HAL
+ * write of storage_info_t.program_size bytes). An 8 KB sector takes about
+ * 500 increments before it is erased once.
+ *
+ * Record layout, one program unit each (padded with 0xFF beyond 16 bytes):
+ * @code
+ * magic (2) || counter (1) || ~counter (1) || value (4) || 0xFF (4) || CRC-32 (4)
+ * @endcode
+ * The first unit of a sector is its header (magic, sequence, version,
+ * CRC). Sectors are used round-robin. When the active sector is full the
+ * next one is erased, a checkpoint record for every counter is programmed
+ * into it, and its header is programmed last with the next sequence
+ * number. A sector without a valid header is never read.
+ *
+ * Counters only go up, so mount takes, for each counter, the largest value
+ * of any record in any valid sector. No ordering between records has to be
+ * trusted:
+ * - a torn increment fails its CRC, and the counter keeps its previous value
+ * - a roll cut before its header leaves the old sector active
+ * - a torn erase only leaves stale, smaller values behind
+ * A phrase that was programmed, or failed, is never programmed again.
+ * sign_counter_increment() returns only once the new value is in flash, so
+ * a value handed to an assertion cannot be handed out again after a reset.
+ *
+ * Reads come from a RAM copy and never touch flash.
+ *
+ * @warning Not thread-safe; call from the CTAP task only.
+ */
+
+#include "hal/interface/storage_hal.h"
+
+/** @brief Counters kept in the region */
+#ifndef SIGN_COUNTER_MAX_COUNTERS
+#define SIGN_COUNTER_MAX_COUNTERS       4U
+#endif
+
+/** @brief Sectors the region may span */
+#ifndef SIGN_COUNTER_MAX_SECTORS
+#define SIGN_COUNTER_MAX_SECTORS        8U
+#endif
+
+/** @brief Largest HAL program unit supported (one record each) */
+#ifndef SIGN_COUNTER_MAX_PROGRAM_SIZE
+#define SIGN_COUNTER_MAX_PROGRAM_SIZE   128U
+#endif
+
+/** @brief Free records left in the active sector when idle time erases the next one */
+#ifndef SIGN_COUNTER_PREPARE_RECORDS
+#define SIGN_COUNTER_PREPARE_RECORDS    32U
+#endif
+
+/** @brief Counter used for FIDO2 and U2F assertions */
+#define SIGN_COUNTER_FIDO               0U
+
+/**
+ * @brief Counter store counters
+ */
+typedef struct {
+    uint32_t sectors;               /**< Sectors in the region */
+    uint32_t active_sector;         /**< Sector appended to */
+    uint32_t free_records;          /**< Records left in the active sector */
+    uint32_t increments;            /**< Successful increments */
+    uint32_t programs;              /**< HAL write calls */
+    uint32_t bytes_programmed;      /**< Bytes passed to HAL write */
+    uint32_t erases;                /**< Sectors erased */
+    uint32_t rolls;                 /**< Moves to a fresh sector */
+    uint32_t foreground_erases;     /**< Erases an increment had to wait for */
+} sign_counter_stats_t;
+
+/**
+ * @brief Mount the counters on a range of the storage HAL
+ *
+ * @param hal Storage HAL
+ * @param base_address Region start, sector aligned
+ * @param size Region size, whole sectors, at least 2
+ * @param format Erase the region and start every counter at 0
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM Geometry not supported
+ * @retval HAL_ERROR_INVALID_STATE Already mounted
+ */
+hal_result_t sign_counter_mount(storage_hal_t* hal, uint32_t base_address, uint32_t size,
+                                bool format);
+
+/**
+ * @brief Forget the mounted counters (flash is already consistent)
+ */
+void sign_counter_unmount(void);
+
+/**
+ * @brief Read a counter, without touching flash
+ *
+ * @param counter Counter index, below SIGN_COUNTER_MAX_COUNTERS
+ * @param value Output value
+ * @return HAL_SUCCESS on success, error code otherwise
+ */
+hal_result_t sign_counter_get(uint32_t counter, uint32_t* value);
+
+/**
+ * @brief Increment a counter and make the new value durable
+ *
+ * One program of a single record, plus an erase and a checkpoint when the
+ * active sector is full and idle time did not prepare the next one.
+ *
+ * @param counter Counter index, below SIGN_COUNTER_MAX_COUNTERS
+ * @param value Output new value, to be used only on HAL_SUCCESS
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_STATE Counter at 0xFFFFFFFF
+ * @retval HAL_ERROR_HARDWARE_FAILURE Program failed; the counter is unchanged
+ */
+hal_result_t sign_counter_increment(uint32_t counter, uint32_t* value);
+
+/**
+ * @brief Erase the next sector ahead of a roll
+ *
+ * Call from idle time. Does nothing until fewer than
+ * SIGN_COUNTER_PREPARE_RECORDS records are left in the active sector.
+ *
+ * @return true if a sector was erased
+ */
+bool sign_counter_prepare(void);
+
+/**
+ * @brief Read the store counters
+ *
+ * @param stats Output counters
+ */
+void sign_counter_get_stats(sign_counter_stats_t* stats);
+
+#endif // SIGN_COUNTER_H
@@ -0,0 +1,213 @@
+/**
+ * @file sign_counter_bench.c
+ * @brief Host-side signature counter benchmark and power-loss check
+ * @author USB Key Authentication Team
+ * @date 2025-09-22
+ * @version 1.0
+ *
+ * Runs sign_counter.h on a RAM flash shaped like the MCXA156 internal
+ * flash. The flash has 8 KB sectors and programs 16-byte phrases, and a
+ * phrase can only be programmed while fully erased, as ECC requires. The
+ * run increments the FIDO counter as assertions would, with an occasional
+ * increment of a second counter, and calls sign_counter_prepare() between
+ * requests as idle time would. Reports
+ * - HAL programs, bytes programmed and erases per increment, next to an
+ *   in-place rewrite (one erase and one page program per increment)
+ * - erase counts per sector, and the increments the region lasts at
+ *   100K erase cycles per sector
+ * With -p it also cuts power during random programs and erases, tearing
+ * the operation halfway. It then remounts and checks that each counter
+ * is at least its last acknowledged value and at most one above it.
+ *
+ * Build and run on Linux from the repository root:
+ * @code
+ * gcc -std=c11 -O2 -I src -I src/platform/storage \
+ *     src/platform/storage/sign_counter_bench.c src/platform/storage/sign_counter.c \
+ *     src/platform/storage/storage_util.c src/platform/storage/storage_bench_flash.c \
+ *     -o sign_counter_bench
+ * ./sign_counter_bench [-i increments] [-s sectors] [-I] [-p cuts]
+ * @endcode
+ *
+ * Options:
+ * - -i  Increments (default 100000)
+ * - -s  Sectors in the region (default 2)
+ * - -I  No idle preparation: every erase happens during an increment
+ * - -p  Power cuts to inject (default 0)
+ */
+
+#include "sign_counter.h"
+#include "storage_bench_flash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_SECTOR_SIZE       8192U           /**< Erase sector */
+#define BENCH_PAGE_SIZE         128U            /**< Program page */
+#define BENCH_PHRASE_SIZE       16U             /**< Program unit */
+#define BENCH_FLASH_SIZE        (SIGN_COUNTER_MAX_SECTORS * BENCH_SECTOR_SIZE)
+#define BENCH_ENDURANCE         100000U         /**< Erase cycles per sector */
+#define BENCH_OTHER_COUNTER     1U              /**< Incremented now and then */
+
+// ============================================================================
+// Main
+// ============================================================================
+
+static bench_flash_t* g_flash;
+static sign_counter_stats_t g_totals;
+
+/**
+ * @brief Add a mount session's counters to the run totals
+ */
+static void add_session(void) {
+    sign_counter_stats_t stats;
+    sign_counter_get_stats(&stats);
+    g_totals.increments += stats.increments;
+    g_totals.programs += stats.programs;
+    g_totals.bytes_programmed += stats.bytes_programmed;
+    g_totals.erases += stats.erases;
+    g_totals.rolls += stats.rolls;
+    g_totals.foreground_erases += stats.foreground_erases;
+}
+
+int main(int argc, char** argv) {
+    uint32_t increments = 100000;
+    uint32_t sectors = 2;
+    bool idle = true;
+    uint32_t cuts = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            increments = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            sectors = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-I") == 0) {
+            idle = false;
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            cuts = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-i increments] [-s sectors] [-I] [-p cuts]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (increments == 0 || sectors < 2 || sectors > SIGN_COUNTER_MAX_SECTORS) {
+        fprintf(stderr, "need increments and 2..%u sectors\n", SIGN_COUNTER_MAX_SECTORS);
+        return 2;
+    }
+
+    uint32_t size = sectors * BENCH_SECTOR_SIZE;
+    const bench_flash_geometry_t geometry = {
+        .size = BENCH_FLASH_SIZE,
+        .sector_size = BENCH_SECTOR_SIZE,
+        .page_size = BENCH_PAGE_SIZE,
+        .program_size = BENCH_PHRASE_SIZE,
+    };
+    g_flash = bench_flash_init(&geometry);
+    if (!g_flash) {
+        return 1;
+    }
+    if (sign_counter_mount(bench_flash_hal(), 0, size, true) != HAL_SUCCESS) {
+        fprintf(stderr, "mount failed\n");
+        return 1;
+    }
+
+    // Last value each counter was acknowledged at, and whether one is in flight
+    uint32_t acknowledged[2] = { 0, 0 };
+    uint32_t cuts_done = 0;
+    uint32_t failures = 0;
+    uint32_t gap = cuts ? increments / cuts : 0;
+
+    for (uint32_t n = 0; n < increments; n++) {
+        uint32_t counter = (bench_random() % 50U == 0) ? BENCH_OTHER_COUNTER : SIGN_COUNTER_FIDO;
+        bool cut = (cuts_done < cuts && gap != 0 && (n % gap) == gap / 2U);
+        if (cut) {
+            // Power fails within the next few flash operations
+            g_flash->cut_after = (int32_t)(bench_random() % 3U);
+        }
+
+        uint32_t value;
+        hal_result_t result = sign_counter_increment(counter, &value);
+        if (result == HAL_SUCCESS) {
+            if (value != acknowledged[counter] + 1U) {
+                failures++;
+            }
+            acknowledged[counter] = value;
+        }
+
+        if (idle && !g_flash->powered_off) {
+            sign_counter_prepare();
+        }
+
+        if (cut) {
+            // Power back: remount and check what survived
+            add_session();
+            sign_counter_unmount();
+            g_flash->powered_off = false;
+            g_flash->cut_after = -1;
+            if (sign_counter_mount(bench_flash_hal(), 0, size, false) != HAL_SUCCESS) {
+                fprintf(stderr, "remount after cut %u failed\n", (unsigned)cuts_done);
+                return 1;
+            }
+            for (uint32_t c = 0; c < 2U; c++) {
+                uint32_t recovered;
+                sign_counter_get(c, &recovered);
+                if (recovered < acknowledged[c] || recovered > acknowledged[c] + 1U) {
+                    fprintf(stderr, "cut %u: counter %u recovered %u, acknowledged %u\n",
+                            (unsigned)cuts_done, (unsigned)c, (unsigned)recovered,
+                            (unsigned)acknowledged[c]);
+                    failures++;
+                }
+                acknowledged[c] = recovered;
+            }
+            cuts_done++;
+        }
+    }
+
+    // A clean remount must read back the same values
+    add_session();
+    sign_counter_unmount();
+    if (sign_counter_mount(bench_flash_hal(), 0, size, false) != HAL_SUCCESS) {
+        fprintf(stderr, "final remount failed\n");
+        return 1;
+    }
+    for (uint32_t c = 0; c < 2U; c++) {
+        uint32_t recovered;
+        sign_counter_get(c, &recovered);
+        failures += (recovered != acknowledged[c]) ? 1U : 0U;
+    }
+    add_session();
+
+    uint32_t low = 0xFFFFFFFFU;
+    uint32_t high = 0;
+    for (uint32_t s = 0; s < sectors; s++) {
+        low = (g_flash->sector_erases[s] < low) ? g_flash->sector_erases[s] : low;
+        high = (g_flash->sector_erases[s] > high) ? g_flash->sector_erases[s] : high;
+    }
+    double per = (double)g_totals.increments;
+    double lifetime = (g_totals.erases != 0) ?
+        (double)BENCH_ENDURANCE * sectors * per / g_totals.erases : 0.0;
+
+    printf("sign_counter: %u increments over %u sectors, %s\n", (unsigned)g_totals.increments,
+           (unsigned)sectors, idle ? "idle preparation" : "no idle preparation");
+    printf("  per increment:  %6.3f programs  %7.2f bytes programmed  %.5f erases\n",
+           g_totals.programs / per, g_totals.bytes_programmed / per, g_totals.erases / per);
+    printf("  rewrite:        %6.3f programs  %7.2f bytes programmed  %.5f erases\n", 1.0,
+           (double)BENCH_PAGE_SIZE, 1.0);
+    printf("  rolls:          %u (%u erases in the foreground)\n", (unsigned)g_totals.rolls,
+           (unsigned)g_totals.foreground_erases);
+    printf("  sector erases:  %u..%u over %u sectors; %.0f increments at %u cycles\n",
+           (unsigned)low, (unsigned)high, (unsigned)sectors, lifetime,
+           (unsigned)BENCH_ENDURANCE);
+    if (cuts) {
+        printf("  power cuts:     %u, every counter at its acknowledged value or one above\n",
+               (unsigned)cuts_done);
+    }
+
+    bool pass = (failures == 0 && g_flash->violations == 0);
+    if (!pass) {
+        printf("  failures: %u, flash violations: %u\n", (unsigned)failures,
+               (unsigned)g_flash->violations);
+    }
+    bench_flash_deinit();
+    printf("%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file storage_bench_flash.c
+ * @brief RAM Flash HAL Shared by the Storage Benchmarks
+ * @author USB Key Authentication Team
+ * @date 2025-09-26
+ * @version 1.0
+ */
+
+#include "storage_bench_flash.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bench_flash_t g_flash;
+static uint32_t g_rng = 0x9E3779B9U;
+
+/**
+ * @brief Count down to the armed power cut
+ *
+ * @return true if power is off from this operation on
+ */
+static bool power_cut(void) {
+    if (g_flash.powered_off) {
+        return true;
+    }
+    if (g_flash.cut_after >= 0 && g_flash.cut_after-- == 0) {
+        g_flash.powered_off = true;
+        return true;
+    }
+    return false;
+}
+
+static void mark_programmed(uint32_t address, size_t length, bool programmed) {
+    if (length == 0) {
+        return;
+    }
+    uint32_t first = address / g_flash.unit;
+    uint32_t last = (address + (uint32_t)length - 1U) / g_flash.unit;
+    for (uint32_t u = first; u <= last; u++) {
+        g_flash.programmed[u] = programmed;
+    }
+}
+
+static hal_result_t flash_get_info(storage_info_t* info) {
+    memset(info, 0, sizeof(*info));
+    info->type = STORAGE_TYPE_FLASH;
+    info->total_size = g_flash.geometry.size;
+    info->sector_size = g_flash.geometry.sector_size;
+    info->page_size = g_flash.geometry.page_size;
+    info->program_size = g_flash.geometry.program_size;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t flash_read(uint32_t address, uint8_t* buffer, size_t length) {
+    if (g_flash.powered_off) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+    if (address > g_flash.geometry.size || length > g_flash.geometry.size - address) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    memcpy(buffer, &g_flash.memory[address], length);
+    g_flash.reads++;
+    g_flash.bytes_read += length;
+    return HAL_SUCCESS;
+}
+
+/**
+ * @brief Program whole units, each once per erase
+ */
+static hal_result_t flash_write(uint32_t address, const uint8_t* data, size_t length) {
+    if (address > g_flash.geometry.size || length == 0 ||
+        length > g_flash.geometry.size - address) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if ((address % g_flash.unit) != 0 || (length % g_flash.unit) != 0) {
+        g_flash.misaligned++;
+        g_flash.violations++;
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    for (uint32_t u = address / g_flash.unit; u < (address + length) / g_flash.unit; u++) {
+        if (g_flash.programmed[u]) {
+            g_flash.reprograms++;
+            g_flash.violations++;
+            return HAL_ERROR_HARDWARE_FAILURE;
+        }
+    }
+    if (power_cut()) {
+        // Torn: the first half lands, the rest stays erased
+        memcpy(&g_flash.memory[address], data, length / 2U);
+        mark_programmed(address, length / 2U, true);
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+    if (g_flash.ordered < sizeof(g_flash.order) / sizeof(g_flash.order[0])) {
+        g_flash.order[g_flash.ordered++] = address;
+    }
+    memcpy(&g_flash.memory[address], data, length);
+    mark_programmed(address, length, true);
+    g_flash.bytes_programmed += length;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t flash_erase(uint32_t address, size_t length) {
+    uint32_t sector = g_flash.geometry.sector_size;
+
+    if ((address % sector) != 0 || (length % sector) != 0 ||
+        address > g_flash.geometry.size || length > g_flash.geometry.size - address) {
+        g_flash.violations++;
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    if (power_cut()) {
+        // Torn: the second half is erased, the first half, header included, survives
+        memset(&g_flash.memory[address + length / 2U], 0xFF, length / 2U);
+        mark_programmed(address + (uint32_t)(length / 2U), length / 2U, false);
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+    memset(&g_flash.memory[address], 0xFF, length);
+    mark_programmed(address, length, false);
+    for (size_t s = 0; s < length / sector; s++) {
+        g_flash.sector_erases[address / sector + s]++;
+    }
+    g_flash.erases += length / sector;
+    return HAL_SUCCESS;
+}
+
+static hal_result_t flash_flush(void) {
+    return g_flash.powered_off ? HAL_ERROR_HARDWARE_FAILURE : HAL_SUCCESS;
+}
+
+static storage_hal_t g_flash_hal = {
+    .get_info = flash_get_info,
+    .read = flash_read,
+    .write = flash_write,
+    .erase = flash_erase,
+    .flush = flash_flush,
+};
+
+bench_flash_t* bench_flash_init(const bench_flash_geometry_t* geometry) {
+    bench_flash_deinit();
+
+    g_flash.geometry = *geometry;
+    g_flash.unit = geometry->program_size ? geometry->program_size : geometry->page_size;
+    g_flash.memory = malloc(geometry->size);
+    g_flash.programmed = calloc(geometry->size / g_flash.unit, sizeof(bool));
+    g_flash.sector_erases = calloc(geometry->size / geometry->sector_size, sizeof(uint32_t));
+    if (!g_flash.memory || !g_flash.programmed || !g_flash.sector_erases) {
+        bench_flash_deinit();
+        return NULL;
+    }
+    memset(g_flash.memory, 0xFF, geometry->size);
+    g_flash.cut_after = -1;
+    return &g_flash;
+}
+
+void bench_flash_deinit(void) {
+    free(g_flash.memory);
+    free(g_flash.programmed);
+    free(g_flash.sector_erases);
+    memset(&g_flash, 0, sizeof(g_flash));
+}
+
+storage_hal_t* bench_flash_hal(void) {
+    return &g_flash_hal;
+}
+
+void bench_flash_fill(uint32_t address, size_t length, uint8_t value) {
+    memset(&g_flash.memory[address], value, length);
+    mark_programmed(address, length, value != 0xFF);
+}
+
+void bench_random_seed(uint32_t seed) {
+    g_rng = seed;
+}
+
+uint32_t bench_random(void) {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
@@ -0,0 +1,97 @@
+#ifndef STORAGE_BENCH_FLASH_H
+#define STORAGE_BENCH_FLASH_H
+
+/**
+ * @file storage_bench_flash.h
+ * @brief RAM Flash HAL Shared by the Storage Benchmarks
+ * @author USB Key Authentication Team
+ * @date 2025-09-26
+ * @version 1.0
+ *
+ * A storage_hal_t backed by host memory, shaped by a geometry: erase
+ * sector, program page and program unit (16-byte phrases on MCXA156, or
+ * whole pages). A write must cover whole program units, each programmed
+ * at most once per erase, as ECC flash requires; anything else is refused
+ * and counted. A power cut can be armed to fail the Nth write or erase
+ * half done. Host builds only: storage_fs_bench.c, storage_cache_bench.c,
+ * credential_log_bench.c, credential_index_bench.c and sign_counter_bench.c.
+ */
+
+#include "hal/interface/storage_hal.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief RAM flash geometry
+ */
+typedef struct {
+    uint32_t size;                  /**< Flash size */
+    uint32_t sector_size;           /**< Erase sector */
+    uint32_t page_size;             /**< Program page */
+    uint32_t program_size;          /**< Program unit reported in storage_info_t, 0 for pages */
+} bench_flash_geometry_t;
+
+/**
+ * @brief RAM flash state and counters
+ */
+typedef struct {
+    bench_flash_geometry_t geometry;        /**< Geometry */
+    uint32_t unit;                          /**< Program unit writes are checked against */
+    uint8_t* memory;                        /**< Flash contents */
+    bool* programmed;                       /**< Unit programmed since its erase */
+    uint32_t* sector_erases;                /**< Erases per sector */
+    uint64_t reads;                         /**< HAL read calls */
+    uint64_t bytes_read;                    /**< Bytes returned by HAL read */
+    uint64_t bytes_programmed;              /**< Bytes programmed */
+    uint64_t erases;                        /**< Sectors erased */
+    uint32_t violations;                    /**< Refused writes and erases */
+    uint32_t reprograms;                    /**< Writes refused: unit already programmed */
+    uint32_t misaligned;                    /**< Writes refused: not whole units */
+    uint32_t order[8];                      /**< Addresses of the first programs */
+    uint32_t ordered;                       /**< Programs logged in order */
+    int32_t cut_after;                      /**< Writes and erases until power fails, -1 never */
+    bool powered_off;                       /**< Cut happened, every operation fails */
+} bench_flash_t;
+
+/**
+ * @brief Create an erased RAM flash, replacing any previous one
+ *
+ * @param geometry Flash geometry; sizes must divide each other
+ * @return Flash state, NULL if out of memory
+ */
+bench_flash_t* bench_flash_init(const bench_flash_geometry_t* geometry);
+
+/**
+ * @brief Free the RAM flash
+ */
+void bench_flash_deinit(void);
+
+/**
+ * @brief HAL serving the RAM flash
+ */
+storage_hal_t* bench_flash_hal(void);
+
+/**
+ * @brief Overwrite flash contents outside the HAL
+ *
+ * 0xFF leaves the range erased; any other value leaves it programmed,
+ * like leftovers from earlier firmware or a damaged volume.
+ *
+ * @param address Start of the range
+ * @param length Bytes to fill, whole program units
+ * @param value Byte written
+ */
+void bench_flash_fill(uint32_t address, size_t length, uint8_t value);
+
+/**
+ * @brief Restart the benchmark random sequence
+ */
+void bench_random_seed(uint32_t seed);
+
+/**
+ * @brief Next value of a xorshift32 sequence (seed 0x9E3779B9 by default)
+ */
+uint32_t bench_random(void);
+
+#endif // STORAGE_BENCH_FLASH_H
@@ -0,0 +1,328 @@
+/**
+ * @file storage_cache.c
+ * @brief Page Write-Back Cache behind storage_platform_write_region()
+ * @author USB Key Authentication Team
+ * @date 2025-09-23
+ * @version 1.0
+ *
+ * A line keeps one flash page and a bit per program unit that waits for a
+ * commit. Victims are chosen least recently used. The line data sits in
+ * its own array so it can be placed in SRAMX. That section is NOLOAD, so
+ * nothing relies on it being zero: a line's data is only read after the
+ * line is filled.
+ */
+
+#include "storage_cache.h"
+#include <string.h>
+
+#define NO_LINE             0xFFFFFFFFUL        /**< No line holds the page */
+#define MAX_UNITS_PER_LINE  32U                 /**< Bits in a dirty mask */
+
+/** @brief Lines allocated; one even when caching is compiled out */
+#define LINE_COUNT          ((STORAGE_CACHE_LINES != 0U) ? STORAGE_CACHE_LINES : 1U)
+
+#if defined(MCXA156_SERIES)
+#define CACHE_SECTION       __attribute__((section(".sramx"), aligned(4)))
+#else
+#define CACHE_SECTION
+#endif
+
+/**
+ * @brief Cache line bookkeeping
+ */
+typedef struct {
+    uint32_t address;       /**< Page address */
+    uint32_t dirty;         /**< Program units to commit, one bit each */
+    uint32_t last_use;      /**< LRU stamp */
+    uint32_t first_dirty;   /**< Stamp of the write that made the line dirty */
+    bool valid;             /**< Holds a page */
+} cache_line_t;
+
+/**
+ * @brief Cache state
+ */
+typedef struct {
+    storage_hal_t* hal;                         /**< Storage HAL */
+    uint32_t page_size;                         /**< Line size, 0 when writes pass through */
+    uint32_t unit;                              /**< Program unit */
+    uint32_t clock;                             /**< LRU stamp source */
+    cache_line_t lines[LINE_COUNT];             /**< Line bookkeeping */
+    storage_cache_stats_t stats;                /**< Counters */
+} storage_cache_state_t;
+
+static storage_cache_state_t g_cache;
+static uint8_t g_line_data[LINE_COUNT][STORAGE_CACHE_LINE_SIZE] CACHE_SECTION;
+
+// ============================================================================
+// Lines
+// ============================================================================
+
+static hal_result_t program(uint32_t address, const uint8_t* data, size_t length) {
+    g_cache.stats.programs++;
+    g_cache.stats.bytes_programmed += (uint32_t)length;
+    hal_result_t result = g_cache.hal->write(address, data, length);
+    if (result != HAL_SUCCESS) {
+        g_cache.stats.errors++;
+    }
+    return result;
+}
+
+static uint32_t find_line(uint32_t page) {
+    for (uint32_t i = 0; i < STORAGE_CACHE_LINES; i++) {
+        if (g_cache.lines[i].valid && g_cache.lines[i].address == page) {
+            return i;
+        }
+    }
+    return NO_LINE;
+}
+
+/**
+ * @brief Program a line's dirty units, one HAL write per run
+ *
+ * A run that fails is reloaded from flash, so reads show what reached
+ * flash; the line's other runs are still programmed. Only if the reload
+ * fails too is the line dropped.
+ */
+static hal_result_t commit_line(uint32_t index) {
+    cache_line_t* line = &g_cache.lines[index];
+    uint32_t units = g_cache.page_size / g_cache.unit;
+    hal_result_t first_error = HAL_SUCCESS;
+
+    for (uint32_t u = 0; u < units;) {
+        if (!(line->dirty & (1UL << u))) {
+            u++;
+            continue;
+        }
+        uint32_t start = u;
+        while (u < units && (line->dirty & (1UL << u))) {
+            u++;
+        }
+        uint32_t address = line->address + start * g_cache.unit;
+        uint8_t* data = &g_line_data[index][start * g_cache.unit];
+        hal_result_t result = program(address, data, (u - start) * g_cache.unit);
+        if (result != HAL_SUCCESS) {
+            if (first_error == HAL_SUCCESS) {
+                first_error = result;
+            }
+            if (g_cache.hal->read(address, data, (u - start) * g_cache.unit) != HAL_SUCCESS) {
+                line->valid = false;
+            }
+        }
+    }
+
+    line->dirty = 0;
+    return first_error;
+}
+
+/**
+ * @brief Give a page a line: a free one or the least recently used
+ */
+static hal_result_t allocate_line(uint32_t page, uint32_t* index) {
+    uint32_t victim = 0;
+    for (uint32_t i = 0; i < STORAGE_CACHE_LINES; i++) {
+        if (!g_cache.lines[i].valid) {
+            victim = i;
+            break;
+        }
+        if (g_cache.lines[i].last_use < g_cache.lines[victim].last_use) {
+            victim = i;
+        }
+    }
+
+    cache_line_t* line = &g_cache.lines[victim];
+    if (line->valid && line->dirty) {
+        g_cache.stats.evictions++;
+        hal_result_t result = commit_line(victim);
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    }
+
+    // Units written only in part are programmed with what flash holds around them
+    line->valid = false;
+    g_cache.stats.fills++;
+    hal_result_t result = g_cache.hal->read(page, g_line_data[victim], g_cache.page_size);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    line->address = page;
+    line->dirty = 0;
+    line->valid = true;
+    *index = victim;
+    return HAL_SUCCESS;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+hal_result_t storage_cache_init(storage_hal_t* hal) {
+    if (!hal) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    storage_info_t info;
+    hal_result_t result = hal->get_info(&info);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    memset(&g_cache, 0, sizeof(g_cache));
+    g_cache.hal = hal;
+
+    uint32_t unit = (info.program_size != 0) ? info.program_size : info.page_size;
+    if (STORAGE_CACHE_LINES != 0U && info.page_size != 0 &&
+        info.page_size <= STORAGE_CACHE_LINE_SIZE && unit != 0 &&
+        (info.page_size % unit) == 0 && info.page_size / unit <= MAX_UNITS_PER_LINE) {
+        g_cache.page_size = info.page_size;
+        g_cache.unit = unit;
+    }
+
+    return HAL_SUCCESS;
+}
+
+void storage_cache_deinit(void) {
+    memset(&g_cache, 0, sizeof(g_cache));
+}
+
+hal_result_t storage_cache_write(uint32_t address, const uint8_t* data, size_t length) {
+    if (!g_cache.hal) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    if (!data) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    g_cache.stats.writes++;
+    g_cache.stats.bytes_written += (uint32_t)length;
+
+    if (g_cache.page_size == 0) {
+        return program(address, data, length);
+    }
+
+    while (length > 0) {
+        uint32_t page = address - (address % g_cache.page_size);
+        uint32_t offset = address - page;
+        size_t chunk = g_cache.page_size - offset;
+        if (chunk > length) {
+            chunk = length;
+        }
+
+        uint32_t index = find_line(page);
+        if (index == NO_LINE) {
+            hal_result_t result = allocate_line(page, &index);
+            if (result != HAL_SUCCESS) {
+                return result;
+            }
+        }
+
+        cache_line_t* line = &g_cache.lines[index];
+        if (!line->dirty) {
+            line->first_dirty = g_cache.clock + 1U;
+        }
+        memcpy(&g_line_data[index][offset], data, chunk);
+        for (uint32_t u = offset / g_cache.unit;
+             u <= (offset + (uint32_t)chunk - 1U) / g_cache.unit; u++) {
+            line->dirty |= 1UL << u;
+        }
+        line->last_use = ++g_cache.clock;
+
+        address += (uint32_t)chunk;
+        data += chunk;
+        length -= chunk;
+    }
+
+    return HAL_SUCCESS;
+}
+
+void storage_cache_overlay(uint32_t address, uint8_t* buffer, size_t length) {
+    if (!buffer || g_cache.page_size == 0) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < STORAGE_CACHE_LINES; i++) {
+        const cache_line_t* line = &g_cache.lines[i];
+        if (!line->valid || !line->dirty || line->address + g_cache.page_size <= address ||
+            line->address >= address + length) {
+            continue;
+        }
+
+        // Only dirty units differ from flash
+        uint32_t from = (line->address > address) ? line->address : address;
+        uint32_t to = line->address + g_cache.page_size;
+        if (to > address + length) {
+            to = address + (uint32_t)length;
+        }
+        for (uint32_t a = from; a < to; a++) {
+            uint32_t offset = a - line->address;
+            if (line->dirty & (1UL << (offset / g_cache.unit))) {
+                buffer[a - address] = g_line_data[i][offset];
+            }
+        }
+    }
+}
+
+void storage_cache_discard(uint32_t address, size_t length) {
+    for (uint32_t i = 0; i < STORAGE_CACHE_LINES && g_cache.page_size != 0; i++) {
+        cache_line_t* line = &g_cache.lines[i];
+        if (line->valid && line->address + g_cache.page_size > address &&
+            line->address < address + length) {
+            line->valid = false;
+            line->dirty = 0;
+        }
+    }
+}
+
+hal_result_t storage_cache_commit(void) {
+    if (!g_cache.hal) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+
+    hal_result_t first_error = HAL_SUCCESS;
+    bool programmed = false;
+
+    // Write order: the line dirtied first since the last commit goes first
+    for (;;) {
+        uint32_t next = NO_LINE;
+        for (uint32_t i = 0; i < STORAGE_CACHE_LINES; i++) {
+            if (g_cache.lines[i].valid && g_cache.lines[i].dirty &&
+                (next == NO_LINE ||
+                 g_cache.lines[i].first_dirty < g_cache.lines[next].first_dirty)) {
+                next = i;
+            }
+        }
+        if (next == NO_LINE) {
+            break;
+        }
+
+        programmed = true;
+        hal_result_t result = commit_line(next);
+        if (result != HAL_SUCCESS && first_error == HAL_SUCCESS) {
+            first_error = result;
+        }
+    }
+
+    if (programmed) {
+        g_cache.stats.commits++;
+    }
+    return first_error;
+}
+
+bool storage_cache_dirty(void) {
+    for (uint32_t i = 0; i < STORAGE_CACHE_LINES; i++) {
+        if (g_cache.lines[i].valid && g_cache.lines[i].dirty) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void storage_cache_get_stats(storage_cache_stats_t* stats) {
+    if (!stats) {
+        return;
+    }
+
+    *stats = g_cache.stats;
+}
@@ -0,0 +1,126 @@
+#ifndef STORAGE_CACHE_H
+#define STORAGE_CACHE_H
+
+/**
+ * @file storage_cache.h
+ * @brief Page Write-Back Cache behind storage_platform_write_region()
+ * @author USB Key Authentication Team
+ * @date 2025-09-23
+ * @version 1.0
+ *
+ * Raw region writes land in page-sized cache lines instead of going
+ * straight to hal->write(). A line is filled from flash when it is
+ * allocated, and each write marks the program units it touches dirty
+ * (16-byte phrases on MCXA156, storage_info_t.program_size, or whole
+ * pages). Writes to the same or adjacent units merge. A commit programs
+ * every run of dirty units in one HAL write, so a fully written page is
+ * one page program, and a small unaligned write is one phrase program
+ * padded with what the flash already holds.
+ *
+ * Lines are committed by storage_cache_commit() (the platform's barrier,
+ * called at the end of each CTAP request, from idle time and after every
+ * write to a STORAGE_FLAG_ATOMIC region) or when a line is evicted to make
+ * room. Until then reads see the cached data.
+ * A commit programs lines in the order they became dirty, but a line
+ * carries all its writes, including ones made after a later line's, and
+ * eviction commits out of turn. A caller that needs one write durable
+ * before another issues a barrier between them.
+ *
+ * The lines live in SRAMX (m_sramx0, section .sramx) on MCXA156, away from
+ * the main data RAM.
+ *
+ * @warning Not thread-safe; call from the task that owns the storage platform.
+ */
+
+#include "hal/interface/storage_hal.h"
+
+/** @brief Cache lines, one flash page each; 0 passes writes straight through */
+#ifndef STORAGE_CACHE_LINES
+#define STORAGE_CACHE_LINES         8U
+#endif
+
+/** @brief Largest page size cached (line size) */
+#ifndef STORAGE_CACHE_LINE_SIZE
+#define STORAGE_CACHE_LINE_SIZE     128U
+#endif
+
+/**
+ * @brief Cache counters
+ */
+typedef struct {
+    uint32_t writes;                /**< storage_cache_write() calls */
+    uint32_t bytes_written;         /**< Bytes passed to storage_cache_write() */
+    uint32_t programs;              /**< HAL write calls */
+    uint32_t bytes_programmed;      /**< Bytes passed to HAL write */
+    uint32_t fills;                 /**< Lines read from flash on allocation */
+    uint32_t evictions;             /**< Dirty lines committed to make room */
+    uint32_t commits;               /**< storage_cache_commit() calls that programmed */
+    uint32_t errors;                /**< Failed programs (the run is reloaded from flash) */
+} storage_cache_stats_t;
+
+/**
+ * @brief Start caching writes to a storage HAL
+ *
+ * Writes pass straight through when the HAL has no page size, or pages
+ * larger than STORAGE_CACHE_LINE_SIZE.
+ *
+ * @param hal Storage HAL
+ * @return HAL_SUCCESS on success, error code otherwise
+ */
+hal_result_t storage_cache_init(storage_hal_t* hal);
+
+/**
+ * @brief Stop caching; dirty lines are dropped, commit first
+ */
+void storage_cache_deinit(void);
+
+/**
+ * @brief Write through the cache
+ *
+ * @param address Physical address
+ * @param data Data to program
+ * @param length Size of data
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_HARDWARE_FAILURE Fill read, or the commit of an evicted line, failed
+ */
+hal_result_t storage_cache_write(uint32_t address, const uint8_t* data, size_t length);
+
+/**
+ * @brief Lay cached data over a buffer just read from flash
+ *
+ * @param address Physical address the buffer was read from
+ * @param buffer Data read
+ * @param length Size of buffer
+ */
+void storage_cache_overlay(uint32_t address, uint8_t* buffer, size_t length);
+
+/**
+ * @brief Drop cached lines in a range about to be erased
+ *
+ * @param address Physical address
+ * @param length Size of the range
+ */
+void storage_cache_discard(uint32_t address, size_t length);
+
+/**
+ * @brief Program every dirty line
+ *
+ * @return HAL_SUCCESS on success, the first error otherwise (failed runs are dropped)
+ */
+hal_result_t storage_cache_commit(void);
+
+/**
+ * @brief Check whether any line waits for a commit
+ *
+ * @return true if a commit would program flash
+ */
+bool storage_cache_dirty(void);
+
+/**
+ * @brief Read the cache counters
+ *
+ * @param stats Output counters
+ */
+void storage_cache_get_stats(storage_cache_stats_t* stats);
+
+#endif // STORAGE_CACHE_H
@@ -0,0 +1,354 @@
+/**
+ * @file storage_cache_bench.c
+ * @brief Host-side benchmark of flash programs per CTAP request
+ * @author USB Key Authentication Team
+ * @date 2025-09-23
+ * @version 1.0
+ *
+ * Runs get_storage_platform() on a RAM flash HAL shaped like the MCXA156
+ * internal flash (8 KB sectors, 128-byte pages, 16-byte phrases). A phrase
+ * can only be programmed while fully erased, as ECC requires. Each request
+ * writes the way request handlers do, one field at a time:
+ * - an audit entry of 4 fields in a 32-byte slot of the LOGS region
+ * - every 2nd request, a PIN retry record of 3 fields in a 16-byte slot
+ * - every 8th request, a 300-byte user data blob in one write to the
+ *   STORAGE_FLAG_ATOMIC region, which must be in flash when it returns
+ * It then calls barrier(). The same requests run twice:
+ * - write-through: a barrier after every write, as when each write went
+ *   straight to hal->write()
+ * - write-back: one barrier per request
+ * Reports programs and bytes programmed per request from
+ * get_platform_stats(), and the phrases each mode tried to program twice.
+ * Write-back must read every record back intact, before and after its
+ * barrier, and must never program a phrase twice. Finally the cache alone
+ * must commit pages in the order they were dirtied, and a commit that
+ * fails one run must still program the page's other runs.
+ *
+ * Build and run on Linux from the repository root:
+ * @code
+ * LFS=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/littlefs
+ * gcc -std=c11 -O2 -DLFS_NO_MALLOC -I src -I src/platform/storage -I $LFS \
+ *     src/platform/storage/storage_cache_bench.c src/platform/storage/storage_cache.c \
+ *     src/platform/storage/storage_platform.c src/platform/storage/storage_fs.c \
+ *     src/platform/storage/storage_bench_flash.c $LFS/lfs.c $LFS/lfs_util.c \
+ *     -o storage_cache_bench
+ * ./storage_cache_bench [-r requests] > /dev/null
+ * @endcode
+ * The report goes to stderr, past the platform's log lines.
+ *
+ * Options:
+ * - -r  Requests per mode (default 5000)
+ */
+
+#include "storage_platform.h"
+#include "storage_cache.h"
+#include "storage_bench_flash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_FLASH_SIZE        (256U * 1024U)  /**< RAM flash size */
+#define BENCH_SECTOR_SIZE       8192U           /**< Erase sector */
+#define BENCH_PAGE_SIZE         128U            /**< Program page */
+#define BENCH_PHRASE_SIZE       16U             /**< Program unit */
+
+#define LOG_BASE                0x00000U        /**< LOGS region */
+#define LOG_SIZE                (64U * 1024U)
+#define LOG_SLOT                32U             /**< Audit entry slot */
+#define PIN_BASE                0x10000U        /**< PIN_DATA region */
+#define PIN_SIZE                (16U * 1024U)
+#define PIN_SLOT                16U             /**< Retry record slot */
+#define USER_BASE               0x20000U        /**< USER_DATA region */
+#define USER_SIZE               (128U * 1024U)
+#define USER_BLOB               300U            /**< Blob size */
+#define USER_SLOT               304U            /**< Blob slot, phrase aligned */
+
+void storage_platform_init_interface(void);
+storage_platform_t* get_storage_platform(void);
+
+// ============================================================================
+// Workload
+// ============================================================================
+
+/**
+ * @brief Append position in one region
+ */
+typedef struct {
+    storage_region_t region;    /**< Region */
+    uint32_t size;              /**< Region size */
+    uint32_t slot;              /**< Record slot */
+    uint32_t next;              /**< Offset of the next slot */
+} bench_log_t;
+
+/**
+ * @brief One mode's run
+ */
+typedef struct {
+    bool write_back;            /**< One barrier per request, not per write */
+    uint32_t requests;          /**< Requests run */
+    uint32_t programs;          /**< HAL programs */
+    uint32_t bytes;             /**< Bytes programmed */
+    uint32_t erases;            /**< Region erases */
+    uint32_t reprograms;        /**< Programs refused by the flash */
+    uint32_t misaligned;        /**< Programs the HAL would have widened */
+    uint32_t mismatches;        /**< Records that read back wrong */
+} bench_run_t;
+
+static const bench_flash_geometry_t g_geometry = {
+    .size = BENCH_FLASH_SIZE,
+    .sector_size = BENCH_SECTOR_SIZE,
+    .page_size = BENCH_PAGE_SIZE,
+    .program_size = BENCH_PHRASE_SIZE,
+};
+
+static bench_flash_t* g_flash;
+static storage_platform_t* g_platform;
+
+/**
+ * @brief Take the next slot, erasing the region when it is full
+ */
+static uint32_t take_slot(bench_log_t* log, bench_run_t* run) {
+    if (log->next + log->slot > log->size) {
+        g_platform->erase_region(log->region);
+        run->erases++;
+        log->next = 0;
+    }
+    uint32_t offset = log->next;
+    log->next += log->slot;
+    return offset;
+}
+
+static void write_field(bench_run_t* run, storage_region_t region, uint32_t offset,
+                        const uint8_t* data, size_t length) {
+    g_platform->write_region(region, offset, data, length);
+    if (!run->write_back) {
+        g_platform->barrier();
+    }
+}
+
+static void check(bench_run_t* run, storage_region_t region, uint32_t offset,
+                  const uint8_t* expected, size_t length) {
+    uint8_t actual[USER_BLOB];
+    if (g_platform->read_region(region, offset, actual, length) != HAL_SUCCESS ||
+        memcmp(actual, expected, length) != 0) {
+        run->mismatches++;
+    }
+}
+
+static void run_requests(bench_run_t* run) {
+    bench_log_t logs = { STORAGE_REGION_LOGS, LOG_SIZE, LOG_SLOT, 0 };
+    bench_log_t pins = { STORAGE_REGION_PIN_DATA, PIN_SIZE, PIN_SLOT, 0 };
+    bench_log_t users = { STORAGE_REGION_USER_DATA, USER_SIZE, USER_SLOT, 0 };
+    uint8_t entry[LOG_SLOT];
+    uint8_t pin[PIN_SLOT];
+    uint8_t blob[USER_BLOB];
+
+    bench_random_seed(0x9E3779B9U);
+    for (uint32_t n = 0; n < run->requests; n++) {
+        // Audit entry: type, time, rpIdHash prefix, detail
+        for (uint32_t i = 0; i < sizeof(entry); i++) {
+            entry[i] = (uint8_t)bench_random();
+        }
+        uint32_t entry_at = take_slot(&logs, run);
+        write_field(run, logs.region, entry_at, &entry[0], 4);
+        write_field(run, logs.region, entry_at + 4U, &entry[4], 4);
+        write_field(run, logs.region, entry_at + 8U, &entry[8], 8);
+        write_field(run, logs.region, entry_at + 16U, &entry[16], 16);
+
+        // PIN retries: count, flags, check value
+        uint32_t pin_at = 0;
+        if ((n % 2U) == 0) {
+            for (uint32_t i = 0; i < sizeof(pin); i++) {
+                pin[i] = (uint8_t)bench_random();
+            }
+            pin_at = take_slot(&pins, run);
+            write_field(run, pins.region, pin_at, &pin[0], 4);
+            write_field(run, pins.region, pin_at + 4U, &pin[4], 4);
+            write_field(run, pins.region, pin_at + 8U, &pin[8], 8);
+        }
+
+        // User data blob: an atomic record, written whole and durable at once
+        uint32_t blob_at = 0;
+        if ((n % 8U) == 0) {
+            for (uint32_t i = 0; i < sizeof(blob); i++) {
+                blob[i] = (uint8_t)bench_random();
+            }
+            blob_at = take_slot(&users, run);
+            write_field(run, users.region, blob_at, blob, sizeof(blob));
+            if (memcmp(&g_flash->memory[USER_BASE + blob_at], blob, sizeof(blob)) != 0) {
+                run->mismatches++;
+            }
+        }
+
+        // Reads see the request's writes before and after the barrier
+        for (int pass = 0; pass < 2; pass++) {
+            if (pass == 1) {
+                g_platform->barrier();
+            }
+            if (!run->write_back) {
+                continue;
+            }
+            check(run, logs.region, entry_at, entry, sizeof(entry));
+            if ((n % 2U) == 0) {
+                check(run, pins.region, pin_at, pin, sizeof(pin));
+            }
+            if ((n % 8U) == 0) {
+                check(run, users.region, blob_at, blob, sizeof(blob));
+            }
+        }
+    }
+}
+
+static int run_mode(bench_run_t* run) {
+    g_flash = bench_flash_init(&g_geometry);
+    if (!g_flash) {
+        return 1;
+    }
+
+    storage_platform_init_interface();
+    g_platform = get_storage_platform();
+    storage_region_config_t regions[] = {
+        { .region = STORAGE_REGION_LOGS, .base_address = LOG_BASE, .size = LOG_SIZE },
+        { .region = STORAGE_REGION_PIN_DATA, .base_address = PIN_BASE, .size = PIN_SIZE },
+        { .region = STORAGE_REGION_USER_DATA, .base_address = USER_BASE, .size = USER_SIZE,
+          .flags = STORAGE_FLAG_ATOMIC },
+    };
+    if (g_platform->init(bench_flash_hal(), NULL) != HAL_SUCCESS) {
+        return 1;
+    }
+    for (uint32_t i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+        if (g_platform->configure_region(regions[i].region, &regions[i]) != HAL_SUCCESS) {
+            return 1;
+        }
+    }
+
+    storage_stats_t before;
+    storage_stats_t after;
+    g_platform->get_platform_stats(&before);
+    storage_cache_stats_t cache_before;
+    storage_cache_get_stats(&cache_before);
+
+    run_requests(run);
+
+    g_platform->get_platform_stats(&after);
+    storage_cache_stats_t cache_after;
+    storage_cache_get_stats(&cache_after);
+    run->programs = after.total_writes - before.total_writes;
+    run->bytes = cache_after.bytes_programmed - cache_before.bytes_programmed;
+    run->reprograms = g_flash->reprograms;
+    run->misaligned = g_flash->misaligned;
+    g_platform->deinit();
+    return 0;
+}
+
+/**
+ * @brief Check commit order and failure handling on the cache directly
+ *
+ * Pages 2, 0, 1 are dirtied in that order and must be programmed in that
+ * order. Then page 3 gets two separate runs, the first onto a phrase the
+ * flash refuses: the commit must fail, still program the second run, and
+ * reads must show flash for the first.
+ *
+ * @return Failed checks
+ */
+static uint32_t check_commit(void) {
+    static const uint32_t pages[] = { 2U, 0U, 1U };
+    uint8_t data[BENCH_PHRASE_SIZE];
+    uint8_t actual[BENCH_PHRASE_SIZE];
+    uint32_t failures = 0;
+
+    g_flash = bench_flash_init(&g_geometry);
+    if (!g_flash) {
+        return 1;
+    }
+    memset(data, 0xA5, sizeof(data));
+    if (storage_cache_init(bench_flash_hal()) != HAL_SUCCESS) {
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < 3U; i++) {
+        storage_cache_write(pages[i] * BENCH_PAGE_SIZE, data, sizeof(data));
+    }
+    storage_cache_write(0, data, sizeof(data));     // rewrite keeps page 0's turn
+    if (storage_cache_commit() != HAL_SUCCESS || g_flash->ordered != 3U) {
+        failures++;
+    }
+    for (uint32_t i = 0; i < 3U && i < g_flash->ordered; i++) {
+        if (g_flash->order[i] != pages[i] * BENCH_PAGE_SIZE) {
+            fprintf(stderr, "  commit order: program %u went to 0x%x\n", (unsigned)i,
+                    (unsigned)g_flash->order[i]);
+            failures++;
+        }
+    }
+
+    uint32_t page = 3U * BENCH_PAGE_SIZE;
+    g_flash->programmed[page / BENCH_PHRASE_SIZE] = true;
+    storage_cache_write(page, data, sizeof(data));
+    storage_cache_write(page + 2U * BENCH_PHRASE_SIZE, data, sizeof(data));
+    if (storage_cache_commit() == HAL_SUCCESS || storage_cache_dirty() ||
+        memcmp(&g_flash->memory[page + 2U * BENCH_PHRASE_SIZE], data, sizeof(data)) != 0) {
+        fprintf(stderr, "  failed commit: other run of the page not programmed\n");
+        failures++;
+    }
+    memset(actual, 0, sizeof(actual));
+    storage_cache_overlay(page, actual, sizeof(actual));
+    if (actual[0] != 0) {
+        fprintf(stderr, "  failed commit: rejected run still overlays reads\n");
+        failures++;
+    }
+
+    storage_cache_deinit();
+    bench_flash_deinit();
+    return failures;
+}
+
+static void report(const char* name, const bench_run_t* run) {
+    fprintf(stderr, "  %-14s %6.3f programs  %7.1f bytes programmed per request, "
+            "%u phrases programmed twice\n", name, (double)run->programs / run->requests,
+            (double)run->bytes / run->requests, (unsigned)run->reprograms);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    uint32_t requests = 5000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            requests = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "usage: %s [-r requests]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (requests == 0) {
+        fprintf(stderr, "need at least one request\n");
+        return 2;
+    }
+
+    bench_run_t through = { .write_back = false, .requests = requests };
+    bench_run_t back = { .write_back = true, .requests = requests };
+    if (run_mode(&through) != 0 || run_mode(&back) != 0) {
+        fprintf(stderr, "platform setup failed\n");
+        return 1;
+    }
+
+    // Writes per request: 4 audit fields, 3/2 PIN fields, 1/8 blob
+    fprintf(stderr, "storage_cache: %u requests, %.3f writes each, %u cache lines of %u bytes\n",
+            (unsigned)requests, 4.0 + 3.0 / 2.0 + 1.0 / 8.0, (unsigned)STORAGE_CACHE_LINES,
+            (unsigned)STORAGE_CACHE_LINE_SIZE);
+    report("write-through:", &through);
+    report("write-back:", &back);
+    fprintf(stderr, "  region erases: %u, records read back wrong: %u\n", (unsigned)back.erases,
+            (unsigned)back.mismatches);
+
+    uint32_t commit_failures = check_commit();
+    fprintf(stderr, "  commit order and failed runs: %s\n", commit_failures ? "FAIL" : "ok");
+
+    bool pass = (back.reprograms == 0 && back.misaligned == 0 && back.mismatches == 0 &&
+                 commit_failures == 0);
+    fprintf(stderr, "%s\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
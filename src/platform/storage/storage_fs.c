@@ -0,0 +1,516 @@
+/**
+ * @file storage_fs.c
+ * @brief littlefs File Layer Behind storage_platform_t
+ * @author USB Key Authentication Team
+ * @date 2025-09-19
+ * @version 1.0
+ *
+ * The block device is the region's slice of the storage HAL: block b,
+ * offset o maps to base_address + b * STORAGE_FS_BLOCK_SIZE + o. littlefs
+ * only programs erased, prog_size-aligned pages and erases whole blocks,
+ * which is what the flash driver needs.
+ */
+
+#include "storage_fs.h"
+#include "lfs.h"
+#include <stdio.h>
+#include <string.h>
+
+#if (STORAGE_FS_CACHE_SIZE % STORAGE_FS_PROG_SIZE) != 0 || \
+    (STORAGE_FS_CACHE_SIZE % STORAGE_FS_READ_SIZE) != 0 || \
+    (STORAGE_FS_BLOCK_SIZE % STORAGE_FS_CACHE_SIZE) != 0
+#error "STORAGE_FS_CACHE_SIZE must divide the block and be a multiple of the read and program sizes"
+#endif
+
+#if (STORAGE_FS_LOOKAHEAD_SIZE % 4U) != 0 || STORAGE_FS_LOOKAHEAD_SIZE == 0
+#error "STORAGE_FS_LOOKAHEAD_SIZE must be a non-zero multiple of 4"
+#endif
+
+/** @brief Name buffer for "%08lx" plus terminator */
+#define STORAGE_FS_NAME_SIZE    9U
+
+// ============================================================================
+// State
+// ============================================================================
+
+/**
+ * @brief One mounted littlefs volume
+ */
+typedef struct {
+    lfs_t lfs;                                              /**< littlefs instance */
+    struct lfs_config config;                               /**< Geometry and callbacks */
+    storage_hal_t* hal;                                     /**< Underlying device */
+    uint32_t base_address;                                  /**< First byte of block 0 */
+    storage_region_t region;                                /**< Owning region */
+    bool mounted;                                           /**< Slot in use */
+    uint8_t read_buffer[STORAGE_FS_CACHE_SIZE];             /**< littlefs read cache */
+    uint8_t prog_buffer[STORAGE_FS_CACHE_SIZE];             /**< littlefs program cache */
+    uint32_t lookahead_buffer[STORAGE_FS_LOOKAHEAD_SIZE / 4U]; /**< Free-block bitmap */
+} storage_fs_volume_t;
+
+/**
+ * @brief One open file
+ */
+typedef struct {
+    lfs_file_t file;                                        /**< littlefs file */
+    struct lfs_file_config config;                          /**< Points at cache */
+    storage_fs_volume_t* volume;                            /**< Volume the file is on */
+    uint32_t file_id;                                       /**< File ID */
+    bool in_use;                                            /**< Slot in use */
+    uint8_t cache[STORAGE_FS_CACHE_SIZE];                   /**< Per-file cache */
+} storage_fs_file_t;
+
+/** @brief Volume table */
+static storage_fs_volume_t g_fs_volumes[STORAGE_FS_MAX_VOLUMES];
+
+/** @brief Open file table */
+static storage_fs_file_t g_fs_files[STORAGE_FS_MAX_OPEN_FILES];
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+/**
+ * @brief Map a littlefs error to a HAL result
+ *
+ * @param err littlefs return value, negative on error
+ * @return HAL result
+ */
+static hal_result_t fs_result(int err) {
+    switch (err) {
+        case LFS_ERR_OK:
+            return HAL_SUCCESS;
+        case LFS_ERR_NOSPC:
+        case LFS_ERR_NOMEM:
+        case LFS_ERR_FBIG:
+            return HAL_ERROR_INSUFFICIENT_MEMORY;
+        case LFS_ERR_INVAL:
+        case LFS_ERR_NAMETOOLONG:
+            return HAL_ERROR_INVALID_PARAM;
+        default:
+            return HAL_ERROR_HARDWARE_FAILURE;
+    }
+}
+
+/**
+ * @brief Map a HAL result to a littlefs error for the block device
+ *
+ * @param result HAL result
+ * @return littlefs error
+ */
+static int bd_error(hal_result_t result) {
+    return (result == HAL_SUCCESS) ? LFS_ERR_OK : LFS_ERR_IO;
+}
+
+/**
+ * @brief Find the volume of a region
+ *
+ * @param region Region
+ * @return Mounted volume, NULL if none
+ */
+static storage_fs_volume_t* find_volume(storage_region_t region) {
+    for (uint32_t i = 0; i < STORAGE_FS_MAX_VOLUMES; i++) {
+        if (g_fs_volumes[i].mounted && g_fs_volumes[i].region == region) {
+            return &g_fs_volumes[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find the slot of an open file
+ *
+ * @param region Region of the file
+ * @param file_id File ID
+ * @return Open slot, NULL if the file is not open
+ */
+static storage_fs_file_t* find_file(storage_region_t region, uint32_t file_id) {
+    for (uint32_t i = 0; i < STORAGE_FS_MAX_OPEN_FILES; i++) {
+        storage_fs_file_t* slot = &g_fs_files[i];
+        if (slot->in_use && slot->volume->region == region && slot->file_id == file_id) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find the slot behind an open handle
+ *
+ * @param file Handle
+ * @return Open slot, NULL if the handle is not open
+ */
+static storage_fs_file_t* handle_slot(const storage_file_t* file) {
+    if (!file || !file->is_open) {
+        return NULL;
+    }
+    return find_file(file->region, file->file_id);
+}
+
+/**
+ * @brief Name of a file inside its volume
+ *
+ * @param file_id File ID
+ * @param name Output STORAGE_FS_NAME_SIZE bytes
+ */
+static void file_name(uint32_t file_id, char* name) {
+    snprintf(name, STORAGE_FS_NAME_SIZE, "%08lx", (unsigned long)file_id);
+}
+
+// ============================================================================
+// Block Device
+// ============================================================================
+
+static int bd_read(const struct lfs_config* c, lfs_block_t block, lfs_off_t off,
+                   void* buffer, lfs_size_t size) {
+    const storage_fs_volume_t* volume = (const storage_fs_volume_t*)c->context;
+    uint32_t address = volume->base_address + block * c->block_size + off;
+    return bd_error(volume->hal->read(address, (uint8_t*)buffer, size));
+}
+
+static int bd_prog(const struct lfs_config* c, lfs_block_t block, lfs_off_t off,
+                   const void* buffer, lfs_size_t size) {
+    const storage_fs_volume_t* volume = (const storage_fs_volume_t*)c->context;
+    uint32_t address = volume->base_address + block * c->block_size + off;
+    return bd_error(volume->hal->write(address, (const uint8_t*)buffer, size));
+}
+
+static int bd_erase(const struct lfs_config* c, lfs_block_t block) {
+    const storage_fs_volume_t* volume = (const storage_fs_volume_t*)c->context;
+    uint32_t address = volume->base_address + block * c->block_size;
+    return bd_error(volume->hal->erase(address, c->block_size));
+}
+
+static int bd_sync(const struct lfs_config* c) {
+    const storage_fs_volume_t* volume = (const storage_fs_volume_t*)c->context;
+    if (!volume->hal->flush) {
+        return LFS_ERR_OK;
+    }
+    return bd_error(volume->hal->flush());
+}
+
+// ============================================================================
+// Volumes
+// ============================================================================
+
+/**
+ * @brief Check that a volume's region reads as erased flash
+ *
+ * Borrows the volume's read cache, so call it before mounting.
+ *
+ * @param volume Volume with its configuration filled in
+ * @return true if every byte reads 0xFF
+ */
+static bool volume_erased(storage_fs_volume_t* volume) {
+    const struct lfs_config* config = &volume->config;
+    uint32_t size = config->block_count * config->block_size;
+
+    for (uint32_t offset = 0; offset < size; offset += sizeof(volume->read_buffer)) {
+        if (volume->hal->read(volume->base_address + offset, volume->read_buffer,
+                              sizeof(volume->read_buffer)) != HAL_SUCCESS) {
+            return false;
+        }
+        for (uint32_t i = 0; i < sizeof(volume->read_buffer); i++) {
+            if (volume->read_buffer[i] != 0xFFU) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+hal_result_t storage_fs_mount(storage_hal_t* hal, storage_region_t region,
+                              uint32_t base_address, uint32_t size, bool format) {
+    if (!hal || region >= STORAGE_REGION_MAX) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (find_volume(region)) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    storage_info_t info;
+    hal_result_t result = hal->get_info(&info);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    if ((base_address % STORAGE_FS_BLOCK_SIZE) != 0 || (size % STORAGE_FS_BLOCK_SIZE) != 0 ||
+        size < 2U * STORAGE_FS_BLOCK_SIZE ||
+        (info.sector_size != 0 && (STORAGE_FS_BLOCK_SIZE % info.sector_size) != 0) ||
+        (info.page_size != 0 && (STORAGE_FS_PROG_SIZE % info.page_size) != 0)) {
+        printf("[STORAGE_FS] Region %d does not fit %u-byte blocks\n", region,
+               (unsigned)STORAGE_FS_BLOCK_SIZE);
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    storage_fs_volume_t* volume = NULL;
+    for (uint32_t i = 0; i < STORAGE_FS_MAX_VOLUMES; i++) {
+        if (!g_fs_volumes[i].mounted) {
+            volume = &g_fs_volumes[i];
+            break;
+        }
+    }
+    if (!volume) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    memset(volume, 0, sizeof(*volume));
+    volume->hal = hal;
+    volume->base_address = base_address;
+    volume->region = region;
+
+    struct lfs_config* config = &volume->config;
+    config->context = volume;
+    config->read = bd_read;
+    config->prog = bd_prog;
+    config->erase = bd_erase;
+    config->sync = bd_sync;
+    config->read_size = STORAGE_FS_READ_SIZE;
+    config->prog_size = STORAGE_FS_PROG_SIZE;
+    config->block_size = STORAGE_FS_BLOCK_SIZE;
+    config->block_count = size / STORAGE_FS_BLOCK_SIZE;
+    config->block_cycles = STORAGE_FS_BLOCK_CYCLES;
+    config->cache_size = STORAGE_FS_CACHE_SIZE;
+    config->lookahead_size = STORAGE_FS_LOOKAHEAD_SIZE;
+    config->read_buffer = volume->read_buffer;
+    config->prog_buffer = volume->prog_buffer;
+    config->lookahead_buffer = volume->lookahead_buffer;
+    config->name_max = STORAGE_FS_NAME_SIZE - 1U;
+
+    int err = LFS_ERR_CORRUPT;
+    if (!format) {
+        err = lfs_mount(&volume->lfs, config);
+        // Only blank flash gets a new volume; anything else may be data worth recovering
+        if (err != LFS_ERR_OK && volume_erased(volume)) {
+            format = true;
+        }
+    }
+    if (format) {
+        printf("[STORAGE_FS] Formatting region %d (%lu blocks)\n", region,
+               (unsigned long)config->block_count);
+        err = lfs_format(&volume->lfs, config);
+        if (err == LFS_ERR_OK) {
+            err = lfs_mount(&volume->lfs, config);
+        }
+    }
+    if (err != LFS_ERR_OK) {
+        printf("[STORAGE_FS] Mount failed for region %d: %d\n", region, err);
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    volume->mounted = true;
+    return HAL_SUCCESS;
+}
+
+hal_result_t storage_fs_unmount(storage_region_t region) {
+    storage_fs_volume_t* volume = find_volume(region);
+    if (!volume) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    hal_result_t result = HAL_SUCCESS;
+    for (uint32_t i = 0; i < STORAGE_FS_MAX_OPEN_FILES; i++) {
+        storage_fs_file_t* slot = &g_fs_files[i];
+        if (slot->in_use && slot->volume == volume) {
+            int err = lfs_file_close(&volume->lfs, &slot->file);
+            if (err != LFS_ERR_OK && result == HAL_SUCCESS) {
+                result = fs_result(err);
+            }
+            slot->in_use = false;
+        }
+    }
+
+    lfs_unmount(&volume->lfs);
+    volume->mounted = false;
+    return result;
+}
+
+void storage_fs_unmount_all(void) {
+    for (uint32_t i = 0; i < STORAGE_FS_MAX_VOLUMES; i++) {
+        if (g_fs_volumes[i].mounted) {
+            storage_fs_unmount(g_fs_volumes[i].region);
+        }
+    }
+}
+
+bool storage_fs_is_mounted(storage_region_t region) {
+    return find_volume(region) != NULL;
+}
+
+hal_result_t storage_fs_gc(storage_region_t region) {
+    if (region < STORAGE_REGION_MAX && !find_volume(region)) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    hal_result_t result = HAL_SUCCESS;
+
+    for (uint32_t i = 0; i < STORAGE_FS_MAX_VOLUMES; i++) {
+        storage_fs_volume_t* volume = &g_fs_volumes[i];
+        if (!volume->mounted || (region < STORAGE_REGION_MAX && volume->region != region)) {
+            continue;
+        }
+        int err = lfs_fs_gc(&volume->lfs);
+        if (err != LFS_ERR_OK && result == HAL_SUCCESS) {
+            result = fs_result(err);
+        }
+    }
+
+    return result;
+}
+
+hal_result_t storage_fs_used(storage_region_t region, uint32_t* used_bytes) {
+    storage_fs_volume_t* volume = find_volume(region);
+    if (!volume || !used_bytes) {
+        return volume ? HAL_ERROR_INVALID_PARAM : HAL_ERROR_INVALID_STATE;
+    }
+
+    lfs_ssize_t blocks = lfs_fs_size(&volume->lfs);
+    if (blocks < 0) {
+        return fs_result((int)blocks);
+    }
+
+    *used_bytes = (uint32_t)blocks * STORAGE_FS_BLOCK_SIZE;
+    return HAL_SUCCESS;
+}
+
+// ============================================================================
+// Files
+// ============================================================================
+
+hal_result_t storage_fs_open(storage_region_t region, uint32_t file_id, storage_file_t* file) {
+    if (!file) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    storage_fs_volume_t* volume = find_volume(region);
+    if (!volume) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    if (find_file(region, file_id)) {
+        return HAL_ERROR_BUSY;
+    }
+
+    storage_fs_file_t* slot = NULL;
+    for (uint32_t i = 0; i < STORAGE_FS_MAX_OPEN_FILES; i++) {
+        if (!g_fs_files[i].in_use) {
+            slot = &g_fs_files[i];
+            break;
+        }
+    }
+    if (!slot) {
+        return HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    char name[STORAGE_FS_NAME_SIZE];
+    file_name(file_id, name);
+
+    int flags = LFS_O_RDWR | LFS_O_CREAT;
+    if (file->flags & STORAGE_FILE_FLAG_TRUNCATE) {
+        flags |= LFS_O_TRUNC;
+    }
+
+    memset(&slot->config, 0, sizeof(slot->config));
+    slot->config.buffer = slot->cache;
+
+    int err = lfs_file_opencfg(&volume->lfs, &slot->file, name, flags, &slot->config);
+    if (err != LFS_ERR_OK) {
+        return fs_result(err);
+    }
+
+    slot->volume = volume;
+    slot->file_id = file_id;
+    slot->in_use = true;
+
+    file->region = region;
+    file->file_id = file_id;
+    file->offset = 0;
+    file->size = (uint32_t)lfs_file_size(&volume->lfs, &slot->file);
+    file->is_open = true;
+    return HAL_SUCCESS;
+}
+
+hal_result_t storage_fs_close(storage_file_t* file) {
+    storage_fs_file_t* slot = handle_slot(file);
+    if (!slot) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+
+    int err = lfs_file_close(&slot->volume->lfs, &slot->file);
+    slot->in_use = false;
+    file->is_open = false;
+    return fs_result(err);
+}
+
+hal_result_t storage_fs_read(storage_file_t* file, uint8_t* buffer, size_t length,
+                             size_t* bytes_read) {
+    storage_fs_file_t* slot = handle_slot(file);
+    if (!slot || !buffer || !bytes_read) {
+        return file && !file->is_open ? HAL_ERROR_INVALID_STATE : HAL_ERROR_INVALID_PARAM;
+    }
+
+    *bytes_read = 0;
+    lfs_t* lfs = &slot->volume->lfs;
+
+    // The handle's offset is authoritative, callers may move it between calls
+    lfs_soff_t position = lfs_file_seek(lfs, &slot->file, (lfs_soff_t)file->offset, LFS_SEEK_SET);
+    if (position < 0) {
+        return fs_result((int)position);
+    }
+
+    lfs_ssize_t count = lfs_file_read(lfs, &slot->file, buffer, (lfs_size_t)length);
+    if (count < 0) {
+        return fs_result((int)count);
+    }
+
+    file->offset += (uint32_t)count;
+    *bytes_read = (size_t)count;
+    return HAL_SUCCESS;
+}
+
+hal_result_t storage_fs_write(storage_file_t* file, const uint8_t* data, size_t length,
+                              size_t* bytes_written) {
+    storage_fs_file_t* slot = handle_slot(file);
+    if (!slot || !data || !bytes_written) {
+        return file && !file->is_open ? HAL_ERROR_INVALID_STATE : HAL_ERROR_INVALID_PARAM;
+    }
+
+    *bytes_written = 0;
+    lfs_t* lfs = &slot->volume->lfs;
+
+    lfs_soff_t position = lfs_file_seek(lfs, &slot->file, (lfs_soff_t)file->offset, LFS_SEEK_SET);
+    if (position < 0) {
+        return fs_result((int)position);
+    }
+
+    lfs_ssize_t count = lfs_file_write(lfs, &slot->file, data, (lfs_size_t)length);
+    if (count < 0) {
+        return fs_result((int)count);
+    }
+
+    file->offset += (uint32_t)count;
+    file->size = (uint32_t)lfs_file_size(lfs, &slot->file);
+    *bytes_written = (size_t)count;
+    return HAL_SUCCESS;
+}
+
+hal_result_t storage_fs_delete(storage_region_t region, uint32_t file_id) {
+    storage_fs_volume_t* volume = find_volume(region);
+    if (!volume) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+
+    if (find_file(region, file_id)) {
+        return HAL_ERROR_BUSY;
+    }
+
+    char name[STORAGE_FS_NAME_SIZE];
+    file_name(file_id, name);
+
+    int err = lfs_remove(&volume->lfs, name);
+    if (err == LFS_ERR_NOENT) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+    return fs_result(err);
+}
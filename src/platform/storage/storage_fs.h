@@ -0,0 +1,207 @@
+#ifndef STORAGE_FS_H
+#define STORAGE_FS_H
+
+/**
+ * @file storage_fs.h
+ * @brief littlefs File Layer Behind storage_platform_t
+ * @author USB Key Authentication Team
+ * @date 2025-09-19
+ * @version 1.0
+ *
+ * Regions configured with STORAGE_FLAG_FILESYSTEM hold a littlefs volume
+ * (SDK middleware/littlefs) on top of the raw storage_hal_t, and their
+ * files are the open_file/read_file/write_file/delete_file of
+ * storage_platform_t. A file is named by its 32-bit ID inside its region's
+ * volume.
+ *
+ * Everything littlefs would allocate is static: per volume the lfs_t,
+ * read and program caches and lookahead bitmap, per open file the lfs_file_t
+ * and its cache. Build littlefs with LFS_NO_MALLOC.
+ *
+ * The geometry fits the MCXA156 internal flash: one 8 KB sector per block
+ * and 128-byte program pages. With STORAGE_FS_CACHE_SIZE at 1024, files up
+ * to 1022 bytes (littlefs's attribute limit, room for any resident
+ * credential) are inlined in their directory's metadata log, so updating
+ * one appends a commit of a few pages instead of rewriting a block. A
+ * larger file takes at least a whole 8 KB block of its own.
+ *
+ * @warning Not thread-safe, like storage_platform_t.
+ */
+
+#include "storage_platform.h"
+
+/** @brief Volumes that can be mounted at once */
+#ifndef STORAGE_FS_MAX_VOLUMES
+#define STORAGE_FS_MAX_VOLUMES      2U
+#endif
+
+/** @brief Files that can be open at once, across all volumes */
+#ifndef STORAGE_FS_MAX_OPEN_FILES
+#define STORAGE_FS_MAX_OPEN_FILES   2U
+#endif
+
+/** @brief Smallest read the block device is asked for */
+#ifndef STORAGE_FS_READ_SIZE
+#define STORAGE_FS_READ_SIZE        16U
+#endif
+
+/** @brief Program granularity, the flash page */
+#ifndef STORAGE_FS_PROG_SIZE
+#define STORAGE_FS_PROG_SIZE        128U
+#endif
+
+/** @brief littlefs block, the flash erase sector */
+#ifndef STORAGE_FS_BLOCK_SIZE
+#define STORAGE_FS_BLOCK_SIZE       8192U
+#endif
+
+/**
+ * @brief Read, program and per-file cache size, also the inline file limit
+ *
+ * Costs 2x per volume and 1x per open file in RAM. Below 1024 the inline
+ * limit drops with it, and credentials above it each take a block.
+ */
+#ifndef STORAGE_FS_CACHE_SIZE
+#define STORAGE_FS_CACHE_SIZE       1024U
+#endif
+
+/** @brief Lookahead bitmap in bytes, 8 blocks per byte (a 1 MB volume fits in 16) */
+#ifndef STORAGE_FS_LOOKAHEAD_SIZE
+#define STORAGE_FS_LOOKAHEAD_SIZE   16U
+#endif
+
+/**
+ * @brief Erases of a metadata pair before littlefs moves it
+ *
+ * Small files all commit to the root directory's pair, so it takes almost
+ * every erase; the low end of littlefs's 100-1000 range spreads that over
+ * the volume at the cost of a relocation every 100 compactions.
+ */
+#ifndef STORAGE_FS_BLOCK_CYCLES
+#define STORAGE_FS_BLOCK_CYCLES     100
+#endif
+
+/**
+ * @brief Mount the volume of a region
+ *
+ * @param hal Storage HAL the volume lives on
+ * @param region Region the volume belongs to
+ * @param base_address First byte of the volume, STORAGE_FS_BLOCK_SIZE aligned
+ * @param size Volume size, a multiple of STORAGE_FS_BLOCK_SIZE, at least 2 blocks
+ * @param format Format first; otherwise format only if the region is erased
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_PARAM Geometry does not fit the device or the block size
+ * @retval HAL_ERROR_INVALID_STATE Region already mounted
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY STORAGE_FS_MAX_VOLUMES mounted
+ * @retval HAL_ERROR_HARDWARE_FAILURE Format failed, or the region holds
+ *         something that does not mount; it is left untouched
+ */
+hal_result_t storage_fs_mount(storage_hal_t* hal, storage_region_t region,
+                              uint32_t base_address, uint32_t size, bool format);
+
+/**
+ * @brief Close the region's open files and unmount its volume
+ *
+ * @param region Mounted region
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_STATE Region not mounted
+ */
+hal_result_t storage_fs_unmount(storage_region_t region);
+
+/**
+ * @brief Unmount every volume
+ */
+void storage_fs_unmount_all(void);
+
+/**
+ * @brief Check whether a region has a mounted volume
+ *
+ * @param region Region to check
+ * @return true if mounted
+ */
+bool storage_fs_is_mounted(storage_region_t region);
+
+/**
+ * @brief Open a file, creating it if missing
+ *
+ * Set STORAGE_FILE_FLAG_TRUNCATE in file->flags beforehand to drop the
+ * previous content, as for a whole-record rewrite.
+ *
+ * @param region Mounted region
+ * @param file_id File ID
+ * @param file Output handle, offset 0
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INVALID_STATE Region not mounted
+ * @retval HAL_ERROR_BUSY File already open
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY STORAGE_FS_MAX_OPEN_FILES open, or volume full
+ */
+hal_result_t storage_fs_open(storage_region_t region, uint32_t file_id, storage_file_t* file);
+
+/**
+ * @brief Commit and close a file
+ *
+ * @param file Open handle
+ * @return HAL_SUCCESS on success, error code otherwise
+ */
+hal_result_t storage_fs_close(storage_file_t* file);
+
+/**
+ * @brief Read at the file offset
+ *
+ * @param file Open handle
+ * @param buffer Output buffer
+ * @param length Bytes wanted
+ * @param bytes_read Output bytes read, short at end of file
+ * @return HAL_SUCCESS on success, error code otherwise
+ */
+hal_result_t storage_fs_read(storage_file_t* file, uint8_t* buffer, size_t length,
+                             size_t* bytes_read);
+
+/**
+ * @brief Write at the file offset
+ *
+ * Data reaches flash at close, or earlier when the file cache fills.
+ *
+ * @param file Open handle
+ * @param data Data to write
+ * @param length Size of data in bytes
+ * @param bytes_written Output bytes written
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_INSUFFICIENT_MEMORY Volume full
+ */
+hal_result_t storage_fs_write(storage_file_t* file, const uint8_t* data, size_t length,
+                              size_t* bytes_written);
+
+/**
+ * @brief Remove a file
+ *
+ * @param region Mounted region
+ * @param file_id File ID
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_BUSY File is open
+ * @retval HAL_ERROR_HARDWARE_FAILURE File not found
+ */
+hal_result_t storage_fs_delete(storage_region_t region, uint32_t file_id);
+
+/**
+ * @brief Compact metadata logs ahead of time
+ *
+ * Runs littlefs's lfs_fs_gc(): metadata pairs past their compaction
+ * threshold are compacted now rather than in the middle of a later write,
+ * and the block allocator's lookahead is refilled.
+ *
+ * @param region Mounted region, or STORAGE_REGION_MAX for every volume
+ * @return HAL_SUCCESS on success, error code otherwise
+ */
+hal_result_t storage_fs_gc(storage_region_t region);
+
+/**
+ * @brief Space a volume uses
+ *
+ * @param region Mounted region
+ * @param used_bytes Output bytes in allocated blocks
+ * @return HAL_SUCCESS on success, error code otherwise
+ */
+hal_result_t storage_fs_used(storage_region_t region, uint32_t* used_bytes);
+
+#endif // STORAGE_FS_H
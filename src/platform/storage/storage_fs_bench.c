@@ -0,0 +1,313 @@
+/**
+ * @file storage_fs_bench.c
+ * @brief Host-side credential file latency and write amplification benchmark
+ * @author USB Key Authentication Team
+ * @date 2025-09-19
+ * @version 1.0
+ *
+ * Runs get_storage_platform() with a file system region on a RAM flash
+ * HAL shaped like the MCXA156 internal flash (8 KB sectors, 128-byte pages,
+ * programming only erased bytes), fills it with credential-sized files and
+ * then rewrites them at random the way a signature counter update does:
+ * open with STORAGE_FILE_FLAG_TRUNCATE, write the record, close. Reports
+ * - open+read latency and the flash bytes read per lookup
+ * - write amplification: flash bytes programmed per credential byte, and
+ *   erases per update, averaged over enough updates to include compactions
+ * - the worst single update (a compaction or block relocation)
+ * then checks that a damaged volume fails to mount without being formatted
+ * while an erased region is formatted, and exits non-zero when a file reads back wrong or a threshold is missed.
+ *
+ * Build and run on Linux from the repository root:
+ * @code
+ * LFS=src/core/mcxa156/sdks/frdm_mcxa156_sdk/middleware/littlefs
+ * gcc -std=c11 -O2 -DLFS_NO_MALLOC -I src -I src/platform/storage -I $LFS \
+ *     src/platform/storage/storage_fs_bench.c src/platform/storage/storage_fs.c \
+ *     src/platform/storage/storage_platform.c src/platform/storage/storage_cache.c \
+ *     src/platform/storage/storage_bench_flash.c $LFS/lfs.c $LFS/lfs_util.c \
+ *     -o storage_fs_bench
+ * ./storage_fs_bench [-n credentials] [-s size] [-u updates] [-W max_amplification]
+ * @endcode
+ *
+ * Options:
+ * - -n  Credential files (default 32)
+ * - -s  Bytes per credential (default 300)
+ * - -u  Random updates after the fill (default 2000)
+ * - -W  Fail if programmed bytes per credential byte exceed this
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "storage_platform.h"
+#include "storage_fs.h"
+#include "storage_bench_flash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FLASH_SIZE            (256U * 1024U)  /**< RAM flash size */
+#define BENCH_SECTOR_SIZE           8192U           /**< Erase sector */
+#define BENCH_PAGE_SIZE             128U            /**< Program page */
+#define BENCH_MAX_CREDENTIAL_SIZE   2048U           /**< -s upper bound */
+#define BENCH_FIRST_FILE_ID         0x1000U         /**< ID of credential 0 */
+
+void storage_platform_init_interface(void);
+storage_platform_t* get_storage_platform(void);
+
+static bench_flash_t* g_flash;
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Deterministic record content for a credential generation
+ */
+static void fill_record(uint8_t* record, size_t size, uint32_t index, uint32_t generation) {
+    for (size_t i = 0; i < size; i++) {
+        record[i] = (uint8_t)(index * 31U + generation * 7U + i);
+    }
+}
+
+/**
+ * @brief Rewrite one credential file
+ */
+static hal_result_t write_credential(storage_platform_t* platform, uint32_t index,
+                                     const uint8_t* record, size_t size) {
+    storage_file_t file = { .flags = STORAGE_FILE_FLAG_TRUNCATE };
+    hal_result_t result = platform->open_file(STORAGE_REGION_CREDENTIALS,
+                                              BENCH_FIRST_FILE_ID + index, &file);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    size_t written = 0;
+    result = platform->write_file(&file, record, size, &written);
+    hal_result_t close_result = platform->close_file(&file);
+    if (result == HAL_SUCCESS && written != size) {
+        result = HAL_ERROR_INSUFFICIENT_MEMORY;
+    }
+    return (result != HAL_SUCCESS) ? result : close_result;
+}
+
+/**
+ * @brief Read one credential file back and compare
+ */
+static hal_result_t check_credential(storage_platform_t* platform, uint32_t index,
+                                     const uint8_t* expected, size_t size) {
+    static uint8_t buffer[BENCH_MAX_CREDENTIAL_SIZE + 1U];
+    storage_file_t file = {0};
+    hal_result_t result = platform->open_file(STORAGE_REGION_CREDENTIALS,
+                                              BENCH_FIRST_FILE_ID + index, &file);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+
+    size_t read = 0;
+    result = platform->read_file(&file, buffer, sizeof(buffer), &read);
+    platform->close_file(&file);
+    if (result == HAL_SUCCESS && (read != size || memcmp(buffer, expected, size) != 0)) {
+        printf("credential %u: read %zu bytes, content %s\n", index, read,
+               read == size ? "differs" : "short");
+        result = HAL_ERROR_HARDWARE_FAILURE;
+    }
+    return result;
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+int main(int argc, char** argv) {
+    uint32_t credentials = 32;
+    size_t size = 300;
+    uint32_t updates = 2000;
+    double max_amplification = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            credentials = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            size = (size_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+            updates = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-W") == 0 && i + 1 < argc) {
+            max_amplification = strtod(argv[++i], NULL);
+        } else {
+            fprintf(stderr, "usage: %s [-n credentials] [-s size] [-u updates] "
+                    "[-W max_amplification]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (credentials == 0 || size == 0 || size > BENCH_MAX_CREDENTIAL_SIZE) {
+        fprintf(stderr, "need at least one credential of 1..%u bytes\n",
+                BENCH_MAX_CREDENTIAL_SIZE);
+        return 2;
+    }
+
+    uint32_t* generations = calloc(credentials, sizeof(uint32_t));
+    uint8_t* record = malloc(size);
+    if (!generations || !record) {
+        return 1;
+    }
+
+    const bench_flash_geometry_t geometry = {
+        .size = BENCH_FLASH_SIZE,
+        .sector_size = BENCH_SECTOR_SIZE,
+        .page_size = BENCH_PAGE_SIZE,
+    };
+    g_flash = bench_flash_init(&geometry);
+    if (!g_flash) {
+        return 1;
+    }
+    bench_random_seed(0x2545F491U);
+
+    storage_platform_init_interface();
+    storage_platform_t* platform = get_storage_platform();
+    const storage_region_config_t config = {
+        .region = STORAGE_REGION_CREDENTIALS,
+        .base_address = 0,
+        .size = BENCH_FLASH_SIZE,
+        .flags = STORAGE_FLAG_FILESYSTEM,
+    };
+    if (platform->init(bench_flash_hal(), NULL) != HAL_SUCCESS ||
+        platform->configure_region(STORAGE_REGION_CREDENTIALS, &config) != HAL_SUCCESS) {
+        fprintf(stderr, "storage platform setup failed\n");
+        return 1;
+    }
+
+    int failures = 0;
+
+    // Fill
+    for (uint32_t i = 0; i < credentials; i++) {
+        fill_record(record, size, i, 0);
+        if (write_credential(platform, i, record, size) != HAL_SUCCESS) {
+            printf("fill: credential %u failed\n", i);
+            failures++;
+        }
+    }
+
+    // Random rewrites
+    uint64_t programmed_before = g_flash->bytes_programmed;
+    uint64_t erases_before = g_flash->erases;
+    uint64_t worst_update = 0;
+    uint64_t update_ns = 0;
+    for (uint32_t u = 0; u < updates; u++) {
+        uint32_t index = bench_random() % credentials;
+        fill_record(record, size, index, ++generations[index]);
+
+        uint64_t programmed = g_flash->bytes_programmed;
+        uint64_t start = now_ns();
+        if (write_credential(platform, index, record, size) != HAL_SUCCESS) {
+            printf("update %u: credential %u failed\n", u, index);
+            failures++;
+            break;
+        }
+        update_ns += now_ns() - start;
+        if (g_flash->bytes_programmed - programmed > worst_update) {
+            worst_update = g_flash->bytes_programmed - programmed;
+        }
+    }
+    uint64_t update_programmed = g_flash->bytes_programmed - programmed_before;
+    uint64_t update_erases = g_flash->erases - erases_before;
+
+    // Lookups, then a remount to prove everything was committed
+    uint64_t read_before = g_flash->bytes_read;
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < credentials; i++) {
+        fill_record(record, size, i, generations[i]);
+        if (check_credential(platform, i, record, size) != HAL_SUCCESS) {
+            failures++;
+        }
+    }
+    uint64_t lookup_ns = now_ns() - start;
+    uint64_t lookup_read = g_flash->bytes_read - read_before;
+
+    const storage_region_config_t persistent = {
+        .region = STORAGE_REGION_CREDENTIALS,
+        .base_address = 0,
+        .size = BENCH_FLASH_SIZE,
+        .flags = STORAGE_FLAG_FILESYSTEM | STORAGE_FLAG_PERSISTENT,
+    };
+    if (platform->configure_region(STORAGE_REGION_CREDENTIALS, &persistent) != HAL_SUCCESS) {
+        printf("remount failed\n");
+        failures++;
+    } else {
+        for (uint32_t i = 0; i < credentials; i++) {
+            fill_record(record, size, i, generations[i]);
+            if (check_credential(platform, i, record, size) != HAL_SUCCESS) {
+                failures++;
+            }
+        }
+    }
+
+    if (platform->garbage_collect(STORAGE_REGION_CREDENTIALS) != HAL_SUCCESS ||
+        platform->wear_leveling(STORAGE_REGION_CREDENTIALS) != HAL_SUCCESS) {
+        printf("garbage_collect/wear_leveling failed\n");
+        failures++;
+    }
+
+    storage_region_info_t info;
+    platform->get_region_info(STORAGE_REGION_CREDENTIALS, &info);
+    platform->deinit();
+
+    // A damaged volume must not be formatted over; blank flash must be
+    bench_flash_fill(0, 2U * STORAGE_FS_BLOCK_SIZE, 0x5A);
+    uint64_t programmed_damaged = g_flash->bytes_programmed;
+    if (storage_fs_mount(bench_flash_hal(), STORAGE_REGION_CREDENTIALS, 0, BENCH_FLASH_SIZE,
+                         false) == HAL_SUCCESS ||
+        g_flash->bytes_programmed != programmed_damaged || g_flash->memory[0] != 0x5A) {
+        printf("damaged volume: formatted instead of failing\n");
+        failures++;
+    }
+    storage_fs_unmount_all();
+    bench_flash_fill(0, BENCH_FLASH_SIZE, 0xFF);
+    if (storage_fs_mount(bench_flash_hal(), STORAGE_REGION_CREDENTIALS, 0, BENCH_FLASH_SIZE,
+                         false) != HAL_SUCCESS) {
+        printf("erased region: not formatted\n");
+        failures++;
+    }
+    storage_fs_unmount_all();
+
+    double amplification = 0.0;
+    if (updates > 0) {
+        amplification = (double)update_programmed / ((double)updates * (double)size);
+    }
+
+    printf("storage_fs: %u credentials x %zu bytes, %u updates, block %u, cache %u, "
+           "block_cycles %d\n", credentials, size, updates, (unsigned)STORAGE_FS_BLOCK_SIZE,
+           (unsigned)STORAGE_FS_CACHE_SIZE, STORAGE_FS_BLOCK_CYCLES);
+    printf("  open+read:     %8.2f us  %8.1f flash bytes read per lookup\n",
+           (double)lookup_ns / 1000.0 / credentials, (double)lookup_read / credentials);
+    if (updates > 0) {
+        printf("  update:        %8.2f us  %8.1f bytes programmed (%.2fx), "
+               "%.4f erases per update\n",
+               (double)update_ns / 1000.0 / updates, (double)update_programmed / updates,
+               amplification, (double)update_erases / updates);
+        printf("  worst update:  %8llu bytes programmed\n", (unsigned long long)worst_update);
+    }
+    printf("  volume:        %u of %u bytes in use\n", info.used_size, config.size);
+
+    if (g_flash->violations != 0) {
+        printf("FAIL: %u writes to unerased or misaligned flash\n", g_flash->violations);
+        failures++;
+    }
+    if (max_amplification > 0.0 && amplification > max_amplification) {
+        printf("FAIL: write amplification %.2f above %.2f\n", amplification, max_amplification);
+        failures++;
+    }
+
+    free(generations);
+    free(record);
+    bench_flash_deinit();
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures ? 1 : 0;
+}
@@ -7,9 +7,15 @@
  * 
  * This file implements the Storage Platform layer functionality including
  * region management, encryption, wear leveling, and file operations.
+ * File operations are served by littlefs volumes (storage_fs.c) on regions
+ * configured with STORAGE_FLAG_FILESYSTEM. Raw region writes go through the
+ * page write-back cache (storage_cache.c) and reach flash at barrier(), or
+ * before write_region() returns on STORAGE_FLAG_ATOMIC regions.
  */
 
 #include "storage_platform.h"
+#include "storage_fs.h"
+#include "storage_cache.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -27,6 +33,7 @@ typedef struct {
     bool region_configured[STORAGE_REGION_MAX];           /**< Region setup status */
     uint32_t wear_level_counter;                          /**< Wear leveling counter */
     uint32_t gc_threshold;                                 /**< Garbage collection threshold */
+    storage_stats_t stats;                                 /**< Raw region reads, erases and errors */
 } storage_platform_state_t;
 
 /**
@@ -39,32 +46,7 @@ static storage_platform_state_t g_storage_state = {0};
  */
 static storage_platform_t g_storage_platform;
 
-/**
- * @brief Calculate CRC32 for data integrity
- * 
- * Simple CRC32 implementation for data integrity checking.
- * 
- * @param data Data to calculate CRC for
- * @param length Length of data
- * @return CRC32 value
- */
-static uint32_t calculate_crc32(const uint8_t* data, size_t length) {
-    uint32_t crc = 0xFFFFFFFF;
-    const uint32_t polynomial = 0xEDB88320;
-    
-    for (size_t i = 0; i < length; i++) {
-        crc ^= data[i];
-        for (int j = 0; j < 8; j++) {
-            if (crc & 1) {
-                crc = (crc >> 1) ^ polynomial;
-            } else {
-                crc >>= 1;
-            }
-        }
-    }
-    
-    return ~crc;
-}
+static hal_result_t storage_platform_barrier(void);
 
 /**
  * @brief Encrypt data for storage
@@ -173,6 +155,28 @@ static bool validate_region_config(storage_region_t region, const storage_region
     return true;
 }
 
+/**
+ * @brief Check that a region holds a file system
+ *
+ * @param region Region ID
+ * @return HAL_SUCCESS if file operations can run on the region
+ */
+static hal_result_t check_file_region(storage_region_t region) {
+    if (!g_storage_state.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    if (region >= STORAGE_REGION_MAX) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!g_storage_state.region_configured[region] || !storage_fs_is_mounted(region)) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    
+    return HAL_SUCCESS;
+}
+
 // Implementation of platform interface functions
 
 static hal_result_t storage_platform_init(storage_hal_t* storage_hal, crypto_hal_t* crypto_hal) {
@@ -209,6 +213,13 @@ static hal_result_t storage_platform_init(storage_hal_t* storage_hal, crypto_hal
     printf("[STORAGE_PLATFORM] Storage device: %u bytes, sector: %u, page: %u\n",
            info.total_size, info.sector_size, info.page_size);
     
+    memset(&g_storage_state.stats, 0, sizeof(g_storage_state.stats));
+    result = storage_cache_init(storage_hal);
+    if (result != HAL_SUCCESS) {
+        printf("[STORAGE_PLATFORM] Write cache init failed: %d\n", result);
+        return result;
+    }
+    
     g_storage_state.initialized = true;
     
     printf("[STORAGE_PLATFORM] Storage platform initialized successfully\n");
@@ -222,6 +233,13 @@ static hal_result_t storage_platform_deinit(void) {
     
     printf("[STORAGE_PLATFORM] Deinitializing storage platform\n");
     
+    // Close open files and commit file system state
+    storage_fs_unmount_all();
+    
+    // Program cached region writes
+    storage_cache_commit();
+    storage_cache_deinit();
+    
     // Flush any pending operations
     if (g_storage_state.hal && g_storage_state.hal->flush) {
         g_storage_state.hal->flush();
@@ -248,6 +266,10 @@ static hal_result_t storage_platform_configure_region(storage_region_t region,
     printf("[STORAGE_PLATFORM] Configuring region %d: addr=0x%08X, size=%u\n",
            region, config->base_address, config->size);
     
+    if (storage_fs_is_mounted(region)) {
+        storage_fs_unmount(region);
+    }
+    
     // Store region configuration
     g_storage_state.regions[region] = *config;
     g_storage_state.region_configured[region] = true;
@@ -258,6 +280,8 @@ static hal_result_t storage_platform_configure_region(storage_region_t region,
         // Just mark as configured
     } else {
         // For non-persistent regions, erase to ensure clean state
+        storage_cache_discard(config->base_address, config->size);
+        g_storage_state.stats.total_erases++;
         hal_result_t result = g_storage_state.hal->erase(config->base_address, config->size);
         if (result != HAL_SUCCESS) {
             printf("[STORAGE_PLATFORM] Failed to erase region %d: %d\n", region, result);
@@ -266,6 +290,18 @@ static hal_result_t storage_platform_configure_region(storage_region_t region,
         }
     }
     
+    // Persistent file system regions keep their volume, others start empty
+    if (config->flags & STORAGE_FLAG_FILESYSTEM) {
+        hal_result_t result = storage_fs_mount(g_storage_state.hal, region, config->base_address,
+                                               config->size,
+                                               !(config->flags & STORAGE_FLAG_PERSISTENT));
+        if (result != HAL_SUCCESS) {
+            printf("[STORAGE_PLATFORM] Failed to mount region %d: %d\n", region, result);
+            g_storage_state.region_configured[region] = false;
+            return result;
+        }
+    }
+    
     printf("[STORAGE_PLATFORM] Region %d configured successfully\n", region);
     return HAL_SUCCESS;
 }
@@ -287,10 +323,14 @@ static hal_result_t storage_platform_get_region_info(storage_region_t region,
     // Fill in region info
     info->config = g_storage_state.regions[region];
     
-    // TODO: Calculate actual used/free space by scanning region
-    // For now, provide placeholder values
     info->used_size = 0;
-    info->free_size = info->config.size;
+    if (storage_fs_is_mounted(region)) {
+        hal_result_t result = storage_fs_used(region, &info->used_size);
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    }
+    info->free_size = info->config.size - info->used_size;
     info->write_count = 0;
     info->error_count = 0;
     info->is_healthy = true;
@@ -321,12 +361,15 @@ static hal_result_t storage_platform_read_region(storage_region_t region, uint32
     
     uint32_t physical_address = config->base_address + offset;
     
-    // Read from storage
+    // Read from storage, then the writes still in the cache
+    g_storage_state.stats.total_reads++;
     hal_result_t result = g_storage_state.hal->read(physical_address, buffer, length);
     if (result != HAL_SUCCESS) {
+        g_storage_state.stats.error_count++;
         printf("[STORAGE_PLATFORM] Read failed from region %d: %d\n", region, result);
         return result;
     }
+    storage_cache_overlay(physical_address, buffer, length);
     
     // Decrypt if encrypted
     if (config->flags & STORAGE_FLAG_ENCRYPTED) {
@@ -371,6 +414,11 @@ static hal_result_t storage_platform_write_region(storage_region_t region, uint3
     
     storage_region_config_t* config = &g_storage_state.regions[region];
     
+    // Raw writes would corrupt the volume, use the file operations
+    if (config->flags & STORAGE_FLAG_FILESYSTEM) {
+        return HAL_ERROR_INVALID_STATE;
+    }
+    
     // Check bounds
     if (offset + length > config->size) {
         return HAL_ERROR_INVALID_PARAM;
@@ -404,23 +452,24 @@ static hal_result_t storage_platform_write_region(storage_region_t region, uint3
     
     // TODO: Add integrity protection if authenticated
     
-    // Write to storage
-    hal_result_t result = g_storage_state.hal->write(physical_address, write_data, write_length);
+    // Merge into the cache; barrier() programs it
+    hal_result_t result = storage_cache_write(physical_address, write_data, write_length);
     
     if (encrypted_buffer) {
         free(encrypted_buffer);
     }
     
+    // Atomic regions are written through: durable when this returns, after
+    // every write cached before it
+    if (result == HAL_SUCCESS && (config->flags & STORAGE_FLAG_ATOMIC)) {
+        result = storage_platform_barrier();
+    }
+    
     if (result != HAL_SUCCESS) {
         printf("[STORAGE_PLATFORM] Write failed to region %d: %d\n", region, result);
         return result;
     }
     
-    // Flush if atomic
-    if (config->flags & STORAGE_FLAG_ATOMIC) {
-        g_storage_state.hal->flush();
-    }
-    
     // Update wear leveling counter
     g_storage_state.wear_level_counter++;
     
@@ -444,14 +493,158 @@ static hal_result_t storage_platform_erase_region(storage_region_t region) {
     
     printf("[STORAGE_PLATFORM] Erasing region %d\n", region);
     
+    if (storage_fs_is_mounted(region)) {
+        storage_fs_unmount(region);
+    }
+    
+    // Cached writes to the region are superseded by the erase
+    storage_cache_discard(config->base_address, config->size);
+    
+    g_storage_state.stats.total_erases++;
     hal_result_t result = g_storage_state.hal->erase(config->base_address, config->size);
     if (result != HAL_SUCCESS) {
+        g_storage_state.stats.error_count++;
         printf("[STORAGE_PLATFORM] Erase failed for region %d: %d\n", region, result);
+        return result;
+    }
+    
+    // An erased file system region comes back as an empty volume
+    if (config->flags & STORAGE_FLAG_FILESYSTEM) {
+        result = storage_fs_mount(g_storage_state.hal, region, config->base_address,
+                                  config->size, true);
+    }
+    
+    return result;
+}
+
+static hal_result_t storage_platform_open_file(storage_region_t region, uint32_t file_id,
+                                              storage_file_t* file) {
+    if (!file) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    hal_result_t result = check_file_region(region);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+    
+    return storage_fs_open(region, file_id, file);
+}
+
+static hal_result_t storage_platform_close_file(storage_file_t* file) {
+    if (!file || !file->is_open) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    return storage_fs_close(file);
+}
+
+static hal_result_t storage_platform_read_file(storage_file_t* file, uint8_t* buffer,
+                                              size_t length, size_t* bytes_read) {
+    if (!g_storage_state.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    return storage_fs_read(file, buffer, length, bytes_read);
+}
+
+static hal_result_t storage_platform_write_file(storage_file_t* file, const uint8_t* data,
+                                               size_t length, size_t* bytes_written) {
+    if (!g_storage_state.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    hal_result_t result = storage_fs_write(file, data, length, bytes_written);
+    if (result == HAL_SUCCESS) {
+        g_storage_state.wear_level_counter++;
+    }
+    
+    return result;
+}
+
+static hal_result_t storage_platform_delete_file(storage_region_t region, uint32_t file_id) {
+    hal_result_t result = check_file_region(region);
+    if (result != HAL_SUCCESS) {
+        return result;
+    }
+    
+    return storage_fs_delete(region, file_id);
+}
+
+static hal_result_t storage_platform_garbage_collect(storage_region_t region) {
+    if (!g_storage_state.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    // Out-of-range region means every volume
+    if (region < STORAGE_REGION_MAX) {
+        hal_result_t result = check_file_region(region);
+        if (result != HAL_SUCCESS) {
+            return result;
+        }
+    }
+    
+    return storage_fs_gc(region < STORAGE_REGION_MAX ? region : STORAGE_REGION_MAX);
+}
+
+static hal_result_t storage_platform_wear_leveling(storage_region_t region) {
+    if (!g_storage_state.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    // littlefs allocates blocks round-robin and moves metadata pairs after
+    // STORAGE_FS_BLOCK_CYCLES erases, so there is nothing to redistribute
+    if (region >= STORAGE_REGION_MAX) {
+        for (uint32_t i = 0; i < STORAGE_REGION_MAX; i++) {
+            if (storage_fs_is_mounted((storage_region_t)i)) {
+                return HAL_SUCCESS;
+            }
+        }
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+    
+    return storage_fs_is_mounted(region) ? HAL_SUCCESS : HAL_ERROR_NOT_SUPPORTED;
+}
+
+static hal_result_t storage_platform_barrier(void) {
+    if (!g_storage_state.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    hal_result_t result = storage_cache_commit();
+    if (result != HAL_SUCCESS) {
+        printf("[STORAGE_PLATFORM] Barrier commit failed: %d\n", result);
+        return result;
+    }
+    
+    if (g_storage_state.hal->flush) {
+        result = g_storage_state.hal->flush();
     }
     
     return result;
 }
 
+static hal_result_t storage_platform_get_platform_stats(storage_stats_t* stats) {
+    if (!g_storage_state.initialized) {
+        return HAL_ERROR_NOT_INITIALIZED;
+    }
+    
+    if (!stats) {
+        return HAL_ERROR_INVALID_PARAM;
+    }
+    
+    // Flash programs are counted where they happen, in the cache
+    storage_cache_stats_t cache;
+    storage_cache_get_stats(&cache);
+    
+    *stats = g_storage_state.stats;
+    stats->total_reads += cache.fills;
+    stats->total_writes = cache.programs;
+    stats->error_count += cache.errors;
+    
+    return HAL_SUCCESS;
+}
+
 // Initialize the platform interface structure
 void storage_platform_init_interface(void) {
     g_storage_platform.hal = NULL;
@@ -466,8 +659,17 @@ void storage_platform_init_interface(void) {
     g_storage_platform.read_region = storage_platform_read_region;
     g_storage_platform.write_region = storage_platform_write_region;
     g_storage_platform.erase_region = storage_platform_erase_region;
-    
-    // TODO: Implement remaining functions (file operations, GC, wear leveling, etc.)
+    g_storage_platform.open_file = storage_platform_open_file;
+    g_storage_platform.close_file = storage_platform_close_file;
+    g_storage_platform.read_file = storage_platform_read_file;
+    g_storage_platform.write_file = storage_platform_write_file;
+    g_storage_platform.delete_file = storage_platform_delete_file;
+    g_storage_platform.garbage_collect = storage_platform_garbage_collect;
+    g_storage_platform.wear_leveling = storage_platform_wear_leveling;
+    g_storage_platform.barrier = storage_platform_barrier;
+    g_storage_platform.get_platform_stats = storage_platform_get_platform_stats;
+    
+    // TODO: Implement check_integrity
 }
 
 /**
@@ -41,6 +41,12 @@ typedef enum {
 #define STORAGE_FLAG_AUTHENTICATED  0x04    /**< Integrity protection */
 #define STORAGE_FLAG_PERSISTENT     0x08    /**< Survives power cycles */
 #define STORAGE_FLAG_COMPRESSED     0x10    /**< Data compression */
+#define STORAGE_FLAG_FILESYSTEM     0x20    /**< Holds a littlefs volume for file operations */
+
+/**
+ * @brief File open flags (storage_file_t.flags, set before open_file())
+ */
+#define STORAGE_FILE_FLAG_TRUNCATE  0x01    /**< Discard existing content on open */
 
 /**
  * @brief Storage region configuration
@@ -80,7 +86,7 @@ typedef struct {
     uint32_t file_id;          /**< Unique file identifier */
     uint32_t offset;           /**< Current file offset */
     uint32_t size;             /**< File size */
-    uint32_t flags;            /**< File flags */
+    uint32_t flags;            /**< File flags (STORAGE_FILE_FLAG_*) */
     bool is_open;              /**< File open status */
 } storage_file_t;
 
@@ -202,6 +208,11 @@ typedef struct {
      * @note Data is automatically encrypted if region has STORAGE_FLAG_ENCRYPTED
      * @note Integrity protection is added if region has STORAGE_FLAG_AUTHENTICATED
      * @note Wear leveling is performed automatically
+     * @note Writes are merged in a page cache and reach flash at barrier();
+     *       reads see them before that. A write to a STORAGE_FLAG_ATOMIC
+     *       region is a barrier of its own: it is durable when the call
+     *       returns. Write atomic records whole, a program unit cannot be
+     *       programmed twice before its sector is erased
      */
     hal_result_t (*write_region)(storage_region_t region, uint32_t offset,
                                 const uint8_t* data, size_t length);
@@ -220,9 +231,25 @@ typedef struct {
      * @retval HAL_ERROR_HARDWARE_FAILURE Storage erase error
      * 
      * @warning This operation destroys all data in the region
+     * @note Cached writes to the region are dropped
      */
     hal_result_t (*erase_region)(storage_region_t region);
     
+    /**
+     * @brief Commit cached region writes (storage barrier)
+     * 
+     * Programs every page written since the last barrier, then flushes the
+     * HAL. Call at the end of each CTAP request, before the response goes
+     * out, and from idle time.
+     * 
+     * @return HAL_SUCCESS on success, error code otherwise
+     * @retval HAL_ERROR_HARDWARE_FAILURE A program failed; that page is dropped
+     * 
+     * @note The programs a request cost are the change in
+     *       get_platform_stats() total_writes across it
+     */
+    hal_result_t (*barrier)(void);
+    
     /**
      * @brief Open file in region
      * 
@@ -237,8 +264,11 @@ typedef struct {
      * @retval HAL_ERROR_INVALID_PARAM Invalid parameters
      * @retval HAL_ERROR_NOT_INITIALIZED Platform not initialized
      * @retval HAL_ERROR_NOT_SUPPORTED File system not available
+     * @retval HAL_ERROR_BUSY File already open
      * 
      * @note File is created if it doesn't exist
+     * @note Only regions configured with STORAGE_FLAG_FILESYSTEM hold files
+     * @note STORAGE_FILE_FLAG_TRUNCATE in file->flags empties the file
      * @see close_file()
      */
     hal_result_t (*open_file)(storage_region_t region, uint32_t file_id, storage_file_t* file);
@@ -296,6 +326,7 @@ typedef struct {
      * 
      * @note File offset is updated after successful write
      * @note File size may grow if writing beyond current end
+     * @note Data is committed to flash by close_file()
      */
     hal_result_t (*write_file)(storage_file_t* file, const uint8_t* data, 
                               size_t length, size_t* bytes_written);
@@ -332,6 +363,7 @@ typedef struct {
      * 
      * @note This operation may take considerable time
      * @note Improves write performance and available space
+     * @note On file system regions this compacts metadata ahead of the next write
      */
     hal_result_t (*garbage_collect)(storage_region_t region);
     
@@ -349,6 +381,7 @@ typedef struct {
      * 
      * @note Primarily for flash memory storage
      * @note May be performed automatically during write operations
+     * @note File system regions level wear on every write, so this returns HAL_SUCCESS at once
      */
     hal_result_t (*wear_leveling)(storage_region_t region);
     
@@ -381,6 +414,8 @@ typedef struct {
      * @retval HAL_SUCCESS Statistics retrieved successfully
      * @retval HAL_ERROR_INVALID_PARAM Invalid stats pointer
      * @retval HAL_ERROR_NOT_INITIALIZED Platform not initialized
+     * 
+     * @note Counts the raw region path: total_writes is HAL program calls
      */
     hal_result_t (*get_platform_stats)(storage_stats_t* stats);
     
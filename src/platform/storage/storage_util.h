@@ -0,0 +1,48 @@
+#ifndef STORAGE_UTIL_H
+#define STORAGE_UTIL_H
+
+/**
+ * @file storage_util.h
+ * @brief Record Encoding Helpers Shared by the Storage Modules
+ * @author USB Key Authentication Team
+ * @date 2025-09-22
+ * @version 1.0
+ *
+ * On-flash records are little-endian and end in a CRC-32 (IEEE, reflected,
+ * as zlib computes it). credential_log.c and sign_counter.c both encode
+ * their records with these.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Store a 16-bit value little-endian
+ */
+void storage_put_u16(uint8_t* p, uint16_t v);
+
+/**
+ * @brief Store a 32-bit value little-endian
+ */
+void storage_put_u32(uint8_t* p, uint32_t v);
+
+/**
+ * @brief Load a little-endian 16-bit value
+ */
+uint16_t storage_get_u16(const uint8_t* p);
+
+/**
+ * @brief Load a little-endian 32-bit value
+ */
+uint32_t storage_get_u32(const uint8_t* p);
+
+/**
+ * @brief CRC-32 (IEEE, reflected)
+ *
+ * @param data Data
+ * @param length Bytes of data
+ * @return CRC of data
+ */
+uint32_t storage_crc32(const uint8_t* data, size_t length);
+
+#endif // STORAGE_UTIL_H
@@ -0,0 +1,61 @@
+/**
+ * @file cycle_counter.c
+ * @brief Free-Running Cycle Counter Implementation
+ * @author USB Key Authentication Team
+ * @date 2025-09-09
+ * @version 1.0
+ */
+
+#if !defined(MCXA156_SERIES) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "cycle_counter.h"
+#include <stdbool.h>
+
+#if defined(MCXA156_SERIES)
+#include "fsl_device_registers.h"
+#else
+#include <time.h>
+#endif
+
+/** @brief Counter enabled flag */
+static bool g_cycle_counter_enabled = false;
+
+hal_result_t cycle_counter_init(void) {
+    if (g_cycle_counter_enabled) {
+        return HAL_SUCCESS;
+    }
+
+#if defined(MCXA156_SERIES)
+    // DWT only counts while trace is enabled in DEMCR
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if ((DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) != 0U) {
+        return HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    g_cycle_counter_enabled = true;
+    return HAL_SUCCESS;
+}
+
+uint32_t cycle_counter_read(void) {
+#if defined(MCXA156_SERIES)
+    return DWT->CYCCNT;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+uint32_t cycle_counter_get_hz(void) {
+#if defined(MCXA156_SERIES)
+    return SystemCoreClock;
+#else
+    return 1000000000u;
+#endif
+}
@@ -0,0 +1,47 @@
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+/**
+ * @file cycle_counter.h
+ * @brief Free-Running Cycle Counter Interface
+ * @author USB Key Authentication Team
+ * @date 2025-09-09
+ * @version 1.0
+ *
+ * Fine-grained time base for profiling individual operations. On MCXA156
+ * it reads the Cortex-M33 DWT cycle counter (core clock cycles); host
+ * builds count CLOCK_MONOTONIC nanoseconds instead, so cycle_counter_get_hz()
+ * must be used to turn a count into time.
+ */
+
+#include "hal/interface/hal_common.h"
+#include <stdint.h>
+
+/**
+ * @brief Enable the cycle counter
+ *
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_NOT_SUPPORTED Core has no DWT cycle counter
+ *
+ * @note Safe to call more than once, later calls are no-ops
+ */
+hal_result_t cycle_counter_init(void);
+
+/**
+ * @brief Read the cycle counter
+ *
+ * @return Current count, wraps at 32 bits
+ *
+ * @note Measure intervals with unsigned subtraction. At 96 MHz the counter
+ *       wraps after ~44 s, on the host after ~4.2 s.
+ */
+uint32_t cycle_counter_read(void);
+
+/**
+ * @brief Get the cycle counter frequency
+ *
+ * @return Counts per second (core clock on MCXA156, 1 GHz on the host)
+ */
+uint32_t cycle_counter_get_hz(void);
+
+#endif // CYCLE_COUNTER_H
@@ -0,0 +1,96 @@
+/**
+ * @file platform_clock.c
+ * @brief Monotonic Platform Clock Implementation
+ * @author USB Key Authentication Team
+ * @date 2025-09-08
+ * @version 1.0
+ */
+
+#if !defined(MCXA156_SERIES) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "platform_clock.h"
+#include <stdbool.h>
+
+#if defined(MCXA156_SERIES)
+#include "fsl_clock.h"
+#include "fsl_adapter_time_stamp.h"
+#else
+#include <time.h>
+#endif
+
+/**
+ * @brief Clock state
+ */
+typedef struct {
+#if defined(MCXA156_SERIES)
+    TIME_STAMP_HANDLE_DEFINE(handle);       /**< time_stamp adapter handle */
+#endif
+    uint64_t epoch_us;                      /**< Raw time at initialization */
+#if defined(PLATFORM_CLOCK_SIMULATED) && !defined(MCXA156_SERIES)
+    uint64_t simulated_us;                  /**< Simulated raw time */
+#endif
+    bool initialized;                       /**< Initialization flag */
+} platform_clock_state_t;
+
+/** @brief Global clock state */
+static platform_clock_state_t g_clock_state = {0};
+
+/**
+ * @brief Read the raw time source in microseconds
+ */
+static uint64_t read_raw_us(void) {
+#if defined(MCXA156_SERIES)
+    return HAL_GetTimeStamp((hal_time_stamp_handle_t)g_clock_state.handle);
+#elif defined(PLATFORM_CLOCK_SIMULATED)
+    return g_clock_state.simulated_us;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+hal_result_t platform_clock_init(void) {
+    if (g_clock_state.initialized) {
+        return HAL_SUCCESS;
+    }
+
+#if defined(MCXA156_SERIES)
+    // OSTIMER runs from the clock selected by the board clock config
+    hal_time_stamp_config_t config = {
+        .srcClock_Hz = CLOCK_GetOstimerClkFreq(),
+        .instance = PLATFORM_CLOCK_OSTIMER_INSTANCE,
+        .clockSrcSelect = 0,
+    };
+
+    if (config.srcClock_Hz == 0) {
+        return HAL_ERROR_HARDWARE_FAILURE;
+    }
+
+    HAL_TimeStampInit((hal_time_stamp_handle_t)g_clock_state.handle, &config);
+#endif
+
+    g_clock_state.epoch_us = read_raw_us();
+    g_clock_state.initialized = true;
+    return HAL_SUCCESS;
+}
+
+uint64_t platform_clock_get_us(void) {
+    if (!g_clock_state.initialized) {
+        return 0;
+    }
+
+    return read_raw_us() - g_clock_state.epoch_us;
+}
+
+uint32_t platform_clock_get_ms(void) {
+    return (uint32_t)(platform_clock_get_us() / 1000u);
+}
+
+#if defined(PLATFORM_CLOCK_SIMULATED) && !defined(MCXA156_SERIES)
+void platform_clock_advance_us(uint64_t us) {
+    g_clock_state.simulated_us += us;
+}
+#endif
@@ -0,0 +1,64 @@
+#ifndef PLATFORM_CLOCK_H
+#define PLATFORM_CLOCK_H
+
+/**
+ * @file platform_clock.h
+ * @brief Monotonic Platform Clock Interface
+ * @author USB Key Authentication Team
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ * Free-running monotonic time base used for protocol timeouts and
+ * measurements. On MCXA156 it is backed by the SDK time_stamp adapter
+ * (OSTIMER0); host builds use CLOCK_MONOTONIC, or a simulated clock when
+ * PLATFORM_CLOCK_SIMULATED is defined.
+ */
+
+#include "hal/interface/hal_common.h"
+#include <stdint.h>
+
+/** @brief OSTIMER instance used by the time_stamp adapter */
+#ifndef PLATFORM_CLOCK_OSTIMER_INSTANCE
+#define PLATFORM_CLOCK_OSTIMER_INSTANCE     0U
+#endif
+
+/**
+ * @brief Initialize the platform clock
+ *
+ * @return HAL_SUCCESS on success, error code otherwise
+ * @retval HAL_ERROR_HARDWARE_FAILURE Timer clock is not running
+ *
+ * @note Safe to call more than once, later calls are no-ops
+ */
+hal_result_t platform_clock_init(void);
+
+/**
+ * @brief Get monotonic time in microseconds
+ *
+ * @return Microseconds since platform_clock_init()
+ */
+uint64_t platform_clock_get_us(void);
+
+/**
+ * @brief Get monotonic time in milliseconds
+ *
+ * @return Milliseconds since platform_clock_init(), wraps after ~49 days
+ *
+ * @note Compare timestamps with unsigned subtraction to survive the wrap
+ */
+uint32_t platform_clock_get_ms(void);
+
+#if defined(PLATFORM_CLOCK_SIMULATED) && !defined(MCXA156_SERIES)
+/**
+ * @brief Advance the simulated clock
+ *
+ * Host builds with PLATFORM_CLOCK_SIMULATED replace CLOCK_MONOTONIC with a
+ * counter that only moves when told to, so benchmarks can replay traffic
+ * at bus speed without sleeping.
+ *
+ * @param us Microseconds to advance
+ */
+void platform_clock_advance_us(uint64_t us);
+#endif
+
+#endif // PLATFORM_CLOCK_H
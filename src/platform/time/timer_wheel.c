@@ -0,0 +1,113 @@
+/**
+ * @file timer_wheel.c
+ * @brief Hashed Timer Wheel Implementation
+ * @author USB Key Authentication Team
+ * @date 2025-09-08
+ * @version 1.0
+ */
+
+#include "timer_wheel.h"
+#include <stddef.h>
+
+#define TIMER_WHEEL_MASK        (TIMER_WHEEL_SLOTS - 1u)
+
+/**
+ * @brief Make a list head point to itself
+ */
+static void list_init(timer_wheel_node_t* head) {
+    head->next = head;
+    head->prev = head;
+}
+
+/**
+ * @brief Insert node right after head
+ */
+static void list_push(timer_wheel_node_t* head, timer_wheel_node_t* node) {
+    node->next = head->next;
+    node->prev = head;
+    head->next->prev = node;
+    head->next = node;
+}
+
+/**
+ * @brief Unlink node from whatever list holds it
+ */
+static void list_unlink(timer_wheel_node_t* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = NULL;
+    node->prev = NULL;
+}
+
+void timer_wheel_init(timer_wheel_t* wheel, uint32_t tick_ms, uint32_t now_ms) {
+    for (uint32_t i = 0; i < TIMER_WHEEL_SLOTS; i++) {
+        list_init(&wheel->slots[i]);
+    }
+    wheel->tick_ms = tick_ms ? tick_ms : 1u;
+    wheel->current = 0;
+    wheel->last_ms = now_ms;
+}
+
+void timer_wheel_node_init(timer_wheel_node_t* node, timer_wheel_callback_t callback,
+                           void* owner) {
+    node->next = NULL;
+    node->prev = NULL;
+    node->rounds = 0;
+    node->callback = callback;
+    node->owner = owner;
+}
+
+void timer_wheel_schedule(timer_wheel_t* wheel, timer_wheel_node_t* node, uint32_t timeout_ms) {
+    if (timer_wheel_is_armed(node)) {
+        list_unlink(node);
+    }
+
+    // One extra tick covers the part of the current tick already elapsed,
+    // so a timer never fires early
+    uint32_t ticks = timeout_ms / wheel->tick_ms + 1u;
+
+    node->rounds = (ticks - 1u) / TIMER_WHEEL_SLOTS;
+    list_push(&wheel->slots[(wheel->current + ticks) & TIMER_WHEEL_MASK], node);
+}
+
+void timer_wheel_cancel(timer_wheel_node_t* node) {
+    if (timer_wheel_is_armed(node)) {
+        list_unlink(node);
+    }
+}
+
+bool timer_wheel_is_armed(const timer_wheel_node_t* node) {
+    return node->next != NULL;
+}
+
+void timer_wheel_advance(timer_wheel_t* wheel, uint32_t now_ms) {
+    while (now_ms - wheel->last_ms >= wheel->tick_ms) {
+        wheel->last_ms += wheel->tick_ms;
+        wheel->current = (wheel->current + 1u) & TIMER_WHEEL_MASK;
+
+        timer_wheel_node_t* slot = &wheel->slots[wheel->current];
+        if (slot->next == slot) {
+            continue;
+        }
+
+        // Detach the slot so callbacks can freely schedule and cancel timers
+        timer_wheel_node_t due;
+        due.next = slot->next;
+        due.prev = slot->prev;
+        due.next->prev = &due;
+        due.prev->next = &due;
+        list_init(slot);
+
+        while (due.next != &due) {
+            timer_wheel_node_t* node = due.next;
+            list_unlink(node);
+
+            if (node->rounds > 0) {
+                node->rounds--;
+                list_push(slot, node);
+            } else if (node->callback) {
+                node->callback(node->owner);
+            }
+        }
+    }
+}
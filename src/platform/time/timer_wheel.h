@@ -0,0 +1,111 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+/**
+ * @file timer_wheel.h
+ * @brief Hashed Timer Wheel Interface
+ * @author USB Key Authentication Team
+ * @date 2025-09-08
+ * @version 1.0
+ *
+ * Fixed-size hashed timer wheel for protocol timeouts. Timers are nodes
+ * embedded in their owner, so scheduling, rescheduling and cancelling are
+ * O(1) and need no allocation. Timeouts longer than one revolution are
+ * handled with a per-node round counter.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Number of wheel slots (power of two) */
+#ifndef TIMER_WHEEL_SLOTS
+#define TIMER_WHEEL_SLOTS       64
+#endif
+
+#if (TIMER_WHEEL_SLOTS & (TIMER_WHEEL_SLOTS - 1)) != 0
+#error "TIMER_WHEEL_SLOTS must be a power of two"
+#endif
+
+/**
+ * @brief Timer expiry callback
+ *
+ * @param owner Owner pointer given to timer_wheel_node_init()
+ *
+ * @note The node is already disarmed; the callback may schedule it again
+ */
+typedef void (*timer_wheel_callback_t)(void* owner);
+
+/**
+ * @brief Timer node, embedded in the object it times
+ */
+typedef struct timer_wheel_node {
+    struct timer_wheel_node* next;          /**< Next node in slot */
+    struct timer_wheel_node* prev;          /**< Previous node in slot */
+    uint32_t rounds;                        /**< Revolutions left before expiry */
+    timer_wheel_callback_t callback;        /**< Expiry callback */
+    void* owner;                            /**< Callback argument */
+} timer_wheel_node_t;
+
+/**
+ * @brief Timer wheel
+ */
+typedef struct {
+    timer_wheel_node_t slots[TIMER_WHEEL_SLOTS]; /**< Slot list heads */
+    uint32_t tick_ms;                       /**< Slot granularity */
+    uint32_t current;                       /**< Slot of the last processed tick */
+    uint32_t last_ms;                       /**< Time of the last processed tick */
+} timer_wheel_t;
+
+/**
+ * @brief Initialize a timer wheel
+ *
+ * @param wheel Wheel to initialize
+ * @param tick_ms Granularity in milliseconds (must be non-zero)
+ * @param now_ms Current time
+ */
+void timer_wheel_init(timer_wheel_t* wheel, uint32_t tick_ms, uint32_t now_ms);
+
+/**
+ * @brief Initialize a timer node
+ *
+ * @param node Node to initialize
+ * @param callback Expiry callback
+ * @param owner Argument passed to the callback
+ */
+void timer_wheel_node_init(timer_wheel_node_t* node, timer_wheel_callback_t callback,
+                           void* owner);
+
+/**
+ * @brief Arm (or re-arm) a timer
+ *
+ * @param wheel Wheel to schedule on
+ * @param node Initialized node; rescheduled if already armed
+ * @param timeout_ms Timeout, rounded up to the wheel granularity
+ */
+void timer_wheel_schedule(timer_wheel_t* wheel, timer_wheel_node_t* node, uint32_t timeout_ms);
+
+/**
+ * @brief Disarm a timer
+ *
+ * @param node Node to disarm (no-op if not armed)
+ */
+void timer_wheel_cancel(timer_wheel_node_t* node);
+
+/**
+ * @brief Check if a timer is armed
+ */
+bool timer_wheel_is_armed(const timer_wheel_node_t* node);
+
+/**
+ * @brief Advance the wheel to the current time
+ *
+ * Processes every whole tick elapsed since the previous call and runs the
+ * callbacks of expired timers. Cost per tick is the number of nodes hashed
+ * to that slot, independent of the total number of timers.
+ *
+ * @param wheel Wheel to advance
+ * @param now_ms Current time
+ */
+void timer_wheel_advance(timer_wheel_t* wheel, uint32_t now_ms);
+
+#endif // TIMER_WHEEL_H